@@ -0,0 +1,120 @@
+#include <fmus/dsp/dsp.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace fmus::dsp;
+
+namespace {
+
+template<typename Func>
+double microsecondsPerCall(Func&& func, uint32_t iterations) {
+    func(); // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+}
+
+std::vector<float> makeFrames(uint32_t size, uint32_t channels) {
+    std::vector<float> frames(static_cast<size_t>(size) * channels);
+    for (uint32_t t = 0; t < size; ++t) {
+        for (uint32_t c = 0; c < channels; ++c) {
+            frames[static_cast<size_t>(t) * channels + c] = static_cast<float>(std::sin(0.01 * (c + 1) * t));
+        }
+    }
+    return frames;
+}
+
+} // anonymous namespace
+
+int main() {
+    const uint32_t channels = 64;
+    const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Batched FFT benchmark (float, " << channels << " channels, interleaved input)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(8) << "size"
+              << std::setw(18) << "serial vec [us]"
+              << std::setw(18) << "serial ws [us]"
+              << std::setw(14) << "batch [us]"
+              << std::setw(10) << "path" << std::endl;
+
+    for (uint32_t size = 16; size <= 8192; size *= 2) {
+        std::vector<float> frames = makeFrames(size, channels);
+        BatchFFT<float> batch(size, channels);
+        std::vector<std::complex<float>> output(static_cast<size_t>(channels) * batch.getBinCount());
+        uint32_t iterations = std::max(4u, (1u << 22) / (size * channels));
+
+        // Baseline: de-interleave and call the vector API once per channel
+        std::vector<float> channel(size);
+        double vectorCost = microsecondsPerCall([&] {
+            for (uint32_t c = 0; c < channels; ++c) {
+                for (uint32_t t = 0; t < size; ++t) {
+                    channel[t] = frames[static_cast<size_t>(t) * channels + c];
+                }
+                auto result = FFT::forwardReal(channel, 1.0f);
+                std::copy(result.value().data.begin(), result.value().data.end(),
+                          output.begin() + static_cast<size_t>(c) * batch.getBinCount());
+            }
+        }, iterations);
+
+        // Same loop over the allocation-free workspace API
+        FFTWorkspace<float> workspace(size);
+        double workspaceCost = microsecondsPerCall([&] {
+            for (uint32_t c = 0; c < channels; ++c) {
+                for (uint32_t t = 0; t < size; ++t) {
+                    channel[t] = frames[static_cast<size_t>(t) * channels + c];
+                }
+                FFT::forwardReal(channel.data(), size, output.data() + static_cast<size_t>(c) * batch.getBinCount(),
+                                 workspace);
+            }
+        }, iterations);
+
+        double batchCost = microsecondsPerCall([&] {
+            batch.forwardReal(frames.data(), BatchLayout::Interleaved, output.data());
+        }, iterations);
+
+        std::cout << std::setw(8) << size
+                  << std::setw(18) << vectorCost
+                  << std::setw(18) << workspaceCost
+                  << std::setw(14) << batchCost
+                  << std::setw(10) << (batch.isLaneWise() ? "lanes" : "channel") << std::endl;
+    }
+
+    // Thread scaling; speedups above 1 need as many idle cores as threads
+    std::cout << std::endl << "Scaling over worker threads (" << hardwareThreads
+              << " hardware threads available)" << std::endl;
+    std::cout << std::setw(8) << "size" << std::setw(10) << "threads"
+              << std::setw(14) << "batch [us]" << std::setw(12) << "speedup" << std::endl;
+
+    const uint32_t maxThreads = std::max(4u, hardwareThreads);
+    for (uint32_t size : {256u, 4096u}) {
+        std::vector<float> frames = makeFrames(size, channels);
+        BatchFFT<float> batch(size, channels);
+        std::vector<std::complex<float>> output(static_cast<size_t>(channels) * batch.getBinCount());
+        uint32_t iterations = std::max(4u, (1u << 22) / (size * channels));
+
+        double singleCost = 0;
+        for (uint32_t threads = 1; threads <= maxThreads; threads *= 2) {
+            WorkerPool pool(threads);
+            double cost = microsecondsPerCall([&] {
+                batch.forwardReal(frames.data(), BatchLayout::Interleaved, output.data(), &pool);
+            }, iterations);
+            if (threads == 1) {
+                singleCost = cost;
+            }
+            std::cout << std::setw(8) << size << std::setw(10) << threads
+                      << std::setw(14) << cost << std::setw(12) << std::setprecision(2) << singleCost / cost
+                      << std::setprecision(1) << std::endl;
+        }
+    }
+
+    return 0;
+}
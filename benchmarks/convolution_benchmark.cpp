@@ -0,0 +1,96 @@
+#include <fmus/dsp/dsp.h>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace fmus::dsp;
+
+namespace {
+
+// Direct-form FIR over a circular history, the baseline for the FFT paths
+class DirectFIR {
+public:
+    explicit DirectFIR(const std::vector<float>& taps)
+        : m_taps(taps), m_history(2 * taps.size(), 0.0f), m_index(0) {}
+
+    void process(const float* input, float* output, size_t count) {
+        const size_t n = m_taps.size();
+        for (size_t i = 0; i < count; ++i) {
+            m_index = (m_index == 0) ? n - 1 : m_index - 1;
+            m_history[m_index] = input[i];
+            m_history[m_index + n] = input[i];
+            const float* x = m_history.data() + m_index;
+            float sum = 0.0f;
+            for (size_t k = 0; k < n; ++k) {
+                sum += m_taps[k] * x[k];
+            }
+            output[i] = sum;
+        }
+    }
+
+private:
+    std::vector<float> m_taps;
+    std::vector<float> m_history;
+    size_t m_index;
+};
+
+template<typename Func>
+double nanosecondsPerSample(Func&& func, size_t samples, uint32_t iterations) {
+    func(); // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (iterations * static_cast<double>(samples));
+}
+
+} // anonymous namespace
+
+int main() {
+    const size_t blockSamples = 4096;
+    std::vector<float> input(blockSamples), output(blockSamples);
+    for (size_t i = 0; i < blockSamples; ++i) {
+        input[i] = static_cast<float>(std::sin(0.01 * i));
+    }
+
+    std::cout << "FIR convolution benchmark (float, " << blockSamples << "-sample buffers)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(8) << "taps"
+              << std::setw(16) << "direct [ns/smp]"
+              << std::setw(16) << "ols [ns/smp]"
+              << std::setw(10) << "ols lat"
+              << std::setw(18) << "part64 [ns/smp]"
+              << std::setw(12) << "part64 lat" << std::endl;
+
+    for (size_t tapCount = 64; tapCount <= 4096; tapCount *= 2) {
+        std::vector<float> taps(tapCount);
+        for (size_t k = 0; k < tapCount; ++k) {
+            taps[k] = static_cast<float>(std::exp(-0.002 * k) * std::cos(0.1 * k));
+        }
+        uint32_t iterations = 40;
+
+        DirectFIR direct(taps);
+        double directCost = nanosecondsPerSample([&] { direct.process(input.data(), output.data(), blockSamples); },
+                                                 blockSamples, iterations);
+
+        FFTConvolver<float> overlapSave(taps, ConvolutionMode::OverlapSave);
+        double olsCost = nanosecondsPerSample([&] { overlapSave.process(input.data(), output.data(), blockSamples); },
+                                              blockSamples, iterations);
+
+        FFTConvolver<float> partitioned(taps, ConvolutionMode::Partitioned, 64);
+        double partCost = nanosecondsPerSample([&] { partitioned.process(input.data(), output.data(), blockSamples); },
+                                               blockSamples, iterations);
+
+        std::cout << std::setw(8) << tapCount
+                  << std::setw(16) << directCost
+                  << std::setw(16) << olsCost
+                  << std::setw(10) << overlapSave.getLatency()
+                  << std::setw(18) << partCost
+                  << std::setw(12) << partitioned.getLatency() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <fmus/dsp/dsp.h>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace fmus::dsp;
+
+namespace {
+
+template<typename Func>
+double microsecondsPerCall(Func&& func, uint32_t iterations) {
+    func(); // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+}
+
+std::vector<float> makeSignal(size_t n, double frequency) {
+    std::vector<float> signal(n);
+    for (size_t i = 0; i < n; ++i) {
+        signal[i] = static_cast<float>(std::sin(frequency * i) + 0.3 * std::cos(0.7 * i));
+    }
+    return signal;
+}
+
+// Returns true if the FFT path was faster
+bool benchmarkPair(size_t n1, size_t n2) {
+    auto a = makeSignal(n1, 0.01);
+    auto b = makeSignal(n2, 0.02);
+    double work = static_cast<double>(n1) * static_cast<double>(n2);
+    uint32_t iterations = static_cast<uint32_t>(std::max(3.0, std::min(2000.0, 2e8 / work)));
+
+    double direct = microsecondsPerCall([&] { crossCorrelation(a, b, CorrelationMethod::Direct); }, iterations);
+    double fft = microsecondsPerCall([&] { crossCorrelation(a, b, CorrelationMethod::FFT); }, iterations);
+    bool autoFFT = shouldUseFFTCorrelation(n1, n2);
+
+    std::cout << std::setw(8) << n1 << std::setw(8) << n2
+              << std::setw(14) << direct
+              << std::setw(14) << fft
+              << std::setw(10) << (autoFFT ? "FFT" : "Direct")
+              << std::setw(10) << ((fft < direct) == autoFFT ? "" : "(miss)") << std::endl;
+    return fft < direct;
+}
+
+void printHeader() {
+    std::cout << std::setw(8) << "n1" << std::setw(8) << "n2"
+              << std::setw(14) << "direct [us]"
+              << std::setw(14) << "fft [us]"
+              << std::setw(10) << "auto" << std::endl;
+}
+
+} // anonymous namespace
+
+int main() {
+    std::cout << "Cross-correlation benchmark (float, SIMD level: "
+              << simdLevelToString(detectSimdLevel()) << ")" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << std::endl << "Equal lengths" << std::endl;
+    printHeader();
+    size_t crossover = 0;
+    for (size_t n = 8; n <= 32768; n *= 2) {
+        if (benchmarkPair(n, n) && crossover == 0) {
+            crossover = n;
+        }
+    }
+    std::cout << "FFT faster from n = " << crossover << std::endl;
+
+    std::cout << std::endl << "Template matching against 32768 samples" << std::endl;
+    printHeader();
+    crossover = 0;
+    for (size_t n = 4; n <= 4096; n *= 2) {
+        if (benchmarkPair(32768, n) && crossover == 0) {
+            crossover = n;
+        }
+    }
+    std::cout << "FFT faster from template length = " << crossover << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <fmus/dsp/fft.h>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace fmus::dsp;
+
+namespace {
+
+// Textbook radix-2 over std::complex with a twiddle recurrence, as a
+// baseline for the planned kernels
+template<typename T>
+void referenceRadix2(std::vector<std::complex<T>>& data) {
+    uint32_t n = static_cast<uint32_t>(data.size());
+
+    uint32_t j = 0;
+    for (uint32_t i = 1; i < n; ++i) {
+        uint32_t bit = n >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    for (uint32_t len = 2; len <= n; len <<= 1) {
+        T angle = static_cast<T>(-2 * M_PI / len);
+        std::complex<T> wlen(std::cos(angle), std::sin(angle));
+        for (uint32_t i = 0; i < n; i += len) {
+            std::complex<T> w(1, 0);
+            for (uint32_t k = 0; k < len / 2; ++k) {
+                std::complex<T> u = data[i + k];
+                std::complex<T> v = data[i + k + len / 2] * w;
+                data[i + k] = u + v;
+                data[i + k + len / 2] = u - v;
+                w *= wlen;
+            }
+        }
+    }
+}
+
+template<typename Func>
+double nanosecondsPerCall(Func&& func, uint32_t iterations) {
+    func(); // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+template<typename T>
+void benchmarkSize(uint32_t n, const char* typeName) {
+    std::vector<std::complex<T>> input(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        input[i] = {static_cast<T>(std::sin(0.01 * i)), static_cast<T>(std::cos(0.03 * i))};
+    }
+    std::vector<std::complex<T>> data = input;
+    uint32_t iterations = std::max<uint32_t>(20, 4000000 / n);
+
+    double reference = nanosecondsPerCall([&] { data = input; referenceRadix2(data); }, iterations);
+
+    FFTPlan<T> scalarPlan(n, FFTDirection::Forward, SimdLevel::Scalar);
+    double scalar = nanosecondsPerCall([&] { data = input; scalarPlan.execute(data.data()); }, iterations);
+
+    FFTPlan<T> simdPlan(n, FFTDirection::Forward);
+    double simd = nanosecondsPerCall([&] { data = input; simdPlan.execute(data.data()); }, iterations);
+
+    std::cout << std::setw(6) << typeName << std::setw(8) << n
+              << std::setw(14) << reference / 1000.0
+              << std::setw(14) << scalar / 1000.0
+              << std::setw(14) << simd / 1000.0
+              << std::setw(10) << reference / simd << "x" << std::endl;
+}
+
+template<typename T>
+void benchmarkArbitrarySize(uint32_t n) {
+    std::vector<std::complex<T>> input(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        input[i] = {static_cast<T>(std::sin(0.01 * i)), static_cast<T>(std::cos(0.03 * i))};
+    }
+    std::vector<std::complex<T>> data = input;
+    uint32_t iterations = std::max<uint32_t>(20, 2000000 / n);
+
+    FFTPlan<T> mixedPlan(n, FFTDirection::Forward, detectSimdLevel(), FFTAlgorithm::MixedRadix);
+    double mixed = nanosecondsPerCall([&] { data = input; mixedPlan.execute(data.data()); }, iterations);
+
+    FFTPlan<T> bluesteinPlan(n, FFTDirection::Forward, detectSimdLevel(), FFTAlgorithm::Bluestein);
+    double bluestein = nanosecondsPerCall([&] { data = input; bluesteinPlan.execute(data.data()); }, iterations);
+
+    // Zero-padding to the next power of 2 (fast, but a different transform)
+    uint32_t padded = FFT::nextPowerOf2(n);
+    std::vector<std::complex<T>> paddedData(padded);
+    FFTPlan<T> paddedPlan(padded, FFTDirection::Forward);
+    double pad = nanosecondsPerCall([&] {
+        std::copy(input.begin(), input.end(), paddedData.begin());
+        std::fill(paddedData.begin() + n, paddedData.end(), std::complex<T>(0, 0));
+        paddedPlan.execute(paddedData.data());
+    }, iterations);
+
+    // MixedRadix falls back to Bluestein for non-smooth sizes
+    bool smooth = mixedPlan.getAlgorithm() == FFTAlgorithm::MixedRadix;
+    std::cout << std::setw(8) << n
+              << std::setw(14) << (smooth ? mixed / 1000.0 : NAN)
+              << std::setw(14) << bluestein / 1000.0
+              << std::setw(14) << pad / 1000.0
+              << std::setw(12)
+              << (FFTPlan<T>::selectAlgorithm(n) == FFTAlgorithm::MixedRadix ? "mixed" : "bluestein")
+              << std::endl;
+}
+
+} // anonymous namespace
+
+int main() {
+    std::cout << "FFT benchmark (SIMD level: " << simdLevelToString(detectSimdLevel()) << ")" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(6) << "type" << std::setw(8) << "N"
+              << std::setw(14) << "ref [us]"
+              << std::setw(14) << "scalar [us]"
+              << std::setw(14) << "simd [us]"
+              << std::setw(11) << "speedup" << std::endl;
+
+    for (uint32_t n = 256; n <= 16384; n *= 2) {
+        benchmarkSize<float>(n, "float");
+    }
+    for (uint32_t n = 256; n <= 16384; n *= 2) {
+        benchmarkSize<double>(n, "double");
+    }
+
+    std::cout << std::endl << "Arbitrary sizes (float)" << std::endl;
+    std::cout << std::setw(8) << "N"
+              << std::setw(14) << "mixed [us]"
+              << std::setw(14) << "bluestein [us]"
+              << std::setw(14) << "padded [us]"
+              << std::setw(12) << "auto" << std::endl;
+    for (uint32_t n : {1000u, 1009u, 1536u, 3000u, 4095u, 5000u, 10007u, 44100u}) {
+        benchmarkArbitrarySize<float>(n);
+    }
+
+    return 0;
+}
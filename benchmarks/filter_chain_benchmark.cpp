@@ -0,0 +1,105 @@
+#include <fmus/dsp/dsp.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace fmus::dsp;
+
+namespace {
+
+const size_t BLOCK_SIZE = 4096;
+const uint32_t ITERATIONS = 200;
+
+template<size_t, typename Stage>
+using Repeat = Stage;
+
+template<typename Stage, size_t... I>
+StaticFilterChain<float, Repeat<I, Stage>...> repeatStage(const Stage& stage, std::index_sequence<I...>) {
+    return StaticFilterChain<float, Repeat<I, Stage>...>(((void)I, stage)...);
+}
+
+template<typename Func>
+double nanosecondsPerSample(Func&& func) {
+    func(); // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        func();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (ITERATIONS * static_cast<double>(BLOCK_SIZE));
+}
+
+// One row: N copies of the same stage, run-time list vs compile-time chain
+template<size_t N, typename Stage, typename MakeFilter>
+void compare(const char* name, const Stage& stage, MakeFilter makeFilter, const std::vector<float>& input) {
+    RealTimeProcessor<float> processor(BLOCK_SIZE, 48000.0f);
+    for (size_t i = 0; i < N; ++i) {
+        processor.addFilter(makeFilter());
+    }
+    auto chain = repeatStage(stage, std::make_index_sequence<N>{});
+
+    std::vector<float> dynamicOutput(BLOCK_SIZE);
+    std::vector<float> staticOutput(BLOCK_SIZE);
+    double dynamicCost = nanosecondsPerSample([&] {
+        for (size_t n = 0; n < BLOCK_SIZE; ++n) {
+            dynamicOutput[n] = processor.processSample(input[n]);
+        }
+    });
+    double staticCost = nanosecondsPerSample([&] {
+        chain.processBlock(input.data(), staticOutput.data(), BLOCK_SIZE);
+    });
+
+    // Both ran the same number of blocks, so their states must agree
+    double maxDifference = 0;
+    for (size_t n = 0; n < BLOCK_SIZE; ++n) {
+        maxDifference = std::max(maxDifference, static_cast<double>(std::abs(dynamicOutput[n] - staticOutput[n])));
+    }
+
+    std::cout << std::setw(10) << name << std::setw(8) << N
+              << std::setw(16) << dynamicCost << std::setw(16) << staticCost
+              << std::setw(11) << dynamicCost / staticCost << "x"
+              << std::setw(14) << std::scientific << std::setprecision(1) << maxDifference
+              << std::fixed << std::setprecision(2) << std::endl;
+}
+
+template<typename Stage, typename MakeFilter, size_t... N>
+void compareAll(const char* name, const Stage& stage, MakeFilter makeFilter, const std::vector<float>& input,
+                std::index_sequence<N...>) {
+    (compare<N + 1>(name, stage, makeFilter, input), ...);
+}
+
+} // anonymous namespace
+
+int main() {
+    std::vector<float> input(BLOCK_SIZE);
+    for (size_t n = 0; n < BLOCK_SIZE; ++n) {
+        input[n] = static_cast<float>(std::sin(0.01 * n) + 0.3 * std::sin(1.7 * n));
+    }
+
+    std::cout << "Filter chain benchmark: RealTimeProcessor (virtual call per stage and sample)" << std::endl
+              << "vs StaticFilterChain::processBlock, " << BLOCK_SIZE << "-sample blocks" << std::endl << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(10) << "stage" << std::setw(8) << "stages"
+              << std::setw(16) << "dynamic [ns/s]" << std::setw(16) << "static [ns/s]"
+              << std::setw(12) << "speedup" << std::setw(14) << "max diff" << std::endl;
+
+    const float alpha = 0.3f;
+    compareAll("one-pole", OnePoleLowPassStage<float>(alpha),
+               [&] { return std::make_shared<LowPassFilter<float>>(alpha); },
+               input, std::make_index_sequence<8>{});
+
+    const BiquadSection<float> section = designSOS<float>(FilterImplementation::Butterworth,
+                                                          FilterType::LowPass, 2, 0.3f).value()[0];
+    compareAll("biquad", BiquadStage<float>(section),
+               [&] {
+                   return std::make_shared<SOSFilter<float>>(std::vector<BiquadSection<float>>{section});
+               },
+               input, std::make_index_sequence<8>{});
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+#include <fmus/dsp/dsp.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace fmus::dsp;
+
+namespace {
+
+// Float direct-form FIR with the same doubled delay line as FIRFilterQ15
+class DirectFIR {
+public:
+    explicit DirectFIR(const std::vector<float>& taps)
+        : m_taps(taps), m_history(2 * taps.size(), 0.0f), m_index(0) {}
+
+    void process(const float* input, float* output, size_t count) {
+        const size_t n = m_taps.size();
+        for (size_t i = 0; i < count; ++i) {
+            m_index = (m_index == 0) ? n - 1 : m_index - 1;
+            m_history[m_index] = input[i];
+            m_history[m_index + n] = input[i];
+            const float* x = m_history.data() + m_index;
+            float sum = 0.0f;
+            for (size_t k = 0; k < n; ++k) {
+                sum += m_taps[k] * x[k];
+            }
+            output[i] = sum;
+        }
+    }
+
+private:
+    std::vector<float> m_taps;
+    std::vector<float> m_history;
+    size_t m_index;
+};
+
+// Float direct-form I biquad cascade, the baseline for BiquadFilterQ15
+template<typename T>
+void biquadCascade(const std::vector<float>& coefficients, const T* input, T* output, size_t count) {
+    const T* source = input;
+    for (size_t s = 0; s < coefficients.size(); s += 5) {
+        const float* c = coefficients.data() + s;
+        T x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        for (size_t i = 0; i < count; ++i) {
+            T x = source[i];
+            T y = c[0] * x + c[1] * x1 + c[2] * x2 - c[3] * y1 - c[4] * y2;
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            output[i] = y;
+        }
+        source = output;
+    }
+}
+
+template<typename Func>
+double microsecondsPerCall(Func&& func, uint32_t iterations) {
+    func(); // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+}
+
+// Signal-to-error ratio in dB
+template<typename A, typename B>
+double snrDecibels(const A& expected, const B& actual) {
+    double signal = 0;
+    double error = 0;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        signal += std::norm(expected[i]);
+        error += std::norm(actual[i] - expected[i]);
+    }
+    return (error > 0) ? 10 * std::log10(signal / error) : INFINITY;
+}
+
+template<typename Q>
+void runFixedFFT(uint32_t size, const std::vector<double>& re, const std::vector<double>& im,
+                 const std::vector<std::complex<double>>& reference, uint32_t iterations,
+                 double& cost, double& snr) {
+    std::vector<Q> inRe(size), inIm(size), workRe(size), workIm(size);
+    toFixed(re.data(), inRe.data(), size);
+    toFixed(im.data(), inIm.data(), size);
+    FixedFFTPlan<Q> plan(size, FFTDirection::Forward);
+
+    int32_t exponent = 0;
+    cost = microsecondsPerCall([&] {
+        std::copy(inRe.begin(), inRe.end(), workRe.begin());
+        std::copy(inIm.begin(), inIm.end(), workIm.begin());
+        exponent = plan.execute(workRe.data(), workIm.data()).value();
+    }, iterations);
+
+    std::vector<std::complex<double>> actual(size);
+    for (uint32_t k = 0; k < size; ++k) {
+        actual[k] = {fromFixed<double>(workRe[k], exponent), fromFixed<double>(workIm[k], exponent)};
+    }
+    snr = snrDecibels(reference, actual);
+}
+
+} // anonymous namespace
+
+int main() {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> dist(-0.7, 0.7);
+
+    std::cout << "Fixed-point vs float benchmark (SIMD level " << simdLevelToString(detectSimdLevel())
+              << ", SNR against double)" << std::endl << std::endl;
+    std::cout << "Complex FFT, split format" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(8) << "size"
+              << std::setw(13) << "float [us]" << std::setw(11) << "SNR [dB]"
+              << std::setw(13) << "Q15 [us]" << std::setw(11) << "SNR [dB]"
+              << std::setw(13) << "Q31 [us]" << std::setw(11) << "SNR [dB]" << std::endl;
+
+    for (uint32_t size = 64; size <= 4096; size *= 4) {
+        std::vector<double> re(size), im(size);
+        std::vector<std::complex<double>> signal(size);
+        for (uint32_t i = 0; i < size; ++i) {
+            re[i] = dist(rng);
+            im[i] = dist(rng);
+            signal[i] = {re[i], im[i]};
+        }
+        std::vector<std::complex<double>> reference = FFT::forward(signal).value().data;
+        uint32_t iterations = std::max(20u, (1u << 22) / size);
+
+        FFTPlan<float> plan(size, FFTDirection::Forward);
+        std::vector<float> floatRe(re.begin(), re.end()), floatIm(im.begin(), im.end());
+        std::vector<float> workRe(size), workIm(size);
+        double floatCost = microsecondsPerCall([&] {
+            std::copy(floatRe.begin(), floatRe.end(), workRe.begin());
+            std::copy(floatIm.begin(), floatIm.end(), workIm.begin());
+            plan.execute(workRe.data(), workIm.data());
+        }, iterations);
+        std::vector<std::complex<double>> floatResult(size);
+        for (uint32_t k = 0; k < size; ++k) {
+            floatResult[k] = {workRe[k], workIm[k]};
+        }
+
+        double q15Cost = 0, q15Snr = 0, q31Cost = 0, q31Snr = 0;
+        runFixedFFT<int16_t>(size, re, im, reference, iterations, q15Cost, q15Snr);
+        runFixedFFT<int32_t>(size, re, im, reference, iterations, q31Cost, q31Snr);
+
+        std::cout << std::setw(8) << size
+                  << std::setw(13) << floatCost << std::setw(11) << snrDecibels(reference, floatResult)
+                  << std::setw(13) << q15Cost << std::setw(11) << q15Snr
+                  << std::setw(13) << q31Cost << std::setw(11) << q31Snr << std::endl;
+    }
+
+    // Filters over a block of samples, timed per sample
+    const size_t blockSize = 4096;
+    std::vector<double> input(blockSize);
+    for (size_t i = 0; i < blockSize; ++i) {
+        input[i] = 0.5 * std::sin(0.01 * i) + 0.2 * dist(rng);
+    }
+    std::vector<float> floatInput(input.begin(), input.end());
+    std::vector<int16_t> fixedInput(blockSize);
+    toFixed(input.data(), fixedInput.data(), blockSize);
+    std::vector<float> floatOutput(blockSize);
+    std::vector<int16_t> fixedOutput(blockSize);
+    std::vector<double> fixedResult(blockSize);
+
+    std::cout << std::endl << "Filters (" << blockSize << "-sample blocks)" << std::endl;
+    std::cout << std::setw(16) << "filter"
+              << std::setw(15) << "float [ns/s]" << std::setw(11) << "SNR [dB]"
+              << std::setw(15) << "Q15 [ns/s]" << std::setw(11) << "SNR [dB]" << std::endl;
+
+    for (uint32_t taps : {16u, 64u, 256u}) {
+        // Windowed-sinc low-pass at 0.1 fs
+        std::vector<float> coefficients(taps);
+        for (uint32_t k = 0; k < taps; ++k) {
+            double t = k - (taps - 1) / 2.0;
+            double sinc = (t == 0) ? 0.2 : std::sin(0.2 * M_PI * t) / (M_PI * t);
+            coefficients[k] = static_cast<float>(sinc * (0.54 - 0.46 * std::cos(2 * M_PI * k / (taps - 1))));
+        }
+
+        std::vector<double> reference(blockSize);
+        for (size_t n = 0; n < blockSize; ++n) {
+            double acc = 0;
+            for (size_t k = 0; k < taps && k <= n; ++k) {
+                acc += static_cast<double>(coefficients[k]) * input[n - k];
+            }
+            reference[n] = acc;
+        }
+
+        uint32_t iterations = std::max(4u, (1u << 20) / static_cast<uint32_t>(blockSize * taps / 16));
+        DirectFIR floatFilter(coefficients);
+        double floatCost = microsecondsPerCall([&] {
+            floatFilter.process(floatInput.data(), floatOutput.data(), blockSize);
+        }, iterations);
+        floatFilter = DirectFIR(coefficients);
+        floatFilter.process(floatInput.data(), floatOutput.data(), blockSize);
+
+        FIRFilterQ15 fixedFilter(coefficients);
+        double fixedCost = microsecondsPerCall([&] {
+            fixedFilter.process(fixedInput.data(), fixedOutput.data(), blockSize);
+        }, iterations);
+        fixedFilter.reset();
+        fixedFilter.process(fixedInput.data(), fixedOutput.data(), blockSize);
+        fromFixed(fixedOutput.data(), fixedResult.data(), blockSize);
+
+        std::cout << std::setw(11) << "FIR " << std::setw(5) << taps
+                  << std::setw(15) << 1000 * floatCost / blockSize << std::setw(11) << snrDecibels(reference, floatOutput)
+                  << std::setw(15) << 1000 * fixedCost / blockSize << std::setw(11) << snrDecibels(reference, fixedResult)
+                  << std::endl;
+    }
+
+    // Fourth-order Butterworth low-pass at 0.1 fs as two sections
+    const std::vector<float> sections = {
+        0.0048243f, 0.0096486f, 0.0048243f, -1.0485995f, 0.2961403f,
+        1.0f, 2.0f, 1.0f, -1.3209134f, 0.6327387f};
+    std::vector<double> reference(blockSize);
+    biquadCascade(sections, input.data(), reference.data(), blockSize);
+
+    uint32_t iterations = 400;
+    double floatCost = microsecondsPerCall([&] {
+        biquadCascade(sections, floatInput.data(), floatOutput.data(), blockSize);
+    }, iterations);
+    BiquadFilterQ15 biquad(sections);
+    double fixedCost = microsecondsPerCall([&] {
+        biquad.reset();
+        biquad.process(fixedInput.data(), fixedOutput.data(), blockSize);
+    }, iterations);
+    fromFixed(fixedOutput.data(), fixedResult.data(), blockSize);
+
+    std::cout << std::setw(16) << "biquad x2"
+              << std::setw(15) << 1000 * floatCost / blockSize << std::setw(11) << snrDecibels(reference, floatOutput)
+              << std::setw(15) << 1000 * fixedCost / blockSize << std::setw(11) << snrDecibels(reference, fixedResult)
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <fmus/dsp/dsp.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace fmus::dsp;
+
+namespace {
+
+const uint32_t STEPS = 200000;
+
+// NZ axes of NX / NZ states each: position, velocity and, with three
+// states per axis, a sensor bias added to the measured position
+template<typename T, size_t NX, size_t NZ>
+KalmanFilterN<T, NX, NZ> makeModel(KalmanForm form) {
+    using Filter = KalmanFilterN<T, NX, NZ>;
+    const size_t perAxis = NX / NZ;
+    const T dt = static_cast<T>(0.001);
+
+    typename Filter::StateMatrix f = Filter::StateMatrix::identity();
+    typename Filter::ObservationMatrix h{};
+    typename Filter::StateMatrix q{};
+    typename Filter::MeasurementMatrix r{};
+    for (size_t axis = 0; axis < NZ; ++axis) {
+        const size_t p = axis * perAxis;
+        f(p, p + 1) = dt;
+        h(axis, p) = 1;
+        q(p, p) = static_cast<T>(1e-7);
+        q(p + 1, p + 1) = static_cast<T>(1e-4);
+        r(axis, axis) = static_cast<T>(0.01);
+        if (perAxis == 3) {
+            h(axis, p + 2) = 1;
+            q(p + 2, p + 2) = static_cast<T>(1e-9);
+        }
+    }
+    return Filter(f, h, q, r, Filter::StateVector::zero(), Filter::StateMatrix::identity(), form);
+}
+
+template<typename T, size_t NX, size_t NZ>
+void run(const char* type, KalmanForm form) {
+    auto filter = makeModel<T, NX, NZ>(form);
+
+    std::mt19937 rng(1);
+    std::normal_distribution<T> noise(0, static_cast<T>(0.1));
+    std::vector<typename KalmanFilterN<T, NX, NZ>::MeasurementVector> measurements(1024);
+    for (auto& z : measurements) {
+        for (size_t i = 0; i < NZ; ++i) {
+            z.data[i] = 1 + noise(rng);
+        }
+    }
+
+    uint32_t failures = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < STEPS; ++n) {
+        filter.predict();
+        failures += filter.update(measurements[n & 1023]).isError() ? 1 : 0;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::setw(8) << NX << std::setw(8) << NZ << std::setw(8) << type
+              << std::setw(8) << (form == KalmanForm::Joseph ? "Joseph" : "UD")
+              << std::setw(18) << STEPS / seconds / 1e6
+              << std::setw(14) << seconds * 1e9 / STEPS
+              << std::setw(12) << filter.getState().data[0] << (failures ? "  FAILED" : "") << std::endl;
+}
+
+template<typename T>
+void runAll(const char* type) {
+    for (KalmanForm form : {KalmanForm::Joseph, KalmanForm::UD}) {
+        run<T, 3, 1>(type, form);
+        run<T, 6, 3>(type, form);
+        run<T, 9, 3>(type, form);
+    }
+}
+
+} // anonymous namespace
+
+int main() {
+    std::cout << "KalmanFilterN benchmark: one predict() and update() per step, "
+              << STEPS << " steps" << std::endl << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::setw(8) << "states" << std::setw(8) << "meas" << std::setw(8) << "type"
+              << std::setw(8) << "form" << std::setw(18) << "updates [M/s]"
+              << std::setw(14) << "[ns/step]" << std::setw(12) << "x[0]" << std::endl;
+
+    runAll<float>("float");
+    runAll<double>("double");
+    return 0;
+}
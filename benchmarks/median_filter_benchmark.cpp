@@ -0,0 +1,89 @@
+#include <fmus/dsp/dsp.h>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace fmus::dsp;
+
+namespace {
+
+const size_t SIGNAL_LENGTH = 20000;
+const double SAMPLE_RATE = 20000.0;
+
+// The previous MedianFilter: copy the window and sort it for every sample
+class SortingMedian {
+public:
+    explicit SortingMedian(uint32_t windowSize) : m_buffer(windowSize, 0.0f), m_index(0), m_full(false) {}
+
+    float process(float input) {
+        m_buffer[m_index] = input;
+        m_index = (m_index + 1) % m_buffer.size();
+        if (m_index == 0) {
+            m_full = true;
+        }
+
+        std::vector<float> sorted(m_buffer.begin(), m_full ? m_buffer.end() : m_buffer.begin() + m_index);
+        std::sort(sorted.begin(), sorted.end());
+        size_t size = sorted.size();
+        return (size % 2 == 0) ? (sorted[size / 2 - 1] + sorted[size / 2]) / 2 : sorted[size / 2];
+    }
+
+private:
+    std::vector<float> m_buffer;
+    size_t m_index;
+    bool m_full;
+};
+
+template<typename Func>
+double nanosecondsPerSample(Func&& func, size_t samples) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(samples);
+}
+
+} // anonymous namespace
+
+int main() {
+    // Noisy sensor signal with impulsive outliers
+    std::mt19937 rng(1);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    std::vector<float> input(SIGNAL_LENGTH);
+    for (size_t n = 0; n < SIGNAL_LENGTH; ++n) {
+        input[n] = static_cast<float>(std::sin(0.002 * n)) + noise(rng) + (uniform(rng) < 0.01f ? 10.0f : 0.0f);
+    }
+
+    std::cout << "Median filter benchmark: copy+sort per sample vs double heap, "
+              << SIGNAL_LENGTH << " samples" << std::endl << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::setw(8) << "window" << std::setw(16) << "sort [ns/s]" << std::setw(16) << "heap [ns/s]"
+              << std::setw(12) << "speedup" << std::setw(18) << "load @ 20 kHz" << std::setw(10) << "equal" << std::endl;
+
+    for (uint32_t window : {5u, 11u, 31u, 101u, 301u, 1001u}) {
+        SortingMedian sorting(window);
+        MedianFilter<float> heap(window);
+        std::vector<float> sortOutput(SIGNAL_LENGTH);
+        std::vector<float> heapOutput(SIGNAL_LENGTH);
+
+        double sortCost = nanosecondsPerSample([&] {
+            for (size_t n = 0; n < SIGNAL_LENGTH; ++n) {
+                sortOutput[n] = sorting.process(input[n]);
+            }
+        }, SIGNAL_LENGTH);
+        double heapCost = nanosecondsPerSample([&] {
+            heap.processBlock(input.data(), heapOutput.data(), SIGNAL_LENGTH);
+        }, SIGNAL_LENGTH);
+
+        // Share of one core needed to keep up with a 20 kHz stream
+        double load = heapCost * SAMPLE_RATE * 1e-9 * 100.0;
+        std::cout << std::setw(8) << window << std::setw(16) << sortCost << std::setw(16) << heapCost
+                  << std::setw(11) << sortCost / heapCost << "x" << std::setw(17) << std::setprecision(3) << load << "%"
+                  << std::setw(10) << (sortOutput == heapOutput ? "yes" : "NO") << std::setprecision(1) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+/**
+ * @file batch_fft.h
+ * @brief Same-size FFTs over many channels in one call
+ *
+ * Multi-channel sensors (accelerometer arrays, microphone arrays) transform
+ * every channel with the same size each frame. Batching them amortizes the
+ * per-call overhead, lets small transforms vectorize across channels rather
+ * than within one short channel, and spreads channels over a WorkerPool.
+ */
+
+#include "fft.h"
+#include "worker_pool.h"
+#include <vector>
+#include <cstdint>
+#include <complex>
+#include <memory>
+#include <string>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief Memory layout of a multi-channel sample block
+ */
+enum class BatchLayout : uint8_t {
+    ChannelMajor = 0,   ///< Channel c, sample n at c * size + n
+    Interleaved = 1     ///< Channel c, sample n at n * channelCount + c (frames)
+};
+
+/**
+ * @brief Forward real FFT of every channel of a sample matrix
+ *
+ * Output is one contiguous channel-major block of getBinCount() (N/2 + 1)
+ * bins per channel, matching FFT::forwardReal() on each channel.
+ *
+ * Power-of-2 sizes up to MAX_LANE_SIZE are computed lane-wise: channels
+ * are packed in pairs as the real and imaginary parts of one complex
+ * transform, and the butterflies run across LANE_COUNT such pairs at once.
+ * Other sizes use one RealFFTPlan per channel. Per-worker scratch is
+ * allocated on the first call with a given worker count and reused after
+ * that. An instance must not be used from several threads at once.
+ */
+template<typename T>
+class FMUS_EMBED_API BatchFFT {
+public:
+    /**
+     * @brief Largest size transformed lane-wise across channels
+     */
+    static const uint32_t MAX_LANE_SIZE = 1024;
+
+    /**
+     * @brief Channel pairs per lane group
+     */
+    static const uint32_t LANE_COUNT = 8;
+
+    /**
+     * @brief Construct a batch transform
+     *
+     * @param size FFT size N per channel (at least 1)
+     * @param channelCount Number of channels (at least 1)
+     * @param window Window applied to every channel
+     */
+    BatchFFT(uint32_t size, uint32_t channelCount, WindowType window = WindowType::None);
+
+    ~BatchFFT();
+
+    /**
+     * @brief Transform all channels
+     *
+     * @param input size * channelCount samples in the given layout
+     * @param layout Input layout
+     * @param output channelCount * getBinCount() bins, channel-major
+     * @param pool Optional pool to spread channels over (nullptr runs on
+     *             the calling thread)
+     * @return core::Result<void> Success or error
+     */
+    core::Result<void> forwardReal(const T* input, BatchLayout layout, std::complex<T>* output,
+                                   WorkerPool* pool = nullptr);
+
+    /**
+     * @brief Get FFT size per channel
+     *
+     * @return uint32_t Size
+     */
+    uint32_t getSize() const { return m_size; }
+
+    /**
+     * @brief Get number of channels
+     *
+     * @return uint32_t Channel count
+     */
+    uint32_t getChannelCount() const { return m_channelCount; }
+
+    /**
+     * @brief Get number of output bins per channel
+     *
+     * @return uint32_t N/2 + 1
+     */
+    uint32_t getBinCount() const { return m_size / 2 + 1; }
+
+    /**
+     * @brief Check whether channels are transformed lane-wise
+     *
+     * @return bool True for power-of-2 sizes up to MAX_LANE_SIZE
+     */
+    bool isLaneWise() const { return m_laneWise; }
+
+private:
+    uint32_t m_size;
+    uint32_t m_channelCount;
+    WindowType m_windowType;
+    bool m_laneWise;
+    SimdLevel m_simdLevel;
+    std::shared_ptr<const std::vector<T>> m_window;     ///< Null for a rectangular window
+
+    // Lane-wise path
+    std::vector<uint32_t> m_bitReverse;
+    std::vector<T> m_twiddles;
+    std::vector<std::vector<T>> m_laneScratch;          ///< Per worker: re and im, N * LANE_COUNT each
+
+    // Per-channel path
+    std::vector<std::unique_ptr<FFTWorkspace<T>>> m_workspaces;
+    std::vector<std::vector<T>> m_channelScratch;       ///< Per worker: one gathered channel
+
+    void ensureScratch(uint32_t workers);
+    void transformLaneGroup(const T* input, BatchLayout layout, std::complex<T>* output,
+                            uint32_t group, T* scratch) const;
+    void transformChannel(const T* input, BatchLayout layout, std::complex<T>* output,
+                          uint32_t channel, uint32_t worker);
+};
+
+/**
+ * @brief Get string representation of batch layout
+ *
+ * @param layout Batch layout
+ * @return std::string String representation
+ */
+FMUS_EMBED_API std::string batchLayoutToString(BatchLayout layout);
+
+// Explicit template instantiations
+extern template class FMUS_EMBED_API BatchFFT<float>;
+extern template class FMUS_EMBED_API BatchFFT<double>;
+
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,224 @@
+#pragma once
+
+/**
+ * @file cic_filter.h
+ * @brief Cascaded integrator-comb (CIC) decimators and interpolators
+ *
+ * A CIC filter changes the sample rate by a large integer factor using
+ * only additions: N integrators run at the high rate and N combs at the
+ * low rate. Its sinc^N response droops across the passband, which an
+ * optional short FIR at the low rate compensates, so the usual chain is a
+ * CIC for the bulk of the rate change followed by the expensive DSP at
+ * the reduced rate.
+ */
+
+#include "../fmus_config.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief CIC decimator with optional droop compensation
+ *
+ * Samples are converted to 64-bit fixed point, whose wrap-around
+ * arithmetic keeps the integrators exact however long the stream runs:
+ * the register overflows harmlessly as long as the final output fits.
+ * Outputs are scaled back to unity DC gain.
+ */
+template<typename T>
+class FMUS_EMBED_API CICDecimator {
+public:
+    /**
+     * @brief Construct a decimator
+     *
+     * @param factor Decimation factor R
+     * @param order Number of integrator/comb stages N (1-8)
+     * @param differentialDelay Comb delay D in output samples (1 or 2)
+     * @param compensationTaps Length of the droop compensation FIR (0 disables it)
+     * @param maxInput Largest input magnitude, which sets the fixed-point scaling
+     */
+    CICDecimator(uint32_t factor, uint32_t order = 4, uint32_t differentialDelay = 1,
+                 uint32_t compensationTaps = 0, T maxInput = 1);
+
+    /**
+     * @brief Decimate a block
+     *
+     * @param input Input samples at the high rate
+     * @param count Number of input samples
+     * @param output Output buffer with room for getMaxOutputCount(count) samples
+     * @return size_t Number of output samples written
+     */
+    size_t process(const T* input, size_t count, T* output);
+
+    /**
+     * @brief Decimate a block into a new vector
+     *
+     * @param input Input samples at the high rate
+     * @return std::vector<T> Output samples at the low rate
+     */
+    std::vector<T> process(const std::vector<T>& input);
+
+    /**
+     * @brief Upper bound on the outputs produced by one process() call
+     *
+     * @param inputCount Number of input samples
+     * @return size_t Maximum number of output samples
+     */
+    size_t getMaxOutputCount(size_t inputCount) const { return inputCount / m_factor + 1; }
+
+    /**
+     * @brief Clear the integrators, combs and compensator history
+     */
+    void reset();
+
+    uint32_t getFactor() const { return m_factor; }
+    uint32_t getOrder() const { return m_order; }
+    uint32_t getDifferentialDelay() const { return m_delay; }
+
+    /**
+     * @brief Get the register growth N * log2(R * D)
+     *
+     * @return uint32_t Bits added to the input by the filter gain
+     */
+    uint32_t getBitGrowth() const { return m_bitGrowth; }
+
+    /**
+     * @brief Get the compensation FIR coefficients
+     *
+     * @return const std::vector<T>& Taps at the output rate, empty if disabled
+     */
+    const std::vector<T>& getCompensationTaps() const { return m_compensator; }
+
+private:
+    T compensate(T sample);
+
+    uint32_t m_factor;
+    uint32_t m_order;
+    uint32_t m_delay;
+    uint32_t m_bitGrowth;
+    double m_inputScale;            ///< Input to fixed point
+    double m_outputScale;           ///< Fixed point back to unity gain
+    std::vector<uint64_t> m_integrators;
+    std::vector<uint64_t> m_combs;  ///< D delayed values per stage
+    uint32_t m_combIndex;
+    uint32_t m_phase;               ///< Inputs since the last output
+    std::vector<T> m_compensator;
+    std::vector<T> m_compensatorHistory;
+    uint32_t m_compensatorIndex;
+};
+
+/**
+ * @brief CIC interpolator with optional droop pre-compensation
+ *
+ * The mirror image of CICDecimator: the compensation FIR and the combs run
+ * at the low input rate and the integrators at the high output rate, with
+ * the same wrap-around fixed-point arithmetic. Outputs have unity DC gain.
+ */
+template<typename T>
+class FMUS_EMBED_API CICInterpolator {
+public:
+    /**
+     * @brief Construct an interpolator
+     *
+     * @param factor Interpolation factor R
+     * @param order Number of comb/integrator stages N (1-8)
+     * @param differentialDelay Comb delay D in input samples (1 or 2)
+     * @param compensationTaps Length of the droop compensation FIR (0 disables it)
+     * @param maxInput Largest input magnitude, which sets the fixed-point scaling
+     */
+    CICInterpolator(uint32_t factor, uint32_t order = 4, uint32_t differentialDelay = 1,
+                    uint32_t compensationTaps = 0, T maxInput = 1);
+
+    /**
+     * @brief Interpolate a block
+     *
+     * @param input Input samples at the low rate
+     * @param count Number of input samples
+     * @param output Output buffer with room for getMaxOutputCount(count) samples
+     * @return size_t Number of output samples written (count * R)
+     */
+    size_t process(const T* input, size_t count, T* output);
+
+    /**
+     * @brief Interpolate a block into a new vector
+     *
+     * @param input Input samples at the low rate
+     * @return std::vector<T> Output samples at the high rate
+     */
+    std::vector<T> process(const std::vector<T>& input);
+
+    /**
+     * @brief Number of outputs produced by one process() call
+     *
+     * @param inputCount Number of input samples
+     * @return size_t inputCount * R
+     */
+    size_t getMaxOutputCount(size_t inputCount) const { return inputCount * m_factor; }
+
+    /**
+     * @brief Clear the combs, integrators and compensator history
+     */
+    void reset();
+
+    uint32_t getFactor() const { return m_factor; }
+    uint32_t getOrder() const { return m_order; }
+    uint32_t getDifferentialDelay() const { return m_delay; }
+
+    /**
+     * @brief Get the register growth N * log2(R * D)
+     *
+     * @return uint32_t Bits added to the input by the filter gain
+     */
+    uint32_t getBitGrowth() const { return m_bitGrowth; }
+
+    /**
+     * @brief Get the compensation FIR coefficients
+     *
+     * @return const std::vector<T>& Taps at the input rate, empty if disabled
+     */
+    const std::vector<T>& getCompensationTaps() const { return m_compensator; }
+
+private:
+    T compensate(T sample);
+
+    uint32_t m_factor;
+    uint32_t m_order;
+    uint32_t m_delay;
+    uint32_t m_bitGrowth;
+    double m_inputScale;
+    double m_outputScale;
+    std::vector<uint64_t> m_combs;
+    uint32_t m_combIndex;
+    std::vector<uint64_t> m_integrators;
+    std::vector<T> m_compensator;
+    std::vector<T> m_compensatorHistory;
+    uint32_t m_compensatorIndex;
+};
+
+/**
+ * @brief Design a CIC droop compensation FIR
+ *
+ * Linear-phase, Kaiser-windowed approximation of the inverse CIC response
+ * up to a quarter of the low sample rate, cut off above it.
+ *
+ * @tparam T Data type
+ * @param factor Rate change factor R
+ * @param order Number of CIC stages N
+ * @param differentialDelay Comb delay D
+ * @param numTaps FIR length (rounded up to odd)
+ * @return std::vector<T> Taps at the low rate with unity DC gain
+ */
+template<typename T>
+FMUS_EMBED_API std::vector<T> designCICCompensator(uint32_t factor, uint32_t order,
+                                                   uint32_t differentialDelay, uint32_t numTaps);
+
+extern template class FMUS_EMBED_API CICDecimator<float>;
+extern template class FMUS_EMBED_API CICDecimator<double>;
+extern template class FMUS_EMBED_API CICInterpolator<float>;
+extern template class FMUS_EMBED_API CICInterpolator<double>;
+
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,140 @@
+#pragma once
+
+/**
+ * @file convolution.h
+ * @brief FFT block convolution for long FIR filters
+ *
+ * Streaming FIR filtering by uniformly partitioned overlap-save. The kernel
+ * is split into partitions of B taps whose spectra are computed once; each
+ * block of B input samples costs one real FFT and one inverse FFT of size 2B
+ * plus a spectral multiply-accumulate per partition.
+ */
+
+#include "filter.h"
+#include "fft.h"
+#include <vector>
+#include <cstdint>
+#include <memory>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief Block convolution modes
+ */
+enum class ConvolutionMode : uint8_t {
+    OverlapSave = 0,    ///< Single partition covering all taps (latency >= tap count)
+    Partitioned = 1     ///< Uniform partitions of the requested block size (low latency)
+};
+
+/**
+ * @brief FIR filter evaluated by FFT block convolution
+ *
+ * Output is delayed by getLatency() samples relative to a direct FIR, as
+ * each block is transformed once it is complete. Steady-state processing
+ * performs no allocations.
+ */
+template<typename T>
+class FMUS_EMBED_API FFTConvolver : public Filter<T> {
+public:
+    /**
+     * @brief Construct a convolver
+     *
+     * @param taps FIR coefficients (at least one)
+     * @param mode Convolution mode
+     * @param blockSize Block size for Partitioned mode, rounded up to a power
+     *                  of 2; in OverlapSave mode the block is at least the tap count
+     * @param type Filter type reported by getType()
+     */
+    FFTConvolver(const std::vector<T>& taps,
+                 ConvolutionMode mode = ConvolutionMode::OverlapSave,
+                 uint32_t blockSize = 64,
+                 FilterType type = FilterType::LowPass);
+
+    ~FFTConvolver() override;
+
+    T process(T input) override;
+    std::vector<T> process(const std::vector<T>& input) override;
+    void reset() override;
+    FilterType getType() const override { return m_type; }
+    FilterImplementation getImplementation() const override { return FilterImplementation::FIR; }
+    uint32_t getOrder() const override;
+
+    /**
+     * @brief Filter a buffer without allocating
+     *
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param count Number of samples
+     */
+    void process(const T* input, T* output, size_t count);
+
+    using Filter<T>::processBlock;
+    void processBlock(const T* input, T* output, size_t count) override { process(input, output, count); }
+
+    /**
+     * @brief Get block latency in samples
+     *
+     * @return uint32_t Latency (equal to the block size)
+     */
+    uint32_t getLatency() const { return m_blockSize; }
+
+    /**
+     * @brief Get block size
+     *
+     * @return uint32_t Samples per block
+     */
+    uint32_t getBlockSize() const { return m_blockSize; }
+
+    /**
+     * @brief Get number of kernel partitions
+     *
+     * @return uint32_t Partition count
+     */
+    uint32_t getPartitionCount() const { return m_partitionCount; }
+
+    /**
+     * @brief Get convolution mode
+     *
+     * @return ConvolutionMode Mode
+     */
+    ConvolutionMode getMode() const { return m_mode; }
+
+private:
+    uint32_t m_tapCount;
+    ConvolutionMode m_mode;
+    FilterType m_type;
+    uint32_t m_blockSize;           ///< B; the FFT size is 2B
+    uint32_t m_binCount;            ///< B + 1
+    uint32_t m_partitionCount;      ///< P = ceil(taps / B)
+    std::shared_ptr<const RealFFTPlan<T>> m_forwardPlan;
+    std::shared_ptr<const RealFFTPlan<T>> m_inversePlan;
+    std::vector<T> m_kernelRe;      ///< P partition spectra, split format
+    std::vector<T> m_kernelIm;
+    std::vector<T> m_delayRe;       ///< Frequency-domain delay line of P input spectra
+    std::vector<T> m_delayIm;
+    uint32_t m_delayIndex;          ///< Slot holding the newest input spectrum
+    std::vector<T> m_inputBuffer;   ///< Previous and current input block (2B)
+    std::vector<T> m_outputBlock;   ///< Output of the last completed block (B)
+    std::vector<std::complex<T>> m_spectrum;
+    std::vector<T> m_timeScratch;   ///< 2B
+    std::vector<T> m_workspace;     ///< FFT scratch
+    uint32_t m_fill;                ///< Samples in the current input block
+
+    void convolveBlock();
+};
+
+/**
+ * @brief Get string representation of convolution mode
+ *
+ * @param mode Convolution mode
+ * @return std::string String representation
+ */
+FMUS_EMBED_API std::string convolutionModeToString(ConvolutionMode mode);
+
+// Explicit template instantiations
+extern template class FMUS_EMBED_API FFTConvolver<float>;
+extern template class FMUS_EMBED_API FFTConvolver<double>;
+
+} // namespace dsp
+} // namespace fmus
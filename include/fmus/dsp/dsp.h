@@ -10,9 +10,24 @@
 
 #include "filter.h"
 #include "fft.h"
+#include "batch_fft.h"
+#include "convolution.h"
+#include "sliding_dft.h"
+#include "spectral_features.h"
+#include "spectral_density.h"
+#include "sos_filter.h"
+#include "static_filter_chain.h"
+#include "kalman_filter.h"
+#include "resampler.h"
+#include "cic_filter.h"
+#include "nco.h"
+#include "spsc_ring.h"
+#include "fixed_point.h"
+#include "worker_pool.h"
 #include "../core/result.h"
 #include <vector>
 #include <cstdint>
+#include <memory>
 
 namespace fmus {
 namespace dsp {
@@ -55,6 +70,105 @@ struct SignalStats {
     uint32_t length; ///< Signal length
 };
 
+/**
+ * @brief Streaming accumulator for signal statistics
+ *
+ * Single samples are folded in with Welford's update; blocks are summarised
+ * with SIMD two-pass moments over cache-sized pieces and folded in with
+ * Chan's pairwise merge, which also combines accumulators filled by
+ * different threads. Mean and squared deviations are kept in double
+ * precision, so the result stays accurate over unbounded streams and does
+ * not suffer the cancellation of the sum-of-squares formula.
+ */
+template<typename T>
+class FMUS_EMBED_API RunningStats {
+public:
+    RunningStats();
+
+    /**
+     * @brief Add one sample
+     *
+     * @param sample Input sample
+     */
+    void add(T sample);
+
+    /**
+     * @brief Add a block of samples
+     *
+     * @param data Input samples
+     * @param count Number of samples
+     */
+    void add(const T* data, size_t count);
+
+    /**
+     * @brief Fold in another accumulator as if its samples had been added
+     *
+     * @param other Accumulator to merge
+     */
+    void merge(const RunningStats& other);
+
+    /**
+     * @brief Clear all samples
+     */
+    void reset();
+
+    /**
+     * @brief Get the number of samples added
+     *
+     * @return uint64_t Sample count
+     */
+    uint64_t getCount() const { return m_count; }
+
+    /**
+     * @brief Get the mean of the samples
+     *
+     * @return T Mean, 0 when empty
+     */
+    T getMean() const { return static_cast<T>(m_mean); }
+
+    /**
+     * @brief Get the population variance (divided by the count)
+     *
+     * @return T Variance, 0 when empty
+     */
+    T getVariance() const;
+
+    /**
+     * @brief Get the sample variance (divided by the count minus one)
+     *
+     * @return T Unbiased variance, 0 with fewer than two samples
+     */
+    T getSampleVariance() const;
+
+    /**
+     * @brief Get the smallest sample
+     *
+     * @return T Minimum, 0 when empty
+     */
+    T getMin() const { return m_min; }
+
+    /**
+     * @brief Get the largest sample
+     *
+     * @return T Maximum, 0 when empty
+     */
+    T getMax() const { return m_max; }
+
+    /**
+     * @brief Get the statistics of all samples added so far
+     *
+     * @return SignalStats<T> Statistics (all zero when empty)
+     */
+    SignalStats<T> getStats() const;
+
+private:
+    uint64_t m_count;
+    double m_mean;
+    double m_squaredDeviations;     ///< sum (x - mean)^2
+    T m_min;
+    T m_max;
+};
+
 /**
  * @brief Calculate comprehensive signal statistics
  *
@@ -65,31 +179,87 @@ struct SignalStats {
 template<typename T>
 FMUS_EMBED_API SignalStats<T> calculateSignalStats(const std::vector<T>& signal);
 
+/**
+ * @brief Calculate signal statistics, splitting large inputs across a pool
+ *
+ * Each worker accumulates a contiguous share into its own RunningStats;
+ * the shares are merged in order, so the result does not depend on
+ * scheduling. Small inputs are processed on the calling thread.
+ *
+ * @tparam T Data type
+ * @param signal Input samples
+ * @param count Number of samples
+ * @param pool Pool to spread the work over
+ * @return SignalStats<T> Calculated statistics
+ */
+template<typename T>
+FMUS_EMBED_API SignalStats<T> calculateSignalStats(const T* signal, size_t count, WorkerPool& pool);
+
+/**
+ * @brief Algorithm used for correlation
+ */
+enum class CorrelationMethod : uint8_t {
+    Auto = 0,       ///< Choose by estimated cost
+    Direct = 1,     ///< Direct O(n1*n2) sum
+    FFT = 2         ///< Zero-padded real FFT, multiply by conjugate, inverse
+};
+
 /**
  * @brief Calculate cross-correlation between two signals
  *
+ * Computes r[lag] = sum_n signal1[n + lag] * signal2[n] for every lag from
+ * -(n2 - 1) to n1 - 1. Element i of the result holds lag i - (n2 - 1).
+ * Long inputs use the FFT when that is estimated to be cheaper.
+ *
  * @tparam T Data type
  * @param signal1 First signal
  * @param signal2 Second signal
- * @return std::vector<T> Cross-correlation result
+ * @param method Correlation algorithm
+ * @return std::vector<T> Cross-correlation result (n1 + n2 - 1 values)
  */
 template<typename T>
 FMUS_EMBED_API std::vector<T> crossCorrelation(const std::vector<T>& signal1, 
-                                               const std::vector<T>& signal2);
+                                               const std::vector<T>& signal2,
+                                               CorrelationMethod method = CorrelationMethod::Auto);
 
 /**
  * @brief Calculate auto-correlation of a signal
  *
+ * Same layout as crossCorrelation(); zero lag is at index n - 1.
+ *
  * @tparam T Data type
  * @param signal Input signal
- * @return std::vector<T> Auto-correlation result
+ * @param method Correlation algorithm
+ * @return std::vector<T> Auto-correlation result (2n - 1 values)
  */
 template<typename T>
-FMUS_EMBED_API std::vector<T> autoCorrelation(const std::vector<T>& signal);
+FMUS_EMBED_API std::vector<T> autoCorrelation(const std::vector<T>& signal,
+                                              CorrelationMethod method = CorrelationMethod::Auto);
+
+/**
+ * @brief Check whether the FFT path is expected to beat direct correlation
+ *
+ * @param size1 Length of the first signal
+ * @param size2 Length of the second signal
+ * @return bool True if CorrelationMethod::Auto picks the FFT
+ */
+FMUS_EMBED_API bool shouldUseFFTCorrelation(size_t size1, size_t size2);
+
+/**
+ * @brief Get string representation of correlation method
+ *
+ * @param method Correlation method
+ * @return std::string String representation
+ */
+FMUS_EMBED_API std::string correlationMethodToString(CorrelationMethod method);
 
 /**
  * @brief Resample signal to new sample rate
  *
+ * Whole-number rates whose reduced ratio is small use a PolyphaseResampler;
+ * other ratios use a FarrowResampler. The output has size * target / original
+ * samples, aligned with the input.
+ *
  * @tparam T Data type
  * @param signal Input signal
  * @param originalRate Original sample rate
@@ -104,6 +274,9 @@ FMUS_EMBED_API core::Result<std::vector<T>> resample(const std::vector<T>& signa
 /**
  * @brief Decimate signal by integer factor
  *
+ * With filtering, only the kept outputs of a polyphase windowed-sinc
+ * anti-aliasing filter are computed.
+ *
  * @tparam T Data type
  * @param signal Input signal
  * @param factor Decimation factor
@@ -118,6 +291,9 @@ FMUS_EMBED_API std::vector<T> decimate(const std::vector<T>& signal,
 /**
  * @brief Interpolate signal by integer factor
  *
+ * With filtering, a polyphase windowed-sinc filter produces the new samples
+ * directly; without it, zeros are stuffed between the input samples.
+ *
  * @tparam T Data type
  * @param signal Input signal
  * @param factor Interpolation factor
@@ -131,6 +307,9 @@ FMUS_EMBED_API std::vector<T> interpolate(const std::vector<T>& signal,
 
 /**
  * @brief Generate test signals for DSP development
+ *
+ * Waveforms come from an NCO and noise from a NoiseGenerator; use those
+ * directly to stream long signals block by block.
  */
 class FMUS_EMBED_API SignalGenerator {
 public:
@@ -230,8 +409,36 @@ public:
     static std::vector<T> chirp(T startFreq, T endFreq, T amplitude, T sampleRate, T duration);
 };
 
+/**
+ * @brief Counters for one stage of a pipelined RealTimeProcessor
+ */
+struct PipelineStageStats {
+    uint32_t firstFilter;   ///< Index of the stage's first filter
+    uint32_t filterCount;   ///< Number of filters the stage runs
+    uint64_t blocks;        ///< Blocks processed
+    double meanLatency;     ///< Mean processing time per block in microseconds
+    double maxLatency;      ///< Longest processing time per block in microseconds
+    uint32_t queued;        ///< Blocks waiting in the stage's input queue
+    uint32_t queueCapacity; ///< Capacity of the stage's input queue
+    uint64_t stalls;        ///< Times the stage waited on a full output queue
+};
+
+template<typename T>
+struct RealTimePipeline;
+
 /**
  * @brief Real-time signal processor for streaming applications
+ *
+ * By default every filter runs on the calling thread. startPipeline()
+ * splits the chain into stages that each run on their own thread, handing
+ * blocks of getBufferSize() samples between them through bounded lock-free
+ * queues, so different blocks are filtered by different stages at once.
+ * processBuffer() returns the same output in either mode.
+ *
+ * Since the filters may be running on another thread in either mode,
+ * retune them through their publish methods (e.g.
+ * LowPassFilter::publishAlpha()), not their plain setters; the filters
+ * adopt published values at their next block.
  */
 template<typename T>
 class FMUS_EMBED_API RealTimeProcessor {
@@ -253,18 +460,86 @@ public:
      * @brief Add filter to processing chain
      *
      * @param filter Filter to add
-     * @return core::Result<void> Success or error
+     * @return core::Result<void> Success or error (also while pipelined)
      */
     core::Result<void> addFilter(std::shared_ptr<Filter<T>> filter);
 
     /**
-     * @brief Remove all filters
+     * @brief Remove all filters (stops the pipeline)
      */
     void clearFilters();
 
+    /**
+     * @brief Run the filter chain as a multi-threaded pipeline
+     *
+     * The filters are split into contiguous stages of near-equal length,
+     * each served by a worker thread. Restarts the pipeline if it is
+     * already running.
+     *
+     * @param stageCount Number of stages (capped at the number of filters)
+     * @param queueDepth Blocks each stage's input queue can hold
+     * @return core::Result<void> Success or error
+     */
+    core::Result<void> startPipeline(uint32_t stageCount, uint32_t queueDepth = 4);
+
+    /**
+     * @brief Stop the pipeline threads and return to single-threaded mode
+     *
+     * Blocks still in flight are discarded.
+     */
+    void stopPipeline();
+
+    /**
+     * @brief Check whether the pipeline is running
+     *
+     * @return bool True if pipelined
+     */
+    bool isPipelined() const { return m_pipeline != nullptr; }
+
+    /**
+     * @brief Queue a block for the pipeline without waiting
+     *
+     * Returns false when the first stage's queue is full (backpressure),
+     * or when the pipeline is not running; nothing is queued then.
+     *
+     * @param input Input samples
+     * @param count Number of samples (at most getBufferSize())
+     * @return bool True if the block was queued
+     */
+    bool pushBlock(const T* input, size_t count);
+
+    /**
+     * @brief Take the oldest finished block from the pipeline without waiting
+     *
+     * @param output Receives the processed block
+     * @return bool True if a block was available
+     */
+    bool popBlock(std::vector<T>& output);
+
+    /**
+     * @brief Get per-stage counters of the running pipeline
+     *
+     * @return std::vector<PipelineStageStats> One entry per stage (empty if
+     *         not pipelined)
+     */
+    std::vector<PipelineStageStats> getPipelineStats() const;
+
+    /**
+     * @brief Get the block size
+     *
+     * @return uint32_t Samples per block handed between pipeline stages
+     */
+    uint32_t getBufferSize() const { return m_bufferSize; }
+
     /**
      * @brief Process single sample
      *
+     * When pipelined, the sample passes through the stages as a block of
+     * one and the call waits for it, so published parameters apply from
+     * the next sample. Otherwise each filter runs process(T), which keeps
+     * the current parameters until the next processBuffer(). Returns 0 without processing while
+     * pushBlock() blocks are in flight.
+     *
      * @param input Input sample
      * @return T Processed output sample
      */
@@ -273,6 +548,11 @@ public:
     /**
      * @brief Process buffer of samples
      *
+     * When pipelined, the buffer is fed through the stages block by block
+     * and the call returns once every block is out. Returns an empty
+     * vector without processing while pushBlock() blocks are in flight;
+     * popBlock() them first.
+     *
      * @param input Input samples
      * @return std::vector<T> Processed output samples
      */
@@ -280,6 +560,9 @@ public:
 
     /**
      * @brief Reset all filters
+     *
+     * When pipelined, the stage threads are stopped for the reset and
+     * restarted with the same layout; blocks in flight are discarded.
      */
     void reset();
 
@@ -295,6 +578,7 @@ private:
     T m_sampleRate;
     std::vector<std::shared_ptr<Filter<T>>> m_filters;
     uint32_t m_latency;
+    std::unique_ptr<RealTimePipeline<T>> m_pipeline;
 };
 
 /**
@@ -307,6 +591,8 @@ FMUS_EMBED_API std::string getDSPStatus();
 // Explicit template instantiations
 extern template struct FMUS_EMBED_API SignalStats<float>;
 extern template struct FMUS_EMBED_API SignalStats<double>;
+extern template class FMUS_EMBED_API RunningStats<float>;
+extern template class FMUS_EMBED_API RunningStats<double>;
 extern template class FMUS_EMBED_API RealTimeProcessor<float>;
 extern template class FMUS_EMBED_API RealTimeProcessor<double>;
 
@@ -10,9 +10,12 @@
 
 #include "../fmus_config.h"
 #include "../core/result.h"
+#include "simd.h"
 #include <vector>
 #include <complex>
 #include <cstdint>
+#include <functional>
+#include <memory>
 
 namespace fmus {
 namespace dsp {
@@ -30,6 +33,338 @@ enum class WindowType : uint8_t {
     Tukey = 6       ///< Tukey window
 };
 
+/**
+ * @brief Window cache counters
+ */
+struct WindowCacheStats {
+    uint64_t hits;      ///< Lookups served from the cache
+    uint64_t misses;    ///< Lookups that generated new coefficients
+    size_t entries;     ///< Windows currently cached (all data types)
+};
+
+/**
+ * @brief Transform direction for FFT plans
+ */
+enum class FFTDirection : uint8_t {
+    Forward = 0,    ///< Time to frequency domain
+    Inverse = 1     ///< Frequency to time domain (scaled by 1/N)
+};
+
+/**
+ * @brief FFT algorithm used by a plan
+ */
+enum class FFTAlgorithm : uint8_t {
+    Auto = 0,       ///< Pick the cheapest algorithm for the size
+    Radix4 = 1,     ///< Radix-4/2 SIMD kernel (power-of-2 sizes only)
+    MixedRadix = 2, ///< Mixed-radix 2/3/4/5/7/... (sizes whose prime factors are <= 31)
+    Bluestein = 3   ///< Bluestein chirp-z via power-of-2 convolution (any size)
+};
+
+/**
+ * @brief Zero-padding policy for FFT entry points
+ */
+enum class FFTPadding : uint8_t {
+    None = 0,           ///< Transform exactly input.size() points
+    NextPowerOf2 = 1    ///< Zero-pad to the next power of 2
+};
+
+/**
+ * @brief Precomputed FFT plan
+ *
+ * Holds the twiddle table and bit-reversal permutation for one transform
+ * size and direction, so repeated transforms of the same size skip all
+ * trigonometry. Twiddles are evaluated directly per index rather than by
+ * recurrence, which keeps large transforms accurate. A plan is immutable
+ * after construction and may be shared between threads.
+ *
+ * Power-of-2 sizes run radix-4 butterflies (plus one radix-2 stage for
+ * odd powers of 2) over split real/imaginary arrays, using the widest SIMD
+ * level detected at runtime (AVX2, SSE2 or NEON) with a portable scalar
+ * fallback. Other sizes are transformed exactly, either by a mixed-radix
+ * kernel or by Bluestein's chirp-z algorithm, whichever is estimated to be
+ * cheaper.
+ */
+template<typename T>
+class FMUS_EMBED_API FFTPlan {
+public:
+    /**
+     * @brief Construct a plan
+     *
+     * @param size Transform size (at least 1)
+     * @param direction Transform direction
+     * @param simd SIMD level for the butterflies (unsupported levels fall back to detection)
+     * @param algorithm Algorithm to use (unsuitable choices fall back to Auto)
+     */
+    FFTPlan(uint32_t size, FFTDirection direction, SimdLevel simd = detectSimdLevel(),
+            FFTAlgorithm algorithm = FFTAlgorithm::Auto);
+
+    /**
+     * @brief Pick the algorithm Auto would use for a size
+     *
+     * @param size Transform size
+     * @return FFTAlgorithm Selected algorithm
+     */
+    static FFTAlgorithm selectAlgorithm(uint32_t size);
+
+    /**
+     * @brief Get a plan from the process-wide cache, creating it on first use
+     *
+     * @param size Transform size (at least 1)
+     * @param direction Transform direction
+     * @return std::shared_ptr<const FFTPlan<T>> Shared plan, or nullptr if size is zero
+     */
+    static std::shared_ptr<const FFTPlan<T>> get(uint32_t size, FFTDirection direction);
+
+    /**
+     * @brief Drop all cached plans of this data type
+     *
+     * Plans still held by callers stay valid.
+     */
+    static void clearCache();
+
+    /**
+     * @brief Execute the transform in place
+     *
+     * Uses a per-thread scratch buffer that is reused across calls.
+     *
+     * @param data Array of getSize() complex samples
+     */
+    void execute(std::complex<T>* data) const;
+
+    /**
+     * @brief Execute the transform in place with caller-provided scratch
+     *
+     * @param data Array of getSize() complex samples
+     * @param workspace Scratch array of getWorkspaceSize() elements
+     */
+    void execute(std::complex<T>* data, T* workspace) const;
+
+    /**
+     * @brief Execute the transform in place on split-format data
+     *
+     * @param real getSize() real parts
+     * @param imag getSize() imaginary parts
+     */
+    void execute(T* real, T* imag) const;
+
+    /**
+     * @brief Execute the transform in place
+     *
+     * @param data Complex samples (size must equal getSize())
+     */
+    void execute(std::vector<std::complex<T>>& data) const;
+
+    /**
+     * @brief Get transform size
+     *
+     * @return uint32_t Transform size
+     */
+    uint32_t getSize() const { return m_size; }
+
+    /**
+     * @brief Get transform direction
+     *
+     * @return FFTDirection Transform direction
+     */
+    FFTDirection getDirection() const { return m_direction; }
+
+    /**
+     * @brief Get SIMD level used by the butterflies
+     *
+     * @return SimdLevel SIMD level
+     */
+    SimdLevel getSimdLevel() const { return m_simdLevel; }
+
+    /**
+     * @brief Get algorithm used by this plan
+     *
+     * @return FFTAlgorithm Algorithm
+     */
+    FFTAlgorithm getAlgorithm() const { return m_algorithm; }
+
+    /**
+     * @brief Get scratch size needed by execute(data, workspace)
+     *
+     * @return size_t Number of T elements
+     */
+    size_t getWorkspaceSize() const { return m_workspaceSize; }
+
+private:
+    uint32_t m_size;
+    FFTDirection m_direction;
+    SimdLevel m_simdLevel;
+    FFTAlgorithm m_algorithm;
+    size_t m_workspaceSize;
+
+    // Radix4
+    std::vector<T> m_twiddles;              ///< Split twiddles per radix-4 stage (W^2j, W^j, W^3j)
+    std::vector<uint32_t> m_bitReverse;     ///< Bit-reversal permutation
+
+    // MixedRadix
+    std::vector<uint32_t> m_factors;        ///< (radix, remaining length) pairs
+    std::vector<std::complex<T>> m_roots;   ///< exp(-+2*pi*i*t/N) for t < N
+
+    // Bluestein
+    std::vector<std::complex<T>> m_chirp;   ///< exp(-+i*pi*t^2/N) for t < N
+    std::vector<T> m_chirpSpectrum;         ///< Split FFT of the conjugate chirp filter
+    std::shared_ptr<const FFTPlan<T>> m_convolutionPlan;   ///< Forward power-of-2 plan of size M
+    std::shared_ptr<const FFTPlan<T>> m_convolutionInverse; ///< Inverse power-of-2 plan of size M
+
+    void runStages(T* real, T* imag) const;
+    void executeMixedRadix(std::complex<T>* data, T* workspace) const;
+    void executeBluestein(std::complex<T>* data, T* workspace) const;
+};
+
+/**
+ * @brief Precomputed real-input FFT plan
+ *
+ * Transforms N real samples by packing even/odd samples into an N/2-point
+ * complex FFT and untangling the result with a precomputed twiddle table.
+ * Only the N/2+1 non-redundant bins are produced (forward) or consumed
+ * (inverse).
+ */
+template<typename T>
+class FMUS_EMBED_API RealFFTPlan {
+public:
+    /**
+     * @brief Construct a plan
+     *
+     * @param size Number of real samples (even, at least 2)
+     * @param direction Transform direction
+     */
+    RealFFTPlan(uint32_t size, FFTDirection direction);
+
+    /**
+     * @brief Get a plan from the process-wide cache, creating it on first use
+     *
+     * @param size Number of real samples (even, at least 2)
+     * @param direction Transform direction
+     * @return std::shared_ptr<const RealFFTPlan<T>> Shared plan, or nullptr if size is invalid
+     */
+    static std::shared_ptr<const RealFFTPlan<T>> get(uint32_t size, FFTDirection direction);
+
+    /**
+     * @brief Drop all cached real plans of this data type
+     */
+    static void clearCache();
+
+    /**
+     * @brief Execute a forward plan
+     *
+     * @param input getSize() real samples
+     * @param output getSize()/2+1 complex bins
+     */
+    void execute(const T* input, std::complex<T>* output) const;
+
+    /**
+     * @brief Execute an inverse plan
+     *
+     * @param input getSize()/2+1 complex bins
+     * @param output getSize() real samples (scaled by 1/N)
+     */
+    void execute(const std::complex<T>* input, T* output) const;
+
+    /**
+     * @brief Execute a forward plan with caller-provided scratch
+     *
+     * @param input getSize() real samples
+     * @param output getSize()/2+1 complex bins
+     * @param workspace Scratch buffer of at least getWorkspaceSize() elements
+     */
+    void execute(const T* input, std::complex<T>* output, T* workspace) const;
+
+    /**
+     * @brief Execute an inverse plan with caller-provided scratch
+     *
+     * @param input getSize()/2+1 complex bins
+     * @param output getSize() real samples (scaled by 1/N)
+     * @param workspace Scratch buffer of at least getWorkspaceSize() elements
+     */
+    void execute(const std::complex<T>* input, T* output, T* workspace) const;
+
+    /**
+     * @brief Get scratch size required by the workspace overloads of execute()
+     *
+     * @return size_t Number of T elements
+     */
+    size_t getWorkspaceSize() const { return m_halfPlan ? m_halfPlan->getWorkspaceSize() : 0; }
+
+    /**
+     * @brief Get number of real samples
+     *
+     * @return uint32_t Transform size
+     */
+    uint32_t getSize() const { return m_size; }
+
+    /**
+     * @brief Get number of complex bins (N/2+1)
+     *
+     * @return uint32_t Bin count
+     */
+    uint32_t getBinCount() const { return m_size / 2 + 1; }
+
+    /**
+     * @brief Get transform direction
+     *
+     * @return FFTDirection Transform direction
+     */
+    FFTDirection getDirection() const { return m_direction; }
+
+private:
+    uint32_t m_size;
+    FFTDirection m_direction;
+    std::shared_ptr<const FFTPlan<T>> m_halfPlan;   ///< N/2-point complex plan
+    std::vector<std::complex<T>> m_twiddles;         ///< exp(-+2*pi*i*k/N) for k = 0..N/4
+};
+
+/**
+ * @brief Reusable buffers for allocation-free FFT calls
+ *
+ * Holds the plans, window coefficients and scratch memory for one transform
+ * size and window, all allocated at construction. The pointer overloads of
+ * FFT::forward(), FFT::forwardReal() and FFT::inverseReal() then run without
+ * touching the heap. A workspace must not be shared between threads.
+ */
+template<typename T>
+class FMUS_EMBED_API FFTWorkspace {
+public:
+    /**
+     * @brief Construct a workspace
+     *
+     * @param size Transform size (at least 1)
+     * @param window Window applied to the input of forward transforms
+     */
+    explicit FFTWorkspace(uint32_t size, WindowType window = WindowType::None);
+
+    /**
+     * @brief Get transform size
+     *
+     * @return uint32_t Transform size (0 if construction failed)
+     */
+    uint32_t getSize() const { return m_size; }
+
+    /**
+     * @brief Get window applied by forward transforms
+     *
+     * @return WindowType Window type
+     */
+    WindowType getWindow() const { return m_window; }
+
+private:
+    friend class FFT;
+
+    uint32_t m_size;
+    WindowType m_window;
+    std::shared_ptr<const FFTPlan<T>> m_forwardPlan;
+    std::shared_ptr<const FFTPlan<T>> m_inversePlan;
+    std::shared_ptr<const RealFFTPlan<T>> m_realForwardPlan;    ///< Even sizes only
+    std::shared_ptr<const RealFFTPlan<T>> m_realInversePlan;    ///< Even sizes only
+    std::shared_ptr<const std::vector<T>> m_windowCoeffs;       ///< Null for WindowType::None
+    std::vector<T> m_samples;                                   ///< Windowed, zero-padded input
+    std::vector<std::complex<T>> m_buffer;                      ///< Complex staging buffer
+    std::vector<T> m_scratch;                                   ///< Plan scratch memory
+};
+
 /**
  * @brief FFT result structure containing frequency domain data
  */
@@ -41,6 +376,13 @@ struct FFTResult {
     uint32_t size;                      ///< FFT size
     WindowType windowUsed;              ///< Window function used
 
+    /**
+     * @brief Check whether only the non-redundant half spectrum is stored
+     *
+     * @return bool True if data holds size/2+1 bins from a real-input FFT
+     */
+    bool isOneSided() const { return data.size() != size; }
+
     /**
      * @brief Get magnitude spectrum
      *
@@ -85,16 +427,20 @@ public:
     /**
      * @brief Compute forward FFT of real signal
      *
+     * Any input length is transformed exactly unless padding is requested.
+     *
      * @tparam T Data type (float or double)
      * @param input Real input signal
      * @param sampleRate Sample rate in Hz
      * @param window Window function to apply
+     * @param padding Zero-padding policy
      * @return core::Result<FFTResult<T>> FFT result or error
      */
     template<typename T>
     static core::Result<FFTResult<T>> forward(const std::vector<T>& input, 
                                              T sampleRate = 1.0, 
-                                             WindowType window = WindowType::None);
+                                             WindowType window = WindowType::None,
+                                             FFTPadding padding = FFTPadding::None);
 
     /**
      * @brief Compute forward FFT of complex signal
@@ -103,12 +449,46 @@ public:
      * @param input Complex input signal
      * @param sampleRate Sample rate in Hz
      * @param window Window function to apply
+     * @param padding Zero-padding policy
      * @return core::Result<FFTResult<T>> FFT result or error
      */
     template<typename T>
     static core::Result<FFTResult<T>> forward(const std::vector<std::complex<T>>& input,
                                              T sampleRate = 1.0,
-                                             WindowType window = WindowType::None);
+                                             WindowType window = WindowType::None,
+                                             FFTPadding padding = FFTPadding::None);
+
+    /**
+     * @brief Compute forward FFT of real signal, keeping only non-redundant bins
+     *
+     * Uses the half-length packing trick for even sizes, so the work and
+     * the result are half those of forward(). The result holds size/2+1
+     * bins.
+     *
+     * @tparam T Data type (float or double)
+     * @param input Real input signal
+     * @param sampleRate Sample rate in Hz
+     * @param window Window function to apply
+     * @param padding Zero-padding policy
+     * @return core::Result<FFTResult<T>> One-sided FFT result or error
+     */
+    template<typename T>
+    static core::Result<FFTResult<T>> forwardReal(const std::vector<T>& input,
+                                                 T sampleRate = 1.0,
+                                                 WindowType window = WindowType::None,
+                                                 FFTPadding padding = FFTPadding::None);
+
+    /**
+     * @brief Compute inverse FFT of a one-sided spectrum
+     *
+     * @tparam T Data type (float or double)
+     * @param input size/2+1 complex bins, as produced by forwardReal()
+     * @param size Number of output samples (0 means 2 * (bins - 1))
+     * @return core::Result<std::vector<T>> Real time domain samples or error
+     */
+    template<typename T>
+    static core::Result<std::vector<T>> inverseReal(const std::vector<std::complex<T>>& input,
+                                                    uint32_t size = 0);
 
     /**
      * @brief Compute inverse FFT
@@ -120,6 +500,55 @@ public:
     template<typename T>
     static core::Result<std::vector<T>> inverse(const std::vector<std::complex<T>>& input);
 
+    /**
+     * @brief Compute forward FFT of real signal into a caller buffer
+     *
+     * Performs no heap allocation. Input shorter than the workspace size is
+     * zero-padded; the workspace window is applied.
+     *
+     * @tparam T Data type (float or double)
+     * @param input Real input samples
+     * @param inputSize Number of input samples (at most workspace.getSize())
+     * @param output workspace.getSize() complex bins
+     * @param workspace Workspace created for the transform size
+     * @return core::Result<void> Success or error
+     */
+    template<typename T>
+    static core::Result<void> forward(const T* input, uint32_t inputSize,
+                                      std::complex<T>* output, FFTWorkspace<T>& workspace);
+
+    /**
+     * @brief Compute one-sided FFT of real signal into a caller buffer
+     *
+     * Performs no heap allocation. Input shorter than the workspace size is
+     * zero-padded; the workspace window is applied.
+     *
+     * @tparam T Data type (float or double)
+     * @param input Real input samples
+     * @param inputSize Number of input samples (at most workspace.getSize())
+     * @param output workspace.getSize()/2+1 complex bins
+     * @param workspace Workspace created for the transform size
+     * @return core::Result<void> Success or error
+     */
+    template<typename T>
+    static core::Result<void> forwardReal(const T* input, uint32_t inputSize,
+                                          std::complex<T>* output, FFTWorkspace<T>& workspace);
+
+    /**
+     * @brief Compute inverse FFT of a one-sided spectrum into a caller buffer
+     *
+     * Performs no heap allocation.
+     *
+     * @tparam T Data type (float or double)
+     * @param input workspace.getSize()/2+1 complex bins
+     * @param output workspace.getSize() real samples
+     * @param workspace Workspace created for the transform size
+     * @return core::Result<void> Success or error
+     */
+    template<typename T>
+    static core::Result<void> inverseReal(const std::complex<T>* input, T* output,
+                                          FFTWorkspace<T>& workspace);
+
     /**
      * @brief Compute inverse FFT returning complex result
      *
@@ -145,7 +574,39 @@ public:
                                      T parameter = 0);
 
     /**
-     * @brief Generate window function coefficients
+     * @brief Get window coefficients from the process-wide cache
+     *
+     * Coefficients are generated on first use for each (size, window,
+     * parameter) and shared afterwards. The parameter is ignored for window
+     * types that do not take one. Thread-safe.
+     *
+     * @tparam T Data type
+     * @param size Window size
+     * @param window Window type
+     * @param parameter Window parameter (for Kaiser, Gaussian, Tukey; 0 selects the default)
+     * @return std::shared_ptr<const std::vector<T>> Immutable coefficients
+     */
+    template<typename T>
+    static std::shared_ptr<const std::vector<T>> getWindow(uint32_t size,
+                                                           WindowType window,
+                                                           T parameter = 0);
+
+    /**
+     * @brief Get window cache hit/miss counters
+     *
+     * @return WindowCacheStats Current counters
+     */
+    static WindowCacheStats getWindowCacheStats();
+
+    /**
+     * @brief Drop all cached windows and reset the counters
+     *
+     * Coefficient arrays still referenced by callers stay valid.
+     */
+    static void clearWindowCache();
+
+    /**
+     * @brief Generate window function coefficients (uncached)
      *
      * @tparam T Data type
      * @param size Window size
@@ -159,7 +620,7 @@ public:
                                         T parameter = 0);
 
     /**
-     * @brief Check if size is valid for FFT (power of 2)
+     * @brief Check if size is a power of 2 (the fastest FFT sizes)
      *
      * @param size Size to check
      * @return bool True if valid
@@ -187,16 +648,10 @@ public:
 
 private:
     /**
-     * @brief Internal radix-2 FFT implementation
+     * @brief Internal in-place transform (executes a cached plan)
      */
     template<typename T>
-    static void radix2FFT(std::vector<std::complex<T>>& data, bool inverse);
-
-    /**
-     * @brief Bit-reverse permutation
-     */
-    template<typename T>
-    static void bitReverse(std::vector<std::complex<T>>& data);
+    static void transform(std::vector<std::complex<T>>& data, bool inverse);
 };
 
 /**
@@ -221,6 +676,8 @@ public:
     /**
      * @brief Find multiple peaks in spectrum
      *
+     * Strongest local maxima among bins 0 to N/2 (see SpectralFeatures).
+     *
      * @tparam T Data type
      * @param fftResult FFT result
      * @param numPeaks Number of peaks to find
@@ -263,6 +720,8 @@ public:
     /**
      * @brief Calculate spectral centroid (brightness measure)
      *
+     * Magnitude-weighted mean frequency of bins 0 to N/2.
+     *
      * @tparam T Data type
      * @param fftResult FFT result
      * @return T Spectral centroid frequency (Hz)
@@ -273,6 +732,9 @@ public:
     /**
      * @brief Calculate spectral rolloff
      *
+     * Lowest frequency below which the given fraction of the power in bins
+     * 0 to N/2 lies.
+     *
      * @tparam T Data type
      * @param fftResult FFT result
      * @param rolloffPercent Rolloff percentage (e.g., 0.85 for 85%)
@@ -284,14 +746,28 @@ public:
 
 /**
  * @brief Real-time FFT processor for streaming data
+ *
+ * Short-time FFT over a sliding window: once fftSize samples have arrived,
+ * one one-sided spectrum (fftSize/2+1 bins) is emitted every hop. Samples
+ * are written twice into a mirrored ring buffer so the latest frame is
+ * always contiguous and nothing is shifted. Plans, window and scratch are
+ * set up at construction; the callback overload of processSamples() makes
+ * no allocations.
  */
 template<typename T>
 class FMUS_EMBED_API RealTimeFFT {
 public:
+    /**
+     * @brief Callback receiving each spectrum frame
+     *
+     * The bins are only valid for the duration of the call.
+     */
+    using FrameCallback = std::function<void(const std::complex<T>* bins, uint32_t binCount)>;
+
     /**
      * @brief Construct real-time FFT processor
      *
-     * @param fftSize FFT size (must be power of 2)
+     * @param fftSize FFT size (at least 2; powers of 2 are fastest)
      * @param sampleRate Sample rate in Hz
      * @param overlapFactor Overlap factor (0.0 to 0.75)
      * @param window Window function
@@ -311,6 +787,16 @@ public:
      */
     std::vector<FFTResult<T>> processSamples(const std::vector<T>& samples);
 
+    /**
+     * @brief Process a chunk of samples, reporting each frame to a callback
+     *
+     * @param samples Input samples
+     * @param count Number of samples (any size)
+     * @param onFrame Called once per completed frame
+     * @return uint32_t Number of frames emitted
+     */
+    uint32_t processSamples(const T* samples, size_t count, const FrameCallback& onFrame);
+
     /**
      * @brief Process single sample
      *
@@ -338,16 +824,28 @@ public:
      */
     T getSampleRate() const;
 
+    /**
+     * @brief Get number of new samples between frames
+     *
+     * @return uint32_t Hop size
+     */
+    uint32_t getHopSize() const { return m_hopSize; }
+
 private:
     uint32_t m_fftSize;
     T m_sampleRate;
     T m_overlapFactor;
     WindowType m_window;
-    std::vector<T> m_buffer;
-    std::vector<T> m_windowCoeffs;
-    uint32_t m_bufferIndex;
+    std::vector<T> m_buffer;                    ///< Mirrored ring buffer (2 * fftSize)
+    std::vector<std::complex<T>> m_spectrum;    ///< Bins of the latest frame
+    FFTWorkspace<T> m_workspace;                ///< Plans, window and scratch
+    uint32_t m_bufferIndex;                     ///< Next write position (oldest sample)
     uint32_t m_hopSize;
+    uint32_t m_samplesUntilFrame;
     bool m_bufferReady;
+
+    void writeSamples(const T* samples, uint32_t count);
+    FFTResult<T> makeResult() const;
 };
 
 /**
@@ -359,6 +857,12 @@ private:
 FMUS_EMBED_API std::string windowTypeToString(WindowType window);
 
 // Explicit template instantiations
+extern template class FMUS_EMBED_API FFTPlan<float>;
+extern template class FMUS_EMBED_API FFTPlan<double>;
+extern template class FMUS_EMBED_API RealFFTPlan<float>;
+extern template class FMUS_EMBED_API RealFFTPlan<double>;
+extern template class FMUS_EMBED_API FFTWorkspace<float>;
+extern template class FMUS_EMBED_API FFTWorkspace<double>;
 extern template struct FMUS_EMBED_API FFTResult<float>;
 extern template struct FMUS_EMBED_API FFTResult<double>;
 extern template class FMUS_EMBED_API RealTimeFFT<float>;
@@ -10,6 +10,7 @@
 
 #include "../fmus_config.h"
 #include "../core/result.h"
+#include "triple_buffer.h"
 #include <vector>
 #include <cstdint>
 #include <memory>
@@ -41,6 +42,9 @@ enum class FilterImplementation : uint8_t {
     Elliptic = 5    ///< Elliptic (Cauer)
 };
 
+template<typename T>
+class SOSFilter;
+
 /**
  * @brief Base filter interface
  */
@@ -65,6 +69,32 @@ public:
      */
     virtual std::vector<T> process(const std::vector<T>& input) = 0;
 
+    /**
+     * @brief Process a block of samples without allocating
+     *
+     * The default runs process(T) sample by sample; filters override it
+     * with block algorithms whose output matches up to rounding.
+     *
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param count Number of samples
+     */
+    virtual void processBlock(const T* input, T* output, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            output[i] = process(input[i]);
+        }
+    }
+
+    /**
+     * @brief Process a block of samples in place
+     *
+     * @param data Samples, replaced by the filtered output
+     * @param count Number of samples
+     */
+    void processBlock(T* data, size_t count) {
+        processBlock(data, data, count);
+    }
+
     /**
      * @brief Reset filter state
      */
@@ -108,7 +138,10 @@ public:
     /**
      * @brief Construct a Butterworth low-pass filter
      *
-     * @param cutoffFreq Cutoff frequency (normalized, 0-1)
+     * Runs an SOSFilter designed for the cutoff; an invalid cutoff or a zero
+     * order falls back to the RC filter.
+     *
+     * @param cutoffFreq Cutoff frequency (normalized to Nyquist, 0-1)
      * @param order Filter order
      */
     LowPassFilter(T cutoffFreq, uint32_t order);
@@ -117,6 +150,8 @@ public:
 
     T process(T input) override;
     std::vector<T> process(const std::vector<T>& input) override;
+    using Filter<T>::processBlock;
+    void processBlock(const T* input, T* output, size_t count) override;
     void reset() override;
     FilterType getType() const override { return FilterType::LowPass; }
     FilterImplementation getImplementation() const override;
@@ -125,23 +160,55 @@ public:
     /**
      * @brief Set filter coefficient
      *
+     * Turns a Butterworth filter back into the first-order RC filter.
+     * Not safe while another thread runs the filter; use publishAlpha()
+     * then.
+     *
      * @param alpha New coefficient
      */
     void setAlpha(T alpha);
 
+    /**
+     * @brief Set the coefficient from a control thread
+     *
+     * Lock-free and safe while another thread runs the filter; the
+     * processing thread switches at the start of its next processBlock()
+     * or process(vector) call, like setAlpha(). process(T) keeps the
+     * current coefficient. A Butterworth design it drops is freed on the
+     * next publishAlpha() call, off the processing thread. Call from one
+     * control thread at a time.
+     *
+     * @param alpha New coefficient
+     */
+    void publishAlpha(T alpha);
+
     /**
      * @brief Get current coefficient
      *
+     * The coefficient in use, which changes at the processing thread's
+     * block boundaries; read it on that thread, or while no thread runs
+     * the filter.
+     *
      * @return T Current coefficient
      */
     T getAlpha() const;
 
 private:
+    // Coefficient published by publishAlpha(), and a design the processing
+    // thread dropped, waiting for the control thread to free it
+    struct Tuning {
+        T alpha = 0;
+        std::unique_ptr<SOSFilter<T>> retired;
+    };
+
+    void applyTuning();
+
     T m_alpha;
     T m_previousOutput;
     uint32_t m_order;
     FilterImplementation m_implementation;
-    void* m_impl; ///< Implementation details
+    std::unique_ptr<SOSFilter<T>> m_design; ///< Butterworth sections (cutoff/order constructor)
+    TripleBuffer<Tuning> m_tuning;
 };
 
 /**
@@ -160,7 +227,10 @@ public:
     /**
      * @brief Construct a Butterworth high-pass filter
      *
-     * @param cutoffFreq Cutoff frequency (normalized, 0-1)
+     * Runs an SOSFilter designed for the cutoff; an invalid cutoff or a zero
+     * order falls back to the RC filter.
+     *
+     * @param cutoffFreq Cutoff frequency (normalized to Nyquist, 0-1)
      * @param order Filter order
      */
     HighPassFilter(T cutoffFreq, uint32_t order);
@@ -169,18 +239,41 @@ public:
 
     T process(T input) override;
     std::vector<T> process(const std::vector<T>& input) override;
+    using Filter<T>::processBlock;
+    void processBlock(const T* input, T* output, size_t count) override;
     void reset() override;
     FilterType getType() const override { return FilterType::HighPass; }
     FilterImplementation getImplementation() const override;
     uint32_t getOrder() const override;
 
+    /**
+     * @brief Set the coefficient from a control thread
+     *
+     * Same hand-over as LowPassFilter::publishAlpha(): a Butterworth
+     * filter becomes the first-order RC filter at the start of the next
+     * processBlock() or process(vector) call. Call from one control thread
+     * at a time.
+     *
+     * @param alpha New coefficient
+     */
+    void publishAlpha(T alpha);
+
 private:
+    // Same as LowPassFilter::Tuning
+    struct Tuning {
+        T alpha = 0;
+        std::unique_ptr<SOSFilter<T>> retired;
+    };
+
+    void applyTuning();
+
     T m_alpha;
     T m_previousInput;
     T m_previousOutput;
     uint32_t m_order;
     FilterImplementation m_implementation;
-    void* m_impl;
+    std::unique_ptr<SOSFilter<T>> m_design; ///< Butterworth sections (cutoff/order constructor)
+    TripleBuffer<Tuning> m_tuning;
 };
 
 /**
@@ -192,8 +285,10 @@ public:
     /**
      * @brief Construct a band-pass filter
      *
-     * @param lowCutoff Low cutoff frequency (normalized, 0-1)
-     * @param highCutoff High cutoff frequency (normalized, 0-1)
+     * High-pass and low-pass Butterworth stages of order / 2 each.
+     *
+     * @param lowCutoff Low cutoff frequency (normalized to Nyquist, 0-1)
+     * @param highCutoff High cutoff frequency (normalized to Nyquist, 0-1)
      * @param order Filter order
      */
     BandPassFilter(T lowCutoff, T highCutoff, uint32_t order = 2);
@@ -202,17 +297,43 @@ public:
 
     T process(T input) override;
     std::vector<T> process(const std::vector<T>& input) override;
+    using Filter<T>::processBlock;
+    void processBlock(const T* input, T* output, size_t count) override;
     void reset() override;
     FilterType getType() const override { return FilterType::BandPass; }
     FilterImplementation getImplementation() const override;
     uint32_t getOrder() const override;
 
+    /**
+     * @brief Set the band edges from a control thread
+     *
+     * Both stages are designed here and swapped in lock-free, with cleared
+     * state, at the start of the next processBlock() or process(vector)
+     * call; the stages they replace are freed by a later publishCutoffs()
+     * call, off the processing thread. Call from one control thread at a
+     * time.
+     *
+     * @param lowCutoff Low cutoff frequency (normalized to Nyquist, 0-1)
+     * @param highCutoff High cutoff frequency (normalized to Nyquist, 0-1)
+     */
+    void publishCutoffs(T lowCutoff, T highCutoff);
+
 private:
+    // Stages designed by publishCutoffs(); after the swap they hold the
+    // previous stages until the control thread frees them
+    struct Tuning {
+        std::unique_ptr<LowPassFilter<T>> lowPass;
+        std::unique_ptr<HighPassFilter<T>> highPass;
+    };
+
+    void applyTuning();
+
     T m_lowCutoff;
     T m_highCutoff;
     uint32_t m_order;
     std::unique_ptr<LowPassFilter<T>> m_lowPass;
     std::unique_ptr<HighPassFilter<T>> m_highPass;
+    TripleBuffer<Tuning> m_tuning;
 };
 
 /**
@@ -232,6 +353,8 @@ public:
 
     T process(T input) override;
     std::vector<T> process(const std::vector<T>& input) override;
+    using Filter<T>::processBlock;
+    void processBlock(const T* input, T* output, size_t count) override;
     void reset() override;
     FilterType getType() const override { return FilterType::LowPass; }
     FilterImplementation getImplementation() const override { return FilterImplementation::FIR; }
@@ -240,27 +363,64 @@ public:
     /**
      * @brief Set window size
      *
+     * Clears the window. Not safe while another thread runs the filter;
+     * use publishWindowSize() then.
+     *
      * @param windowSize New window size
      */
     void setWindowSize(uint32_t windowSize);
 
+    /**
+     * @brief Set the window size from a control thread
+     *
+     * The new, cleared window is allocated here and swapped in lock-free
+     * at the start of the processing thread's next processBlock() or
+     * process(vector) call; the old window is freed or reused by a later
+     * publishWindowSize() call, so the processing thread never allocates.
+     * Call from one control thread at a time.
+     *
+     * @param windowSize New window size
+     */
+    void publishWindowSize(uint32_t windowSize);
+
     /**
      * @brief Get current window size
      *
+     * Changes at the processing thread's block boundaries; read it on
+     * that thread, or while no thread runs the filter.
+     *
      * @return uint32_t Current window size
      */
     uint32_t getWindowSize() const;
 
 private:
+    // Window prepared by publishWindowSize(); after the swap it holds the
+    // previous window until the control thread reuses it
+    struct Tuning {
+        uint32_t windowSize = 0;
+        std::vector<T> buffer;
+    };
+
+    void applyTuning();
+    T advance(T input);
+
     uint32_t m_windowSize;
     std::vector<T> m_buffer;
     uint32_t m_index;
     T m_sum;
     bool m_bufferFull;
+    TripleBuffer<Tuning> m_tuning;
 };
 
 /**
  * @brief Median filter
+ *
+ * The window is kept in two heaps that meet at the median: a max-heap of
+ * the lower half and a min-heap of the upper half, both holding slots of
+ * the circular sample buffer. Replacing the oldest sample re-sifts one
+ * entry, so each sample costs O(log w) and no allocation. Until the window
+ * has filled, the median is taken over the samples seen so far; even
+ * counts average the two middle values.
  */
 template<typename T>
 class FMUS_EMBED_API MedianFilter : public Filter<T> {
@@ -276,18 +436,57 @@ public:
 
     T process(T input) override;
     std::vector<T> process(const std::vector<T>& input) override;
+    using Filter<T>::processBlock;
+    void processBlock(const T* input, T* output, size_t count) override;
     void reset() override;
     FilterType getType() const override { return FilterType::LowPass; }
     FilterImplementation getImplementation() const override { return FilterImplementation::FIR; }
     uint32_t getOrder() const override;
 
+    /**
+     * @brief Set the window size from a control thread
+     *
+     * The window and both heaps are allocated here and swapped in
+     * lock-free, cleared, at the start of the next processBlock() or
+     * process(vector) call; the old ones are freed or reused by a later
+     * publishWindowSize() call. Call from one control thread at a time.
+     *
+     * @param windowSize New window size (should be odd)
+     */
+    void publishWindowSize(uint32_t windowSize);
+
 private:
+    // Storage prepared by publishWindowSize(); after the swap it holds the
+    // previous storage until the control thread reuses it
+    struct Tuning {
+        uint32_t windowSize = 0;
+        std::vector<T> buffer;
+        std::vector<int32_t> heap;
+        std::vector<int32_t> heapIndex;
+    };
+
+    void applyTuning();
+
     uint32_t m_windowSize;
     std::vector<T> m_buffer;
     uint32_t m_index;
-    bool m_bufferFull;
-
-    T calculateMedian();
+    uint32_t m_count;                   ///< Samples in the window
+    std::vector<int32_t> m_heap;        ///< Buffer slots by heap position, median at m_heapCenter
+    std::vector<int32_t> m_heapIndex;   ///< Heap position of each buffer slot (< 0: max-heap, > 0: min-heap)
+    int32_t m_heapCenter;
+    TripleBuffer<Tuning> m_tuning;
+
+    int32_t& heapAt(int32_t position) { return m_heap[m_heapCenter + position]; }
+    int32_t minHeapCount() const { return (static_cast<int32_t>(m_count) - 1) / 2; }
+    int32_t maxHeapCount() const { return static_cast<int32_t>(m_count) / 2; }
+    bool heapLess(int32_t i, int32_t j);
+    bool exchangeIfLess(int32_t i, int32_t j);
+    void minSortDown(int32_t child);
+    void maxSortDown(int32_t child);
+    bool minSortUp(int32_t position);
+    bool maxSortUp(int32_t position);
+    void insert(T input);
+    T median();
 };
 
 /**
@@ -340,21 +539,60 @@ public:
      */
     T getCovariance() const;
 
+    /**
+     * @brief Set the noise covariances from a control thread
+     *
+     * Lock-free and safe while another thread runs update(); the new
+     * values take effect at its next call. Call from one control thread
+     * at a time.
+     *
+     * @param processNoise Process noise covariance (Q)
+     * @param measurementNoise Measurement noise covariance (R)
+     */
+    void publishNoise(T processNoise, T measurementNoise);
+
+    /**
+     * @brief Get the process noise covariance in use
+     *
+     * Changes when update() adopts a published value; read it on the
+     * thread that runs update(), or while no thread does.
+     *
+     * @return T Process noise covariance (Q)
+     */
+    T getProcessNoise() const { return m_processNoise; }
+
+    /**
+     * @brief Get the measurement noise covariance in use
+     *
+     * Same threading rule as getProcessNoise().
+     *
+     * @return T Measurement noise covariance (R)
+     */
+    T getMeasurementNoise() const { return m_measurementNoise; }
+
 private:
+    struct Tuning {
+        T processNoise = 0;
+        T measurementNoise = 0;
+    };
+
     T m_processNoise;      ///< Process noise covariance (Q)
     T m_measurementNoise;  ///< Measurement noise covariance (R)
     T m_estimate;          ///< Current state estimate
     T m_covariance;        ///< Current error covariance
     T m_initialEstimate;   ///< Initial estimate
     T m_initialCovariance; ///< Initial covariance
+    TripleBuffer<Tuning> m_tuning;
 };
 
 /**
  * @brief Create a filter of specified type
  *
+ * Low-pass and high-pass types return a Butterworth SOSFilter.
+ *
  * @tparam T Data type (float, double)
  * @param type Filter type
- * @param cutoffFreq Cutoff frequency (normalized, 0-1)
+ * @param cutoffFreq Cutoff frequency (normalized to Nyquist, 0-1)
  * @param order Filter order
  * @return std::unique_ptr<Filter<T>> Filter instance
  */
@@ -364,9 +602,12 @@ FMUS_EMBED_API std::unique_ptr<Filter<T>> createFilter(FilterType type, T cutoff
 /**
  * @brief Create a band-pass filter
  *
+ * Returns a Butterworth SOSFilter; the band-pass transform doubles the
+ * prototype order, so odd orders are rounded up.
+ *
  * @tparam T Data type
- * @param lowCutoff Low cutoff frequency
- * @param highCutoff High cutoff frequency
+ * @param lowCutoff Low cutoff frequency (normalized to Nyquist, 0-1)
+ * @param highCutoff High cutoff frequency (normalized to Nyquist, 0-1)
  * @param order Filter order
  * @return std::unique_ptr<Filter<T>> Filter instance
  */
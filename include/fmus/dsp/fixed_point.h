@@ -0,0 +1,358 @@
+#pragma once
+
+/**
+ * @file fixed_point.h
+ * @brief Q15/Q31 fixed-point FFT and filters
+ *
+ * Fixed-point counterparts of the float paths for targets with slow or no
+ * floating-point hardware, and for SIMD hosts where 16-bit samples fit
+ * twice as many lanes per register. Samples are signed fractions in
+ * [-1, 1): Q15 in int16_t, Q31 in int32_t. All arithmetic rounds to
+ * nearest and saturates instead of wrapping.
+ */
+
+#include "../fmus_config.h"
+#include "../core/result.h"
+#include "fft.h"
+#include "simd.h"
+#include <vector>
+#include <cstdint>
+#include <cmath>
+
+namespace fmus {
+namespace dsp {
+
+using q15_t = int16_t;      ///< Q1.15 fraction
+using q31_t = int32_t;      ///< Q1.31 fraction
+
+/**
+ * @brief Properties of a fixed-point sample type
+ */
+template<typename Q>
+struct FixedPointTraits;
+
+template<>
+struct FixedPointTraits<int16_t> {
+    using Accumulator = int32_t;                ///< Holds a product or a sum of two products
+    static constexpr uint32_t FRACTION_BITS = 15;
+    static constexpr int16_t MIN_VALUE = INT16_MIN;
+    static constexpr int16_t MAX_VALUE = INT16_MAX;
+};
+
+template<>
+struct FixedPointTraits<int32_t> {
+    using Accumulator = int64_t;                ///< Holds a product or a sum of two products
+    static constexpr uint32_t FRACTION_BITS = 31;
+    static constexpr int32_t MIN_VALUE = INT32_MIN;
+    static constexpr int32_t MAX_VALUE = INT32_MAX;
+};
+
+/**
+ * @brief Clamp a wider integer to the range of a fixed-point type
+ *
+ * @param value Value in units of the fixed-point LSB
+ * @return Q Saturated value
+ */
+template<typename Q, typename A>
+inline Q saturate(A value) {
+    if (value > static_cast<A>(FixedPointTraits<Q>::MAX_VALUE)) {
+        return FixedPointTraits<Q>::MAX_VALUE;
+    }
+    if (value < static_cast<A>(FixedPointTraits<Q>::MIN_VALUE)) {
+        return FixedPointTraits<Q>::MIN_VALUE;
+    }
+    return static_cast<Q>(value);
+}
+
+/**
+ * @brief Convert a real value to fixed point (rounded, saturated)
+ *
+ * @param value Value, nominally in [-1, 1)
+ * @return Q Fixed-point value (0 for NaN)
+ */
+template<typename Q, typename T>
+inline Q toFixed(T value) {
+    double scaled = std::round(std::ldexp(static_cast<double>(value), FixedPointTraits<Q>::FRACTION_BITS));
+    if (scaled != scaled) {
+        return 0;
+    }
+    if (scaled >= static_cast<double>(FixedPointTraits<Q>::MAX_VALUE)) {
+        return FixedPointTraits<Q>::MAX_VALUE;
+    }
+    if (scaled <= static_cast<double>(FixedPointTraits<Q>::MIN_VALUE)) {
+        return FixedPointTraits<Q>::MIN_VALUE;
+    }
+    return static_cast<Q>(scaled);
+}
+
+/**
+ * @brief Convert a fixed-point value to a real value
+ *
+ * @param value Fixed-point value
+ * @param exponent Block exponent; the result is value * 2^exponent
+ * @return T Real value
+ */
+template<typename T, typename Q>
+inline T fromFixed(Q value, int32_t exponent = 0) {
+    return static_cast<T>(std::ldexp(static_cast<double>(value),
+                                     exponent - static_cast<int32_t>(FixedPointTraits<Q>::FRACTION_BITS)));
+}
+
+/**
+ * @brief Fractional multiply (rounded, saturated)
+ *
+ * @param a First factor
+ * @param b Second factor
+ * @return Q a * b (only -1 * -1 saturates)
+ */
+template<typename Q>
+inline Q fixedMultiply(Q a, Q b) {
+    using Acc = typename FixedPointTraits<Q>::Accumulator;
+    const uint32_t bits = FixedPointTraits<Q>::FRACTION_BITS;
+    Acc product = static_cast<Acc>(a) * static_cast<Acc>(b);
+    return saturate<Q>((product + (static_cast<Acc>(1) << (bits - 1))) >> bits);
+}
+
+/**
+ * @brief Saturating addition
+ *
+ * @param a First term
+ * @param b Second term
+ * @return Q a + b clamped to the representable range
+ */
+template<typename Q>
+inline Q saturatingAdd(Q a, Q b) {
+    using Acc = typename FixedPointTraits<Q>::Accumulator;
+    return saturate<Q>(static_cast<Acc>(a) + static_cast<Acc>(b));
+}
+
+/**
+ * @brief Convert a block of real values to fixed point
+ *
+ * @param input Real values, nominally in [-1, 1)
+ * @param output Fixed-point values (count entries)
+ * @param count Number of values
+ */
+template<typename Q, typename T>
+FMUS_EMBED_API void toFixed(const T* input, Q* output, size_t count);
+
+/**
+ * @brief Convert a block of fixed-point values to real values
+ *
+ * @param input Fixed-point values
+ * @param output Real values (count entries)
+ * @param count Number of values
+ * @param exponent Block exponent applied to every value
+ */
+template<typename T, typename Q>
+FMUS_EMBED_API void fromFixed(const Q* input, T* output, size_t count, int32_t exponent = 0);
+
+/**
+ * @brief Block-floating-point FFT plan for Q15/Q31 data
+ *
+ * Radix-2 decimation-in-time over split real/imaginary arrays
+ * (power-of-2 sizes). Before every stage the plan checks the largest
+ * magnitude produced by the previous one and halves the whole block, once
+ * or twice, only if the stage could otherwise overflow. The shifts are
+ * returned as a block exponent so no headroom is wasted on small inputs.
+ * Q15 stages run on SSE2/AVX2 when available; Q31 uses portable code.
+ */
+template<typename Q>
+class FMUS_EMBED_API FixedFFTPlan {
+public:
+    /**
+     * @brief Build a plan
+     *
+     * @param size Transform size (power of 2, at least 2)
+     * @param direction Transform direction
+     * @param simd SIMD level (falls back to the detected level if unsupported)
+     */
+    FixedFFTPlan(uint32_t size, FFTDirection direction, SimdLevel simd = detectSimdLevel());
+
+    /**
+     * @brief Transform in place
+     *
+     * The true transform is output * 2^exponent (in Q units). The inverse
+     * includes the 1/N factor in the exponent.
+     *
+     * @param real Real parts (size entries)
+     * @param imag Imaginary parts (size entries)
+     * @return core::Result<int32_t> Block exponent or error
+     */
+    core::Result<int32_t> execute(Q* real, Q* imag) const;
+
+    /**
+     * @brief Check whether the plan was built for a valid size
+     *
+     * @return bool True if execute() can run
+     */
+    bool isValid() const { return !m_bitReverse.empty(); }
+
+    /**
+     * @brief Get transform size
+     *
+     * @return uint32_t Number of points
+     */
+    uint32_t getSize() const { return m_size; }
+
+    /**
+     * @brief Get transform direction
+     *
+     * @return FFTDirection Direction
+     */
+    FFTDirection getDirection() const { return m_direction; }
+
+    /**
+     * @brief Get SIMD level used by the stages
+     *
+     * @return SimdLevel Level
+     */
+    SimdLevel getSimdLevel() const { return m_simdLevel; }
+
+private:
+    uint32_t m_size;
+    FFTDirection m_direction;
+    SimdLevel m_simdLevel;
+    uint32_t m_log2Size;
+    std::vector<uint32_t> m_bitReverse;
+    std::vector<Q> m_twiddleRe;             ///< W^j for j < h, stage after stage (h = 1, 2, 4, ...)
+    std::vector<Q> m_twiddleIm;
+};
+
+/**
+ * @brief Q15 FIR filter
+ *
+ * Products are accumulated exactly in 64 bits and rounded once per output
+ * sample, so long filters do not build up rounding noise.
+ */
+class FMUS_EMBED_API FIRFilterQ15 {
+public:
+    /**
+     * @brief Construct a filter
+     *
+     * @param coefficients Taps in [-1, 1); larger values saturate
+     * @param simd SIMD level (falls back to the detected level if unsupported)
+     */
+    explicit FIRFilterQ15(const std::vector<float>& coefficients, SimdLevel simd = detectSimdLevel());
+
+    /**
+     * @brief Process a single sample
+     *
+     * @param input Input sample
+     * @return int16_t Filtered sample
+     */
+    int16_t process(int16_t input);
+
+    /**
+     * @brief Process a block of samples
+     *
+     * @param input Input samples
+     * @param output Filtered samples (may alias input)
+     * @param count Number of samples
+     */
+    void process(const int16_t* input, int16_t* output, size_t count);
+
+    /**
+     * @brief Process a vector of samples
+     *
+     * @param input Input samples
+     * @return std::vector<int16_t> Filtered samples
+     */
+    std::vector<int16_t> process(const std::vector<int16_t>& input);
+
+    /**
+     * @brief Clear the delay line
+     */
+    void reset();
+
+    /**
+     * @brief Get number of taps
+     *
+     * @return uint32_t Tap count
+     */
+    uint32_t getTapCount() const { return static_cast<uint32_t>(m_coefficients.size()); }
+
+    /**
+     * @brief Get the quantized taps
+     *
+     * @return const std::vector<int16_t>& Q15 coefficients
+     */
+    const std::vector<int16_t>& getCoefficients() const { return m_coefficients; }
+
+private:
+    std::vector<int16_t> m_coefficients;
+    std::vector<int16_t> m_history;         ///< Delay line stored twice so each window is contiguous
+    uint32_t m_position;
+    SimdLevel m_simdLevel;
+};
+
+/**
+ * @brief Q15 biquad cascade (direct form I)
+ *
+ * Each section scales its coefficients by a power of 2 so that feedback
+ * terms up to |a1| < 2 fit in Q15, and shifts the 64-bit accumulator back
+ * once per output sample.
+ */
+class FMUS_EMBED_API BiquadFilterQ15 {
+public:
+    /**
+     * @brief Construct a cascade
+     *
+     * @param coefficients Five values per section: b0, b1, b2, a1, a2
+     *                     (normalized so that a0 = 1)
+     */
+    explicit BiquadFilterQ15(const std::vector<float>& coefficients);
+
+    /**
+     * @brief Process a single sample
+     *
+     * @param input Input sample
+     * @return int16_t Filtered sample
+     */
+    int16_t process(int16_t input);
+
+    /**
+     * @brief Process a block of samples
+     *
+     * @param input Input samples
+     * @param output Filtered samples (may alias input)
+     * @param count Number of samples
+     */
+    void process(const int16_t* input, int16_t* output, size_t count);
+
+    /**
+     * @brief Process a vector of samples
+     *
+     * @param input Input samples
+     * @return std::vector<int16_t> Filtered samples
+     */
+    std::vector<int16_t> process(const std::vector<int16_t>& input);
+
+    /**
+     * @brief Clear all section states
+     */
+    void reset();
+
+    /**
+     * @brief Get number of second-order sections
+     *
+     * @return uint32_t Section count
+     */
+    uint32_t getSectionCount() const { return static_cast<uint32_t>(m_sections.size()); }
+
+private:
+    struct Section {
+        int16_t b0, b1, b2, a1, a2;         ///< Coefficients scaled by 2^-postShift
+        uint32_t postShift;
+        int16_t x1, x2, y1, y2;
+    };
+
+    std::vector<Section> m_sections;
+};
+
+// Explicit template instantiations
+extern template class FMUS_EMBED_API FixedFFTPlan<int16_t>;
+extern template class FMUS_EMBED_API FixedFFTPlan<int32_t>;
+
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,549 @@
+#pragma once
+
+/**
+ * @file kalman_filter.h
+ * @brief Multi-state Kalman filter with compile-time dimensions
+ *
+ * KalmanFilter in filter.h tracks a single scalar. KalmanFilterN handles
+ * linear models with NX states and NZ measurements, e.g. position,
+ * velocity and sensor bias for IMU fusion. All matrices are fixed-size
+ * members, so predict() and update() never allocate, and every loop has
+ * a compile-time trip count the compiler can unroll.
+ */
+
+#include "../core/result.h"
+#include "triple_buffer.h"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief Fixed-size row-major matrix
+ *
+ * An aggregate, so `StaticMatrix<float, 2, 2>{{1, dt, 0, 1}}` lists the
+ * elements row by row; value-initialized matrices are zero.
+ *
+ * @tparam T Element type
+ * @tparam Rows Number of rows
+ * @tparam Cols Number of columns
+ */
+template<typename T, size_t Rows, size_t Cols>
+struct StaticMatrix {
+    std::array<T, Rows * Cols> data;
+
+    T& operator()(size_t row, size_t col) { return data[row * Cols + col]; }
+    const T& operator()(size_t row, size_t col) const { return data[row * Cols + col]; }
+
+    static StaticMatrix zero() {
+        StaticMatrix m{};
+        return m;
+    }
+
+    static StaticMatrix identity() {
+        static_assert(Rows == Cols, "identity() needs a square matrix");
+        StaticMatrix m{};
+        for (size_t i = 0; i < Rows; ++i) {
+            m(i, i) = 1;
+        }
+        return m;
+    }
+};
+
+/**
+ * @brief Covariance representation of KalmanFilterN
+ */
+enum class KalmanForm : uint8_t {
+    Joseph = 0,     ///< Full covariance, Joseph-form measurement update
+    UD = 1          ///< Bierman-Thornton U-D factors (P = U D U^T)
+};
+
+namespace internal {
+
+// Small dense kernels; the sizes are template arguments throughout
+
+template<typename T, size_t R, size_t K, size_t C>
+StaticMatrix<T, R, C> multiply(const StaticMatrix<T, R, K>& a, const StaticMatrix<T, K, C>& b) {
+    StaticMatrix<T, R, C> out{};
+    for (size_t i = 0; i < R; ++i) {
+        for (size_t k = 0; k < K; ++k) {
+            const T aik = a(i, k);
+            for (size_t j = 0; j < C; ++j) {
+                out(i, j) += aik * b(k, j);
+            }
+        }
+    }
+    return out;
+}
+
+// a * b^T
+template<typename T, size_t R, size_t K, size_t C>
+StaticMatrix<T, R, C> multiplyTransposed(const StaticMatrix<T, R, K>& a, const StaticMatrix<T, C, K>& b) {
+    StaticMatrix<T, R, C> out{};
+    for (size_t i = 0; i < R; ++i) {
+        for (size_t j = 0; j < C; ++j) {
+            T sum = 0;
+            for (size_t k = 0; k < K; ++k) {
+                sum += a(i, k) * b(j, k);
+            }
+            out(i, j) = sum;
+        }
+    }
+    return out;
+}
+
+// In-place U D U^T factorization of a symmetric matrix (U unit upper
+// triangular, stored above the diagonal of u). Non-positive pivots of a
+// semi-definite input become zero with a zero column.
+template<typename T, size_t N>
+void factorUD(const StaticMatrix<T, N, N>& p, StaticMatrix<T, N, N>& u, std::array<T, N>& d) {
+    u = StaticMatrix<T, N, N>::identity();
+    for (size_t j = N; j-- > 0;) {
+        T pivot = p(j, j);
+        for (size_t k = j + 1; k < N; ++k) {
+            pivot -= d[k] * u(j, k) * u(j, k);
+        }
+        d[j] = (pivot > 0) ? pivot : 0;
+        for (size_t i = 0; i < j; ++i) {
+            T sum = p(i, j);
+            for (size_t k = j + 1; k < N; ++k) {
+                sum -= d[k] * u(i, k) * u(j, k);
+            }
+            u(i, j) = (d[j] > 0) ? sum / d[j] : 0;
+        }
+    }
+}
+
+// Solves u * x = b in place for unit upper triangular u
+template<typename T, size_t N, size_t C>
+void solveUnitUpper(const StaticMatrix<T, N, N>& u, StaticMatrix<T, N, C>& b) {
+    for (size_t i = N; i-- > 0;) {
+        for (size_t k = i + 1; k < N; ++k) {
+            const T uik = u(i, k);
+            for (size_t j = 0; j < C; ++j) {
+                b(i, j) -= uik * b(k, j);
+            }
+        }
+    }
+}
+
+} // namespace internal
+
+/**
+ * @brief Linear Kalman filter with NX states and NZ measurements
+ *
+ * Model: x[k] = F x[k-1] + w, z[k] = H x[k] + v with w ~ N(0, Q) and
+ * v ~ N(0, R). The Joseph form keeps P symmetric and positive
+ * semi-definite under rounding; the U-D form propagates factors of P
+ * instead, which is better conditioned for float and stiff models, and
+ * processes measurements one at a time after decorrelating R.
+ *
+ * @tparam T Scalar type (float or double)
+ * @tparam NX Number of states
+ * @tparam NZ Number of measurements
+ */
+template<typename T, size_t NX, size_t NZ>
+class KalmanFilterN {
+public:
+    static_assert(NX > 0 && NZ > 0, "KalmanFilterN needs at least one state and one measurement");
+
+    using StateVector = StaticMatrix<T, NX, 1>;
+    using StateMatrix = StaticMatrix<T, NX, NX>;
+    using MeasurementVector = StaticMatrix<T, NZ, 1>;
+    using MeasurementMatrix = StaticMatrix<T, NZ, NZ>;
+    using ObservationMatrix = StaticMatrix<T, NZ, NX>;
+
+    /**
+     * @brief Construct a filter
+     *
+     * @param transition State transition F
+     * @param observation Observation matrix H
+     * @param processNoise Process noise covariance Q (symmetric, positive semi-definite)
+     * @param measurementNoise Measurement noise covariance R (symmetric, positive definite)
+     * @param initialState Initial state estimate
+     * @param initialCovariance Initial error covariance
+     * @param form Covariance representation
+     */
+    KalmanFilterN(const StateMatrix& transition, const ObservationMatrix& observation,
+                  const StateMatrix& processNoise, const MeasurementMatrix& measurementNoise,
+                  const StateVector& initialState = StateVector::zero(),
+                  const StateMatrix& initialCovariance = StateMatrix::identity(),
+                  KalmanForm form = KalmanForm::Joseph)
+        : m_form(form), m_transition(transition), m_observation(observation),
+          m_initialState(initialState), m_initialCovariance(initialCovariance) {
+        setProcessNoise(processNoise);
+        setMeasurementNoise(measurementNoise);
+        reset();
+    }
+
+    /**
+     * @brief Propagate the state and covariance one step
+     */
+    void predict() {
+        applyTuning();
+        m_state = internal::multiply(m_transition, m_state);
+        if (m_form == KalmanForm::Joseph) {
+            StateMatrix fp = internal::multiply(m_transition, m_covariance);
+            m_covariance = internal::multiplyTransposed(fp, m_transition);
+            for (size_t i = 0; i < NX * NX; ++i) {
+                m_covariance.data[i] += m_processNoise.data[i];
+            }
+        } else {
+            thorntonPredict();
+        }
+    }
+
+    /**
+     * @brief Correct the state with a measurement
+     *
+     * @param measurement Measurement vector z
+     * @return core::Result<void> DataError (state unchanged) if the
+     *         innovation covariance is not positive definite
+     */
+    core::Result<void> update(const MeasurementVector& measurement) {
+        applyTuning();
+        bool ok = (m_form == KalmanForm::Joseph) ? josephUpdate(measurement) : biermanUpdate(measurement);
+        if (!ok) {
+            return core::makeError<void>(core::ErrorCode::DataError,
+                                         "Innovation covariance is not positive definite");
+        }
+        return core::makeOk();
+    }
+
+    /**
+     * @brief Restore the initial state and covariance
+     */
+    void reset() {
+        setState(m_initialState, m_initialCovariance);
+    }
+
+    /**
+     * @brief Overwrite the current state and covariance
+     *
+     * @param state State estimate
+     * @param covariance Error covariance
+     */
+    void setState(const StateVector& state, const StateMatrix& covariance) {
+        m_state = state;
+        if (m_form == KalmanForm::Joseph) {
+            m_covariance = covariance;
+        } else {
+            internal::factorUD(covariance, m_factor, m_diagonal);
+        }
+    }
+
+    /**
+     * @brief Set the state transition F
+     */
+    void setTransition(const StateMatrix& transition) { m_transition = transition; }
+
+    /**
+     * @brief Set the observation matrix H
+     */
+    void setObservation(const ObservationMatrix& observation) { m_observation = observation; }
+
+    /**
+     * @brief Set the process noise covariance Q
+     *
+     * Not safe while another thread runs the filter; use publishNoise()
+     * then.
+     */
+    void setProcessNoise(const StateMatrix& processNoise) {
+        m_processNoise = processNoise;
+        internal::factorUD(processNoise, m_processFactor, m_processDiagonal);
+    }
+
+    /**
+     * @brief Set the measurement noise covariance R
+     *
+     * Not safe while another thread runs the filter; use publishNoise()
+     * then.
+     */
+    void setMeasurementNoise(const MeasurementMatrix& measurementNoise) {
+        m_measurementNoise = measurementNoise;
+        internal::factorUD(measurementNoise, m_measurementFactor, m_measurementDiagonal);
+    }
+
+    /**
+     * @brief Set both noise covariances from a control thread
+     *
+     * Q and R are factored here and handed over lock-free; the processing
+     * thread adopts them at its next predict() or update() call. Call from
+     * one control thread at a time.
+     *
+     * @param processNoise Process noise covariance Q
+     * @param measurementNoise Measurement noise covariance R
+     */
+    void publishNoise(const StateMatrix& processNoise, const MeasurementMatrix& measurementNoise) {
+        Noise& next = m_tuning.back();
+        next.process = processNoise;
+        next.measurement = measurementNoise;
+        internal::factorUD(processNoise, next.processFactor, next.processDiagonal);
+        internal::factorUD(measurementNoise, next.measurementFactor, next.measurementDiagonal);
+        m_tuning.publish();
+    }
+
+    /**
+     * @brief Get the process noise covariance Q
+     *
+     * Changes when predict() or update() adopts a published value; read
+     * it on the thread that runs them, or while no thread does.
+     */
+    const StateMatrix& getProcessNoise() const { return m_processNoise; }
+
+    /**
+     * @brief Get the measurement noise covariance R
+     *
+     * Same threading rule as getProcessNoise().
+     */
+    const MeasurementMatrix& getMeasurementNoise() const { return m_measurementNoise; }
+
+    /**
+     * @brief Get the state estimate
+     *
+     * @return const StateVector& Current state
+     */
+    const StateVector& getState() const { return m_state; }
+
+    /**
+     * @brief Get the error covariance
+     *
+     * @return StateMatrix P (rebuilt from its factors in U-D form)
+     */
+    StateMatrix getCovariance() const {
+        if (m_form == KalmanForm::Joseph) {
+            return m_covariance;
+        }
+        StateMatrix ud = m_factor;
+        for (size_t i = 0; i < NX; ++i) {
+            for (size_t j = 0; j < NX; ++j) {
+                ud(i, j) *= m_diagonal[j];
+            }
+        }
+        return internal::multiplyTransposed(ud, m_factor);
+    }
+
+    /**
+     * @brief Get the covariance representation
+     *
+     * @return KalmanForm Form chosen at construction
+     */
+    KalmanForm getForm() const { return m_form; }
+
+private:
+    // Noise covariances and their U-D factors, as published
+    struct Noise {
+        StateMatrix process{};
+        MeasurementMatrix measurement{};
+        StateMatrix processFactor{};
+        std::array<T, NX> processDiagonal{};
+        MeasurementMatrix measurementFactor{};
+        std::array<T, NZ> measurementDiagonal{};
+    };
+
+    // Members of the unused form stay zero, so copies never read
+    // indeterminate values
+    KalmanForm m_form;
+    StateMatrix m_transition{};                 ///< F
+    ObservationMatrix m_observation{};          ///< H
+    StateMatrix m_processNoise{};               ///< Q
+    MeasurementMatrix m_measurementNoise{};     ///< R
+    StateVector m_state{};                      ///< x
+    StateMatrix m_covariance{};                 ///< P (Joseph form)
+    StateMatrix m_factor{};                     ///< U of P = U D U^T (U-D form)
+    std::array<T, NX> m_diagonal{};             ///< D of P = U D U^T (U-D form)
+    StateMatrix m_processFactor{};              ///< Q = Uq Dq Uq^T
+    std::array<T, NX> m_processDiagonal{};
+    MeasurementMatrix m_measurementFactor{};    ///< R = Ur Dr Ur^T
+    std::array<T, NZ> m_measurementDiagonal{};
+    StateVector m_initialState{};
+    StateMatrix m_initialCovariance{};
+    TripleBuffer<Noise> m_tuning;
+
+    void applyTuning() {
+        if (m_tuning.update()) {
+            const Noise& noise = m_tuning.front();
+            m_processNoise = noise.process;
+            m_measurementNoise = noise.measurement;
+            m_processFactor = noise.processFactor;
+            m_processDiagonal = noise.processDiagonal;
+            m_measurementFactor = noise.measurementFactor;
+            m_measurementDiagonal = noise.measurementDiagonal;
+        }
+    }
+
+    // K = P H^T S^-1 with S = H P H^T + R, then
+    // P = (I - K H) P (I - K H)^T + K R K^T
+    bool josephUpdate(const MeasurementVector& measurement) {
+        const StaticMatrix<T, NX, NZ> pht = internal::multiplyTransposed(m_covariance, m_observation);
+        MeasurementMatrix s = internal::multiply(m_observation, pht);
+        for (size_t i = 0; i < NZ * NZ; ++i) {
+            s.data[i] += m_measurementNoise.data[i];
+        }
+
+        // Cholesky factor S = L L^T in the lower triangle of s, row by row
+        for (size_t i = 0; i < NZ; ++i) {
+            for (size_t j = 0; j <= i; ++j) {
+                T sum = s(i, j);
+                for (size_t k = 0; k < j; ++k) {
+                    sum -= s(i, k) * s(j, k);
+                }
+                if (j < i) {
+                    s(i, j) = sum / s(j, j);
+                } else if (sum > 0) {
+                    s(i, i) = std::sqrt(sum);
+                } else {
+                    return false;
+                }
+            }
+        }
+
+        // Each row of K solves L L^T k = row of P H^T
+        StaticMatrix<T, NX, NZ> gain = pht;
+        for (size_t r = 0; r < NX; ++r) {
+            for (size_t i = 0; i < NZ; ++i) {
+                T sum = gain(r, i);
+                for (size_t k = 0; k < i; ++k) {
+                    sum -= s(i, k) * gain(r, k);
+                }
+                gain(r, i) = sum / s(i, i);
+            }
+            for (size_t i = NZ; i-- > 0;) {
+                T sum = gain(r, i);
+                for (size_t k = i + 1; k < NZ; ++k) {
+                    sum -= s(k, i) * gain(r, k);
+                }
+                gain(r, i) = sum / s(i, i);
+            }
+        }
+
+        const MeasurementVector predicted = internal::multiply(m_observation, m_state);
+        for (size_t r = 0; r < NX; ++r) {
+            T correction = 0;
+            for (size_t i = 0; i < NZ; ++i) {
+                correction += gain(r, i) * (measurement.data[i] - predicted.data[i]);
+            }
+            m_state.data[r] += correction;
+        }
+
+        StateMatrix a = internal::multiply(gain, m_observation);
+        for (size_t i = 0; i < NX * NX; ++i) {
+            a.data[i] = -a.data[i];
+        }
+        for (size_t i = 0; i < NX; ++i) {
+            a(i, i) += 1;
+        }
+        const StateMatrix ap = internal::multiply(a, m_covariance);
+        const StateMatrix apa = internal::multiplyTransposed(ap, a);
+        const StaticMatrix<T, NX, NZ> kr = internal::multiply(gain, m_measurementNoise);
+        const StateMatrix krk = internal::multiplyTransposed(kr, gain);
+        for (size_t i = 0; i < NX; ++i) {
+            for (size_t j = i; j < NX; ++j) {
+                T value = (apa(i, j) + apa(j, i)) / 2 + (krk(i, j) + krk(j, i)) / 2;
+                m_covariance(i, j) = value;
+                m_covariance(j, i) = value;
+            }
+        }
+        return true;
+    }
+
+    // Bierman's sequential scalar updates on measurements decorrelated
+    // by R = Ur Dr Ur^T: z' = Ur^-1 z and H' = Ur^-1 H have covariance Dr
+    bool biermanUpdate(const MeasurementVector& measurement) {
+        for (size_t i = 0; i < NZ; ++i) {
+            if (!(m_measurementDiagonal[i] > 0)) {
+                return false;
+            }
+        }
+        MeasurementVector z = measurement;
+        ObservationMatrix h = m_observation;
+        internal::solveUnitUpper(m_measurementFactor, z);
+        internal::solveUnitUpper(m_measurementFactor, h);
+
+        for (size_t m = 0; m < NZ; ++m) {
+            // f = U^T h, v = D f
+            std::array<T, NX> f;
+            std::array<T, NX> v;
+            std::array<T, NX> gain;
+            for (size_t j = 0; j < NX; ++j) {
+                T sum = h(m, j);
+                for (size_t i = 0; i < j; ++i) {
+                    sum += m_factor(i, j) * h(m, i);
+                }
+                f[j] = sum;
+                v[j] = m_diagonal[j] * sum;
+            }
+
+            T alpha = m_measurementDiagonal[m];
+            for (size_t j = 0; j < NX; ++j) {
+                const T previousAlpha = alpha;
+                alpha += f[j] * v[j];
+                m_diagonal[j] *= previousAlpha / alpha;
+                const T lambda = -f[j] / previousAlpha;
+                for (size_t i = 0; i < j; ++i) {
+                    const T uij = m_factor(i, j);
+                    m_factor(i, j) = uij + lambda * gain[i];
+                    gain[i] += uij * v[j];
+                }
+                gain[j] = v[j];
+            }
+
+            T innovation = z.data[m];
+            for (size_t j = 0; j < NX; ++j) {
+                innovation -= h(m, j) * m_state.data[j];
+            }
+            for (size_t j = 0; j < NX; ++j) {
+                m_state.data[j] += gain[j] * innovation / alpha;
+            }
+        }
+        return true;
+    }
+
+    // Thornton's modified weighted Gram-Schmidt on W = [F U, Uq] with
+    // weights diag(D, Dq), so that W diag(D, Dq) W^T = F P F^T + Q
+    void thorntonPredict() {
+        const StateMatrix fu = internal::multiply(m_transition, m_factor);
+        StaticMatrix<T, NX, 2 * NX> w;
+        std::array<T, 2 * NX> weights;
+        for (size_t i = 0; i < NX; ++i) {
+            for (size_t j = 0; j < NX; ++j) {
+                w(i, j) = fu(i, j);
+                w(i, NX + j) = m_processFactor(i, j);
+            }
+            weights[i] = m_diagonal[i];
+            weights[NX + i] = m_processDiagonal[i];
+        }
+
+        m_factor = StateMatrix::identity();
+        for (size_t k = NX; k-- > 0;) {
+            std::array<T, 2 * NX> weighted;
+            T d = 0;
+            for (size_t l = 0; l < 2 * NX; ++l) {
+                weighted[l] = weights[l] * w(k, l);
+                d += weighted[l] * w(k, l);
+            }
+            m_diagonal[k] = d;
+            if (!(d > 0)) {
+                m_diagonal[k] = 0;
+                continue;
+            }
+            for (size_t j = 0; j < k; ++j) {
+                T sum = 0;
+                for (size_t l = 0; l < 2 * NX; ++l) {
+                    sum += w(j, l) * weighted[l];
+                }
+                const T ujk = sum / d;
+                m_factor(j, k) = ujk;
+                for (size_t l = 0; l < 2 * NX; ++l) {
+                    w(j, l) -= ujk * w(k, l);
+                }
+            }
+        }
+    }
+};
+
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,192 @@
+#pragma once
+
+/**
+ * @file resampler.h
+ * @brief Streaming sample-rate converters
+ *
+ * PolyphaseResampler converts by a fixed rational factor L/M with a
+ * windowed-sinc anti-aliasing filter, evaluating only the filter phase
+ * each output needs. FarrowResampler converts by an arbitrary ratio that
+ * may change between blocks, for tracking a drifting clock. Both keep
+ * their input history between calls, so a stream split into blocks
+ * resamples exactly as it would in one piece.
+ */
+
+#include "../fmus_config.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief Rational L/M resampler with a polyphase windowed-sinc filter
+ *
+ * Conceptually the input is zero-stuffed by L, low-pass filtered and kept
+ * every M-th sample; the polyphase form skips the stuffed zeros and the
+ * discarded outputs, so each output costs getTapsPerPhase() multiply-adds.
+ * The output phase is tracked as an integer, so it never drifts.
+ *
+ * Output sample m lies at input time m * M / L: the filter's delay is
+ * absorbed into getLatency() input samples of look-ahead before the first
+ * output.
+ */
+template<typename T>
+class FMUS_EMBED_API PolyphaseResampler {
+public:
+    /**
+     * @brief Construct a resampler
+     *
+     * The factors are reduced by their greatest common divisor.
+     *
+     * @param upFactor Interpolation factor L (output rate = input rate * L / M)
+     * @param downFactor Decimation factor M
+     * @param tapsPerPhase Filter taps per phase when L >= M, scaled by M / L when decimating
+     * @param bandwidth Passband edge as a fraction of the lower Nyquist rate (0-1)
+     * @param kaiserBeta Kaiser window parameter (8 gives about 80 dB stopband)
+     */
+    PolyphaseResampler(uint32_t upFactor, uint32_t downFactor, uint32_t tapsPerPhase = 32,
+                       T bandwidth = static_cast<T>(0.9), T kaiserBeta = 8);
+
+    /**
+     * @brief Resample a block
+     *
+     * @param input Input samples
+     * @param count Number of input samples
+     * @param output Output buffer with room for getMaxOutputCount(count) samples
+     * @return size_t Number of output samples written
+     */
+    size_t process(const T* input, size_t count, T* output);
+
+    /**
+     * @brief Resample a block into a new vector
+     *
+     * @param input Input samples
+     * @return std::vector<T> Output samples
+     */
+    std::vector<T> process(const std::vector<T>& input);
+
+    /**
+     * @brief Upper bound on the outputs produced by one process() call
+     *
+     * @param inputCount Number of input samples
+     * @return size_t Maximum number of output samples
+     */
+    size_t getMaxOutputCount(size_t inputCount) const;
+
+    /**
+     * @brief Clear the input history
+     */
+    void reset();
+
+    uint32_t getUpFactor() const { return m_up; }
+    uint32_t getDownFactor() const { return m_down; }
+    uint32_t getTapsPerPhase() const { return m_tapsPerPhase; }
+
+    /**
+     * @brief Get the look-ahead in input samples
+     *
+     * @return uint32_t Inputs consumed past an output's time before it is produced
+     */
+    uint32_t getLatency() const { return (m_center + m_up - 1) / m_up; }
+
+private:
+    uint32_t m_up;
+    uint32_t m_down;
+    uint32_t m_tapsPerPhase;
+    uint32_t m_center;          ///< Filter delay at the upsampled rate
+    std::vector<T> m_phases;    ///< Phase p at p * tapsPerPhase, oldest-input tap first
+    std::vector<T> m_history;   ///< Last tapsPerPhase inputs, stored twice
+    uint32_t m_historyIndex;
+    uint64_t m_time;            ///< Next output's upsampled time minus L * newest input index
+};
+
+/**
+ * @brief Arbitrary-ratio resampler with a cubic Lagrange Farrow interpolator
+ *
+ * Each output is a cubic through the four inputs around its time,
+ * evaluated in Horner form from coefficients shared by all fractional
+ * positions. The ratio can be changed between blocks to follow a drifting
+ * clock; the position is accumulated in double precision so long streams
+ * do not wander. The interpolator does no anti-aliasing of its own: use it
+ * for ratios near 1, or after a PolyphaseResampler for large reductions.
+ */
+template<typename T>
+class FMUS_EMBED_API FarrowResampler {
+public:
+    /**
+     * @brief Construct a resampler
+     *
+     * @param ratio Output rate divided by input rate
+     */
+    explicit FarrowResampler(double ratio = 1.0);
+
+    /**
+     * @brief Change the conversion ratio
+     *
+     * Takes effect from the next output sample.
+     *
+     * @param ratio Output rate divided by input rate (positive)
+     */
+    void setRatio(double ratio);
+
+    /**
+     * @brief Get the conversion ratio
+     *
+     * @return double Output rate divided by input rate
+     */
+    double getRatio() const { return m_ratio; }
+
+    /**
+     * @brief Resample a block
+     *
+     * @param input Input samples
+     * @param count Number of input samples
+     * @param output Output buffer with room for getMaxOutputCount(count) samples
+     * @return size_t Number of output samples written
+     */
+    size_t process(const T* input, size_t count, T* output);
+
+    /**
+     * @brief Resample a block into a new vector
+     *
+     * @param input Input samples
+     * @return std::vector<T> Output samples
+     */
+    std::vector<T> process(const std::vector<T>& input);
+
+    /**
+     * @brief Upper bound on the outputs produced by one process() call
+     *
+     * @param inputCount Number of input samples
+     * @return size_t Maximum number of output samples at the current ratio
+     */
+    size_t getMaxOutputCount(size_t inputCount) const;
+
+    /**
+     * @brief Clear the input history and position
+     */
+    void reset();
+
+    /**
+     * @brief Get the look-ahead in input samples
+     *
+     * @return uint32_t Inputs consumed past an output's time before it is produced
+     */
+    uint32_t getLatency() const { return 2; }
+
+private:
+    double m_ratio;
+    double m_step;          ///< Input samples per output sample
+    double m_position;      ///< Next output's time relative to m_taps[1]
+    T m_taps[4];            ///< Last four inputs, oldest first
+};
+
+extern template class FMUS_EMBED_API PolyphaseResampler<float>;
+extern template class FMUS_EMBED_API PolyphaseResampler<double>;
+extern template class FMUS_EMBED_API FarrowResampler<float>;
+extern template class FMUS_EMBED_API FarrowResampler<double>;
+
+} // namespace dsp
+} // namespace fmus
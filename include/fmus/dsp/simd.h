@@ -0,0 +1,54 @@
+#pragma once
+
+/**
+ * @file simd.h
+ * @brief Runtime SIMD capability detection for the fmus-embed DSP module
+ *
+ * DSP kernels with vectorized paths query the host once and pick the
+ * widest instruction set available, falling back to portable scalar code.
+ */
+
+#include "../fmus_config.h"
+#include <cstdint>
+#include <string>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief SIMD instruction set levels used by DSP kernels
+ */
+enum class SimdLevel : uint8_t {
+    Scalar = 0,     ///< Portable scalar code
+    SSE2 = 1,       ///< x86 SSE2 (128-bit)
+    AVX2 = 2,       ///< x86 AVX2 + FMA (256-bit)
+    NEON = 3        ///< ARM NEON (128-bit)
+};
+
+/**
+ * @brief Detect the best SIMD level supported by the host CPU
+ *
+ * The result is computed on first call and cached.
+ *
+ * @return SimdLevel Best supported level
+ */
+FMUS_EMBED_API SimdLevel detectSimdLevel();
+
+/**
+ * @brief Check whether a SIMD level can run on the host CPU
+ *
+ * @param level Level to check
+ * @return bool True if supported (Scalar is always supported)
+ */
+FMUS_EMBED_API bool isSimdLevelSupported(SimdLevel level);
+
+/**
+ * @brief Get string representation of SIMD level
+ *
+ * @param level SIMD level
+ * @return std::string String representation
+ */
+FMUS_EMBED_API std::string simdLevelToString(SimdLevel level);
+
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,202 @@
+#pragma once
+
+/**
+ * @file sliding_dft.h
+ * @brief Streaming single-bin DFT bank for tracking a few known frequencies
+ *
+ * When only a handful of frequencies matter (a fundamental and its
+ * harmonics, pilot tones), updating those bins every sample is far cheaper
+ * than a full FFT per frame.
+ */
+
+#include "../fmus_config.h"
+#include "../core/result.h"
+#include <vector>
+#include <cstdint>
+#include <complex>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief Sliding DFT over a rectangular window for K chosen frequencies
+ *
+ * Each tracked value is the DFT of the latest windowSize samples at one
+ * frequency, updated in O(K) per sample and channel. Frequencies need not
+ * fall on the N-point grid. Running sums are replaced every window by a
+ * freshly accumulated copy, so rounding errors cannot build up over long
+ * streams. State is kept as separate real/imaginary arrays (one lane per
+ * channel and bin) so the per-bin loops vectorize.
+ */
+template<typename T>
+class FMUS_EMBED_API SlidingDFTBank {
+public:
+    /**
+     * @brief Construct a bank
+     *
+     * @param sampleRate Sample rate in Hz
+     * @param windowSize Window length N in samples
+     * @param frequencies Tracked frequencies in Hz (below Nyquist)
+     * @param channelCount Number of interleaved input channels
+     */
+    SlidingDFTBank(T sampleRate, uint32_t windowSize, const std::vector<T>& frequencies,
+                   uint32_t channelCount = 1);
+
+    /**
+     * @brief Build the frequency list for a fundamental and its harmonics
+     *
+     * @param fundamental Fundamental frequency in Hz
+     * @param numHarmonics Number of harmonics after the fundamental
+     * @return std::vector<T> fundamental, 2*fundamental, ...
+     */
+    static std::vector<T> harmonicFrequencies(T fundamental, uint32_t numHarmonics);
+
+    /**
+     * @brief Process one sample of a single-channel bank
+     *
+     * @param sample Input sample
+     */
+    void process(T sample);
+
+    /**
+     * @brief Process interleaved frames
+     *
+     * @param frames frameCount * getChannelCount() samples, channel-interleaved
+     * @param frameCount Number of frames
+     */
+    void process(const T* frames, size_t frameCount);
+
+    /**
+     * @brief Reset all state
+     */
+    void reset();
+
+    /**
+     * @brief Check whether a full window has been seen
+     *
+     * @return bool True once windowSize frames have been processed
+     */
+    bool isReady() const { return m_ready; }
+
+    /**
+     * @brief Get DFT value of a tracked bin (phase relative to window start)
+     *
+     * @param channel Channel index
+     * @param bin Index into the frequency list
+     * @return std::complex<T> DFT value
+     */
+    std::complex<T> getValue(uint32_t channel, uint32_t bin) const;
+
+    /**
+     * @brief Get DFT magnitude of a tracked bin
+     *
+     * @param channel Channel index
+     * @param bin Index into the frequency list
+     * @return T Magnitude
+     */
+    T getMagnitude(uint32_t channel, uint32_t bin) const;
+
+    /**
+     * @brief Get phase of a tracked bin relative to the window start
+     *
+     * @param channel Channel index
+     * @param bin Index into the frequency list
+     * @return T Phase in radians
+     */
+    T getPhase(uint32_t channel, uint32_t bin) const;
+
+    /**
+     * @brief Estimate the peak amplitude of a sinusoid at a tracked bin
+     *
+     * @param channel Channel index
+     * @param bin Index into the frequency list
+     * @return T 2 * |X| / N
+     */
+    T getAmplitude(uint32_t channel, uint32_t bin) const;
+
+    /**
+     * @brief Calculate total harmonic distortion
+     *
+     * Bin 0 is the fundamental and every other bin a harmonic, as laid out
+     * by harmonicFrequencies().
+     *
+     * @param channel Channel index
+     * @return core::Result<T> THD percentage or error
+     */
+    core::Result<T> calculateTHD(uint32_t channel) const;
+
+    /**
+     * @brief Calculate signal-to-noise ratio
+     *
+     * Signal is the power at the given bin; noise is the total window power
+     * minus the power of all tracked bins (so tracked harmonics are excluded).
+     *
+     * @param channel Channel index
+     * @param bin Signal bin
+     * @return core::Result<T> SNR in dB or error
+     */
+    core::Result<T> calculateSNR(uint32_t channel, uint32_t bin = 0) const;
+
+    /**
+     * @brief Get window length
+     *
+     * @return uint32_t Window size
+     */
+    uint32_t getWindowSize() const { return m_windowSize; }
+
+    /**
+     * @brief Get number of tracked bins
+     *
+     * @return uint32_t Bin count
+     */
+    uint32_t getBinCount() const { return m_binCount; }
+
+    /**
+     * @brief Get number of channels
+     *
+     * @return uint32_t Channel count
+     */
+    uint32_t getChannelCount() const { return m_channelCount; }
+
+    /**
+     * @brief Get tracked frequencies
+     *
+     * @return const std::vector<T>& Frequencies in Hz
+     */
+    const std::vector<T>& getFrequencies() const { return m_frequencies; }
+
+private:
+    T m_sampleRate;
+    uint32_t m_windowSize;
+    uint32_t m_binCount;
+    uint32_t m_channelCount;
+    std::vector<T> m_frequencies;
+    std::vector<double> m_omega;            ///< Radians per sample, per bin
+    std::vector<double> m_anchorPhase;      ///< omega * n at the last window boundary, mod 2*pi
+
+    // Per bin: P = exp(-i*omega*n), Q = P * exp(i*omega*N), step exp(-i*omega)
+    std::vector<T> m_phasorRe, m_phasorIm;
+    std::vector<T> m_oldPhasorRe, m_oldPhasorIm;
+    std::vector<T> m_stepRe, m_stepIm;
+
+    // Per lane (channel * binCount + bin): running and shadow sums
+    std::vector<T> m_sumRe, m_sumIm;
+    std::vector<T> m_shadowRe, m_shadowIm;
+
+    // Per channel: sliding and shadow energy, sample history
+    std::vector<T> m_energy, m_shadowEnergy;
+    std::vector<T> m_history;               ///< channelCount * windowSize
+    uint32_t m_position;                    ///< Samples since the last window boundary
+    bool m_ready;
+
+    void processFrame(const T* frame);
+    void anchorPhasors();
+    bool validIndex(uint32_t channel, uint32_t bin) const;
+};
+
+// Explicit template instantiations
+extern template class FMUS_EMBED_API SlidingDFTBank<float>;
+extern template class FMUS_EMBED_API SlidingDFTBank<double>;
+
+} // namespace dsp
+} // namespace fmus
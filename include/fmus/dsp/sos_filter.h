@@ -0,0 +1,195 @@
+#pragma once
+
+/**
+ * @file sos_filter.h
+ * @brief IIR filters as cascades of second-order sections
+ *
+ * Butterworth and Chebyshev designs are built from their analog prototypes
+ * by the bilinear transform and factored into biquads, which stay stable
+ * in single precision at orders where a direct-form polynomial does not.
+ * Frequencies are normalized to the Nyquist rate (1.0 = fs / 2).
+ */
+
+#include "../fmus_config.h"
+#include "../core/result.h"
+#include "filter.h"
+#include "simd.h"
+#include <vector>
+#include <cstdint>
+#include <complex>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief Coefficients of one second-order section (a0 = 1)
+ *
+ * H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+ */
+template<typename T>
+struct BiquadSection {
+    T b0, b1, b2;   ///< Numerator
+    T a1, a2;       ///< Denominator
+};
+
+/**
+ * @brief Design an IIR filter as second-order sections
+ *
+ * Odd orders end in a first-order section (b2 = a2 = 0). The overall gain
+ * is applied to the first section; sections are ordered by increasing pole
+ * radius so the most resonant one comes last.
+ *
+ * @param prototype Butterworth, Chebyshev1 or Chebyshev2
+ * @param type LowPass, HighPass, BandPass or BandStop
+ * @param order Prototype order (band filters have twice as many poles)
+ * @param cutoff Cutoff in (0, 1), or lower band edge for band filters.
+ *               Chebyshev II edges are where the stopband attenuation is reached.
+ * @param upperCutoff Upper band edge in (cutoff, 1) (band filters only)
+ * @param ripple Passband ripple in dB (Chebyshev I) or stopband
+ *               attenuation in dB (Chebyshev II)
+ * @return core::Result<std::vector<BiquadSection<T>>> Sections or error
+ */
+template<typename T>
+FMUS_EMBED_API core::Result<std::vector<BiquadSection<T>>> designSOS(
+    FilterImplementation prototype, FilterType type, uint32_t order,
+    T cutoff, T upperCutoff = 0, T ripple = 1);
+
+/**
+ * @brief Cascade of biquads in transposed direct form II
+ *
+ * Single samples run through the sections one after another. Blocks run
+ * the sections as a wavefront, one section per SIMD lane with each lane a
+ * sample behind the previous one, so a cascade of k sections advances k
+ * samples per step instead of one.
+ */
+template<typename T>
+class FMUS_EMBED_API SOSFilter : public Filter<T> {
+public:
+    /**
+     * @brief Construct a cascade from existing sections
+     *
+     * @param sections Biquad coefficients (an empty cascade passes samples through)
+     * @param type Filter type reported by getType()
+     * @param implementation Implementation reported by getImplementation()
+     * @param simd SIMD level for block processing (falls back to the
+     *             detected level if unsupported)
+     */
+    explicit SOSFilter(const std::vector<BiquadSection<T>>& sections,
+                       FilterType type = FilterType::LowPass,
+                       FilterImplementation implementation = FilterImplementation::IIR,
+                       SimdLevel simd = detectSimdLevel());
+
+    /**
+     * @brief Design and construct a cascade (see designSOS)
+     *
+     * An invalid design is logged and leaves a pass-through filter.
+     *
+     * @param prototype Butterworth, Chebyshev1 or Chebyshev2
+     * @param type LowPass, HighPass, BandPass or BandStop
+     * @param order Prototype order
+     * @param cutoff Cutoff or lower band edge (normalized, 0-1)
+     * @param upperCutoff Upper band edge (band filters only)
+     * @param ripple Passband ripple or stopband attenuation in dB
+     * @param simd SIMD level for block processing
+     */
+    SOSFilter(FilterImplementation prototype, FilterType type, uint32_t order,
+              T cutoff, T upperCutoff = 0, T ripple = 1,
+              SimdLevel simd = detectSimdLevel());
+
+    ~SOSFilter() override;
+
+    T process(T input) override;
+    std::vector<T> process(const std::vector<T>& input) override;
+    void reset() override;
+    FilterType getType() const override { return m_type; }
+    FilterImplementation getImplementation() const override { return m_implementation; }
+    uint32_t getOrder() const override { return m_order; }
+
+    /**
+     * @brief Filter a buffer without allocating
+     *
+     * Adopts sections published by publishSections() first.
+     *
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param count Number of samples
+     */
+    void process(const T* input, T* output, size_t count);
+
+    using Filter<T>::processBlock;
+    void processBlock(const T* input, T* output, size_t count) override { process(input, output, count); }
+
+    /**
+     * @brief Replace the sections from a control thread
+     *
+     * The coefficients are copied here and swapped in lock-free at the
+     * start of the next block (process(const T*, T*, size_t),
+     * processBlock() or process(vector)); process(T) keeps the current
+     * ones. The state carries over if the section count is unchanged and
+     * is cleared otherwise. The replaced sections are reused by a later
+     * publishSections() call, so the processing thread never allocates.
+     * Call from one control thread at a time.
+     *
+     * @param sections New biquad coefficients
+     */
+    void publishSections(const std::vector<BiquadSection<T>>& sections);
+
+    /**
+     * @brief Evaluate the frequency response
+     *
+     * @param frequency Normalized frequency (0 = DC, 1 = Nyquist)
+     * @return std::complex<T> H(exp(i * pi * frequency))
+     */
+    std::complex<T> getFrequencyResponse(T frequency) const;
+
+    /**
+     * @brief Get the sections
+     *
+     * Changes at the processing thread's block boundaries; read it on
+     * that thread, or while no thread runs the filter.
+     *
+     * @return const std::vector<BiquadSection<T>>& Coefficients
+     */
+    const std::vector<BiquadSection<T>>& getSections() const { return m_sections; }
+
+    /**
+     * @brief Get number of sections
+     *
+     * @return uint32_t Section count
+     */
+    uint32_t getSectionCount() const { return static_cast<uint32_t>(m_sections.size()); }
+
+    /**
+     * @brief Get SIMD level used for blocks
+     *
+     * @return SimdLevel Level
+     */
+    SimdLevel getSimdLevel() const { return m_simdLevel; }
+
+private:
+    // Cascade prepared by publishSections(); after the swap it holds the
+    // previous cascade until the control thread reuses it
+    struct Tuning {
+        std::vector<BiquadSection<T>> sections;
+        std::vector<T> state;
+        uint32_t order = 0;
+    };
+
+    std::vector<BiquadSection<T>> m_sections;
+    std::vector<T> m_state;         ///< s1, s2 per section
+    FilterType m_type;
+    FilterImplementation m_implementation;
+    uint32_t m_order;
+    SimdLevel m_simdLevel;
+    TripleBuffer<Tuning> m_tuning;
+
+    void initialize(SimdLevel simd);
+    void applyTuning();
+};
+
+// Explicit template instantiations
+extern template class FMUS_EMBED_API SOSFilter<float>;
+extern template class FMUS_EMBED_API SOSFilter<double>;
+
+} // namespace dsp
+} // namespace fmus
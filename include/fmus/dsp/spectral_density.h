@@ -0,0 +1,321 @@
+#pragma once
+
+/**
+ * @file spectral_density.h
+ * @brief Streaming Welch PSD estimation and spectrograms
+ *
+ * Both consume input in chunks of any size through a RealTimeFFT, so the
+ * FFT plan and window are set up once and memory stays bounded however
+ * long the capture runs.
+ */
+
+#include "fft.h"
+#include <vector>
+#include <cstdint>
+#include <complex>
+#include <string>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief Segment averaging modes for WelchEstimator
+ */
+enum class WelchAveraging : uint8_t {
+    Linear = 0,         ///< Equal weight for every segment since reset
+    Exponential = 1     ///< Exponentially decaying weight (tracks slow changes)
+};
+
+/**
+ * @brief Value stored for each spectrogram cell
+ */
+enum class SpectrogramScale : uint8_t {
+    Magnitude = 0,      ///< |X|
+    Power = 1,          ///< One-sided power spectral density (units^2/Hz)
+    Decibel = 2         ///< 10 * log10 of the power spectral density
+};
+
+/**
+ * @brief Behaviour of a spectrogram once its matrix is full
+ */
+enum class SpectrogramMode : uint8_t {
+    Fill = 0,           ///< Keep the first maxFrames frames and ignore later ones
+    Scroll = 1          ///< Overwrite the oldest frame (keeps the latest maxFrames)
+};
+
+/**
+ * @brief Welch power spectral density estimator over a sample stream
+ *
+ * Splits the stream into overlapping windowed segments and averages their
+ * periodograms. Only the running average is stored (segmentSize/2+1
+ * values), updated in place as mean += w * (P - mean) so long averages do
+ * not lose precision. The result is a one-sided density normalized by the
+ * window power, so integrating it over frequency gives the signal power.
+ */
+template<typename T>
+class FMUS_EMBED_API WelchEstimator {
+public:
+    /**
+     * @brief Construct an estimator
+     *
+     * @param segmentSize Segment (FFT) length (at least 2)
+     * @param sampleRate Sample rate in Hz
+     * @param overlapFactor Segment overlap (0.0 to 0.75)
+     * @param window Window applied to each segment
+     * @param averaging Averaging mode
+     * @param smoothing Weight of the newest segment for Exponential averaging (0, 1]
+     */
+    WelchEstimator(uint32_t segmentSize, T sampleRate, T overlapFactor = 0.5,
+                   WindowType window = WindowType::Hanning,
+                   WelchAveraging averaging = WelchAveraging::Linear,
+                   T smoothing = static_cast<T>(0.1));
+
+    WelchEstimator(const WelchEstimator&) = delete;
+    WelchEstimator& operator=(const WelchEstimator&) = delete;
+
+    /**
+     * @brief Add samples to the estimate
+     *
+     * @param samples Input samples
+     * @param count Number of samples (any size)
+     * @return uint32_t Number of segments completed by this call
+     */
+    uint32_t process(const T* samples, size_t count);
+
+    /**
+     * @brief Add samples to the estimate
+     *
+     * @param samples Input samples
+     * @return uint32_t Number of segments completed by this call
+     */
+    uint32_t process(const std::vector<T>& samples);
+
+    /**
+     * @brief Discard the estimate and any buffered samples
+     */
+    void reset();
+
+    /**
+     * @brief Get the current PSD estimate
+     *
+     * @return const std::vector<T>& Density per bin (units^2/Hz), zero
+     *         until the first segment completes
+     */
+    const std::vector<T>& getPSD() const { return m_psd; }
+
+    /**
+     * @brief Get number of segments averaged since reset
+     *
+     * @return uint64_t Segment count
+     */
+    uint64_t getSegmentCount() const { return m_segmentCount; }
+
+    /**
+     * @brief Get frequency spacing of the PSD bins
+     *
+     * @return T Hz per bin
+     */
+    T getFrequencyResolution() const { return m_sampleRate / static_cast<T>(m_segmentSize); }
+
+    /**
+     * @brief Get number of PSD bins
+     *
+     * @return uint32_t segmentSize/2 + 1
+     */
+    uint32_t getBinCount() const { return static_cast<uint32_t>(m_psd.size()); }
+
+    /**
+     * @brief Get segment length
+     *
+     * @return uint32_t Segment size
+     */
+    uint32_t getSegmentSize() const { return m_segmentSize; }
+
+    /**
+     * @brief Get number of new samples between segments
+     *
+     * @return uint32_t Hop size
+     */
+    uint32_t getHopSize() const { return m_stft.getHopSize(); }
+
+private:
+    uint32_t m_segmentSize;
+    T m_sampleRate;
+    WelchAveraging m_averaging;
+    T m_smoothing;
+    RealTimeFFT<T> m_stft;
+    std::vector<T> m_scale;                 ///< |X|^2 to density, per bin
+    std::vector<T> m_psd;
+    uint64_t m_segmentCount;
+    typename RealTimeFFT<T>::FrameCallback m_onSegment;
+
+    void accumulate(const std::complex<T>* bins, uint32_t binCount);
+};
+
+/**
+ * @brief Spectrogram written into a preallocated frame matrix
+ *
+ * Frames (one per hop) are stored row by row in a single contiguous
+ * maxFrames x binCount block allocated at construction.
+ */
+template<typename T>
+class FMUS_EMBED_API Spectrogram {
+public:
+    /**
+     * @brief Construct a spectrogram
+     *
+     * @param fftSize FFT length per frame (at least 2)
+     * @param sampleRate Sample rate in Hz
+     * @param maxFrames Number of frames the matrix holds (at least 1)
+     * @param overlapFactor Frame overlap (0.0 to 0.75)
+     * @param window Window applied to each frame
+     * @param scale Value stored per cell
+     * @param mode Behaviour once the matrix is full
+     */
+    Spectrogram(uint32_t fftSize, T sampleRate, uint32_t maxFrames, T overlapFactor = 0.5,
+                WindowType window = WindowType::Hanning,
+                SpectrogramScale scale = SpectrogramScale::Power,
+                SpectrogramMode mode = SpectrogramMode::Fill);
+
+    Spectrogram(const Spectrogram&) = delete;
+    Spectrogram& operator=(const Spectrogram&) = delete;
+
+    /**
+     * @brief Add samples, writing each completed frame
+     *
+     * @param samples Input samples
+     * @param count Number of samples (any size)
+     * @return uint32_t Number of frames stored by this call
+     */
+    uint32_t process(const T* samples, size_t count);
+
+    /**
+     * @brief Add samples, writing each completed frame
+     *
+     * @param samples Input samples
+     * @return uint32_t Number of frames stored by this call
+     */
+    uint32_t process(const std::vector<T>& samples);
+
+    /**
+     * @brief Clear all frames and buffered samples
+     */
+    void reset();
+
+    /**
+     * @brief Get a stored frame
+     *
+     * @param index Frame index, 0 being the oldest stored frame
+     * @return const T* binCount values, or nullptr if index >= getFrameCount()
+     */
+    const T* getFrame(uint32_t index) const;
+
+    /**
+     * @brief Get time of a stored frame
+     *
+     * @param index Frame index, 0 being the oldest stored frame
+     * @return T Time of the frame centre in seconds since reset
+     */
+    T getFrameTime(uint32_t index) const;
+
+    /**
+     * @brief Get the frame matrix
+     *
+     * In Scroll mode rows wrap around; use getFrame() for time order.
+     *
+     * @return const std::vector<T>& maxFrames * binCount values
+     */
+    const std::vector<T>& getMatrix() const { return m_matrix; }
+
+    /**
+     * @brief Get number of stored frames
+     *
+     * @return uint32_t Frames available through getFrame()
+     */
+    uint32_t getFrameCount() const { return m_frameCount; }
+
+    /**
+     * @brief Get matrix capacity in frames
+     *
+     * @return uint32_t Maximum number of frames
+     */
+    uint32_t getMaxFrames() const { return m_maxFrames; }
+
+    /**
+     * @brief Get number of bins per frame
+     *
+     * @return uint32_t fftSize/2 + 1
+     */
+    uint32_t getBinCount() const { return m_binCount; }
+
+    /**
+     * @brief Check whether the matrix is full
+     *
+     * @return bool True once maxFrames frames have been stored
+     */
+    bool isFull() const { return m_frameCount == m_maxFrames; }
+
+    /**
+     * @brief Get frequency spacing of the bins
+     *
+     * @return T Hz per bin
+     */
+    T getFrequencyResolution() const { return m_sampleRate / static_cast<T>(m_fftSize); }
+
+    /**
+     * @brief Get number of new samples between frames
+     *
+     * @return uint32_t Hop size
+     */
+    uint32_t getHopSize() const { return m_stft.getHopSize(); }
+
+private:
+    uint32_t m_fftSize;
+    T m_sampleRate;
+    uint32_t m_maxFrames;
+    uint32_t m_binCount;
+    SpectrogramScale m_scale;
+    SpectrogramMode m_mode;
+    RealTimeFFT<T> m_stft;
+    std::vector<T> m_density;               ///< |X|^2 to density, per bin
+    std::vector<T> m_matrix;
+    uint32_t m_frameCount;
+    uint32_t m_oldestRow;
+    uint64_t m_firstFrame;                  ///< Absolute index of the oldest stored frame
+    typename RealTimeFFT<T>::FrameCallback m_onFrame;
+
+    void storeFrame(const std::complex<T>* bins, uint32_t binCount);
+};
+
+/**
+ * @brief Get string representation of Welch averaging mode
+ *
+ * @param averaging Averaging mode
+ * @return std::string String representation
+ */
+FMUS_EMBED_API std::string welchAveragingToString(WelchAveraging averaging);
+
+/**
+ * @brief Get string representation of spectrogram scale
+ *
+ * @param scale Spectrogram scale
+ * @return std::string String representation
+ */
+FMUS_EMBED_API std::string spectrogramScaleToString(SpectrogramScale scale);
+
+/**
+ * @brief Get string representation of spectrogram mode
+ *
+ * @param mode Spectrogram mode
+ * @return std::string String representation
+ */
+FMUS_EMBED_API std::string spectrogramModeToString(SpectrogramMode mode);
+
+// Explicit template instantiations
+extern template class FMUS_EMBED_API WelchEstimator<float>;
+extern template class FMUS_EMBED_API WelchEstimator<double>;
+extern template class FMUS_EMBED_API Spectrogram<float>;
+extern template class FMUS_EMBED_API Spectrogram<double>;
+
+} // namespace dsp
+} // namespace fmus
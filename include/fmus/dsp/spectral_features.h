@@ -0,0 +1,190 @@
+#pragma once
+
+/**
+ * @file spectral_features.h
+ * @brief Single-pass spectral feature extraction
+ *
+ * Computes the power spectrum once and derives peaks, centroid, rolloff,
+ * THD and SNR from it, instead of rebuilding magnitude and frequency
+ * vectors for every SpectralAnalysis call.
+ */
+
+#include "fft.h"
+#include "../core/result.h"
+#include <vector>
+#include <cstdint>
+#include <complex>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief Spectral peak (local maximum of the power spectrum)
+ */
+template<typename T>
+struct SpectralPeak {
+    uint32_t bin;           ///< Bin index
+    T frequency;            ///< Frequency in Hz
+    T magnitude;            ///< |X| at the bin
+};
+
+/**
+ * @brief Spectral feature extraction settings
+ */
+template<typename T>
+struct SpectralFeatureConfig {
+    uint32_t numPeaks = 5;                      ///< Number of peaks to report
+    T minPeakDistance = 0;                      ///< Minimum spacing between reported peaks (Hz)
+    T rolloffPercent = static_cast<T>(0.85);    ///< Fraction of power below the rolloff frequency
+    T fundamentalFreq = 0;                      ///< Fundamental for THD/SNR (Hz); 0 uses the strongest peak
+    uint32_t numHarmonics = 5;                  ///< Harmonics included in THD
+    T signalBandwidth = 0;                      ///< Band around the fundamental counted as signal for SNR (Hz)
+};
+
+/**
+ * @brief Extracts a set of spectral features from one spectrum
+ *
+ * compute() runs one vectorized pass over the bins that stores |X|^2 and
+ * accumulates the magnitude and power sums; every feature is then derived
+ * from the stored power spectrum. Top-K peaks are selected from a heap of
+ * local maxima, so only the peaks actually taken are ordered. Buffers grow
+ * to the largest spectrum seen and are reused, so repeated calls on
+ * same-sized spectra do not allocate.
+ *
+ * Only the non-negative frequencies (bins 0 to N/2) of an FFTResult are
+ * analyzed, whether the result is one- or two-sided.
+ */
+template<typename T>
+class FMUS_EMBED_API SpectralFeatures {
+public:
+    /**
+     * @brief Construct an extractor
+     *
+     * @param config Extraction settings
+     * @param maxBins Bin count to reserve buffers for (0 reserves on first use)
+     */
+    explicit SpectralFeatures(const SpectralFeatureConfig<T>& config = SpectralFeatureConfig<T>(),
+                              uint32_t maxBins = 0);
+
+    /**
+     * @brief Extract features from an FFT result
+     *
+     * @param fftResult FFT result
+     * @return core::Result<void> Success or error
+     */
+    core::Result<void> compute(const FFTResult<T>& fftResult);
+
+    /**
+     * @brief Extract features from one-sided bins
+     *
+     * @param bins Bins 0 to N/2
+     * @param binCount Number of bins
+     * @param frequencyResolution Hz per bin
+     * @return core::Result<void> Success or error
+     */
+    core::Result<void> compute(const std::complex<T>* bins, uint32_t binCount, T frequencyResolution);
+
+    /**
+     * @brief Get strongest peaks, ordered by frequency
+     *
+     * @return const std::vector<SpectralPeak<T>>& Up to numPeaks peaks
+     */
+    const std::vector<SpectralPeak<T>>& getPeaks() const { return m_peaks; }
+
+    /**
+     * @brief Get magnitude-weighted mean frequency
+     *
+     * @return T Spectral centroid (Hz)
+     */
+    T getCentroid() const { return m_centroid; }
+
+    /**
+     * @brief Get frequency below which rolloffPercent of the power lies
+     *
+     * @return T Rolloff frequency (Hz)
+     */
+    T getRolloff() const { return m_rolloff; }
+
+    /**
+     * @brief Get total power (sum of |X|^2)
+     *
+     * @return T Total power
+     */
+    T getTotalPower() const { return m_totalPower; }
+
+    /**
+     * @brief Get fundamental frequency used for THD and SNR
+     *
+     * @return T Configured fundamental, or the strongest peak (0 if none)
+     */
+    T getFundamental() const { return m_fundamental; }
+
+    /**
+     * @brief Get total harmonic distortion
+     *
+     * Harmonic and fundamental powers are the largest |X|^2 within one bin
+     * of each frequency, as in SpectralAnalysis::calculateTHD().
+     *
+     * @return core::Result<T> THD percentage or error
+     */
+    core::Result<T> getTHD() const;
+
+    /**
+     * @brief Get signal-to-noise ratio
+     *
+     * Signal is the power within signalBandwidth/2 (at least one bin) of
+     * the fundamental; noise is all other power except DC, as in
+     * SpectralAnalysis::calculateSNR().
+     *
+     * @return core::Result<T> SNR in dB or error
+     */
+    core::Result<T> getSNR() const;
+
+    /**
+     * @brief Get power spectrum of the last computed spectrum
+     *
+     * @return const std::vector<T>& |X|^2 per bin
+     */
+    const std::vector<T>& getPowerSpectrum() const { return m_power; }
+
+    /**
+     * @brief Get extraction settings
+     *
+     * @return const SpectralFeatureConfig<T>& Settings
+     */
+    const SpectralFeatureConfig<T>& getConfig() const { return m_config; }
+
+    /**
+     * @brief Change extraction settings (applies to the next compute())
+     *
+     * @param config Extraction settings
+     */
+    void setConfig(const SpectralFeatureConfig<T>& config);
+
+private:
+    SpectralFeatureConfig<T> m_config;
+    SimdLevel m_simdLevel;
+    std::vector<T> m_power;
+    std::vector<uint32_t> m_candidates;     ///< Local maxima, arranged as a heap
+    std::vector<SpectralPeak<T>> m_peaks;
+    T m_resolution;
+    T m_centroid;
+    T m_rolloff;
+    T m_totalPower;
+    T m_fundamental;
+    T m_fundamentalPower;
+    T m_harmonicPower;
+    T m_signalPower;
+    T m_noisePower;
+
+    void selectPeaks();
+    void measureHarmonics();
+    T peakPowerNear(T frequency) const;
+};
+
+// Explicit template instantiations
+extern template class FMUS_EMBED_API SpectralFeatures<float>;
+extern template class FMUS_EMBED_API SpectralFeatures<double>;
+
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ * @file spsc_ring.h
+ * @brief Bounded lock-free single-producer/single-consumer queue
+ *
+ * Used to hand blocks between pipeline threads without locks: each side
+ * only writes its own index, and the two indices live on separate cache
+ * lines so the threads do not contend for them.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief Bounded SPSC ring buffer
+ *
+ * Exactly one thread may push and one thread may pop. Items are moved in
+ * and out of preallocated slots, so passing a std::vector through the ring
+ * hands over its buffer without copying or allocating. Each side caches
+ * the other's index and only re-reads it when the ring looks full or
+ * empty.
+ *
+ * @tparam Item Item type (default constructible and move assignable)
+ */
+template<typename Item>
+class SPSCRing {
+public:
+    /**
+     * @brief Construct a ring
+     *
+     * @param capacity Minimum number of items (rounded up to a power of 2)
+     */
+    explicit SPSCRing(size_t capacity)
+        : m_head(0), m_tail(0), m_cachedTail(0), m_cachedHead(0) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    SPSCRing(const SPSCRing&) = delete;
+    SPSCRing& operator=(const SPSCRing&) = delete;
+
+    /**
+     * @brief Push an item (producer thread only)
+     *
+     * @param item Item, moved from only on success
+     * @return bool False if the ring is full
+     */
+    bool tryPush(Item& item) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail > m_mask) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail > m_mask) {
+                return false;
+            }
+        }
+        m_slots[head & m_mask] = std::move(item);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop an item (consumer thread only)
+     *
+     * @param item Receives the oldest item on success
+     * @return bool False if the ring is empty
+     */
+    bool tryPop(Item& item) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_cachedHead) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail == m_cachedHead) {
+                return false;
+            }
+        }
+        item = std::move(m_slots[tail & m_mask]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get the number of queued items
+     *
+     * Exact only when neither side is active; otherwise a snapshot.
+     *
+     * @return size_t Queued items
+     */
+    size_t size() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the capacity
+     *
+     * @return size_t Maximum number of queued items
+     */
+    size_t capacity() const { return m_slots.size(); }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<Item> m_slots;
+    size_t m_mask;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head;    ///< Next slot to write
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail;    ///< Next slot to read
+    alignas(CACHE_LINE_SIZE) size_t m_cachedTail;           ///< Producer's copy of m_tail
+    alignas(CACHE_LINE_SIZE) size_t m_cachedHead;           ///< Consumer's copy of m_head
+};
+
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,238 @@
+#pragma once
+
+/**
+ * @file static_filter_chain.h
+ * @brief Filter chains composed at compile time
+ *
+ * RealTimeProcessor runs a run-time list of Filter<T> objects, one virtual
+ * call per filter and sample. StaticFilterChain fixes the stages in its
+ * type instead: every call is direct and defined in this header, so the
+ * compiler inlines the whole chain into one loop body and keeps the stage
+ * states in registers across a block.
+ *
+ * A stage is any type with `T process(T)` and `void reset()` visible to
+ * the compiler; the stages below cover the common building blocks, and a
+ * chain is itself a stage.
+ */
+
+#include "sos_filter.h"
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief Transposed direct form II biquad stage
+ *
+ * Same arithmetic as one section of SOSFilter.
+ */
+template<typename T>
+struct BiquadStage {
+    BiquadSection<T> section;
+    T s1 = 0;
+    T s2 = 0;
+
+    BiquadStage() : section{1, 0, 0, 0, 0} {}
+    explicit BiquadStage(const BiquadSection<T>& coefficients) : section(coefficients) {}
+
+    T process(T input) {
+        T output = section.b0 * input + s1;
+        s1 = section.b1 * input + s2 - section.a1 * output;
+        s2 = section.b2 * input - section.a2 * output;
+        return output;
+    }
+
+    void reset() {
+        s1 = 0;
+        s2 = 0;
+    }
+};
+
+/**
+ * @brief First-order RC low-pass stage, y = alpha * x + (1 - alpha) * y[n-1]
+ *
+ * Same arithmetic as LowPassFilter(alpha).
+ */
+template<typename T>
+struct OnePoleLowPassStage {
+    T alpha;
+    T previousOutput = 0;
+
+    explicit OnePoleLowPassStage(T a = static_cast<T>(0.5))
+        : alpha(std::clamp(a, static_cast<T>(0.001), static_cast<T>(0.999))) {}
+
+    T process(T input) {
+        previousOutput = alpha * input + (1 - alpha) * previousOutput;
+        return previousOutput;
+    }
+
+    void reset() { previousOutput = 0; }
+};
+
+/**
+ * @brief First-order RC high-pass stage, y = alpha * (y[n-1] + x - x[n-1])
+ *
+ * Same arithmetic as HighPassFilter(alpha).
+ */
+template<typename T>
+struct OnePoleHighPassStage {
+    T alpha;
+    T previousInput = 0;
+    T previousOutput = 0;
+
+    explicit OnePoleHighPassStage(T a = static_cast<T>(0.5))
+        : alpha(std::clamp(a, static_cast<T>(0.001), static_cast<T>(0.999))) {}
+
+    T process(T input) {
+        previousOutput = alpha * (previousOutput + input - previousInput);
+        previousInput = input;
+        return previousOutput;
+    }
+
+    void reset() {
+        previousInput = 0;
+        previousOutput = 0;
+    }
+};
+
+/**
+ * @brief Constant gain stage
+ */
+template<typename T>
+struct GainStage {
+    T gain;
+
+    explicit GainStage(T g = 1) : gain(g) {}
+
+    T process(T input) { return gain * input; }
+    void reset() {}
+};
+
+/**
+ * @brief Fixed sequence of filter stages with all calls resolved at compile time
+ *
+ * The stages are stored by value, back to back in one tuple. Trivially
+ * copyable chains are copied to a local for the duration of a block, so
+ * the output buffer cannot alias the state and the compiler may keep every
+ * stage's state in registers.
+ *
+ * @tparam T Sample type
+ * @tparam Stages Stage types, applied first to last
+ */
+template<typename T, typename... Stages>
+class StaticFilterChain {
+public:
+    static_assert(sizeof...(Stages) > 0, "StaticFilterChain needs at least one stage");
+
+    /**
+     * @brief Construct a chain of default-constructed stages
+     */
+    StaticFilterChain() = default;
+
+    /**
+     * @brief Construct a chain from its stages
+     *
+     * @param stages Stage objects, first to last
+     */
+    explicit StaticFilterChain(Stages... stages) : m_stages(std::move(stages)...) {}
+
+    /**
+     * @brief Process a single sample through every stage
+     *
+     * @param input Input sample
+     * @return T Output of the last stage
+     */
+    T process(T input) {
+        return run(m_stages, input, Indices{});
+    }
+
+    /**
+     * @brief Process a block of samples
+     *
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param count Number of samples
+     */
+    void processBlock(const T* input, T* output, size_t count) {
+        if constexpr ((std::is_trivially_copyable<Stages>::value && ...)) {
+            std::tuple<Stages...> stages = m_stages;
+            for (size_t n = 0; n < count; ++n) {
+                output[n] = run(stages, input[n], Indices{});
+            }
+            m_stages = stages;
+        } else {
+            for (size_t n = 0; n < count; ++n) {
+                output[n] = run(m_stages, input[n], Indices{});
+            }
+        }
+    }
+
+    /**
+     * @brief Process a vector of samples
+     *
+     * @param input Input samples
+     * @return std::vector<T> Output samples
+     */
+    std::vector<T> process(const std::vector<T>& input) {
+        std::vector<T> output(input.size());
+        processBlock(input.data(), output.data(), input.size());
+        return output;
+    }
+
+    /**
+     * @brief Reset every stage
+     */
+    void reset() {
+        std::apply([](auto&... stage) { (stage.reset(), ...); }, m_stages);
+    }
+
+    /**
+     * @brief Access a stage
+     *
+     * @tparam I Stage index
+     * @return Stage reference
+     */
+    template<size_t I>
+    auto& stage() { return std::get<I>(m_stages); }
+
+    template<size_t I>
+    const auto& stage() const { return std::get<I>(m_stages); }
+
+    /**
+     * @brief Get number of stages
+     *
+     * @return size_t Stage count
+     */
+    static constexpr size_t size() { return sizeof...(Stages); }
+
+private:
+    using Indices = std::index_sequence_for<Stages...>;
+
+    std::tuple<Stages...> m_stages;
+
+    template<size_t... I>
+    static T run(std::tuple<Stages...>& stages, T sample, std::index_sequence<I...>) {
+        ((sample = std::get<I>(stages).process(sample)), ...);
+        return sample;
+    }
+};
+
+/**
+ * @brief Build a chain, deducing the stage types
+ *
+ * @tparam T Sample type
+ * @param stages Stage objects, first to last
+ * @return StaticFilterChain<T, Stages...> Chain
+ */
+template<typename T, typename... Stages>
+StaticFilterChain<T, Stages...> makeStaticFilterChain(Stages... stages) {
+    return StaticFilterChain<T, Stages...>(std::move(stages)...);
+}
+
+} // namespace dsp
+} // namespace fmus
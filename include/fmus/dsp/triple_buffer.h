@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * @file triple_buffer.h
+ * @brief Lock-free publication of parameter sets to a processing thread
+ *
+ * Used to retune running filters: the control thread prepares a complete
+ * parameter set, including any memory it needs, and publishes it with one
+ * atomic exchange; the processing thread picks up the newest set between
+ * blocks. The set it gives up returns to the control thread, which reuses
+ * or frees it, so the processing thread never allocates or frees.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace fmus {
+namespace dsp {
+
+/**
+ * @brief Wait-free single-writer/single-reader triple buffer
+ *
+ * Three slots rotate between the writer (back), the reader (front) and a
+ * hand-over slot (middle). publish() exchanges back and middle, update()
+ * exchanges front and middle if the middle holds an unread set, so each
+ * side only ever touches the slot it owns. A set published before the
+ * reader took the previous one replaces it; the reader always sees the
+ * newest.
+ *
+ * Copying is for filters that are copied while idle; it is not
+ * synchronized with either side.
+ *
+ * @tparam Item Parameter set (default constructible and copyable)
+ */
+template<typename Item>
+class TripleBuffer {
+public:
+    TripleBuffer() : m_middle(MIDDLE_START), m_back(BACK_START), m_front(FRONT_START) {}
+
+    TripleBuffer(const TripleBuffer& other)
+        : m_middle(other.m_middle.load(std::memory_order_acquire)),
+          m_back(other.m_back), m_front(other.m_front) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            m_slots[i] = other.m_slots[i];
+        }
+    }
+
+    TripleBuffer& operator=(const TripleBuffer& other) {
+        if (this != &other) {
+            for (uint32_t i = 0; i < 3; ++i) {
+                m_slots[i] = other.m_slots[i];
+            }
+            m_middle.store(other.m_middle.load(std::memory_order_acquire), std::memory_order_release);
+            m_back = other.m_back;
+            m_front = other.m_front;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Get the slot to fill (writer only)
+     *
+     * Holds whatever set the reader gave up last, or an older one.
+     *
+     * @return Item& Back slot
+     */
+    Item& back() { return m_slots[m_back]; }
+
+    /**
+     * @brief Make the back slot the newest set (writer only)
+     */
+    void publish() {
+        m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * @brief Take the newest set if one was published (reader only)
+     *
+     * @return bool True if front() changed
+     */
+    bool update() {
+        if (!(m_middle.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Get the set in use (reader only)
+     *
+     * @return Item& Front slot
+     */
+    Item& front() { return m_slots[m_front]; }
+
+private:
+    static constexpr uint32_t INDEX_MASK = 3;
+    static constexpr uint32_t FRESH = 4;        ///< Middle slot not yet read
+    static constexpr uint32_t FRONT_START = 0;
+    static constexpr uint32_t MIDDLE_START = 1;
+    static constexpr uint32_t BACK_START = 2;
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    Item m_slots[3];
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> m_middle;   ///< Middle index and FRESH flag
+    alignas(CACHE_LINE_SIZE) uint32_t m_back;                  ///< Writer's slot
+    alignas(CACHE_LINE_SIZE) uint32_t m_front;                 ///< Reader's slot
+};
+
+} // namespace dsp
+} // namespace fmus
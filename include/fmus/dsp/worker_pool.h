@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * @file worker_pool.h
+ * @brief Fixed-size thread pool for splitting DSP work across cores
+ */
+
+#include "../fmus_config.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace fmus {
+namespace dsp {
+
+struct WorkerPoolImpl;
+
+/**
+ * @brief Fixed set of worker threads that run range-partitioned jobs
+ *
+ * parallelFor() splits an index range into one contiguous chunk per
+ * participant; the calling thread processes the first chunk itself and
+ * returns once every chunk is done. Threads are created once and reused,
+ * so per-call overhead is a wake-up and a join rather than thread creation.
+ * Jobs from different threads are serialized.
+ */
+class FMUS_EMBED_API WorkerPool {
+public:
+    /**
+     * @brief Task over the half-open range [begin, end)
+     *
+     * The worker index is below getThreadCount() and unique among the
+     * chunks of one job, so it can select per-worker scratch space.
+     */
+    using RangeTask = std::function<void(uint32_t begin, uint32_t end, uint32_t worker)>;
+
+    /**
+     * @brief Construct a pool
+     *
+     * @param threadCount Number of participants including the calling
+     *                    thread (0 uses the hardware concurrency)
+     */
+    explicit WorkerPool(uint32_t threadCount = 0);
+
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Get number of participants including the calling thread
+     *
+     * @return uint32_t Thread count (at least 1)
+     */
+    uint32_t getThreadCount() const { return m_threadCount; }
+
+    /**
+     * @brief Run a task over [0, count) split across the pool
+     *
+     * Chunks are as even as possible; participants whose chunk would be
+     * empty are not woken.
+     *
+     * @param count Number of items
+     * @param task Task invoked once per non-empty chunk
+     */
+    void parallelFor(uint32_t count, const RangeTask& task);
+
+private:
+    uint32_t m_threadCount;
+    std::unique_ptr<WorkerPoolImpl> m_impl;
+};
+
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,201 @@
+#include "fmus/dsp/batch_fft.h"
+#include "fmus/core/logging.h"
+#include "fft_kernels.h"
+#include <algorithm>
+
+namespace fmus {
+namespace dsp {
+
+//=============================================================================
+// BatchFFT Implementation
+//=============================================================================
+
+template<typename T>
+const uint32_t BatchFFT<T>::MAX_LANE_SIZE;
+
+template<typename T>
+const uint32_t BatchFFT<T>::LANE_COUNT;
+
+template<typename T>
+BatchFFT<T>::BatchFFT(uint32_t size, uint32_t channelCount, WindowType window)
+    : m_size(size), m_channelCount(channelCount), m_windowType(window), m_laneWise(false),
+      m_simdLevel(detectSimdLevel()) {
+    if (size == 0) {
+        FMUS_LOG_ERROR("BatchFFT size must be at least 1, using 1");
+        m_size = 1;
+    }
+    if (channelCount == 0) {
+        FMUS_LOG_ERROR("BatchFFT needs at least one channel, using 1");
+        m_channelCount = 1;
+    }
+
+    if (window != WindowType::None) {
+        m_window = FFT::getWindow<T>(m_size, window);
+    }
+
+    // A lone channel has no partner to pair with, so the plain real FFT wins
+    m_laneWise = FFT::isValidSize(m_size) && m_size <= MAX_LANE_SIZE && m_channelCount > 1;
+    if (m_laneWise) {
+        internal::buildBitReverse(m_size, m_bitReverse);
+        internal::buildRadix4Twiddles(m_size, false, m_twiddles);
+    }
+}
+
+template<typename T>
+BatchFFT<T>::~BatchFFT() = default;
+
+template<typename T>
+void BatchFFT<T>::ensureScratch(uint32_t workers) {
+    if (m_laneWise) {
+        if (m_laneScratch.size() < workers) {
+            m_laneScratch.resize(workers, std::vector<T>(2 * static_cast<size_t>(m_size) * LANE_COUNT));
+        }
+        return;
+    }
+
+    while (m_workspaces.size() < workers) {
+        m_workspaces.emplace_back(new FFTWorkspace<T>(m_size, m_windowType));
+        m_channelScratch.emplace_back(m_size);
+    }
+}
+
+template<typename T>
+void BatchFFT<T>::transformLaneGroup(const T* input, BatchLayout layout, std::complex<T>* output,
+                                     uint32_t group, T* scratch) const {
+    const uint32_t n = m_size;
+    const uint32_t lanes = LANE_COUNT;
+    const uint32_t bins = n / 2 + 1;
+    const uint32_t firstChannel = group * 2 * lanes;
+    const uint32_t channels = std::min(2 * lanes, m_channelCount - firstChannel);
+    const T* window = m_window ? m_window->data() : nullptr;
+    T* re = scratch;
+    T* im = scratch + static_cast<size_t>(n) * lanes;
+
+    // Pack channel pairs as z = x[2l] + i x[2l+1], rows in bit-reversed order
+    if (channels < 2 * lanes) {
+        std::fill(scratch, scratch + 2 * static_cast<size_t>(n) * lanes, static_cast<T>(0));
+    }
+    for (uint32_t c = 0; c < channels; ++c) {
+        T* dst = ((c & 1) ? im : re) + c / 2;
+        const uint32_t channel = firstChannel + c;
+        if (layout == BatchLayout::ChannelMajor) {
+            const T* src = input + static_cast<size_t>(channel) * n;
+            for (uint32_t t = 0; t < n; ++t) {
+                T x = window ? src[t] * window[t] : src[t];
+                dst[static_cast<size_t>(m_bitReverse[t]) * lanes] = x;
+            }
+        } else {
+            const T* src = input + channel;
+            for (uint32_t t = 0; t < n; ++t) {
+                T x = src[static_cast<size_t>(t) * m_channelCount];
+                dst[static_cast<size_t>(m_bitReverse[t]) * lanes] = window ? x * window[t] : x;
+            }
+        }
+    }
+
+    uint32_t h = 1;
+    if ((n & 0xAAAAAAAAu) != 0) {
+        internal::radix2FirstStageLanes(re, im, n, lanes);
+        h = 2;
+    }
+    const T* tw = m_twiddles.data();
+    for (; h < n; h *= 4) {
+        internal::radix4StageLanes(m_simdLevel, re, im, n, h, tw, false, lanes);
+        tw += 6 * static_cast<size_t>(h);
+    }
+
+    // Split Z = X + iY: X[k] = (Z[k] + conj(Z[N-k])) / 2, Y[k] = (Z[k] - conj(Z[N-k])) / 2i
+    const T half = static_cast<T>(0.5);
+    for (uint32_t c = 0; c < channels; c += 2) {
+        const uint32_t lane = c / 2;
+        std::complex<T>* even = output + static_cast<size_t>(firstChannel + c) * bins;
+        std::complex<T>* odd = (c + 1 < channels) ? even + bins : nullptr;
+        for (uint32_t k = 0; k < bins; ++k) {
+            const size_t row = static_cast<size_t>(k) * lanes + lane;
+            const size_t mirror = static_cast<size_t>((n - k) & (n - 1)) * lanes + lane;
+            T zr = re[row];
+            T zi = im[row];
+            T yr = re[mirror];
+            T yi = im[mirror];
+            even[k] = std::complex<T>(half * (zr + yr), half * (zi - yi));
+            if (odd) {
+                odd[k] = std::complex<T>(half * (zi + yi), half * (yr - zr));
+            }
+        }
+    }
+}
+
+template<typename T>
+void BatchFFT<T>::transformChannel(const T* input, BatchLayout layout, std::complex<T>* output,
+                                   uint32_t channel, uint32_t worker) {
+    const uint32_t n = m_size;
+    const T* samples = input + static_cast<size_t>(channel) * n;
+    if (layout == BatchLayout::Interleaved) {
+        T* gathered = m_channelScratch[worker].data();
+        for (uint32_t t = 0; t < n; ++t) {
+            gathered[t] = input[static_cast<size_t>(t) * m_channelCount + channel];
+        }
+        samples = gathered;
+    }
+    FFT::forwardReal(samples, n, output + static_cast<size_t>(channel) * getBinCount(), *m_workspaces[worker]);
+}
+
+template<typename T>
+core::Result<void> BatchFFT<T>::forwardReal(const T* input, BatchLayout layout, std::complex<T>* output,
+                                            WorkerPool* pool) {
+    if (input == nullptr || output == nullptr) {
+        return core::makeError(core::ErrorCode::InvalidArgument, "Invalid input or output buffer");
+    }
+
+    const uint32_t workers = pool ? pool->getThreadCount() : 1;
+    ensureScratch(workers);
+
+    if (m_laneWise) {
+        const uint32_t groups = (m_channelCount + 2 * LANE_COUNT - 1) / (2 * LANE_COUNT);
+        auto task = [&](uint32_t begin, uint32_t end, uint32_t worker) {
+            for (uint32_t g = begin; g < end; ++g) {
+                transformLaneGroup(input, layout, output, g, m_laneScratch[worker].data());
+            }
+        };
+        if (pool) {
+            pool->parallelFor(groups, task);
+        } else {
+            task(0, groups, 0);
+        }
+    } else {
+        auto task = [&](uint32_t begin, uint32_t end, uint32_t worker) {
+            for (uint32_t c = begin; c < end; ++c) {
+                transformChannel(input, layout, output, c, worker);
+            }
+        };
+        if (pool) {
+            pool->parallelFor(m_channelCount, task);
+        } else {
+            task(0, m_channelCount, 0);
+        }
+    }
+
+    return core::makeOk();
+}
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+std::string batchLayoutToString(BatchLayout layout) {
+    switch (layout) {
+        case BatchLayout::ChannelMajor: return "ChannelMajor";
+        case BatchLayout::Interleaved: return "Interleaved";
+        default: return "Unknown";
+    }
+}
+
+//=============================================================================
+// Explicit Template Instantiations
+//=============================================================================
+
+template class BatchFFT<float>;
+template class BatchFFT<double>;
+
+} // namespace dsp
+} // namespace fmus
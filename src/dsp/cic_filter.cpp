@@ -0,0 +1,309 @@
+#include "fmus/dsp/cic_filter.h"
+#include "fir_kernels.h"
+#include "fmus/core/logging.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace fmus {
+namespace dsp {
+
+namespace {
+
+const uint32_t MAX_ORDER = 8;
+const uint32_t MAX_DIFFERENTIAL_DELAY = 2;
+// Bits kept below the largest input; fewer than this loses float precision
+const int MIN_FRACTION_BITS = 24;
+// Compensated band edge in cycles per low-rate sample
+const double COMPENSATION_PASSBAND = 0.25;
+const double COMPENSATION_KAISER_BETA = 5.0;
+
+struct CICConfig {
+    uint32_t factor;
+    uint32_t order;
+    uint32_t delay;
+    uint32_t bitGrowth;
+    double inputScale;
+    double gain;            ///< (R * D)^N
+};
+
+// Validates the parameters and picks the fixed-point scaling so that
+// maxInput times the filter gain still fits in a signed 64-bit register
+CICConfig configure(const char* name, uint32_t factor, uint32_t order, uint32_t delay, double maxInput) {
+    if (factor == 0) {
+        FMUS_LOG_ERROR(std::string(name) + ": factor cannot be zero, setting to 1");
+        factor = 1;
+    }
+    if (order == 0 || order > MAX_ORDER) {
+        FMUS_LOG_ERROR(std::string(name) + ": order must be between 1 and " + std::to_string(MAX_ORDER) +
+                       ", clamping to valid range");
+        order = std::clamp<uint32_t>(order, 1, MAX_ORDER);
+    }
+    if (delay == 0 || delay > MAX_DIFFERENTIAL_DELAY) {
+        FMUS_LOG_ERROR(std::string(name) + ": differential delay must be 1 or 2, clamping to valid range");
+        delay = std::clamp<uint32_t>(delay, 1, MAX_DIFFERENTIAL_DELAY);
+    }
+    if (!(maxInput > 0)) {
+        FMUS_LOG_ERROR(std::string(name) + ": maximum input must be positive, setting to 1");
+        maxInput = 1;
+    }
+
+    CICConfig config;
+    config.delay = delay;
+    config.factor = factor;
+    config.order = order;
+    double growth = order * std::log2(static_cast<double>(factor) * delay);
+    int fractionBits = 62 - static_cast<int>(std::ceil(growth + std::log2(maxInput)));
+    // Trade stages for precision rather than overflow the register
+    while (fractionBits < MIN_FRACTION_BITS && config.order > 1) {
+        --config.order;
+        growth = config.order * std::log2(static_cast<double>(factor) * delay);
+        fractionBits = 62 - static_cast<int>(std::ceil(growth + std::log2(maxInput)));
+    }
+    if (config.order != order) {
+        FMUS_LOG_WARNING(std::string(name) + ": register growth too large, reducing order to " +
+                         std::to_string(config.order));
+    }
+    config.bitGrowth = static_cast<uint32_t>(std::ceil(growth));
+    config.inputScale = std::ldexp(1.0, fractionBits);
+    config.gain = std::pow(static_cast<double>(factor) * delay, config.order);
+    return config;
+}
+
+// Two's complement wrap-around, so integrator overflow cancels in the combs
+inline uint64_t toFixed(double value) {
+    return static_cast<uint64_t>(std::llrint(value));
+}
+
+inline double fromFixed(uint64_t value) {
+    return static_cast<double>(static_cast<int64_t>(value));
+}
+
+// Filters the newest taps.size() samples; taps are stored oldest-sample first
+template<typename T>
+T runFIR(const std::vector<T>& taps, std::vector<T>& history, uint32_t& index, T sample) {
+    const uint32_t length = static_cast<uint32_t>(taps.size());
+    return internal::dotProduct(taps.data(), internal::pushHistory(history.data(), length, index, sample), length);
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// CIC Compensator Design
+//=============================================================================
+
+template<typename T>
+std::vector<T> designCICCompensator(uint32_t factor, uint32_t order, uint32_t differentialDelay,
+                                    uint32_t numTaps) {
+    if (numTaps == 0) {
+        return {};
+    }
+    factor = std::max<uint32_t>(factor, 1);
+    differentialDelay = std::max<uint32_t>(differentialDelay, 1);
+    numTaps |= 1;
+
+    // Inverse of the CIC magnitude at low-rate frequency f (cycles/sample)
+    auto inverseResponse = [&](double f) {
+        if (f == 0) {
+            return 1.0;
+        }
+        const double rd = static_cast<double>(factor) * differentialDelay;
+        const double response = std::sin(M_PI * differentialDelay * f) / (rd * std::sin(M_PI * f / factor));
+        return std::pow(std::abs(response), -static_cast<double>(order));
+    };
+
+    // Frequency sampling of the desired band, integrated with the midpoint
+    // rule, then windowed
+    const uint32_t points = 2048;
+    const double df = COMPENSATION_PASSBAND / points;
+    std::vector<double> desired(points);
+    for (uint32_t k = 0; k < points; ++k) {
+        desired[k] = inverseResponse((k + 0.5) * df);
+    }
+
+    const double center = (numTaps - 1) / 2.0;
+    const double windowNorm = internal::besselI0(COMPENSATION_KAISER_BETA);
+    std::vector<double> taps(numTaps);
+    double sum = 0;
+    for (uint32_t n = 0; n < numTaps; ++n) {
+        const double offset = n - center;
+        double value = 0;
+        for (uint32_t k = 0; k < points; ++k) {
+            value += desired[k] * std::cos(2 * M_PI * (k + 0.5) * df * offset);
+        }
+        const double edge = (center > 0) ? offset / center : 0.0;
+        const double window =
+            internal::besselI0(COMPENSATION_KAISER_BETA * std::sqrt(std::max(0.0, 1.0 - edge * edge))) / windowNorm;
+        taps[n] = 2 * df * value * window;
+        sum += taps[n];
+    }
+
+    std::vector<T> result(numTaps);
+    for (uint32_t n = 0; n < numTaps; ++n) {
+        result[n] = static_cast<T>(taps[n] / sum);
+    }
+    return result;
+}
+
+//=============================================================================
+// CICDecimator Implementation
+//=============================================================================
+
+template<typename T>
+CICDecimator<T>::CICDecimator(uint32_t factor, uint32_t order, uint32_t differentialDelay,
+                              uint32_t compensationTaps, T maxInput) {
+    CICConfig config = configure("CICDecimator", factor, order, differentialDelay, maxInput);
+    m_factor = config.factor;
+    m_order = config.order;
+    m_delay = config.delay;
+    m_bitGrowth = config.bitGrowth;
+    m_inputScale = config.inputScale;
+    m_outputScale = 1.0 / (config.inputScale * config.gain);
+
+    m_integrators.resize(m_order);
+    m_combs.resize(m_order * m_delay);
+    m_compensator = designCICCompensator<T>(m_factor, m_order, m_delay, compensationTaps);
+    m_compensatorHistory.resize(2 * m_compensator.size());
+    reset();
+}
+
+template<typename T>
+size_t CICDecimator<T>::process(const T* input, size_t count, T* output) {
+    const uint32_t order = m_order;
+    uint64_t* integrators = m_integrators.data();
+    size_t produced = 0;
+    for (size_t n = 0; n < count; ++n) {
+        uint64_t value = toFixed(static_cast<double>(input[n]) * m_inputScale);
+        for (uint32_t stage = 0; stage < order; ++stage) {
+            integrators[stage] += value;
+            value = integrators[stage];
+        }
+        if (++m_phase < m_factor) {
+            continue;
+        }
+        m_phase = 0;
+
+        // Combs at the low rate: y = x - x[n - D]
+        uint64_t* delayed = m_combs.data() + m_combIndex;
+        for (uint32_t stage = 0; stage < order; ++stage, delayed += m_delay) {
+            const uint64_t previous = *delayed;
+            *delayed = value;
+            value -= previous;
+        }
+        m_combIndex = (m_combIndex + 1 == m_delay) ? 0 : m_combIndex + 1;
+
+        T sample = static_cast<T>(fromFixed(value) * m_outputScale);
+        output[produced++] = m_compensator.empty() ? sample : compensate(sample);
+    }
+    return produced;
+}
+
+template<typename T>
+std::vector<T> CICDecimator<T>::process(const std::vector<T>& input) {
+    std::vector<T> output(getMaxOutputCount(input.size()));
+    output.resize(process(input.data(), input.size(), output.data()));
+    return output;
+}
+
+template<typename T>
+void CICDecimator<T>::reset() {
+    std::fill(m_integrators.begin(), m_integrators.end(), 0);
+    std::fill(m_combs.begin(), m_combs.end(), 0);
+    std::fill(m_compensatorHistory.begin(), m_compensatorHistory.end(), static_cast<T>(0));
+    m_combIndex = 0;
+    m_phase = 0;
+    m_compensatorIndex = 0;
+}
+
+template<typename T>
+T CICDecimator<T>::compensate(T sample) {
+    return runFIR(m_compensator, m_compensatorHistory, m_compensatorIndex, sample);
+}
+
+//=============================================================================
+// CICInterpolator Implementation
+//=============================================================================
+
+template<typename T>
+CICInterpolator<T>::CICInterpolator(uint32_t factor, uint32_t order, uint32_t differentialDelay,
+                                    uint32_t compensationTaps, T maxInput) {
+    CICConfig config = configure("CICInterpolator", factor, order, differentialDelay, maxInput);
+    m_factor = config.factor;
+    m_order = config.order;
+    m_delay = config.delay;
+    m_bitGrowth = config.bitGrowth;
+    m_inputScale = config.inputScale;
+    // Zero-stuffing divides the DC gain by R
+    m_outputScale = m_factor / (config.inputScale * config.gain);
+
+    m_combs.resize(m_order * m_delay);
+    m_integrators.resize(m_order);
+    m_compensator = designCICCompensator<T>(m_factor, m_order, m_delay, compensationTaps);
+    m_compensatorHistory.resize(2 * m_compensator.size());
+    reset();
+}
+
+template<typename T>
+size_t CICInterpolator<T>::process(const T* input, size_t count, T* output) {
+    const uint32_t order = m_order;
+    uint64_t* integrators = m_integrators.data();
+    for (size_t n = 0; n < count; ++n) {
+        T sample = m_compensator.empty() ? input[n] : compensate(input[n]);
+        uint64_t value = toFixed(static_cast<double>(sample) * m_inputScale);
+
+        uint64_t* delayed = m_combs.data() + m_combIndex;
+        for (uint32_t stage = 0; stage < order; ++stage, delayed += m_delay) {
+            const uint64_t previous = *delayed;
+            *delayed = value;
+            value -= previous;
+        }
+        m_combIndex = (m_combIndex + 1 == m_delay) ? 0 : m_combIndex + 1;
+
+        // Integrators at the high rate, fed the comb output then R - 1 zeros
+        for (uint32_t r = 0; r < m_factor; ++r) {
+            for (uint32_t stage = 0; stage < order; ++stage) {
+                integrators[stage] += value;
+                value = integrators[stage];
+            }
+            *output++ = static_cast<T>(fromFixed(value) * m_outputScale);
+            value = 0;
+        }
+    }
+    return count * m_factor;
+}
+
+template<typename T>
+std::vector<T> CICInterpolator<T>::process(const std::vector<T>& input) {
+    std::vector<T> output(getMaxOutputCount(input.size()));
+    process(input.data(), input.size(), output.data());
+    return output;
+}
+
+template<typename T>
+void CICInterpolator<T>::reset() {
+    std::fill(m_combs.begin(), m_combs.end(), 0);
+    std::fill(m_integrators.begin(), m_integrators.end(), 0);
+    std::fill(m_compensatorHistory.begin(), m_compensatorHistory.end(), static_cast<T>(0));
+    m_combIndex = 0;
+    m_compensatorIndex = 0;
+}
+
+template<typename T>
+T CICInterpolator<T>::compensate(T sample) {
+    return runFIR(m_compensator, m_compensatorHistory, m_compensatorIndex, sample);
+}
+
+//=============================================================================
+// Explicit Template Instantiations
+//=============================================================================
+
+template class CICDecimator<float>;
+template class CICDecimator<double>;
+template class CICInterpolator<float>;
+template class CICInterpolator<double>;
+
+template std::vector<float> designCICCompensator<float>(uint32_t, uint32_t, uint32_t, uint32_t);
+template std::vector<double> designCICCompensator<double>(uint32_t, uint32_t, uint32_t, uint32_t);
+
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,182 @@
+#include "fmus/dsp/convolution.h"
+#include "fmus/core/logging.h"
+#include <algorithm>
+
+namespace fmus {
+namespace dsp {
+
+//=============================================================================
+// FFTConvolver Implementation
+//=============================================================================
+
+template<typename T>
+FFTConvolver<T>::FFTConvolver(const std::vector<T>& taps, ConvolutionMode mode, uint32_t blockSize, FilterType type)
+    : m_tapCount(static_cast<uint32_t>(taps.size())), m_mode(mode), m_type(type), m_delayIndex(0), m_fill(0) {
+    std::vector<T> kernel = taps;
+    if (kernel.empty()) {
+        FMUS_LOG_ERROR("FFTConvolver needs at least one tap, using a zero kernel");
+        kernel.assign(1, 0);
+        m_tapCount = 1;
+    }
+
+    if (mode == ConvolutionMode::OverlapSave) {
+        m_blockSize = FFT::nextPowerOf2(std::max(m_tapCount, blockSize));
+    } else {
+        m_blockSize = FFT::nextPowerOf2(std::max<uint32_t>(blockSize, 1));
+    }
+
+    const uint32_t fftSize = 2 * m_blockSize;
+    m_binCount = m_blockSize + 1;
+    m_partitionCount = (m_tapCount + m_blockSize - 1) / m_blockSize;
+
+    m_forwardPlan = RealFFTPlan<T>::get(fftSize, FFTDirection::Forward);
+    m_inversePlan = RealFFTPlan<T>::get(fftSize, FFTDirection::Inverse);
+    m_workspace.resize(std::max(m_forwardPlan->getWorkspaceSize(), m_inversePlan->getWorkspaceSize()));
+    m_spectrum.resize(m_binCount);
+    m_timeScratch.resize(2 * static_cast<size_t>(m_binCount));
+
+    // Spectrum of each B-tap partition, zero-padded to 2B
+    const size_t spectraSize = static_cast<size_t>(m_partitionCount) * m_binCount;
+    m_kernelRe.resize(spectraSize);
+    m_kernelIm.resize(spectraSize);
+    for (uint32_t p = 0; p < m_partitionCount; ++p) {
+        std::fill(m_timeScratch.begin(), m_timeScratch.end(), static_cast<T>(0));
+        uint32_t begin = p * m_blockSize;
+        uint32_t end = std::min(begin + m_blockSize, m_tapCount);
+        std::copy(kernel.begin() + begin, kernel.begin() + end, m_timeScratch.begin());
+        m_forwardPlan->execute(m_timeScratch.data(), m_spectrum.data(), m_workspace.data());
+
+        T* re = m_kernelRe.data() + static_cast<size_t>(p) * m_binCount;
+        T* im = m_kernelIm.data() + static_cast<size_t>(p) * m_binCount;
+        for (uint32_t k = 0; k < m_binCount; ++k) {
+            re[k] = m_spectrum[k].real();
+            im[k] = m_spectrum[k].imag();
+        }
+    }
+
+    m_delayRe.resize(spectraSize);
+    m_delayIm.resize(spectraSize);
+    m_inputBuffer.resize(fftSize);
+    m_outputBlock.resize(m_blockSize);
+    reset();
+}
+
+template<typename T>
+FFTConvolver<T>::~FFTConvolver() = default;
+
+template<typename T>
+void FFTConvolver<T>::reset() {
+    std::fill(m_delayRe.begin(), m_delayRe.end(), static_cast<T>(0));
+    std::fill(m_delayIm.begin(), m_delayIm.end(), static_cast<T>(0));
+    std::fill(m_inputBuffer.begin(), m_inputBuffer.end(), static_cast<T>(0));
+    std::fill(m_outputBlock.begin(), m_outputBlock.end(), static_cast<T>(0));
+    m_delayIndex = 0;
+    m_fill = 0;
+}
+
+template<typename T>
+uint32_t FFTConvolver<T>::getOrder() const {
+    return m_tapCount - 1;
+}
+
+template<typename T>
+void FFTConvolver<T>::convolveBlock() {
+    const uint32_t bins = m_binCount;
+
+    // Spectrum of [previous block, current block] enters the delay line
+    m_forwardPlan->execute(m_inputBuffer.data(), m_spectrum.data(), m_workspace.data());
+    m_delayIndex = (m_delayIndex == 0) ? m_partitionCount - 1 : m_delayIndex - 1;
+    T* newestRe = m_delayRe.data() + static_cast<size_t>(m_delayIndex) * bins;
+    T* newestIm = m_delayIm.data() + static_cast<size_t>(m_delayIndex) * bins;
+    for (uint32_t k = 0; k < bins; ++k) {
+        newestRe[k] = m_spectrum[k].real();
+        newestIm[k] = m_spectrum[k].imag();
+    }
+
+    // Y = sum_p X[block - p] * H[p]
+    T* accRe = m_timeScratch.data();
+    T* accIm = accRe + bins;
+    std::fill(m_timeScratch.begin(), m_timeScratch.end(), static_cast<T>(0));
+    for (uint32_t p = 0; p < m_partitionCount; ++p) {
+        uint32_t slot = m_delayIndex + p;
+        if (slot >= m_partitionCount) {
+            slot -= m_partitionCount;
+        }
+        const T* xRe = m_delayRe.data() + static_cast<size_t>(slot) * bins;
+        const T* xIm = m_delayIm.data() + static_cast<size_t>(slot) * bins;
+        const T* hRe = m_kernelRe.data() + static_cast<size_t>(p) * bins;
+        const T* hIm = m_kernelIm.data() + static_cast<size_t>(p) * bins;
+        for (uint32_t k = 0; k < bins; ++k) {
+            accRe[k] += xRe[k] * hRe[k] - xIm[k] * hIm[k];
+            accIm[k] += xRe[k] * hIm[k] + xIm[k] * hRe[k];
+        }
+    }
+    for (uint32_t k = 0; k < bins; ++k) {
+        m_spectrum[k] = std::complex<T>(accRe[k], accIm[k]);
+    }
+
+    // The last B samples of the circular result are the valid linear outputs
+    m_inversePlan->execute(m_spectrum.data(), m_timeScratch.data(), m_workspace.data());
+    std::copy(m_timeScratch.begin() + m_blockSize, m_timeScratch.begin() + 2 * m_blockSize, m_outputBlock.begin());
+    std::copy(m_inputBuffer.begin() + m_blockSize, m_inputBuffer.end(), m_inputBuffer.begin());
+}
+
+template<typename T>
+T FFTConvolver<T>::process(T input) {
+    T output = m_outputBlock[m_fill];
+    m_inputBuffer[m_blockSize + m_fill] = input;
+    if (++m_fill == m_blockSize) {
+        convolveBlock();
+        m_fill = 0;
+    }
+    return output;
+}
+
+template<typename T>
+void FFTConvolver<T>::process(const T* input, T* output, size_t count) {
+    while (count > 0) {
+        uint32_t run = static_cast<uint32_t>(std::min<size_t>(count, m_blockSize - m_fill));
+
+        // Consume the input before writing, so output may alias input
+        std::copy(input, input + run, m_inputBuffer.begin() + m_blockSize + m_fill);
+        std::copy(m_outputBlock.begin() + m_fill, m_outputBlock.begin() + m_fill + run, output);
+
+        input += run;
+        output += run;
+        count -= run;
+        m_fill += run;
+        if (m_fill == m_blockSize) {
+            convolveBlock();
+            m_fill = 0;
+        }
+    }
+}
+
+template<typename T>
+std::vector<T> FFTConvolver<T>::process(const std::vector<T>& input) {
+    std::vector<T> output(input.size());
+    process(input.data(), output.data(), input.size());
+    return output;
+}
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+std::string convolutionModeToString(ConvolutionMode mode) {
+    switch (mode) {
+        case ConvolutionMode::OverlapSave: return "OverlapSave";
+        case ConvolutionMode::Partitioned: return "Partitioned";
+        default: return "Unknown";
+    }
+}
+
+//=============================================================================
+// Explicit Template Instantiations
+//=============================================================================
+
+template class FFTConvolver<float>;
+template class FFTConvolver<double>;
+
+} // namespace dsp
+} // namespace fmus
@@ -1,10 +1,15 @@
 #include "fmus/dsp/dsp.h"
 #include "fmus/core/logging.h"
+#include "simd_kernels.h"
 #include <cmath>
 #include <algorithm>
 #include <numeric>
-#include <random>
 #include <sstream>
+#include <limits>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 namespace fmus {
 namespace dsp {
@@ -49,84 +54,306 @@ bool isDSPInitialized() {
 // Signal Statistics Implementation
 //=============================================================================
 
+namespace {
+
+// Samples summarised per SIMD block; small enough for the second pass to
+// hit L1 cache
+const size_t STATS_BLOCK_SIZE = 2048;
+// Samples per parallelFor item, and below which one thread does all the work
+const size_t STATS_PARALLEL_CHUNK = 65536;
+
+} // anonymous namespace
+
 template<typename T>
-SignalStats<T> calculateSignalStats(const std::vector<T>& signal) {
+RunningStats<T>::RunningStats() {
+    reset();
+}
+
+template<typename T>
+void RunningStats<T>::add(T sample) {
+    if (m_count == 0) {
+        m_min = sample;
+        m_max = sample;
+    } else {
+        m_min = std::min(m_min, sample);
+        m_max = std::max(m_max, sample);
+    }
+    ++m_count;
+    const double delta = static_cast<double>(sample) - m_mean;
+    m_mean += delta / static_cast<double>(m_count);
+    m_squaredDeviations += delta * (static_cast<double>(sample) - m_mean);
+}
+
+template<typename T>
+void RunningStats<T>::add(const T* data, size_t count) {
+    const SimdLevel level = detectSimdLevel();
+    for (size_t offset = 0; offset < count; offset += STATS_BLOCK_SIZE) {
+        const size_t length = std::min(STATS_BLOCK_SIZE, count - offset);
+        internal::BlockMoments<T> block = internal::blockMoments(level, data + offset, length);
+
+        RunningStats<T> part;
+        part.m_count = length;
+        part.m_mean = static_cast<double>(block.sum) / static_cast<double>(length);
+        part.m_squaredDeviations = static_cast<double>(block.squaredDeviations);
+        part.m_min = block.min;
+        part.m_max = block.max;
+        merge(part);
+    }
+}
+
+template<typename T>
+void RunningStats<T>::merge(const RunningStats& other) {
+    if (other.m_count == 0) {
+        return;
+    }
+    if (m_count == 0) {
+        *this = other;
+        return;
+    }
+
+    // Chan et al.: combine means and squared deviations of two partitions
+    const double countA = static_cast<double>(m_count);
+    const double countB = static_cast<double>(other.m_count);
+    const double total = countA + countB;
+    const double delta = other.m_mean - m_mean;
+    m_mean += delta * countB / total;
+    m_squaredDeviations += other.m_squaredDeviations + delta * delta * countA * countB / total;
+    m_count += other.m_count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+template<typename T>
+void RunningStats<T>::reset() {
+    m_count = 0;
+    m_mean = 0;
+    m_squaredDeviations = 0;
+    m_min = 0;
+    m_max = 0;
+}
+
+template<typename T>
+T RunningStats<T>::getVariance() const {
+    return (m_count > 0) ? static_cast<T>(m_squaredDeviations / static_cast<double>(m_count)) : 0;
+}
+
+template<typename T>
+T RunningStats<T>::getSampleVariance() const {
+    return (m_count > 1) ? static_cast<T>(m_squaredDeviations / static_cast<double>(m_count - 1)) : 0;
+}
+
+template<typename T>
+SignalStats<T> RunningStats<T>::getStats() const {
     SignalStats<T> stats = {};
-    
-    if (signal.empty()) {
+
+    if (m_count == 0) {
         return stats;
     }
-    
-    stats.length = static_cast<uint32_t>(signal.size());
-    
-    // Calculate mean
-    stats.mean = std::accumulate(signal.begin(), signal.end(), static_cast<T>(0)) / signal.size();
-    
-    // Find min and max
-    auto minmax = std::minmax_element(signal.begin(), signal.end());
-    stats.min = *minmax.first;
-    stats.max = *minmax.second;
-    stats.peakToPeak = stats.max - stats.min;
-    stats.peak = std::max(std::abs(stats.min), std::abs(stats.max));
-    
-    // Calculate variance and standard deviation
-    T sumSquaredDiff = 0;
-    T sumSquares = 0;
-    
-    for (const T& sample : signal) {
-        T diff = sample - stats.mean;
-        sumSquaredDiff += diff * diff;
-        sumSquares += sample * sample;
-    }
-    
-    stats.variance = sumSquaredDiff / signal.size();
-    stats.stdDev = std::sqrt(stats.variance);
-    
-    // Calculate RMS
-    stats.rms = std::sqrt(sumSquares / signal.size());
-    
-    // Calculate crest factor
+
+    stats.length = static_cast<uint32_t>(std::min<uint64_t>(m_count, UINT32_MAX));
+    stats.mean = static_cast<T>(m_mean);
+    stats.min = m_min;
+    stats.max = m_max;
+    stats.peakToPeak = m_max - m_min;
+    stats.peak = std::max(std::abs(m_min), std::abs(m_max));
+
+    const double variance = m_squaredDeviations / static_cast<double>(m_count);
+    stats.variance = static_cast<T>(variance);
+    stats.stdDev = static_cast<T>(std::sqrt(variance));
+
+    // Mean square = variance + mean^2
+    stats.rms = static_cast<T>(std::sqrt(variance + m_mean * m_mean));
+
     stats.crestFactor = (stats.rms > 0) ? stats.peak / stats.rms : 0;
-    
+
     return stats;
 }
 
+template<typename T>
+SignalStats<T> calculateSignalStats(const std::vector<T>& signal) {
+    RunningStats<T> stats;
+    stats.add(signal.data(), signal.size());
+    return stats.getStats();
+}
+
+template<typename T>
+SignalStats<T> calculateSignalStats(const T* signal, size_t count, WorkerPool& pool) {
+    const uint32_t workers = pool.getThreadCount();
+    if (signal == nullptr || workers == 1 || count < 2 * STATS_PARALLEL_CHUNK) {
+        RunningStats<T> stats;
+        if (signal != nullptr) {
+            stats.add(signal, count);
+        }
+        return stats.getStats();
+    }
+
+    // Chunks of each worker are contiguous and ordered by worker index
+    const size_t chunks = (count + STATS_PARALLEL_CHUNK - 1) / STATS_PARALLEL_CHUNK;
+    std::vector<RunningStats<T>> partials(workers);
+    pool.parallelFor(static_cast<uint32_t>(chunks), [&](uint32_t begin, uint32_t end, uint32_t worker) {
+        const size_t first = static_cast<size_t>(begin) * STATS_PARALLEL_CHUNK;
+        const size_t last = std::min(count, static_cast<size_t>(end) * STATS_PARALLEL_CHUNK);
+        partials[worker].add(signal + first, last - first);
+    });
+
+    RunningStats<T> stats;
+    for (const RunningStats<T>& partial : partials) {
+        stats.merge(partial);
+    }
+    return stats.getStats();
+}
+
 //=============================================================================
 // Correlation Functions
 //=============================================================================
 
+namespace {
+
+// Cost model for CorrelationMethod::Auto, in direct multiply-adds:
+// per-butterfly cost of the FFT path plus a fixed setup cost (plan lookup,
+// buffers). Calibrated with benchmarks/correlation_benchmark.
+static const double CORRELATION_FFT_BUTTERFLY_COST = 2.0;
+static const double CORRELATION_FFT_SETUP_COST = 4096.0;
+
 template<typename T>
-std::vector<T> crossCorrelation(const std::vector<T>& signal1, const std::vector<T>& signal2) {
+void directCorrelation(const T* signal1, size_t n1, const T* signal2, size_t n2, T* result) {
+    // result[i] = sum_n signal1[n + lag] * signal2[n] with lag = i - (n2 - 1);
+    // only the overlapping range of n is visited
+    size_t resultSize = n1 + n2 - 1;
+    for (size_t i = 0; i < resultSize; ++i) {
+        size_t start2 = (i < n2 - 1) ? (n2 - 1 - i) : 0;
+        size_t start1 = start2 + i - (n2 - 1);
+        size_t count = std::min(n1 - start1, n2 - start2);
+        T sum = 0;
+        for (size_t k = 0; k < count; ++k) {
+            sum += signal1[start1 + k] * signal2[start2 + k];
+        }
+        result[i] = sum;
+    }
+}
+
+template<typename T>
+void fftCorrelation(const std::vector<T>& signal1, const std::vector<T>& signal2, T* result) {
+    const size_t n1 = signal1.size();
+    const size_t n2 = signal2.size();
+    const uint32_t fftSize = FFT::nextPowerOf2(std::max<uint32_t>(static_cast<uint32_t>(n1 + n2 - 1), 2));
+    const uint32_t bins = fftSize / 2 + 1;
+    const bool autoCorr = (&signal1 == &signal2);
+
+    auto forwardPlan = RealFFTPlan<T>::get(fftSize, FFTDirection::Forward);
+    auto inversePlan = RealFFTPlan<T>::get(fftSize, FFTDirection::Inverse);
+
+    std::vector<T> padded(fftSize, 0);
+    std::vector<std::complex<T>> spectrum1(bins);
+    std::vector<std::complex<T>> spectrum2;
+
+    std::copy(signal1.begin(), signal1.end(), padded.begin());
+    forwardPlan->execute(padded.data(), spectrum1.data());
+
+    if (autoCorr) {
+        for (uint32_t k = 0; k < bins; ++k) {
+            spectrum1[k] = std::norm(spectrum1[k]);
+        }
+    } else {
+        spectrum2.resize(bins);
+        std::fill(padded.begin(), padded.end(), static_cast<T>(0));
+        std::copy(signal2.begin(), signal2.end(), padded.begin());
+        forwardPlan->execute(padded.data(), spectrum2.data());
+        for (uint32_t k = 0; k < bins; ++k) {
+            spectrum1[k] *= std::conj(spectrum2[k]);
+        }
+    }
+
+    inversePlan->execute(spectrum1.data(), padded.data());
+
+    // Circular result holds negative lags at the end of the buffer
+    for (size_t i = 0; i < n1 + n2 - 1; ++i) {
+        size_t index = (i + fftSize - (n2 - 1)) % fftSize;
+        result[i] = padded[index];
+    }
+}
+
+} // anonymous namespace
+
+bool shouldUseFFTCorrelation(size_t size1, size_t size2) {
+    size_t resultSize = size1 + size2 - 1;
+    if (size1 == 0 || size2 == 0 || resultSize > std::numeric_limits<uint32_t>::max() / 2) {
+        return false;
+    }
+
+    // Direct cost is the overlap area; FFT cost is three real transforms of
+    // size M, i.e. about 1.5 * M * log2(M) complex butterflies
+    double fftSize = FFT::nextPowerOf2(static_cast<uint32_t>(resultSize));
+    double directCost = static_cast<double>(size1) * static_cast<double>(size2);
+    double fftCost = CORRELATION_FFT_BUTTERFLY_COST * 1.5 * fftSize * std::log2(std::max(fftSize, 2.0)) +
+                     CORRELATION_FFT_SETUP_COST;
+    return directCost > fftCost;
+}
+
+template<typename T>
+std::vector<T> crossCorrelation(const std::vector<T>& signal1, const std::vector<T>& signal2, CorrelationMethod method) {
     if (signal1.empty() || signal2.empty()) {
         return {};
     }
     
     size_t n1 = signal1.size();
     size_t n2 = signal2.size();
-    size_t resultSize = n1 + n2 - 1;
+    std::vector<T> result(n1 + n2 - 1);
     
-    std::vector<T> result(resultSize, 0);
+    if (method == CorrelationMethod::Auto) {
+        method = shouldUseFFTCorrelation(n1, n2) ? CorrelationMethod::FFT : CorrelationMethod::Direct;
+    }
     
-    for (size_t i = 0; i < resultSize; ++i) {
-        for (size_t j = 0; j < n1; ++j) {
-            if (i >= j && (i - j) < n2) {
-                result[i] += signal1[j] * signal2[i - j];
-            }
-        }
+    if (method == CorrelationMethod::FFT) {
+        fftCorrelation(signal1, signal2, result.data());
+    } else {
+        directCorrelation(signal1.data(), n1, signal2.data(), n2, result.data());
     }
     
     return result;
 }
 
 template<typename T>
-std::vector<T> autoCorrelation(const std::vector<T>& signal) {
-    return crossCorrelation(signal, signal);
+std::vector<T> autoCorrelation(const std::vector<T>& signal, CorrelationMethod method) {
+    return crossCorrelation(signal, signal, method);
+}
+
+std::string correlationMethodToString(CorrelationMethod method) {
+    switch (method) {
+        case CorrelationMethod::Auto: return "Auto";
+        case CorrelationMethod::Direct: return "Direct";
+        case CorrelationMethod::FFT: return "FFT";
+        default: return "Unknown";
+    }
 }
 
 //=============================================================================
 // Resampling Functions
 //=============================================================================
 
+namespace {
+
+// Largest reduced L or M resample() builds a polyphase filter for
+const uint32_t MAX_POLYPHASE_FACTOR = 1024;
+
+// Runs a whole signal through a streaming resampler and flushes it with
+// zeros, so that outputs line up with the input from time 0 on
+template<typename T, typename Resampler>
+std::vector<T> resampleSignal(Resampler& resampler, const std::vector<T>& signal, size_t outputCount) {
+    std::vector<T> output(resampler.getMaxOutputCount(signal.size()));
+    output.resize(resampler.process(signal.data(), signal.size(), output.data()));
+
+    const std::vector<T> zeros(resampler.getLatency() + 1, static_cast<T>(0));
+    std::vector<T> tail(resampler.getMaxOutputCount(zeros.size()));
+    tail.resize(resampler.process(zeros.data(), zeros.size(), tail.data()));
+    output.insert(output.end(), tail.begin(), tail.end());
+
+    output.resize(std::min(output.size(), outputCount));
+    return output;
+}
+
+} // anonymous namespace
+
 template<typename T>
 core::Result<std::vector<T>> resample(const std::vector<T>& signal, T originalRate, T targetRate) {
     if (signal.empty()) {
@@ -139,26 +366,22 @@ core::Result<std::vector<T>> resample(const std::vector<T>& signal, T originalRa
     
     T ratio = targetRate / originalRate;
     size_t newSize = static_cast<size_t>(signal.size() * ratio);
-    
-    std::vector<T> resampled;
-    resampled.reserve(newSize);
-    
-    for (size_t i = 0; i < newSize; ++i) {
-        T sourceIndex = static_cast<T>(i) / ratio;
-        size_t index1 = static_cast<size_t>(sourceIndex);
-        size_t index2 = std::min(index1 + 1, signal.size() - 1);
-        
-        if (index1 >= signal.size()) {
-            break;
+
+    // Whole-number rates with a small reduced ratio get a band-limited
+    // polyphase filter; anything else is interpolated by a Farrow cubic
+    if (originalRate == std::floor(originalRate) && targetRate == std::floor(targetRate) &&
+        originalRate <= static_cast<T>(UINT32_MAX) && targetRate <= static_cast<T>(UINT32_MAX)) {
+        uint32_t up = static_cast<uint32_t>(targetRate);
+        uint32_t down = static_cast<uint32_t>(originalRate);
+        uint32_t divisor = std::gcd(up, down);
+        if (up / divisor <= MAX_POLYPHASE_FACTOR && down / divisor <= MAX_POLYPHASE_FACTOR) {
+            PolyphaseResampler<T> resampler(up / divisor, down / divisor);
+            return core::makeOk<std::vector<T>>(resampleSignal(resampler, signal, newSize));
         }
-        
-        // Linear interpolation
-        T fraction = sourceIndex - index1;
-        T interpolated = signal[index1] * (1 - fraction) + signal[index2] * fraction;
-        resampled.push_back(interpolated);
     }
-    
-    return core::makeOk<std::vector<T>>(std::move(resampled));
+
+    FarrowResampler<T> resampler(static_cast<double>(targetRate) / static_cast<double>(originalRate));
+    return core::makeOk<std::vector<T>>(resampleSignal(resampler, signal, newSize));
 }
 
 template<typename T>
@@ -167,21 +390,16 @@ std::vector<T> decimate(const std::vector<T>& signal, uint32_t factor, bool useF
         return {};
     }
     
-    std::vector<T> decimated;
-    decimated.reserve(signal.size() / factor);
-    
     if (useFilter && factor > 1) {
-        // Apply anti-aliasing filter before decimation
-        LowPassFilter<T> antiAlias(static_cast<T>(0.4) / factor);
-        auto filtered = antiAlias.process(signal);
-        
-        for (size_t i = 0; i < filtered.size(); i += factor) {
-            decimated.push_back(filtered[i]);
-        }
-    } else {
-        for (size_t i = 0; i < signal.size(); i += factor) {
-            decimated.push_back(signal[i]);
-        }
+        // Only every factor-th output of the anti-aliasing filter is computed
+        PolyphaseResampler<T> resampler(1, factor);
+        return resampleSignal(resampler, signal, (signal.size() + factor - 1) / factor);
+    }
+
+    std::vector<T> decimated;
+    decimated.reserve(signal.size() / factor + 1);
+    for (size_t i = 0; i < signal.size(); i += factor) {
+        decimated.push_back(signal[i]);
     }
     
     return decimated;
@@ -193,26 +411,16 @@ std::vector<T> interpolate(const std::vector<T>& signal, uint32_t factor, bool u
         return {};
     }
     
-    std::vector<T> interpolated;
-    interpolated.reserve(signal.size() * factor);
-    
-    // Zero-stuff (insert zeros between samples)
-    for (const T& sample : signal) {
-        interpolated.push_back(sample);
-        for (uint32_t i = 1; i < factor; ++i) {
-            interpolated.push_back(0);
-        }
-    }
-    
     if (useFilter && factor > 1) {
-        // Apply anti-imaging filter after interpolation
-        LowPassFilter<T> antiImage(static_cast<T>(0.4) / factor);
-        interpolated = antiImage.process(interpolated);
-        
-        // Scale by interpolation factor
-        for (T& sample : interpolated) {
-            sample *= factor;
-        }
+        // The anti-imaging filter skips the taps that would meet stuffed zeros
+        PolyphaseResampler<T> resampler(factor, 1);
+        return resampleSignal(resampler, signal, signal.size() * factor);
+    }
+
+    // Zero-stuff (insert zeros between samples)
+    std::vector<T> interpolated(signal.size() * factor, static_cast<T>(0));
+    for (size_t i = 0; i < signal.size(); ++i) {
+        interpolated[i * factor] = signal[i];
     }
     
     return interpolated;
@@ -224,148 +432,157 @@ std::vector<T> interpolate(const std::vector<T>& signal, uint32_t factor, bool u
 
 template<typename T>
 std::vector<T> SignalGenerator::sine(T frequency, T amplitude, T sampleRate, T duration, T phase) {
-    uint32_t numSamples = static_cast<uint32_t>(duration * sampleRate);
-    std::vector<T> signal;
-    signal.reserve(numSamples);
-    
-    T omega = 2 * M_PI * frequency / sampleRate;
-    
-    for (uint32_t i = 0; i < numSamples; ++i) {
-        T sample = amplitude * std::sin(omega * i + phase);
-        signal.push_back(sample);
-    }
-    
-    return signal;
+    NCO<T> nco(sampleRate, frequency, amplitude, Waveform::Sine, phase);
+    return nco.generate(static_cast<uint32_t>(duration * sampleRate));
 }
 
 template<typename T>
 std::vector<T> SignalGenerator::cosine(T frequency, T amplitude, T sampleRate, T duration, T phase) {
-    uint32_t numSamples = static_cast<uint32_t>(duration * sampleRate);
-    std::vector<T> signal;
-    signal.reserve(numSamples);
-    
-    T omega = 2 * M_PI * frequency / sampleRate;
-    
-    for (uint32_t i = 0; i < numSamples; ++i) {
-        T sample = amplitude * std::cos(omega * i + phase);
-        signal.push_back(sample);
-    }
-    
-    return signal;
+    NCO<T> nco(sampleRate, frequency, amplitude, Waveform::Cosine, phase);
+    return nco.generate(static_cast<uint32_t>(duration * sampleRate));
 }
 
 template<typename T>
 std::vector<T> SignalGenerator::square(T frequency, T amplitude, T sampleRate, T duration, T dutyCycle) {
-    uint32_t numSamples = static_cast<uint32_t>(duration * sampleRate);
-    std::vector<T> signal;
-    signal.reserve(numSamples);
-    
-    T period = sampleRate / frequency;
-    T highTime = period * dutyCycle;
-    
-    for (uint32_t i = 0; i < numSamples; ++i) {
-        T phase = std::fmod(static_cast<T>(i), period);
-        T sample = (phase < highTime) ? amplitude : -amplitude;
-        signal.push_back(sample);
-    }
-    
-    return signal;
+    NCO<T> nco(sampleRate, frequency, amplitude, Waveform::Square);
+    nco.setDutyCycle(dutyCycle);
+    return nco.generate(static_cast<uint32_t>(duration * sampleRate));
 }
 
 template<typename T>
 std::vector<T> SignalGenerator::sawtooth(T frequency, T amplitude, T sampleRate, T duration) {
-    uint32_t numSamples = static_cast<uint32_t>(duration * sampleRate);
-    std::vector<T> signal;
-    signal.reserve(numSamples);
-    
-    T period = sampleRate / frequency;
-    
-    for (uint32_t i = 0; i < numSamples; ++i) {
-        T phase = std::fmod(static_cast<T>(i), period);
-        T sample = amplitude * (2 * phase / period - 1);
-        signal.push_back(sample);
-    }
-    
-    return signal;
+    NCO<T> nco(sampleRate, frequency, amplitude, Waveform::Sawtooth);
+    return nco.generate(static_cast<uint32_t>(duration * sampleRate));
 }
 
 template<typename T>
 std::vector<T> SignalGenerator::triangle(T frequency, T amplitude, T sampleRate, T duration) {
-    uint32_t numSamples = static_cast<uint32_t>(duration * sampleRate);
-    std::vector<T> signal;
-    signal.reserve(numSamples);
-    
-    T period = sampleRate / frequency;
-    T halfPeriod = period / 2;
-    
-    for (uint32_t i = 0; i < numSamples; ++i) {
-        T phase = std::fmod(static_cast<T>(i), period);
-        T sample;
-        
-        if (phase < halfPeriod) {
-            sample = amplitude * (2 * phase / halfPeriod - 1);
-        } else {
-            sample = amplitude * (3 - 2 * phase / halfPeriod);
-        }
-        
-        signal.push_back(sample);
-    }
-    
-    return signal;
+    NCO<T> nco(sampleRate, frequency, amplitude, Waveform::Triangle);
+    return nco.generate(static_cast<uint32_t>(duration * sampleRate));
 }
 
 template<typename T>
 std::vector<T> SignalGenerator::whiteNoise(T amplitude, T sampleRate, T duration, uint32_t seed) {
-    uint32_t numSamples = static_cast<uint32_t>(duration * sampleRate);
-    std::vector<T> signal;
-    signal.reserve(numSamples);
-    
-    std::mt19937 generator(seed == 0 ? std::random_device{}() : seed);
-    std::normal_distribution<T> distribution(0, amplitude);
-    
-    for (uint32_t i = 0; i < numSamples; ++i) {
-        signal.push_back(distribution(generator));
-    }
-    
-    return signal;
+    NoiseGenerator<T> noise(amplitude, seed);
+    return noise.generate(static_cast<uint32_t>(duration * sampleRate));
 }
 
 template<typename T>
 std::vector<T> SignalGenerator::chirp(T startFreq, T endFreq, T amplitude, T sampleRate, T duration) {
-    uint32_t numSamples = static_cast<uint32_t>(duration * sampleRate);
-    std::vector<T> signal;
-    signal.reserve(numSamples);
-    
-    T k = (endFreq - startFreq) / duration; // Frequency sweep rate
-    
-    for (uint32_t i = 0; i < numSamples; ++i) {
-        T t = static_cast<T>(i) / sampleRate;
-        T instantFreq = startFreq + k * t;
-        T phase = 2 * M_PI * (startFreq * t + 0.5 * k * t * t);
-        T sample = amplitude * std::sin(phase);
-        signal.push_back(sample);
-    }
-    
-    return signal;
+    NCO<T> nco(sampleRate, startFreq, amplitude, Waveform::Sine);
+    nco.sweepTo(endFreq, duration);
+    return nco.generate(static_cast<uint32_t>(duration * sampleRate));
 }
 
 //=============================================================================
 // RealTimeProcessor Implementation
 //=============================================================================
 
+// Worker thread and queues of a pipelined RealTimeProcessor. Queue i feeds
+// stage i; the last queue returns finished blocks to the caller.
+template<typename T>
+struct RealTimePipeline {
+    using Block = std::vector<T>;
+
+    struct Stage {
+        uint32_t firstFilter = 0;
+        uint32_t filterCount = 0;
+        std::atomic<uint64_t> blocks{0};
+        std::atomic<uint64_t> totalNanoseconds{0};
+        std::atomic<uint64_t> maxNanoseconds{0};
+        std::atomic<uint64_t> stalls{0};
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<SPSCRing<Block>>> queues;
+    std::vector<std::unique_ptr<Stage>> stages;
+    std::vector<Block> spareBlocks;     ///< Caller-side buffers for reuse
+    size_t inFlight = 0;                ///< Blocks pushed but not yet popped
+    std::atomic<bool> running{true};
+};
+
+namespace {
+
+// Yields a few times before sleeping, so an idle pipeline does not spin
+const uint32_t PIPELINE_SPIN_LIMIT = 64;
+const auto PIPELINE_IDLE_SLEEP = std::chrono::microseconds(50);
+
+void pipelineBackoff(uint32_t& idle) {
+    if (++idle < PIPELINE_SPIN_LIMIT) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(PIPELINE_IDLE_SLEEP);
+    }
+}
+
+template<typename T>
+void runPipelineStage(RealTimePipeline<T>* pipeline, uint32_t index,
+                      const std::vector<std::shared_ptr<Filter<T>>>* filters) {
+    typename RealTimePipeline<T>::Stage& stage = *pipeline->stages[index];
+    SPSCRing<std::vector<T>>& input = *pipeline->queues[index];
+    SPSCRing<std::vector<T>>& output = *pipeline->queues[index + 1];
+
+    std::vector<T> block;
+    uint32_t idle = 0;
+    while (pipeline->running.load(std::memory_order_acquire)) {
+        if (!input.tryPop(block)) {
+            pipelineBackoff(idle);
+            continue;
+        }
+        idle = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t f = stage.firstFilter; f < stage.firstFilter + stage.filterCount; ++f) {
+            (*filters)[f]->processBlock(block.data(), block.size());
+        }
+        uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+        // Only this thread writes the counters; others just read them
+        stage.blocks.store(stage.blocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        stage.totalNanoseconds.store(stage.totalNanoseconds.load(std::memory_order_relaxed) + elapsed,
+                                     std::memory_order_relaxed);
+        if (elapsed > stage.maxNanoseconds.load(std::memory_order_relaxed)) {
+            stage.maxNanoseconds.store(elapsed, std::memory_order_relaxed);
+        }
+
+        if (!output.tryPush(block)) {
+            stage.stalls.store(stage.stalls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            while (!output.tryPush(block)) {
+                if (!pipeline->running.load(std::memory_order_acquire)) {
+                    return;
+                }
+                pipelineBackoff(idle);
+            }
+            idle = 0;
+        }
+    }
+}
+
+} // anonymous namespace
+
 template<typename T>
 RealTimeProcessor<T>::RealTimeProcessor(uint32_t bufferSize, T sampleRate)
     : m_bufferSize(bufferSize), m_sampleRate(sampleRate), m_latency(0) {
+    if (m_bufferSize == 0) {
+        FMUS_LOG_ERROR("RealTimeProcessor: buffer size cannot be zero, setting to 1");
+        m_bufferSize = 1;
+    }
 }
 
 template<typename T>
-RealTimeProcessor<T>::~RealTimeProcessor() = default;
+RealTimeProcessor<T>::~RealTimeProcessor() {
+    stopPipeline();
+}
 
 template<typename T>
 core::Result<void> RealTimeProcessor<T>::addFilter(std::shared_ptr<Filter<T>> filter) {
     if (!filter) {
         return core::makeError<void>(core::ErrorCode::InvalidArgument, "Filter pointer is null");
     }
+    if (m_pipeline) {
+        return core::makeError<void>(core::ErrorCode::NotSupported, "Cannot add filters while pipelined");
+    }
 
     m_filters.push_back(filter);
     m_latency += filter->getOrder();
@@ -375,12 +592,142 @@ core::Result<void> RealTimeProcessor<T>::addFilter(std::shared_ptr<Filter<T>> fi
 
 template<typename T>
 void RealTimeProcessor<T>::clearFilters() {
+    stopPipeline();
     m_filters.clear();
     m_latency = 0;
 }
 
+template<typename T>
+core::Result<void> RealTimeProcessor<T>::startPipeline(uint32_t stageCount, uint32_t queueDepth) {
+    if (stageCount == 0) {
+        return core::makeError<void>(core::ErrorCode::InvalidArgument, "Stage count must be positive");
+    }
+    if (m_filters.empty()) {
+        return core::makeError<void>(core::ErrorCode::InvalidArgument, "No filters to pipeline");
+    }
+    stopPipeline();
+
+    const uint32_t filterCount = static_cast<uint32_t>(m_filters.size());
+    stageCount = std::min(stageCount, filterCount);
+    queueDepth = std::max<uint32_t>(queueDepth, 1);
+
+    auto pipeline = std::make_unique<RealTimePipeline<T>>();
+    for (uint32_t i = 0; i <= stageCount; ++i) {
+        pipeline->queues.push_back(std::make_unique<SPSCRing<std::vector<T>>>(queueDepth));
+    }
+    // Contiguous groups, the first filterCount % stageCount one filter longer
+    uint32_t first = 0;
+    for (uint32_t i = 0; i < stageCount; ++i) {
+        auto stage = std::make_unique<typename RealTimePipeline<T>::Stage>();
+        stage->firstFilter = first;
+        stage->filterCount = filterCount / stageCount + (i < filterCount % stageCount ? 1 : 0);
+        first += stage->filterCount;
+        pipeline->stages.push_back(std::move(stage));
+    }
+    for (uint32_t i = 0; i < stageCount; ++i) {
+        pipeline->stages[i]->thread = std::thread(runPipelineStage<T>, pipeline.get(), i, &m_filters);
+    }
+
+    m_pipeline = std::move(pipeline);
+    return core::makeOk();
+}
+
+template<typename T>
+void RealTimeProcessor<T>::stopPipeline() {
+    if (!m_pipeline) {
+        return;
+    }
+    m_pipeline->running.store(false, std::memory_order_release);
+    for (auto& stage : m_pipeline->stages) {
+        stage->thread.join();
+    }
+    m_pipeline.reset();
+}
+
+template<typename T>
+bool RealTimeProcessor<T>::pushBlock(const T* input, size_t count) {
+    if (!m_pipeline || count > m_bufferSize) {
+        return false;
+    }
+
+    std::vector<T> block;
+    if (!m_pipeline->spareBlocks.empty()) {
+        block = std::move(m_pipeline->spareBlocks.back());
+        m_pipeline->spareBlocks.pop_back();
+    }
+    block.assign(input, input + count);
+    if (!m_pipeline->queues.front()->tryPush(block)) {
+        m_pipeline->spareBlocks.push_back(std::move(block));
+        return false;
+    }
+    ++m_pipeline->inFlight;
+    return true;
+}
+
+template<typename T>
+bool RealTimeProcessor<T>::popBlock(std::vector<T>& output) {
+    if (!m_pipeline) {
+        return false;
+    }
+
+    std::vector<T> block;
+    if (!m_pipeline->queues.back()->tryPop(block)) {
+        return false;
+    }
+    --m_pipeline->inFlight;
+    // Keep the caller's old buffer for a later pushBlock()
+    std::swap(block, output);
+    if (block.capacity() > 0) {
+        m_pipeline->spareBlocks.push_back(std::move(block));
+    }
+    return true;
+}
+
+template<typename T>
+std::vector<PipelineStageStats> RealTimeProcessor<T>::getPipelineStats() const {
+    std::vector<PipelineStageStats> result;
+    if (!m_pipeline) {
+        return result;
+    }
+
+    for (size_t i = 0; i < m_pipeline->stages.size(); ++i) {
+        const auto& stage = *m_pipeline->stages[i];
+        PipelineStageStats stats = {};
+        stats.firstFilter = stage.firstFilter;
+        stats.filterCount = stage.filterCount;
+        stats.blocks = stage.blocks.load(std::memory_order_relaxed);
+        stats.meanLatency = stats.blocks
+            ? static_cast<double>(stage.totalNanoseconds.load(std::memory_order_relaxed)) / stats.blocks / 1000.0
+            : 0.0;
+        stats.maxLatency = static_cast<double>(stage.maxNanoseconds.load(std::memory_order_relaxed)) / 1000.0;
+        stats.queued = static_cast<uint32_t>(m_pipeline->queues[i]->size());
+        stats.queueCapacity = static_cast<uint32_t>(m_pipeline->queues[i]->capacity());
+        stats.stalls = stage.stalls.load(std::memory_order_relaxed);
+        result.push_back(stats);
+    }
+    return result;
+}
+
 template<typename T>
 T RealTimeProcessor<T>::processSample(T input) {
+    if (m_pipeline) {
+        // The next popped block would belong to an earlier pushBlock()
+        if (m_pipeline->inFlight > 0) {
+            FMUS_LOG_ERROR("RealTimeProcessor: processSample() called with pushed blocks in flight");
+            return T(0);
+        }
+        // A one-sample block, so the filters only ever run on their stage
+        std::vector<T> block;
+        uint32_t idle = 0;
+        while (!pushBlock(&input, 1)) {
+            pipelineBackoff(idle);
+        }
+        while (!popBlock(block)) {
+            pipelineBackoff(idle);
+        }
+        return block.front();
+    }
+
     T output = input;
 
     for (auto& filter : m_filters) {
@@ -392,11 +739,45 @@ T RealTimeProcessor<T>::processSample(T input) {
 
 template<typename T>
 std::vector<T> RealTimeProcessor<T>::processBuffer(const std::vector<T>& input) {
-    std::vector<T> output;
-    output.reserve(input.size());
+    if (m_pipeline) {
+        if (m_pipeline->inFlight > 0) {
+            FMUS_LOG_ERROR("RealTimeProcessor: processBuffer() called with pushed blocks in flight");
+            return std::vector<T>();
+        }
+        // Keep the first queue topped up and drain the last one, so the
+        // stages work on consecutive blocks at the same time
+        std::vector<T> output(input.size());
+        std::vector<T> block;
+        size_t sent = 0;
+        size_t received = 0;
+        uint32_t idle = 0;
+        while (received < input.size()) {
+            bool progress = false;
+            if (sent < input.size()) {
+                size_t count = std::min<size_t>(m_bufferSize, input.size() - sent);
+                if (pushBlock(input.data() + sent, count)) {
+                    sent += count;
+                    progress = true;
+                }
+            }
+            if (popBlock(block)) {
+                std::copy(block.begin(), block.end(), output.begin() + received);
+                received += block.size();
+                progress = true;
+            }
+            if (progress) {
+                idle = 0;
+            } else {
+                pipelineBackoff(idle);
+            }
+        }
+        return output;
+    }
 
-    for (const T& sample : input) {
-        output.push_back(processSample(sample));
+    // Each filter runs over the whole buffer in turn
+    std::vector<T> output(input);
+    for (auto& filter : m_filters) {
+        filter->processBlock(output.data(), output.size());
     }
 
     return output;
@@ -404,6 +785,22 @@ std::vector<T> RealTimeProcessor<T>::processBuffer(const std::vector<T>& input)
 
 template<typename T>
 void RealTimeProcessor<T>::reset() {
+    if (m_pipeline) {
+        // The stage threads own the filters, so stop them around the reset
+        const uint32_t stageCount = static_cast<uint32_t>(m_pipeline->stages.size());
+        const uint32_t queueDepth = static_cast<uint32_t>(m_pipeline->queues.front()->capacity());
+        stopPipeline();
+        for (auto& filter : m_filters) {
+            filter->reset();
+        }
+        auto result = startPipeline(stageCount, queueDepth);
+        if (!result.isOk()) {
+            FMUS_LOG_ERROR("RealTimeProcessor: failed to restart pipeline after reset: " +
+                           result.error().message());
+        }
+        return;
+    }
+
     for (auto& filter : m_filters) {
         filter->reset();
     }
@@ -418,11 +815,11 @@ std::string getDSPStatus() {
     std::ostringstream oss;
     oss << "DSP Module Status:\n";
     oss << "  Initialized: " << (g_dspInitialized ? "Yes" : "No") << "\n";
-    oss << "  Available Filters: Low-pass, High-pass, Band-pass, Moving Average, Median, Kalman\n";
-    oss << "  FFT Support: Radix-2, Real/Complex, Forward/Inverse\n";
+    oss << "  Available Filters: Low-pass, High-pass, Band-pass, Moving Average, Median, Kalman, FFT convolution (FIR)\n";
+    oss << "  FFT Support: Radix-4 (" << simdLevelToString(detectSimdLevel()) << "), Real/Complex, Forward/Inverse\n";
     oss << "  Window Functions: Hanning, Hamming, Blackman, Kaiser, Gaussian, Tukey\n";
-    oss << "  Signal Generation: Sine, Cosine, Square, Sawtooth, Triangle, White Noise, Chirp\n";
-    oss << "  Analysis Tools: Spectral analysis, Peak detection, THD, SNR, Centroid";
+    oss << "  Signal Generation: Sine, Cosine, Square, Sawtooth, Triangle, White Noise, Chirp (streaming NCO)\n";
+    oss << "  Analysis Tools: Spectral analysis, Peak detection, THD, SNR, Centroid, Sliding DFT bank";
     return oss.str();
 }
 
@@ -430,13 +827,18 @@ std::string getDSPStatus() {
 // Explicit Template Instantiations
 //=============================================================================
 
+template class RunningStats<float>;
+template class RunningStats<double>;
+
 template SignalStats<float> calculateSignalStats<float>(const std::vector<float>&);
 template SignalStats<double> calculateSignalStats<double>(const std::vector<double>&);
+template SignalStats<float> calculateSignalStats<float>(const float*, size_t, WorkerPool&);
+template SignalStats<double> calculateSignalStats<double>(const double*, size_t, WorkerPool&);
 
-template std::vector<float> crossCorrelation<float>(const std::vector<float>&, const std::vector<float>&);
-template std::vector<double> crossCorrelation<double>(const std::vector<double>&, const std::vector<double>&);
-template std::vector<float> autoCorrelation<float>(const std::vector<float>&);
-template std::vector<double> autoCorrelation<double>(const std::vector<double>&);
+template std::vector<float> crossCorrelation<float>(const std::vector<float>&, const std::vector<float>&, CorrelationMethod);
+template std::vector<double> crossCorrelation<double>(const std::vector<double>&, const std::vector<double>&, CorrelationMethod);
+template std::vector<float> autoCorrelation<float>(const std::vector<float>&, CorrelationMethod);
+template std::vector<double> autoCorrelation<double>(const std::vector<double>&, CorrelationMethod);
 
 template core::Result<std::vector<float>> resample<float>(const std::vector<float>&, float, float);
 template core::Result<std::vector<double>> resample<double>(const std::vector<double>&, double, double);
@@ -1,12 +1,514 @@
 #include "fmus/dsp/fft.h"
+#include "fmus/dsp/spectral_features.h"
 #include "fmus/core/logging.h"
+#include "fft_kernels.h"
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <tuple>
 
 namespace fmus {
 namespace dsp {
 
+//=============================================================================
+// FFTPlan Implementation
+//=============================================================================
+
+namespace {
+
+template<typename Plan>
+struct PlanCache {
+    std::mutex mutex;
+    std::map<std::pair<uint32_t, FFTDirection>, std::shared_ptr<const Plan>> plans;
+};
+
+template<typename Plan>
+PlanCache<Plan>& planCache() {
+    static PlanCache<Plan> cache;
+    return cache;
+}
+
+template<typename Plan>
+std::shared_ptr<const Plan> getCachedPlan(uint32_t size, FFTDirection direction) {
+    auto& cache = planCache<Plan>();
+    auto key = std::make_pair(size, direction);
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.plans.find(key);
+        if (it != cache.plans.end()) {
+            return it->second;
+        }
+    }
+
+    // Build outside the lock: plans may fetch other cached plans while
+    // constructing (e.g. Bluestein's power-of-2 convolution plans)
+    auto plan = std::make_shared<const Plan>(size, direction);
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.plans.emplace(key, std::move(plan)).first->second;
+}
+
+template<typename Plan>
+void clearCachedPlans() {
+    auto& cache = planCache<Plan>();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.plans.clear();
+}
+
+template<typename T>
+std::vector<T>& threadWorkspace(size_t size) {
+    thread_local std::vector<T> workspace;
+    if (workspace.size() < size) {
+        workspace.resize(size);
+    }
+    return workspace;
+}
+
+// Split n into (radix, remaining length) pairs: 4s first, then 2, then odd
+// primes. Returns false for n < 2 or if a prime factor exceeds MAX_MIXED_RADIX.
+bool factorize(uint32_t n, std::vector<uint32_t>& factors) {
+    factors.clear();
+    if (n < 2) {
+        return false;
+    }
+    uint32_t remaining = n;
+    uint32_t radix = 4;
+
+    while (remaining > 1) {
+        while (remaining % radix != 0) {
+            radix = (radix == 4) ? 2 : (radix == 2) ? 3 : radix + 2;
+            if (radix > internal::MAX_MIXED_RADIX) {
+                return false;
+            }
+        }
+        remaining /= radix;
+        factors.push_back(radix);
+        factors.push_back(remaining);
+    }
+    return true;
+}
+
+uint32_t log2Floor(uint32_t n) {
+    uint32_t bits = 0;
+    while (n >>= 1) {
+        ++bits;
+    }
+    return bits;
+}
+
+} // anonymous namespace
+
+template<typename T>
+FFTAlgorithm FFTPlan<T>::selectAlgorithm(uint32_t size) {
+    if (FFT::isValidSize(size)) {
+        return FFTAlgorithm::Radix4;
+    }
+
+    std::vector<uint32_t> factors;
+    if (!factorize(size, factors)) {
+        return FFTAlgorithm::Bluestein;
+    }
+
+    // Rough operation counts: each mixed-radix stage of radix p costs about
+    // p per point; Bluestein runs two SIMD power-of-2 transforms of size M
+    // plus pointwise chirp products
+    uint64_t mixedCost = 0;
+    for (size_t i = 0; i < factors.size(); i += 2) {
+        mixedCost += static_cast<uint64_t>(size) * factors[i];
+    }
+    uint64_t m = FFT::nextPowerOf2(2 * size - 1);
+    uint64_t bluesteinCost = m * log2Floor(static_cast<uint32_t>(m)) + 4 * m;
+
+    return (mixedCost <= bluesteinCost) ? FFTAlgorithm::MixedRadix : FFTAlgorithm::Bluestein;
+}
+
+template<typename T>
+FFTPlan<T>::FFTPlan(uint32_t size, FFTDirection direction, SimdLevel simd, FFTAlgorithm algorithm)
+    : m_size(size), m_direction(direction), m_simdLevel(simd),
+      m_algorithm(algorithm), m_workspaceSize(0) {
+    if (size == 0) {
+        FMUS_LOG_ERROR("FFTPlan size must be at least 1");
+        return;
+    }
+
+    if (!isSimdLevelSupported(simd)) {
+        FMUS_LOG_WARNING("FFTPlan: requested SIMD level not supported, using detected level");
+        m_simdLevel = detectSimdLevel();
+    }
+
+    if ((algorithm == FFTAlgorithm::Radix4 && !FFT::isValidSize(size)) ||
+        (algorithm == FFTAlgorithm::MixedRadix && !factorize(size, m_factors))) {
+        FMUS_LOG_WARNING("FFTPlan: requested algorithm cannot handle this size, selecting automatically");
+        m_algorithm = FFTAlgorithm::Auto;
+    }
+    if (m_algorithm == FFTAlgorithm::Auto) {
+        m_algorithm = selectAlgorithm(size);
+    }
+
+    double sign = (direction == FFTDirection::Inverse) ? 1.0 : -1.0;
+
+    if (m_algorithm == FFTAlgorithm::Radix4) {
+        m_workspaceSize = 2 * static_cast<size_t>(size);
+
+        internal::buildBitReverse(size, m_bitReverse);
+        internal::buildRadix4Twiddles(size, direction == FFTDirection::Inverse, m_twiddles);
+    } else if (m_algorithm == FFTAlgorithm::MixedRadix) {
+        m_workspaceSize = 2 * static_cast<size_t>(size);
+        factorize(size, m_factors);
+
+        m_roots.reserve(size);
+        for (uint32_t t = 0; t < size; ++t) {
+            double angle = sign * 2.0 * M_PI * static_cast<double>(t) / static_cast<double>(size);
+            m_roots.emplace_back(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+        }
+    } else {
+        uint32_t m = FFT::nextPowerOf2(2 * size - 1);
+        m_workspaceSize = 2 * static_cast<size_t>(m);
+        m_convolutionPlan = FFTPlan<T>::get(m, FFTDirection::Forward);
+        m_convolutionInverse = FFTPlan<T>::get(m, FFTDirection::Inverse);
+
+        // Chirp exp(-+i*pi*t^2/N); t^2 is reduced mod 2N to keep the angle small
+        m_chirp.reserve(size);
+        for (uint32_t t = 0; t < size; ++t) {
+            uint64_t t2 = (static_cast<uint64_t>(t) * t) % (2 * static_cast<uint64_t>(size));
+            double angle = sign * M_PI * static_cast<double>(t2) / static_cast<double>(size);
+            m_chirp.emplace_back(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+        }
+
+        // Spectrum of the symmetric filter conj(chirp), wrapped around M
+        m_chirpSpectrum.assign(2 * static_cast<size_t>(m), 0);
+        T* filterRe = m_chirpSpectrum.data();
+        T* filterIm = filterRe + m;
+        for (uint32_t t = 0; t < size; ++t) {
+            filterRe[t] = m_chirp[t].real();
+            filterIm[t] = -m_chirp[t].imag();
+            if (t > 0) {
+                filterRe[m - t] = filterRe[t];
+                filterIm[m - t] = filterIm[t];
+            }
+        }
+        m_convolutionPlan->execute(filterRe, filterIm);
+    }
+}
+
+template<typename T>
+std::shared_ptr<const FFTPlan<T>> FFTPlan<T>::get(uint32_t size, FFTDirection direction) {
+    if (size == 0) {
+        FMUS_LOG_ERROR("FFTPlan size must be at least 1");
+        return nullptr;
+    }
+    return getCachedPlan<FFTPlan<T>>(size, direction);
+}
+
+template<typename T>
+void FFTPlan<T>::clearCache() {
+    clearCachedPlans<FFTPlan<T>>();
+}
+
+template<typename T>
+void FFTPlan<T>::runStages(T* real, T* imag) const {
+    const uint32_t n = m_size;
+    const bool inverse = (m_direction == FFTDirection::Inverse);
+
+    uint32_t h = 1;
+    if ((n & 0xAAAAAAAAu) != 0) {
+        // Odd power of 2: one radix-2 stage with unit twiddles first
+        internal::radix2FirstStage(real, imag, n);
+        h = 2;
+    }
+
+    const T* tw = m_twiddles.data();
+    for (; h < n; h *= 4) {
+        internal::radix4Stage(m_simdLevel, real, imag, n, h, tw, inverse);
+        tw += 6 * static_cast<size_t>(h);
+    }
+}
+
+template<typename T>
+void FFTPlan<T>::executeMixedRadix(std::complex<T>* data, T* workspace) const {
+    const uint32_t n = m_size;
+    std::complex<T>* input = reinterpret_cast<std::complex<T>*>(workspace);
+    std::copy(data, data + n, input);
+
+    internal::mixedRadixTransform(input, data, m_factors.data(), m_roots.data(),
+                                  m_direction == FFTDirection::Inverse);
+
+    if (m_direction == FFTDirection::Inverse) {
+        T scale = static_cast<T>(1.0) / n;
+        for (uint32_t i = 0; i < n; ++i) {
+            data[i] *= scale;
+        }
+    }
+}
+
+template<typename T>
+void FFTPlan<T>::executeBluestein(std::complex<T>* data, T* workspace) const {
+    const uint32_t n = m_size;
+    const uint32_t m = m_convolutionPlan->getSize();
+    T* real = workspace;
+    T* imag = workspace + m;
+
+    // a[t] = x[t] * chirp[t], zero-padded to M
+    for (uint32_t t = 0; t < n; ++t) {
+        const std::complex<T>& x = data[t];
+        const std::complex<T>& c = m_chirp[t];
+        real[t] = x.real() * c.real() - x.imag() * c.imag();
+        imag[t] = x.real() * c.imag() + x.imag() * c.real();
+    }
+    std::fill(real + n, real + m, static_cast<T>(0));
+    std::fill(imag + n, imag + m, static_cast<T>(0));
+
+    // Circular convolution with the conjugate chirp
+    m_convolutionPlan->execute(real, imag);
+    const T* filterRe = m_chirpSpectrum.data();
+    const T* filterIm = filterRe + m;
+    for (uint32_t k = 0; k < m; ++k) {
+        T re = real[k] * filterRe[k] - imag[k] * filterIm[k];
+        T im = real[k] * filterIm[k] + imag[k] * filterRe[k];
+        real[k] = re;
+        imag[k] = im;
+    }
+    m_convolutionInverse->execute(real, imag);
+
+    // X[k] = chirp[k] * conv[k]
+    T scale = (m_direction == FFTDirection::Inverse) ? static_cast<T>(1.0) / n : static_cast<T>(1.0);
+    for (uint32_t k = 0; k < n; ++k) {
+        const std::complex<T>& c = m_chirp[k];
+        data[k] = std::complex<T>((real[k] * c.real() - imag[k] * c.imag()) * scale,
+                                  (real[k] * c.imag() + imag[k] * c.real()) * scale);
+    }
+}
+
+template<typename T>
+void FFTPlan<T>::execute(std::complex<T>* data, T* workspace) const {
+    if (m_algorithm == FFTAlgorithm::MixedRadix) {
+        executeMixedRadix(data, workspace);
+        return;
+    }
+    if (m_algorithm == FFTAlgorithm::Bluestein) {
+        executeBluestein(data, workspace);
+        return;
+    }
+
+    const uint32_t n = m_size;
+    T* real = workspace;
+    T* imag = workspace + n;
+
+    // Gather into split format in bit-reversed order
+    for (uint32_t i = 0; i < n; ++i) {
+        const std::complex<T>& sample = data[m_bitReverse[i]];
+        real[i] = sample.real();
+        imag[i] = sample.imag();
+    }
+
+    runStages(real, imag);
+
+    // Scale for inverse transform
+    T scale = (m_direction == FFTDirection::Inverse) ? static_cast<T>(1.0) / n : static_cast<T>(1.0);
+    for (uint32_t i = 0; i < n; ++i) {
+        data[i] = std::complex<T>(real[i] * scale, imag[i] * scale);
+    }
+}
+
+template<typename T>
+void FFTPlan<T>::execute(std::complex<T>* data) const {
+    auto& workspace = threadWorkspace<T>(m_workspaceSize);
+    execute(data, workspace.data());
+}
+
+template<typename T>
+void FFTPlan<T>::execute(T* real, T* imag) const {
+    const uint32_t n = m_size;
+
+    if (m_algorithm != FFTAlgorithm::Radix4) {
+        // Other algorithms work on interleaved data; pack behind the workspace
+        auto& workspace = threadWorkspace<T>(m_workspaceSize + 2 * static_cast<size_t>(n));
+        std::complex<T>* packed = reinterpret_cast<std::complex<T>*>(workspace.data() + m_workspaceSize);
+        for (uint32_t i = 0; i < n; ++i) {
+            packed[i] = std::complex<T>(real[i], imag[i]);
+        }
+        execute(packed, workspace.data());
+        for (uint32_t i = 0; i < n; ++i) {
+            real[i] = packed[i].real();
+            imag[i] = packed[i].imag();
+        }
+        return;
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        uint32_t j = m_bitReverse[i];
+        if (i < j) {
+            std::swap(real[i], real[j]);
+            std::swap(imag[i], imag[j]);
+        }
+    }
+
+    runStages(real, imag);
+
+    if (m_direction == FFTDirection::Inverse) {
+        T scale = static_cast<T>(1.0) / n;
+        for (uint32_t i = 0; i < n; ++i) {
+            real[i] *= scale;
+            imag[i] *= scale;
+        }
+    }
+}
+
+template<typename T>
+void FFTPlan<T>::execute(std::vector<std::complex<T>>& data) const {
+    if (data.size() != m_size || m_size == 0) {
+        FMUS_LOG_ERROR("FFTPlan data size does not match plan size");
+        return;
+    }
+    execute(data.data());
+}
+
+//=============================================================================
+// RealFFTPlan Implementation
+//=============================================================================
+
+template<typename T>
+RealFFTPlan<T>::RealFFTPlan(uint32_t size, FFTDirection direction)
+    : m_size(size), m_direction(direction) {
+    if (size < 2 || (size & 1) != 0) {
+        FMUS_LOG_ERROR("RealFFTPlan size must be even and at least 2");
+        m_size = 0;
+        return;
+    }
+
+    m_halfPlan = FFTPlan<T>::get(size / 2, direction);
+
+    double sign = (direction == FFTDirection::Inverse) ? 1.0 : -1.0;
+    uint32_t quarter = size / 4;
+    m_twiddles.reserve(quarter + 1);
+    for (uint32_t k = 0; k <= quarter; ++k) {
+        double angle = sign * 2.0 * M_PI * static_cast<double>(k) / static_cast<double>(size);
+        m_twiddles.emplace_back(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+    }
+}
+
+template<typename T>
+std::shared_ptr<const RealFFTPlan<T>> RealFFTPlan<T>::get(uint32_t size, FFTDirection direction) {
+    if (size < 2 || (size & 1) != 0) {
+        FMUS_LOG_ERROR("RealFFTPlan size must be even and at least 2");
+        return nullptr;
+    }
+    return getCachedPlan<RealFFTPlan<T>>(size, direction);
+}
+
+template<typename T>
+void RealFFTPlan<T>::clearCache() {
+    clearCachedPlans<RealFFTPlan<T>>();
+}
+
+template<typename T>
+void RealFFTPlan<T>::execute(const T* input, std::complex<T>* output) const {
+    auto& workspace = threadWorkspace<T>(getWorkspaceSize());
+    execute(input, output, workspace.data());
+}
+
+template<typename T>
+void RealFFTPlan<T>::execute(const std::complex<T>* input, T* output) const {
+    auto& workspace = threadWorkspace<T>(getWorkspaceSize());
+    execute(input, output, workspace.data());
+}
+
+template<typename T>
+void RealFFTPlan<T>::execute(const T* input, std::complex<T>* output, T* workspace) const {
+    if (m_direction != FFTDirection::Forward || m_size == 0) {
+        FMUS_LOG_ERROR("RealFFTPlan: forward execute called on an inverse or invalid plan");
+        return;
+    }
+
+    const uint32_t half = m_size / 2;
+    const std::complex<T> minusHalfI(0, static_cast<T>(-0.5));
+
+    // Pack z[n] = x[2n] + i*x[2n+1] and transform at half length
+    for (uint32_t n = 0; n < half; ++n) {
+        output[n] = std::complex<T>(input[2 * n], input[2 * n + 1]);
+    }
+    m_halfPlan->execute(output, workspace);
+
+    // Untangle even/odd spectra: X[k] = E[k] + W^k * O[k], X[M-k] = conj(E[k] - W^k * O[k])
+    std::complex<T> z0 = output[0];
+    output[0] = std::complex<T>(z0.real() + z0.imag(), 0);
+    output[half] = std::complex<T>(z0.real() - z0.imag(), 0);
+
+    for (uint32_t k = 1; k <= half / 2; ++k) {
+        std::complex<T> zk = output[k];
+        std::complex<T> zmk = std::conj(output[half - k]);
+        std::complex<T> even = (zk + zmk) * static_cast<T>(0.5);
+        std::complex<T> odd = (zk - zmk) * minusHalfI * m_twiddles[k];
+        output[k] = even + odd;
+        output[half - k] = std::conj(even - odd);
+    }
+}
+
+template<typename T>
+void RealFFTPlan<T>::execute(const std::complex<T>* input, T* output, T* workspace) const {
+    if (m_direction != FFTDirection::Inverse || m_size == 0) {
+        FMUS_LOG_ERROR("RealFFTPlan: inverse execute called on a forward or invalid plan");
+        return;
+    }
+
+    const uint32_t half = m_size / 2;
+    const std::complex<T> halfI(0, static_cast<T>(0.5));
+
+    // The real output buffer doubles as the packed half-length complex buffer
+    std::complex<T>* packed = reinterpret_cast<std::complex<T>*>(output);
+
+    // Re-tangle: Z[k] = E[k] + i*O[k], Z[M-k] = conj(E[k] - i*O[k])
+    T x0 = input[0].real();
+    T xm = input[half].real();
+    packed[0] = std::complex<T>((x0 + xm) * static_cast<T>(0.5), (x0 - xm) * static_cast<T>(0.5));
+
+    for (uint32_t k = 1; k <= half / 2; ++k) {
+        std::complex<T> xk = input[k];
+        std::complex<T> xmk = std::conj(input[half - k]);
+        std::complex<T> even = (xk + xmk) * static_cast<T>(0.5);
+        std::complex<T> odd = (xk - xmk) * halfI * m_twiddles[k];
+        packed[k] = even + odd;
+        packed[half - k] = std::conj(even - odd);
+    }
+
+    // Inverse half-length transform leaves x[2n] + i*x[2n+1] in place
+    m_halfPlan->execute(packed, workspace);
+}
+
+//=============================================================================
+// FFTWorkspace Implementation
+//=============================================================================
+
+template<typename T>
+FFTWorkspace<T>::FFTWorkspace(uint32_t size, WindowType window)
+    : m_size(size), m_window(window) {
+    if (size == 0) {
+        FMUS_LOG_ERROR("FFTWorkspace size must be at least 1");
+        return;
+    }
+
+    m_forwardPlan = FFTPlan<T>::get(size, FFTDirection::Forward);
+    m_inversePlan = FFTPlan<T>::get(size, FFTDirection::Inverse);
+    size_t scratchSize = std::max(m_forwardPlan->getWorkspaceSize(), m_inversePlan->getWorkspaceSize());
+
+    if (size % 2 == 0) {
+        m_realForwardPlan = RealFFTPlan<T>::get(size, FFTDirection::Forward);
+        m_realInversePlan = RealFFTPlan<T>::get(size, FFTDirection::Inverse);
+        scratchSize = std::max(scratchSize, m_realForwardPlan->getWorkspaceSize());
+        scratchSize = std::max(scratchSize, m_realInversePlan->getWorkspaceSize());
+    }
+
+    if (window != WindowType::None) {
+        m_windowCoeffs = FFT::getWindow<T>(size, window);
+    }
+    m_samples.resize(size);
+    m_buffer.resize(size);
+    m_scratch.resize(scratchSize);
+}
+
 //=============================================================================
 // FFTResult Implementation
 //=============================================================================
@@ -60,7 +562,11 @@ std::vector<T> FFTResult<T>::getPowerSpectralDensity() const {
     // DC and Nyquist components should not be doubled
     if (!power.empty()) {
         power[0] /= 2;
-        if (power.size() % 2 == 0) {
+        if (isOneSided()) {
+            if (size % 2 == 0 && power.size() > 1) {
+                power.back() /= 2;
+            }
+        } else if (power.size() % 2 == 0) {
             power[power.size() / 2] /= 2;
         }
     }
@@ -86,20 +592,24 @@ std::vector<T> FFTResult<T>::getFrequencyBins() const {
 //=============================================================================
 
 template<typename T>
-core::Result<FFTResult<T>> FFT::forward(const std::vector<T>& input, T sampleRate, WindowType window) {
+core::Result<FFTResult<T>> FFT::forward(const std::vector<T>& input, T sampleRate, WindowType window,
+                                        FFTPadding padding) {
     if (input.empty()) {
         return core::makeError<FFTResult<T>>(core::ErrorCode::InvalidArgument, "Input signal is empty");
     }
     
-    // Ensure input size is power of 2
-    uint32_t fftSize = nextPowerOf2(static_cast<uint32_t>(input.size()));
+    uint32_t fftSize = static_cast<uint32_t>(input.size());
+    if (padding == FFTPadding::NextPowerOf2) {
+        fftSize = nextPowerOf2(fftSize);
+    }
     std::vector<T> paddedInput = zeroPad(input, fftSize);
     
     // Apply window function
     if (window != WindowType::None) {
-        auto windowCoeffs = generateWindow<T>(fftSize, window);
+        auto windowCoeffs = getWindow<T>(fftSize, window);
+        const T* coeffs = windowCoeffs->data();
         for (size_t i = 0; i < paddedInput.size(); ++i) {
-            paddedInput[i] *= windowCoeffs[i];
+            paddedInput[i] *= coeffs[i];
         }
     }
     
@@ -111,7 +621,7 @@ core::Result<FFTResult<T>> FFT::forward(const std::vector<T>& input, T sampleRat
     }
     
     // Perform FFT
-    radix2FFT(complexData, false);
+    transform(complexData, false);
     
     // Create result
     FFTResult<T> result;
@@ -125,26 +635,30 @@ core::Result<FFTResult<T>> FFT::forward(const std::vector<T>& input, T sampleRat
 }
 
 template<typename T>
-core::Result<FFTResult<T>> FFT::forward(const std::vector<std::complex<T>>& input, T sampleRate, WindowType window) {
+core::Result<FFTResult<T>> FFT::forward(const std::vector<std::complex<T>>& input, T sampleRate, WindowType window,
+                                        FFTPadding padding) {
     if (input.empty()) {
         return core::makeError<FFTResult<T>>(core::ErrorCode::InvalidArgument, "Input signal is empty");
     }
     
-    // Ensure input size is power of 2
-    uint32_t fftSize = nextPowerOf2(static_cast<uint32_t>(input.size()));
+    uint32_t fftSize = static_cast<uint32_t>(input.size());
+    if (padding == FFTPadding::NextPowerOf2) {
+        fftSize = nextPowerOf2(fftSize);
+    }
     std::vector<std::complex<T>> paddedInput = input;
     paddedInput.resize(fftSize, std::complex<T>(0, 0));
     
     // Apply window function to real part (simplified)
     if (window != WindowType::None) {
-        auto windowCoeffs = generateWindow<T>(fftSize, window);
+        auto windowCoeffs = getWindow<T>(fftSize, window);
+        const T* coeffs = windowCoeffs->data();
         for (size_t i = 0; i < paddedInput.size(); ++i) {
-            paddedInput[i] *= windowCoeffs[i];
+            paddedInput[i] *= coeffs[i];
         }
     }
     
     // Perform FFT
-    radix2FFT(paddedInput, false);
+    transform(paddedInput, false);
     
     // Create result
     FFTResult<T> result;
@@ -157,6 +671,82 @@ core::Result<FFTResult<T>> FFT::forward(const std::vector<std::complex<T>>& inpu
     return core::makeOk<FFTResult<T>>(std::move(result));
 }
 
+template<typename T>
+core::Result<FFTResult<T>> FFT::forwardReal(const std::vector<T>& input, T sampleRate, WindowType window,
+                                            FFTPadding padding) {
+    if (input.empty()) {
+        return core::makeError<FFTResult<T>>(core::ErrorCode::InvalidArgument, "Input signal is empty");
+    }
+    
+    uint32_t fftSize = static_cast<uint32_t>(input.size());
+    if (padding == FFTPadding::NextPowerOf2) {
+        // The packed transform needs at least 2 samples
+        fftSize = nextPowerOf2(std::max<uint32_t>(fftSize, 2));
+    }
+    std::vector<T> paddedInput = zeroPad(input, fftSize);
+    
+    // Apply window function
+    if (window != WindowType::None) {
+        auto windowCoeffs = getWindow<T>(fftSize, window);
+        const T* coeffs = windowCoeffs->data();
+        for (size_t i = 0; i < paddedInput.size(); ++i) {
+            paddedInput[i] *= coeffs[i];
+        }
+    }
+    
+    FFTResult<T> result;
+    result.data.resize(fftSize / 2 + 1);
+    
+    if (fftSize % 2 == 0) {
+        auto plan = RealFFTPlan<T>::get(fftSize, FFTDirection::Forward);
+        plan->execute(paddedInput.data(), result.data.data());
+    } else {
+        // Odd lengths cannot be packed; run the full complex transform
+        std::vector<std::complex<T>> complexData(paddedInput.begin(), paddedInput.end());
+        transform(complexData, false);
+        std::copy(complexData.begin(), complexData.begin() + result.data.size(), result.data.begin());
+    }
+    
+    result.sampleRate = sampleRate;
+    result.frequencyResolution = sampleRate / static_cast<T>(fftSize);
+    result.size = fftSize;
+    result.windowUsed = window;
+    
+    return core::makeOk<FFTResult<T>>(std::move(result));
+}
+
+template<typename T>
+core::Result<std::vector<T>> FFT::inverseReal(const std::vector<std::complex<T>>& input, uint32_t size) {
+    if (input.size() < 2) {
+        return core::makeError<std::vector<T>>(core::ErrorCode::InvalidArgument, "One-sided spectrum needs at least 2 bins");
+    }
+    
+    uint32_t fftSize = (size == 0) ? static_cast<uint32_t>(input.size() - 1) * 2 : size;
+    if (fftSize / 2 + 1 != input.size()) {
+        return core::makeError<std::vector<T>>(core::ErrorCode::InvalidArgument, "One-sided spectrum must have size/2+1 bins");
+    }
+    
+    std::vector<T> result(fftSize);
+    
+    if (fftSize % 2 == 0) {
+        auto plan = RealFFTPlan<T>::get(fftSize, FFTDirection::Inverse);
+        plan->execute(input.data(), result.data());
+    } else {
+        // Rebuild the Hermitian spectrum and run the full complex transform
+        std::vector<std::complex<T>> data(fftSize);
+        std::copy(input.begin(), input.end(), data.begin());
+        for (uint32_t k = 1; k < input.size(); ++k) {
+            data[fftSize - k] = std::conj(input[k]);
+        }
+        transform(data, true);
+        for (uint32_t i = 0; i < fftSize; ++i) {
+            result[i] = data[i].real();
+        }
+    }
+    
+    return core::makeOk<std::vector<T>>(std::move(result));
+}
+
 template<typename T>
 core::Result<std::vector<T>> FFT::inverse(const std::vector<std::complex<T>>& input) {
     if (input.empty()) {
@@ -164,7 +754,7 @@ core::Result<std::vector<T>> FFT::inverse(const std::vector<std::complex<T>>& in
     }
     
     std::vector<std::complex<T>> data = input;
-    radix2FFT(data, true);
+    transform(data, true);
     
     // Extract real part
     std::vector<T> result;
@@ -183,11 +773,105 @@ core::Result<std::vector<std::complex<T>>> FFT::inverseComplex(const std::vector
     }
     
     std::vector<std::complex<T>> data = input;
-    radix2FFT(data, true);
+    transform(data, true);
     
     return core::makeOk<std::vector<std::complex<T>>>(std::move(data));
 }
 
+namespace {
+
+// Copy input into the workspace sample buffer, zero-padding and windowing
+template<typename T>
+bool stageInput(const T* input, uint32_t inputSize, std::vector<T>& samples,
+                const std::shared_ptr<const std::vector<T>>& windowCoeffs) {
+    if (input == nullptr || inputSize == 0 || inputSize > samples.size()) {
+        return false;
+    }
+
+    std::copy(input, input + inputSize, samples.begin());
+    std::fill(samples.begin() + inputSize, samples.end(), static_cast<T>(0));
+    if (windowCoeffs) {
+        const T* coeffs = windowCoeffs->data();
+        for (uint32_t i = 0; i < inputSize; ++i) {
+            samples[i] *= coeffs[i];
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+template<typename T>
+core::Result<void> FFT::forward(const T* input, uint32_t inputSize,
+                                std::complex<T>* output, FFTWorkspace<T>& workspace) {
+    if (output == nullptr || workspace.m_size == 0) {
+        return core::makeError(core::ErrorCode::InvalidArgument, "Invalid output buffer or workspace");
+    }
+    if (!stageInput(input, inputSize, workspace.m_samples, workspace.m_windowCoeffs)) {
+        return core::makeError(core::ErrorCode::InvalidArgument, "Input must hold 1 to workspace size samples");
+    }
+
+    const uint32_t n = workspace.m_size;
+    for (uint32_t i = 0; i < n; ++i) {
+        output[i] = std::complex<T>(workspace.m_samples[i], 0);
+    }
+    workspace.m_forwardPlan->execute(output, workspace.m_scratch.data());
+
+    return core::makeOk();
+}
+
+template<typename T>
+core::Result<void> FFT::forwardReal(const T* input, uint32_t inputSize,
+                                    std::complex<T>* output, FFTWorkspace<T>& workspace) {
+    if (output == nullptr || workspace.m_size == 0) {
+        return core::makeError(core::ErrorCode::InvalidArgument, "Invalid output buffer or workspace");
+    }
+    if (!stageInput(input, inputSize, workspace.m_samples, workspace.m_windowCoeffs)) {
+        return core::makeError(core::ErrorCode::InvalidArgument, "Input must hold 1 to workspace size samples");
+    }
+
+    const uint32_t n = workspace.m_size;
+    if (workspace.m_realForwardPlan) {
+        workspace.m_realForwardPlan->execute(workspace.m_samples.data(), output, workspace.m_scratch.data());
+    } else {
+        // Odd lengths cannot be packed; run the full complex transform
+        std::complex<T>* buffer = workspace.m_buffer.data();
+        for (uint32_t i = 0; i < n; ++i) {
+            buffer[i] = std::complex<T>(workspace.m_samples[i], 0);
+        }
+        workspace.m_forwardPlan->execute(buffer, workspace.m_scratch.data());
+        std::copy(buffer, buffer + n / 2 + 1, output);
+    }
+
+    return core::makeOk();
+}
+
+template<typename T>
+core::Result<void> FFT::inverseReal(const std::complex<T>* input, T* output, FFTWorkspace<T>& workspace) {
+    if (input == nullptr || output == nullptr || workspace.m_size == 0) {
+        return core::makeError(core::ErrorCode::InvalidArgument, "Invalid buffers or workspace");
+    }
+
+    const uint32_t n = workspace.m_size;
+    if (workspace.m_realInversePlan) {
+        workspace.m_realInversePlan->execute(input, output, workspace.m_scratch.data());
+    } else {
+        // Rebuild the Hermitian spectrum and run the full complex transform
+        std::complex<T>* buffer = workspace.m_buffer.data();
+        const uint32_t bins = n / 2 + 1;
+        std::copy(input, input + bins, buffer);
+        for (uint32_t k = 1; k < bins; ++k) {
+            buffer[n - k] = std::conj(input[k]);
+        }
+        workspace.m_inversePlan->execute(buffer, workspace.m_scratch.data());
+        for (uint32_t i = 0; i < n; ++i) {
+            output[i] = buffer[i].real();
+        }
+    }
+
+    return core::makeOk();
+}
+
 bool FFT::isValidSize(uint32_t size) {
     return size > 0 && (size & (size - 1)) == 0;
 }
@@ -215,19 +899,107 @@ std::vector<T> FFT::zeroPad(const std::vector<T>& signal, uint32_t targetSize) {
 
 template<typename T>
 std::vector<T> FFT::applyWindow(const std::vector<T>& signal, WindowType window, T parameter) {
-    auto windowCoeffs = generateWindow<T>(static_cast<uint32_t>(signal.size()), window, parameter);
+    auto windowCoeffs = getWindow<T>(static_cast<uint32_t>(signal.size()), window, parameter);
+    const T* coeffs = windowCoeffs->data();
     std::vector<T> windowed = signal;
     
     for (size_t i = 0; i < signal.size(); ++i) {
-        windowed[i] *= windowCoeffs[i];
+        windowed[i] *= coeffs[i];
     }
     
     return windowed;
 }
 
+namespace {
+
+// Windows of both data types share one lock and one set of counters
+struct WindowCache {
+    std::mutex mutex;
+    std::map<std::tuple<uint32_t, WindowType, float>, std::shared_ptr<const std::vector<float>>> floatWindows;
+    std::map<std::tuple<uint32_t, WindowType, double>, std::shared_ptr<const std::vector<double>>> doubleWindows;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+
+    auto& windows(float) { return floatWindows; }
+    auto& windows(double) { return doubleWindows; }
+};
+
+// Bound on distinct windows kept alive; continuous parameters (e.g. Kaiser
+// beta sweeps) would otherwise grow the cache without limit
+static const size_t MAX_CACHED_WINDOWS = 256;
+
+WindowCache& windowCache() {
+    static WindowCache cache;
+    return cache;
+}
+
+// Parameter a window is actually generated with: 0 selects the default,
+// and windows without a parameter ignore it
+template<typename T>
+T effectiveWindowParameter(WindowType window, T parameter) {
+    switch (window) {
+        case WindowType::Kaiser:
+            return (parameter == 0) ? static_cast<T>(5) : parameter;   // beta
+        case WindowType::Gaussian:
+            return (parameter == 0) ? static_cast<T>(0.4) : parameter; // sigma
+        case WindowType::Tukey:
+            return (parameter == 0) ? static_cast<T>(0.5) : parameter; // alpha
+        default:
+            return 0;
+    }
+}
+
+} // anonymous namespace
+
+template<typename T>
+std::shared_ptr<const std::vector<T>> FFT::getWindow(uint32_t size, WindowType window, T parameter) {
+    auto& cache = windowCache();
+    auto& windows = cache.windows(T());
+    parameter = effectiveWindowParameter(window, parameter);
+    auto key = std::make_tuple(size, window, parameter);
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = windows.find(key);
+        if (it != windows.end()) {
+            cache.hits.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+    }
+
+    cache.misses.fetch_add(1, std::memory_order_relaxed);
+    auto coeffs = std::make_shared<const std::vector<T>>(generateWindow<T>(size, window, parameter));
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.floatWindows.size() + cache.doubleWindows.size() >= MAX_CACHED_WINDOWS) {
+        cache.floatWindows.clear();
+        cache.doubleWindows.clear();
+    }
+    return windows.emplace(key, std::move(coeffs)).first->second;
+}
+
+WindowCacheStats FFT::getWindowCacheStats() {
+    auto& cache = windowCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    WindowCacheStats stats;
+    stats.hits = cache.hits.load(std::memory_order_relaxed);
+    stats.misses = cache.misses.load(std::memory_order_relaxed);
+    stats.entries = cache.floatWindows.size() + cache.doubleWindows.size();
+    return stats;
+}
+
+void FFT::clearWindowCache() {
+    auto& cache = windowCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.floatWindows.clear();
+    cache.doubleWindows.clear();
+    cache.hits.store(0, std::memory_order_relaxed);
+    cache.misses.store(0, std::memory_order_relaxed);
+}
+
 template<typename T>
 std::vector<T> FFT::generateWindow(uint32_t size, WindowType window, T parameter) {
     std::vector<T> coeffs(size);
+    parameter = effectiveWindowParameter(window, parameter);
     
     switch (window) {
         case WindowType::None:
@@ -256,7 +1028,6 @@ std::vector<T> FFT::generateWindow(uint32_t size, WindowType window, T parameter
             
         case WindowType::Kaiser:
             // Simplified Kaiser window (parameter is beta)
-            if (parameter == 0) parameter = 5; // Default beta
             for (uint32_t i = 0; i < size; ++i) {
                 T n = static_cast<T>(i) / (size - 1);
                 T arg = parameter * std::sqrt(1 - (2 * n - 1) * (2 * n - 1));
@@ -267,7 +1038,6 @@ std::vector<T> FFT::generateWindow(uint32_t size, WindowType window, T parameter
             
         case WindowType::Gaussian:
             // Gaussian window (parameter is sigma)
-            if (parameter == 0) parameter = static_cast<T>(0.4); // Default sigma
             for (uint32_t i = 0; i < size; ++i) {
                 T n = (static_cast<T>(i) - (size - 1) / 2.0) / ((size - 1) / 2.0);
                 coeffs[i] = std::exp(-0.5 * (n / parameter) * (n / parameter));
@@ -276,7 +1046,6 @@ std::vector<T> FFT::generateWindow(uint32_t size, WindowType window, T parameter
             
         case WindowType::Tukey:
             // Tukey window (parameter is alpha)
-            if (parameter == 0) parameter = static_cast<T>(0.5); // Default alpha
             for (uint32_t i = 0; i < size; ++i) {
                 T n = static_cast<T>(i) / (size - 1);
                 if (n < parameter / 2) {
@@ -298,60 +1067,16 @@ std::vector<T> FFT::generateWindow(uint32_t size, WindowType window, T parameter
 }
 
 template<typename T>
-void FFT::radix2FFT(std::vector<std::complex<T>>& data, bool inverse) {
+void FFT::transform(std::vector<std::complex<T>>& data, bool inverse) {
     uint32_t n = static_cast<uint32_t>(data.size());
     
-    if (!isValidSize(n)) {
-        FMUS_LOG_ERROR("FFT size must be power of 2");
+    if (n == 0) {
+        FMUS_LOG_ERROR("FFT size must be at least 1");
         return;
     }
     
-    // Bit-reverse permutation
-    bitReverse(data);
-    
-    // FFT computation
-    for (uint32_t len = 2; len <= n; len <<= 1) {
-        T angle = (inverse ? 2 : -2) * M_PI / len;
-        std::complex<T> wlen(std::cos(angle), std::sin(angle));
-        
-        for (uint32_t i = 0; i < n; i += len) {
-            std::complex<T> w(1, 0);
-            for (uint32_t j = 0; j < len / 2; ++j) {
-                std::complex<T> u = data[i + j];
-                std::complex<T> v = data[i + j + len / 2] * w;
-                data[i + j] = u + v;
-                data[i + j + len / 2] = u - v;
-                w *= wlen;
-            }
-        }
-    }
-    
-    // Scale for inverse transform
-    if (inverse) {
-        T scale = static_cast<T>(1.0) / n;
-        for (auto& sample : data) {
-            sample *= scale;
-        }
-    }
-}
-
-template<typename T>
-void FFT::bitReverse(std::vector<std::complex<T>>& data) {
-    uint32_t n = static_cast<uint32_t>(data.size());
-    uint32_t j = 0;
-    
-    for (uint32_t i = 1; i < n; ++i) {
-        uint32_t bit = n >> 1;
-        while (j & bit) {
-            j ^= bit;
-            bit >>= 1;
-        }
-        j ^= bit;
-        
-        if (i < j) {
-            std::swap(data[i], data[j]);
-        }
-    }
+    auto plan = FFTPlan<T>::get(n, inverse ? FFTDirection::Inverse : FFTDirection::Forward);
+    plan->execute(data.data());
 }
 
 //=============================================================================
@@ -364,26 +1089,25 @@ core::Result<T> SpectralAnalysis::findPeakFrequency(const FFTResult<T>& fftResul
         return core::makeError<T>(core::ErrorCode::InvalidArgument, "FFT result is empty");
     }
 
-    auto magnitude = fftResult.getMagnitude();
-    auto frequencies = fftResult.getFrequencyBins();
-
     if (maxFreq < 0) {
         maxFreq = fftResult.sampleRate / 2; // Nyquist frequency
     }
 
     T peakFreq = 0;
-    T peakMagnitude = 0;
+    T peakPower = 0;
 
-    for (size_t i = 0; i < magnitude.size() && i < frequencies.size(); ++i) {
-        if (frequencies[i] >= minFreq && frequencies[i] <= maxFreq) {
-            if (magnitude[i] > peakMagnitude) {
-                peakMagnitude = magnitude[i];
-                peakFreq = frequencies[i];
+    for (size_t i = 0; i < fftResult.data.size(); ++i) {
+        T frequency = static_cast<T>(i) * fftResult.frequencyResolution;
+        if (frequency >= minFreq && frequency <= maxFreq) {
+            T power = std::norm(fftResult.data[i]);
+            if (power > peakPower) {
+                peakPower = power;
+                peakFreq = frequency;
             }
         }
     }
 
-    if (peakMagnitude == 0) {
+    if (peakPower == 0) {
         return core::makeError<T>(core::ErrorCode::DataError, "No peak found in specified frequency range");
     }
 
@@ -392,60 +1116,229 @@ core::Result<T> SpectralAnalysis::findPeakFrequency(const FFTResult<T>& fftResul
 
 template<typename T>
 std::vector<T> SpectralAnalysis::findPeaks(const FFTResult<T>& fftResult, uint32_t numPeaks, T minDistance) {
-    auto magnitude = fftResult.getMagnitude();
-    auto frequencies = fftResult.getFrequencyBins();
+    SpectralFeatureConfig<T> config;
+    config.numPeaks = numPeaks;
+    config.minPeakDistance = minDistance;
+    SpectralFeatures<T> features(config);
 
-    std::vector<std::pair<T, T>> peakPairs; // (magnitude, frequency)
-
-    // Find all local maxima
-    for (size_t i = 1; i < magnitude.size() - 1; ++i) {
-        if (magnitude[i] > magnitude[i-1] && magnitude[i] > magnitude[i+1]) {
-            peakPairs.emplace_back(magnitude[i], frequencies[i]);
+    std::vector<T> peaks;
+    if (features.compute(fftResult).isOk()) {
+        for (const SpectralPeak<T>& peak : features.getPeaks()) {
+            peaks.push_back(peak.frequency);
         }
     }
+    return peaks;
+}
+
+template<typename T>
+T SpectralAnalysis::calculateSpectralCentroid(const FFTResult<T>& fftResult) {
+    SpectralFeatures<T> features;
+    return features.compute(fftResult).isOk() ? features.getCentroid() : 0;
+}
 
-    // Sort by magnitude (descending)
-    std::sort(peakPairs.begin(), peakPairs.end(),
-              [](const auto& a, const auto& b) { return a.first > b.first; });
+template<typename T>
+T SpectralAnalysis::calculateSpectralRolloff(const FFTResult<T>& fftResult, T rolloffPercent) {
+    SpectralFeatureConfig<T> config;
+    config.rolloffPercent = rolloffPercent;
+    SpectralFeatures<T> features(config);
+    return features.compute(fftResult).isOk() ? features.getRolloff() : 0;
+}
 
-    // Select peaks with minimum distance constraint
-    std::vector<T> selectedPeaks;
-    for (const auto& peak : peakPairs) {
-        if (selectedPeaks.size() >= numPeaks) break;
+namespace {
 
-        bool tooClose = false;
-        for (T existingPeak : selectedPeaks) {
-            if (std::abs(peak.second - existingPeak) < minDistance) {
-                tooClose = true;
-                break;
-            }
+// Largest |X|^2 within one bin of the given frequency (tolerates leakage
+// when the tone falls between bins); returns 0 beyond Nyquist
+template<typename T>
+T peakPowerNear(const FFTResult<T>& fftResult, T frequency) {
+    if (fftResult.frequencyResolution <= 0) {
+        return 0;
+    }
+
+    size_t usable = std::min<size_t>(fftResult.data.size(), fftResult.size / 2 + 1);
+    T position = frequency / fftResult.frequencyResolution;
+    if (position < 0 || position > static_cast<T>(usable - 1)) {
+        return 0;
+    }
+
+    size_t center = static_cast<size_t>(std::lround(position));
+    size_t first = (center > 0) ? center - 1 : 0;
+    size_t last = std::min(center + 1, usable - 1);
+    T peak = 0;
+    for (size_t i = first; i <= last; ++i) {
+        peak = std::max(peak, std::norm(fftResult.data[i]));
+    }
+    return peak;
+}
+
+} // anonymous namespace
+
+template<typename T>
+core::Result<T> SpectralAnalysis::calculateTHD(const FFTResult<T>& fftResult, T fundamentalFreq, uint32_t numHarmonics) {
+    if (fftResult.data.empty() || fundamentalFreq <= 0) {
+        return core::makeError<T>(core::ErrorCode::InvalidArgument, "FFT result is empty or fundamental is not positive");
+    }
+
+    T fundamental = peakPowerNear(fftResult, fundamentalFreq);
+    if (fundamental <= 0) {
+        return core::makeError<T>(core::ErrorCode::DataError, "No energy at the fundamental frequency");
+    }
+
+    T harmonicPower = 0;
+    for (uint32_t h = 2; h <= numHarmonics + 1; ++h) {
+        harmonicPower += peakPowerNear(fftResult, fundamentalFreq * static_cast<T>(h));
+    }
+
+    T thd = std::sqrt(harmonicPower / fundamental) * 100;
+    return core::makeOk<T>(std::move(thd));
+}
+
+template<typename T>
+core::Result<T> SpectralAnalysis::calculateSNR(const FFTResult<T>& fftResult, T signalFreq, T bandwidth) {
+    if (fftResult.data.empty() || fftResult.frequencyResolution <= 0) {
+        return core::makeError<T>(core::ErrorCode::InvalidArgument, "FFT result is empty");
+    }
+
+    // Signal: bins within bandwidth/2 of the signal frequency; noise: all
+    // other bins up to Nyquist, excluding DC
+    size_t usable = std::min<size_t>(fftResult.data.size(), fftResult.size / 2 + 1);
+    T halfBand = std::max(bandwidth / 2, fftResult.frequencyResolution);
+    T signalPower = 0;
+    T noisePower = 0;
+    for (size_t i = 1; i < usable; ++i) {
+        T frequency = static_cast<T>(i) * fftResult.frequencyResolution;
+        T power = std::norm(fftResult.data[i]);
+        if (std::abs(frequency - signalFreq) <= halfBand) {
+            signalPower += power;
+        } else {
+            noisePower += power;
         }
+    }
+
+    if (signalPower <= 0 || noisePower <= 0) {
+        return core::makeError<T>(core::ErrorCode::DataError, "Signal or noise power is zero");
+    }
+
+    T snr = 10 * std::log10(signalPower / noisePower);
+    return core::makeOk<T>(std::move(snr));
+}
+
+//=============================================================================
+// RealTimeFFT Implementation
+//=============================================================================
+
+template<typename T>
+RealTimeFFT<T>::RealTimeFFT(uint32_t fftSize, T sampleRate, T overlapFactor, WindowType window)
+    : m_fftSize(fftSize), m_sampleRate(sampleRate), m_overlapFactor(overlapFactor), m_window(window),
+      m_workspace(std::max<uint32_t>(fftSize, 2), window), m_bufferIndex(0), m_hopSize(0),
+      m_samplesUntilFrame(0), m_bufferReady(false) {
+    if (fftSize < 2) {
+        FMUS_LOG_ERROR("RealTimeFFT size must be at least 2");
+        m_fftSize = 0;
+        return;
+    }
+
+    if (overlapFactor < 0 || overlapFactor > static_cast<T>(0.75)) {
+        FMUS_LOG_WARNING("RealTimeFFT overlap factor out of range, clamping to [0, 0.75]");
+        m_overlapFactor = std::min(std::max(overlapFactor, static_cast<T>(0)), static_cast<T>(0.75));
+    }
+
+    m_hopSize = std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(fftSize * (1 - m_overlapFactor))));
+    m_buffer.resize(2 * static_cast<size_t>(fftSize));
+    m_spectrum.resize(fftSize / 2 + 1);
+    reset();
+}
+
+template<typename T>
+RealTimeFFT<T>::~RealTimeFFT() = default;
+
+template<typename T>
+void RealTimeFFT<T>::reset() {
+    std::fill(m_buffer.begin(), m_buffer.end(), static_cast<T>(0));
+    m_bufferIndex = 0;
+    m_samplesUntilFrame = m_fftSize;
+    m_bufferReady = false;
+}
 
-        if (!tooClose) {
-            selectedPeaks.push_back(peak.second);
+template<typename T>
+void RealTimeFFT<T>::writeSamples(const T* samples, uint32_t count) {
+    // Each sample lands at p and p + N, so [index, index + N) always holds
+    // the latest N samples in order
+    while (count > 0) {
+        uint32_t run = std::min(count, m_fftSize - m_bufferIndex);
+        std::copy(samples, samples + run, m_buffer.begin() + m_bufferIndex);
+        std::copy(samples, samples + run, m_buffer.begin() + m_bufferIndex + m_fftSize);
+        samples += run;
+        count -= run;
+        m_bufferIndex += run;
+        if (m_bufferIndex == m_fftSize) {
+            m_bufferIndex = 0;
         }
     }
+}
+
+template<typename T>
+uint32_t RealTimeFFT<T>::processSamples(const T* samples, size_t count, const FrameCallback& onFrame) {
+    if (m_fftSize == 0 || samples == nullptr) {
+        return 0;
+    }
 
-    // Sort by frequency
-    std::sort(selectedPeaks.begin(), selectedPeaks.end());
+    uint32_t frames = 0;
+    while (count > 0) {
+        uint32_t run = static_cast<uint32_t>(std::min<size_t>(count, m_samplesUntilFrame));
+        writeSamples(samples, run);
+        samples += run;
+        count -= run;
+        m_samplesUntilFrame -= run;
 
-    return selectedPeaks;
+        if (m_samplesUntilFrame == 0) {
+            m_bufferReady = true;
+            m_samplesUntilFrame = m_hopSize;
+            FFT::forwardReal(m_buffer.data() + m_bufferIndex, m_fftSize, m_spectrum.data(), m_workspace);
+            ++frames;
+            if (onFrame) {
+                onFrame(m_spectrum.data(), static_cast<uint32_t>(m_spectrum.size()));
+            }
+        }
+    }
+    return frames;
 }
 
 template<typename T>
-T SpectralAnalysis::calculateSpectralCentroid(const FFTResult<T>& fftResult) {
-    auto magnitude = fftResult.getMagnitude();
-    auto frequencies = fftResult.getFrequencyBins();
+FFTResult<T> RealTimeFFT<T>::makeResult() const {
+    FFTResult<T> result;
+    result.data = m_spectrum;
+    result.sampleRate = m_sampleRate;
+    result.frequencyResolution = m_sampleRate / static_cast<T>(m_fftSize);
+    result.size = m_fftSize;
+    result.windowUsed = m_window;
+    return result;
+}
 
-    T numerator = 0;
-    T denominator = 0;
+template<typename T>
+std::vector<FFTResult<T>> RealTimeFFT<T>::processSamples(const std::vector<T>& samples) {
+    std::vector<FFTResult<T>> results;
+    processSamples(samples.data(), samples.size(), [&](const std::complex<T>*, uint32_t) {
+        results.push_back(makeResult());
+    });
+    return results;
+}
 
-    for (size_t i = 0; i < magnitude.size() && i < frequencies.size(); ++i) {
-        numerator += frequencies[i] * magnitude[i];
-        denominator += magnitude[i];
+template<typename T>
+core::Result<FFTResult<T>> RealTimeFFT<T>::processSample(T sample) {
+    if (processSamples(&sample, 1, nullptr) == 0) {
+        return core::makeError<FFTResult<T>>(core::ErrorCode::ResourceUnavailable, "No frame ready");
     }
+    return core::makeOk<FFTResult<T>>(makeResult());
+}
+
+template<typename T>
+uint32_t RealTimeFFT<T>::getFFTSize() const {
+    return m_fftSize;
+}
 
-    return (denominator > 0) ? numerator / denominator : 0;
+template<typename T>
+T RealTimeFFT<T>::getSampleRate() const {
+    return m_sampleRate;
 }
 
 //=============================================================================
@@ -469,13 +1362,32 @@ std::string windowTypeToString(WindowType window) {
 // Explicit Template Instantiations
 //=============================================================================
 
+template class FFTPlan<float>;
+template class FFTPlan<double>;
+template class RealFFTPlan<float>;
+template class RealFFTPlan<double>;
+template class FFTWorkspace<float>;
+template class FFTWorkspace<double>;
 template struct FFTResult<float>;
 template struct FFTResult<double>;
+template class RealTimeFFT<float>;
+template class RealTimeFFT<double>;
+
+template core::Result<FFTResult<float>> FFT::forward<float>(const std::vector<float>&, float, WindowType, FFTPadding);
+template core::Result<FFTResult<double>> FFT::forward<double>(const std::vector<double>&, double, WindowType, FFTPadding);
+template core::Result<FFTResult<float>> FFT::forward<float>(const std::vector<std::complex<float>>&, float, WindowType, FFTPadding);
+template core::Result<FFTResult<double>> FFT::forward<double>(const std::vector<std::complex<double>>&, double, WindowType, FFTPadding);
 
-template core::Result<FFTResult<float>> FFT::forward<float>(const std::vector<float>&, float, WindowType);
-template core::Result<FFTResult<double>> FFT::forward<double>(const std::vector<double>&, double, WindowType);
-template core::Result<FFTResult<float>> FFT::forward<float>(const std::vector<std::complex<float>>&, float, WindowType);
-template core::Result<FFTResult<double>> FFT::forward<double>(const std::vector<std::complex<double>>&, double, WindowType);
+template core::Result<FFTResult<float>> FFT::forwardReal<float>(const std::vector<float>&, float, WindowType, FFTPadding);
+template core::Result<FFTResult<double>> FFT::forwardReal<double>(const std::vector<double>&, double, WindowType, FFTPadding);
+template core::Result<std::vector<float>> FFT::inverseReal<float>(const std::vector<std::complex<float>>&, uint32_t);
+template core::Result<std::vector<double>> FFT::inverseReal<double>(const std::vector<std::complex<double>>&, uint32_t);
+template core::Result<void> FFT::forward<float>(const float*, uint32_t, std::complex<float>*, FFTWorkspace<float>&);
+template core::Result<void> FFT::forward<double>(const double*, uint32_t, std::complex<double>*, FFTWorkspace<double>&);
+template core::Result<void> FFT::forwardReal<float>(const float*, uint32_t, std::complex<float>*, FFTWorkspace<float>&);
+template core::Result<void> FFT::forwardReal<double>(const double*, uint32_t, std::complex<double>*, FFTWorkspace<double>&);
+template core::Result<void> FFT::inverseReal<float>(const std::complex<float>*, float*, FFTWorkspace<float>&);
+template core::Result<void> FFT::inverseReal<double>(const std::complex<double>*, double*, FFTWorkspace<double>&);
 
 template core::Result<std::vector<float>> FFT::inverse<float>(const std::vector<std::complex<float>>&);
 template core::Result<std::vector<double>> FFT::inverse<double>(const std::vector<std::complex<double>>&);
@@ -484,22 +1396,28 @@ template core::Result<std::vector<std::complex<double>>> FFT::inverseComplex<dou
 
 template std::vector<float> FFT::applyWindow<float>(const std::vector<float>&, WindowType, float);
 template std::vector<double> FFT::applyWindow<double>(const std::vector<double>&, WindowType, double);
+template std::shared_ptr<const std::vector<float>> FFT::getWindow<float>(uint32_t, WindowType, float);
+template std::shared_ptr<const std::vector<double>> FFT::getWindow<double>(uint32_t, WindowType, double);
 template std::vector<float> FFT::generateWindow<float>(uint32_t, WindowType, float);
 template std::vector<double> FFT::generateWindow<double>(uint32_t, WindowType, double);
 template std::vector<float> FFT::zeroPad<float>(const std::vector<float>&, uint32_t);
 template std::vector<double> FFT::zeroPad<double>(const std::vector<double>&, uint32_t);
 
-template void FFT::radix2FFT<float>(std::vector<std::complex<float>>&, bool);
-template void FFT::radix2FFT<double>(std::vector<std::complex<double>>&, bool);
-template void FFT::bitReverse<float>(std::vector<std::complex<float>>&);
-template void FFT::bitReverse<double>(std::vector<std::complex<double>>&);
+template void FFT::transform<float>(std::vector<std::complex<float>>&, bool);
+template void FFT::transform<double>(std::vector<std::complex<double>>&, bool);
 
 template core::Result<float> SpectralAnalysis::findPeakFrequency<float>(const FFTResult<float>&, float, float);
 template core::Result<double> SpectralAnalysis::findPeakFrequency<double>(const FFTResult<double>&, double, double);
 template std::vector<float> SpectralAnalysis::findPeaks<float>(const FFTResult<float>&, uint32_t, float);
 template std::vector<double> SpectralAnalysis::findPeaks<double>(const FFTResult<double>&, uint32_t, double);
+template core::Result<float> SpectralAnalysis::calculateTHD<float>(const FFTResult<float>&, float, uint32_t);
+template core::Result<double> SpectralAnalysis::calculateTHD<double>(const FFTResult<double>&, double, uint32_t);
+template core::Result<float> SpectralAnalysis::calculateSNR<float>(const FFTResult<float>&, float, float);
+template core::Result<double> SpectralAnalysis::calculateSNR<double>(const FFTResult<double>&, double, double);
 template float SpectralAnalysis::calculateSpectralCentroid<float>(const FFTResult<float>&);
 template double SpectralAnalysis::calculateSpectralCentroid<double>(const FFTResult<double>&);
+template float SpectralAnalysis::calculateSpectralRolloff<float>(const FFTResult<float>&, float);
+template double SpectralAnalysis::calculateSpectralRolloff<double>(const FFTResult<double>&, double);
 
 } // namespace dsp
 } // namespace fmus
@@ -0,0 +1,524 @@
+#include "fft_kernels.h"
+#include "simd_ops.h"
+#include "fmus/dsp/fixed_point.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace fmus {
+namespace dsp {
+namespace internal {
+
+namespace {
+
+//=============================================================================
+// Vector kernels
+//=============================================================================
+
+// Compiled for the baseline target and again with AVX2 enabled, so the
+// 256-bit operations inline into the AVX2 loops (see simd_ops.h)
+namespace baseline {
+#define FMUS_DSP_KERNEL_TARGET
+#include "fft_kernels.inc"
+#undef FMUS_DSP_KERNEL_TARGET
+} // namespace baseline
+
+#if defined(FMUS_DSP_HAVE_AVX2)
+namespace avx2 {
+#define FMUS_DSP_KERNEL_TARGET FMUS_DSP_TARGET_AVX2
+#include "fft_kernels.inc"
+#undef FMUS_DSP_KERNEL_TARGET
+} // namespace avx2
+#endif
+
+//=============================================================================
+// Mixed-radix butterflies
+//=============================================================================
+
+// Plain complex multiply; std::complex operator* adds NaN/Inf recovery
+// branches that cost more than the arithmetic itself
+template<typename T>
+inline std::complex<T> cmul(const std::complex<T>& a, const std::complex<T>& b) {
+    return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(),
+                           a.real() * b.imag() + a.imag() * b.real());
+}
+
+template<typename T>
+void butterfly2(std::complex<T>* out, size_t fstride, const std::complex<T>* roots, uint32_t m) {
+    for (uint32_t u = 0; u < m; ++u) {
+        std::complex<T> t = cmul(out[u + m], roots[u * fstride]);
+        out[u + m] = out[u] - t;
+        out[u] += t;
+    }
+}
+
+template<typename T>
+void butterfly4(std::complex<T>* out, size_t fstride, const std::complex<T>* roots, uint32_t m, bool inverse) {
+    for (uint32_t u = 0; u < m; ++u) {
+        std::complex<T> s0 = cmul(out[u + m], roots[u * fstride]);
+        std::complex<T> s1 = cmul(out[u + 2 * m], roots[2 * u * fstride]);
+        std::complex<T> s2 = cmul(out[u + 3 * m], roots[3 * u * fstride]);
+
+        std::complex<T> s5 = out[u] - s1;
+        out[u] += s1;
+        std::complex<T> s3 = s0 + s2;
+        std::complex<T> s4 = s0 - s2;
+        out[u + 2 * m] = out[u] - s3;
+        out[u] += s3;
+
+        // Multiply s4 by -i (forward) or +i (inverse)
+        std::complex<T> rotated = inverse ? std::complex<T>(-s4.imag(), s4.real())
+                                          : std::complex<T>(s4.imag(), -s4.real());
+        out[u + m] = s5 + rotated;
+        out[u + 3 * m] = s5 - rotated;
+    }
+}
+
+// Odd-radix butterfly exploiting conjugate symmetry of the DFT matrix:
+// y[k], y[p-k] = A +- iB with A = x0 + sum_j cos(2*pi*jk/p) (x_j + x_{p-j})
+// and B = sum_j sin(2*pi*jk/p) (x_j - x_{p-j}), sign taken from the roots
+template<typename T>
+void butterflyOdd(std::complex<T>* out, size_t fstride, const std::complex<T>* roots, uint32_t m, uint32_t p) {
+    const size_t n = fstride * m * p;
+    const size_t rootStep = n / p;
+    const uint32_t halfP = (p - 1) / 2;
+
+    std::complex<T> sums[MAX_MIXED_RADIX / 2 + 1];
+    std::complex<T> diffs[MAX_MIXED_RADIX / 2 + 1];
+
+    for (uint32_t u = 0; u < m; ++u) {
+        std::complex<T> x0 = out[u];
+        std::complex<T> total = x0;
+        for (uint32_t j = 1; j <= halfP; ++j) {
+            std::complex<T> a = cmul(out[u + j * m], roots[static_cast<size_t>(j) * u * fstride]);
+            std::complex<T> b = cmul(out[u + (p - j) * m], roots[static_cast<size_t>(p - j) * u * fstride]);
+            sums[j] = a + b;
+            diffs[j] = a - b;
+            total += sums[j];
+        }
+
+        out[u] = total;
+        for (uint32_t k = 1; k <= halfP; ++k) {
+            std::complex<T> acc = x0;
+            T bRe = 0;
+            T bIm = 0;
+            for (uint32_t j = 1; j <= halfP; ++j) {
+                const std::complex<T>& w = roots[((static_cast<size_t>(j) * k) % p) * rootStep];
+                acc += sums[j] * w.real();
+                bRe += diffs[j].real() * w.imag();
+                bIm += diffs[j].imag() * w.imag();
+            }
+            // iB = (-bIm, bRe)
+            out[u + k * m] = std::complex<T>(acc.real() - bIm, acc.imag() + bRe);
+            out[u + (p - k) * m] = std::complex<T>(acc.real() + bIm, acc.imag() - bRe);
+        }
+    }
+}
+
+template<typename T>
+void mixedRadixWork(std::complex<T>* out, const std::complex<T>* in, size_t fstride,
+                    const uint32_t* factors, const std::complex<T>* roots, bool inverse) {
+    const uint32_t p = factors[0];
+    const uint32_t m = factors[1];
+
+    if (m == 1) {
+        for (uint32_t k = 0; k < p; ++k) {
+            out[k] = in[k * fstride];
+        }
+    } else {
+        // Each sub-transform reads every p-th sample, so recursion leaves
+        // the output in natural order (no reordering pass needed)
+        for (uint32_t k = 0; k < p; ++k) {
+            mixedRadixWork(out + k * m, in + k * fstride, fstride * p, factors + 2, roots, inverse);
+        }
+    }
+
+    switch (p) {
+        case 2: butterfly2(out, fstride, roots, m); break;
+        case 4: butterfly4(out, fstride, roots, m, inverse); break;
+        default: butterflyOdd(out, fstride, roots, m, p); break;
+    }
+}
+
+//=============================================================================
+// Fixed-point radix-2 stage
+//=============================================================================
+
+// Products and sums are formed in the accumulator type, which holds a sum
+// of two full products, so nothing wraps before the final saturation.
+// Twiddles exclude the minimum value, which keeps |w| below one.
+template<typename Q>
+Q fixedRadix2StageScalar(Q* re, Q* im, uint32_t n, uint32_t h,
+                         const Q* twiddleRe, const Q* twiddleIm, uint32_t shift) {
+    using Acc = typename FixedPointTraits<Q>::Accumulator;
+    const uint32_t bits = FixedPointTraits<Q>::FRACTION_BITS;
+    const Acc productRound = static_cast<Acc>(1) << (bits - 1);
+    const Acc outputRound = (static_cast<Acc>(1) << shift) >> 1;
+    Acc peak = 0;
+
+    for (uint32_t base = 0; base < n; base += 2 * h) {
+        Q* ar = re + base;
+        Q* ai = im + base;
+        Q* br = ar + h;
+        Q* bi = ai + h;
+        for (uint32_t j = 0; j < h; ++j) {
+            Acc wr = twiddleRe[j];
+            Acc wi = twiddleIm[j];
+            Acc tr = (static_cast<Acc>(br[j]) * wr - static_cast<Acc>(bi[j]) * wi + productRound) >> bits;
+            Acc ti = (static_cast<Acc>(br[j]) * wi + static_cast<Acc>(bi[j]) * wr + productRound) >> bits;
+            Acc yr = static_cast<Acc>(ar[j]) + outputRound;
+            Acc yi = static_cast<Acc>(ai[j]) + outputRound;
+
+            Q outAr = saturate<Q>((yr + tr) >> shift);
+            Q outAi = saturate<Q>((yi + ti) >> shift);
+            Q outBr = saturate<Q>((yr - tr) >> shift);
+            Q outBi = saturate<Q>((yi - ti) >> shift);
+            ar[j] = outAr;
+            ai[j] = outAi;
+            br[j] = outBr;
+            bi[j] = outBi;
+
+            peak = std::max(peak, std::max(std::max(std::abs(static_cast<Acc>(outAr)), std::abs(static_cast<Acc>(outAi))),
+                                           std::max(std::abs(static_cast<Acc>(outBr)), std::abs(static_cast<Acc>(outBi)))));
+        }
+    }
+    return saturate<Q>(peak);
+}
+
+#if defined(FMUS_DSP_HAVE_SSE2)
+// Stages with h < 8 on blocks of 8 consecutive points: the a and b halves
+// of each butterfly are gathered into the low four lanes of a register,
+// run through the same arithmetic as fixedRadix2StageQ15Vec and scattered
+// back, so results match the scalar stage exactly
+template<uint32_t H>
+int16_t fixedSmallStageQ15Sse2(int16_t* re, int16_t* im, uint32_t n,
+                               const int16_t* twiddleRe, const int16_t* twiddleIm, uint32_t shift) {
+    using Ops = Sse2Q15Ops;
+    using Vec = __m128i;
+
+    // b lane l belongs to butterfly j = l % H
+    const Vec wr = _mm_setr_epi16(twiddleRe[0], twiddleRe[1 % H], twiddleRe[2 % H], twiddleRe[3 % H], 0, 0, 0, 0);
+    const Vec wi = _mm_setr_epi16(twiddleIm[0], twiddleIm[1 % H], twiddleIm[2 % H], twiddleIm[3 % H], 0, 0, 0, 0);
+    const Vec realPairs = Ops::unpackLo16(wr, Ops::negate16(wi));
+    const Vec imagPairs = Ops::unpackLo16(wi, wr);
+    const __m128i productShift = _mm_cvtsi32_si128(15);
+    const __m128i outputShift = _mm_cvtsi32_si128(static_cast<int>(shift));
+    const Vec productRound = Ops::broadcast32(1 << 14);
+    const Vec outputRound = Ops::broadcast32((1 << shift) >> 1);
+    Vec peak = Ops::zero();
+
+    auto split = [](Vec v, Vec& a, Vec& b) {
+        if (H == 4) {
+            a = v;
+            b = _mm_srli_si128(v, 8);
+        } else if (H == 2) {
+            a = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 1, 2, 0));
+            b = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 0, 3, 1));
+        } else {
+            Vec even = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+            Vec odd = _mm_srai_epi32(v, 16);
+            a = _mm_packs_epi32(even, even);
+            b = _mm_packs_epi32(odd, odd);
+        }
+    };
+    auto merge = [](Vec packed) {
+        if (H == 4) {
+            return packed;
+        } else if (H == 2) {
+            return _mm_unpacklo_epi32(packed, _mm_srli_si128(packed, 8));
+        }
+        return _mm_unpacklo_epi16(packed, _mm_srli_si128(packed, 8));
+    };
+
+    for (uint32_t i = 0; i < n; i += 8) {
+        Vec ar, br, ai, bi;
+        split(Ops::load(re + i), ar, br);
+        split(Ops::load(im + i), ai, bi);
+
+        Vec pairs = Ops::unpackLo16(br, bi);
+        Vec tr = Ops::shiftRight32(Ops::add32(Ops::madd16(pairs, realPairs), productRound), productShift);
+        Vec ti = Ops::shiftRight32(Ops::add32(Ops::madd16(pairs, imagPairs), productRound), productShift);
+        Vec yr = Ops::add32(Ops::widenLo16(ar), outputRound);
+        Vec yi = Ops::add32(Ops::widenLo16(ai), outputRound);
+
+        Vec outR = Ops::pack32(Ops::shiftRight32(Ops::add32(yr, tr), outputShift),
+                               Ops::shiftRight32(Ops::sub32(yr, tr), outputShift));
+        Vec outI = Ops::pack32(Ops::shiftRight32(Ops::add32(yi, ti), outputShift),
+                               Ops::shiftRight32(Ops::sub32(yi, ti), outputShift));
+        Ops::store(re + i, merge(outR));
+        Ops::store(im + i, merge(outI));
+        peak = Ops::max16(peak, Ops::max16(Ops::abs16(outR), Ops::abs16(outI)));
+    }
+
+    alignas(16) int16_t lanes[Ops::width];
+    Ops::store(lanes, peak);
+    return *std::max_element(lanes, lanes + Ops::width);
+}
+#endif
+
+} // anonymous namespace
+
+//=============================================================================
+// Dispatch
+//=============================================================================
+
+template<typename T>
+void radix2FirstStage(T* re, T* im, uint32_t n) {
+    for (uint32_t i = 0; i < n; i += 2) {
+        T ur = re[i];
+        T ui = im[i];
+        T vr = re[i + 1];
+        T vi = im[i + 1];
+        re[i] = ur + vr;
+        im[i] = ui + vi;
+        re[i + 1] = ur - vr;
+        im[i + 1] = ui - vi;
+    }
+}
+
+template<>
+void radix4Stage<float>(SimdLevel level, float* re, float* im, uint32_t n, uint32_t h,
+                        const float* twiddles, bool inverse) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2 && h % Avx2FloatOps::width == 0) {
+        avx2::radix4StageVec<Avx2FloatOps>(re, im, n, h, twiddles, inverse);
+        return;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if ((level == SimdLevel::AVX2 || level == SimdLevel::SSE2) && h % Sse2FloatOps::width == 0) {
+        baseline::radix4StageVec<Sse2FloatOps>(re, im, n, h, twiddles, inverse);
+        return;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON)
+    if (level == SimdLevel::NEON && h % NeonFloatOps::width == 0) {
+        baseline::radix4StageVec<NeonFloatOps>(re, im, n, h, twiddles, inverse);
+        return;
+    }
+#endif
+    (void)level;
+    baseline::radix4StageVec<ScalarOps<float>>(re, im, n, h, twiddles, inverse);
+}
+
+template<>
+void radix4Stage<double>(SimdLevel level, double* re, double* im, uint32_t n, uint32_t h,
+                         const double* twiddles, bool inverse) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2 && h % Avx2DoubleOps::width == 0) {
+        avx2::radix4StageVec<Avx2DoubleOps>(re, im, n, h, twiddles, inverse);
+        return;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if ((level == SimdLevel::AVX2 || level == SimdLevel::SSE2) && h % Sse2DoubleOps::width == 0) {
+        baseline::radix4StageVec<Sse2DoubleOps>(re, im, n, h, twiddles, inverse);
+        return;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON_F64)
+    if (level == SimdLevel::NEON && h % NeonDoubleOps::width == 0) {
+        baseline::radix4StageVec<NeonDoubleOps>(re, im, n, h, twiddles, inverse);
+        return;
+    }
+#endif
+    (void)level;
+    baseline::radix4StageVec<ScalarOps<double>>(re, im, n, h, twiddles, inverse);
+}
+
+template<typename T>
+void radix2FirstStageLanes(T* re, T* im, uint32_t n, uint32_t lanes) {
+    for (uint32_t i = 0; i < n; i += 2) {
+        T* r0 = re + static_cast<size_t>(i) * lanes;
+        T* i0 = im + static_cast<size_t>(i) * lanes;
+        T* r1 = r0 + lanes;
+        T* i1 = i0 + lanes;
+        for (uint32_t l = 0; l < lanes; ++l) {
+            T ur = r0[l];
+            T ui = i0[l];
+            T vr = r1[l];
+            T vi = i1[l];
+            r0[l] = ur + vr;
+            i0[l] = ui + vi;
+            r1[l] = ur - vr;
+            i1[l] = ui - vi;
+        }
+    }
+}
+
+template<>
+void radix4StageLanes<float>(SimdLevel level, float* re, float* im, uint32_t n, uint32_t h,
+                             const float* twiddles, bool inverse, uint32_t lanes) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2 && lanes % Avx2FloatOps::width == 0) {
+        avx2::radix4StageLanesVec<Avx2FloatOps>(re, im, n, h, twiddles, inverse, lanes);
+        return;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if ((level == SimdLevel::AVX2 || level == SimdLevel::SSE2) && lanes % Sse2FloatOps::width == 0) {
+        baseline::radix4StageLanesVec<Sse2FloatOps>(re, im, n, h, twiddles, inverse, lanes);
+        return;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON)
+    if (level == SimdLevel::NEON && lanes % NeonFloatOps::width == 0) {
+        baseline::radix4StageLanesVec<NeonFloatOps>(re, im, n, h, twiddles, inverse, lanes);
+        return;
+    }
+#endif
+    (void)level;
+    baseline::radix4StageLanesVec<ScalarOps<float>>(re, im, n, h, twiddles, inverse, lanes);
+}
+
+template<>
+void radix4StageLanes<double>(SimdLevel level, double* re, double* im, uint32_t n, uint32_t h,
+                             const double* twiddles, bool inverse, uint32_t lanes) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2 && lanes % Avx2DoubleOps::width == 0) {
+        avx2::radix4StageLanesVec<Avx2DoubleOps>(re, im, n, h, twiddles, inverse, lanes);
+        return;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if ((level == SimdLevel::AVX2 || level == SimdLevel::SSE2) && lanes % Sse2DoubleOps::width == 0) {
+        baseline::radix4StageLanesVec<Sse2DoubleOps>(re, im, n, h, twiddles, inverse, lanes);
+        return;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON_F64)
+    if (level == SimdLevel::NEON && lanes % NeonDoubleOps::width == 0) {
+        baseline::radix4StageLanesVec<NeonDoubleOps>(re, im, n, h, twiddles, inverse, lanes);
+        return;
+    }
+#endif
+    (void)level;
+    baseline::radix4StageLanesVec<ScalarOps<double>>(re, im, n, h, twiddles, inverse, lanes);
+}
+
+template<>
+SpectralSums<float> spectralMoments<float>(SimdLevel level, const std::complex<float>* bins, uint32_t count, float* power) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2) {
+        return avx2::spectralMomentsVec<Avx2FloatOps>(bins, count, power);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if (level == SimdLevel::AVX2 || level == SimdLevel::SSE2) {
+        return baseline::spectralMomentsVec<Sse2FloatOps>(bins, count, power);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON)
+    if (level == SimdLevel::NEON) {
+        return baseline::spectralMomentsVec<NeonFloatOps>(bins, count, power);
+    }
+#endif
+    (void)level;
+    return baseline::spectralMomentsVec<ScalarOps<float>>(bins, count, power);
+}
+
+template<>
+SpectralSums<double> spectralMoments<double>(SimdLevel level, const std::complex<double>* bins, uint32_t count, double* power) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2) {
+        return avx2::spectralMomentsVec<Avx2DoubleOps>(bins, count, power);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if (level == SimdLevel::AVX2 || level == SimdLevel::SSE2) {
+        return baseline::spectralMomentsVec<Sse2DoubleOps>(bins, count, power);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON_F64)
+    if (level == SimdLevel::NEON) {
+        return baseline::spectralMomentsVec<NeonDoubleOps>(bins, count, power);
+    }
+#endif
+    (void)level;
+    return baseline::spectralMomentsVec<ScalarOps<double>>(bins, count, power);
+}
+
+template<>
+int16_t fixedRadix2Stage<int16_t>(SimdLevel level, int16_t* re, int16_t* im, uint32_t n, uint32_t h,
+                                  const int16_t* twiddleRe, const int16_t* twiddleIm, uint32_t shift) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2 && h % Avx2Q15Ops::width == 0) {
+        return avx2::fixedRadix2StageQ15Vec<Avx2Q15Ops>(re, im, n, h, twiddleRe, twiddleIm, shift);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if ((level == SimdLevel::AVX2 || level == SimdLevel::SSE2) && n % Sse2Q15Ops::width == 0) {
+        switch (h) {
+            case 1: return fixedSmallStageQ15Sse2<1>(re, im, n, twiddleRe, twiddleIm, shift);
+            case 2: return fixedSmallStageQ15Sse2<2>(re, im, n, twiddleRe, twiddleIm, shift);
+            case 4: return fixedSmallStageQ15Sse2<4>(re, im, n, twiddleRe, twiddleIm, shift);
+            default: return baseline::fixedRadix2StageQ15Vec<Sse2Q15Ops>(re, im, n, h, twiddleRe, twiddleIm, shift);
+        }
+    }
+#endif
+    (void)level;
+    return fixedRadix2StageScalar(re, im, n, h, twiddleRe, twiddleIm, shift);
+}
+
+template<>
+int32_t fixedRadix2Stage<int32_t>(SimdLevel level, int32_t* re, int32_t* im, uint32_t n, uint32_t h,
+                                  const int32_t* twiddleRe, const int32_t* twiddleIm, uint32_t shift) {
+    (void)level;
+    return fixedRadix2StageScalar(re, im, n, h, twiddleRe, twiddleIm, shift);
+}
+
+void buildBitReverse(uint32_t n, std::vector<uint32_t>& table) {
+    table.resize(n);
+    uint32_t j = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        table[i] = j;
+        uint32_t bit = n >> 1;
+        while (bit && (j & bit)) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j ^= bit;
+    }
+}
+
+template<typename T>
+void buildRadix4Twiddles(uint32_t n, bool inverse, std::vector<T>& twiddles) {
+    const double sign = inverse ? 1.0 : -1.0;
+    twiddles.clear();
+
+    // One split block per stage so each butterfly walks its table with unit stride
+    for (uint32_t h = (n & 0xAAAAAAAAu) ? 2 : 1; h < n; h *= 4) {
+        size_t offset = twiddles.size();
+        twiddles.resize(offset + 6 * static_cast<size_t>(h));
+        T* tw = twiddles.data() + offset;
+        for (uint32_t k = 0; k < h; ++k) {
+            const uint32_t powers[3] = {2 * k, k, 3 * k};
+            for (uint32_t t = 0; t < 3; ++t) {
+                double angle = sign * 2.0 * M_PI * static_cast<double>(powers[t]) / (4.0 * h);
+                tw[(2 * t) * h + k] = static_cast<T>(std::cos(angle));
+                tw[(2 * t + 1) * h + k] = static_cast<T>(std::sin(angle));
+            }
+        }
+    }
+}
+
+template<typename T>
+void mixedRadixTransform(const std::complex<T>* input, std::complex<T>* output,
+                         const uint32_t* factors, const std::complex<T>* roots, bool inverse) {
+    mixedRadixWork(output, input, 1, factors, roots, inverse);
+}
+
+template void radix2FirstStage<float>(float*, float*, uint32_t);
+template void radix2FirstStage<double>(double*, double*, uint32_t);
+template void radix2FirstStageLanes<float>(float*, float*, uint32_t, uint32_t);
+template void radix2FirstStageLanes<double>(double*, double*, uint32_t, uint32_t);
+template void buildRadix4Twiddles<float>(uint32_t, bool, std::vector<float>&);
+template void buildRadix4Twiddles<double>(uint32_t, bool, std::vector<double>&);
+template void mixedRadixTransform<float>(const std::complex<float>*, std::complex<float>*,
+                                         const uint32_t*, const std::complex<float>*, bool);
+template void mixedRadixTransform<double>(const std::complex<double>*, std::complex<double>*,
+                                          const uint32_t*, const std::complex<double>*, bool);
+
+} // namespace internal
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ * @file fft_kernels.h
+ * @brief Internal FFT butterfly kernels (not part of the public API)
+ *
+ * Power-of-2 kernels operate on split-format data (separate real and
+ * imaginary arrays) in bit-reversed order, as prepared by FFTPlan. The
+ * lane variants run the same butterflies over several transforms stored
+ * row by row, vectorizing across transforms instead of within one. The
+ * mixed-radix kernel handles other sizes over interleaved complex data.
+ * Fixed-point stages use the same split layout with block scaling.
+ */
+
+#include "fmus/dsp/simd.h"
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace fmus {
+namespace dsp {
+namespace internal {
+
+/**
+ * @brief Radix-2 stage with unit twiddles (first stage of odd-log2 sizes)
+ */
+template<typename T>
+void radix2FirstStage(T* re, T* im, uint32_t n);
+
+/**
+ * @brief One radix-4 decimation-in-time stage
+ *
+ * Combines two radix-2 stages of quarter-length h on bit-reversed data.
+ * The twiddle block holds W^2j, W^j and W^3j (W = exp(-+2*pi*i/4h)) for
+ * j < h as six consecutive arrays: re1, im1, re2, im2, re3, im3.
+ *
+ * @param level SIMD level (must be supported; falls back to scalar when h
+ *              is not a multiple of the vector width)
+ * @param re Real parts
+ * @param im Imaginary parts
+ * @param n Transform size
+ * @param h Quarter block length of this stage
+ * @param twiddles Twiddle block for this stage
+ * @param inverse True for inverse direction
+ */
+template<typename T>
+void radix4Stage(SimdLevel level, T* re, T* im, uint32_t n, uint32_t h,
+                 const T* twiddles, bool inverse);
+
+template<> void radix4Stage<float>(SimdLevel level, float* re, float* im, uint32_t n, uint32_t h,
+                                   const float* twiddles, bool inverse);
+template<> void radix4Stage<double>(SimdLevel level, double* re, double* im, uint32_t n, uint32_t h,
+                                    const double* twiddles, bool inverse);
+
+/**
+ * @brief Radix-2 first stage over lanes (element t of lane l at t * lanes + l)
+ */
+template<typename T>
+void radix2FirstStageLanes(T* re, T* im, uint32_t n, uint32_t lanes);
+
+/**
+ * @brief One radix-4 stage over lanes
+ *
+ * Same stage as radix4Stage applied to `lanes` independent transforms
+ * stored row by row, with element t of lane l at t * lanes + l.
+ *
+ * @param level SIMD level (falls back to scalar when lanes is not a
+ *              multiple of the vector width)
+ * @param re Real parts (n * lanes)
+ * @param im Imaginary parts (n * lanes)
+ * @param n Transform size
+ * @param h Quarter block length of this stage
+ * @param twiddles Twiddle block for this stage
+ * @param inverse True for inverse direction
+ * @param lanes Number of interleaved transforms
+ */
+template<typename T>
+void radix4StageLanes(SimdLevel level, T* re, T* im, uint32_t n, uint32_t h,
+                      const T* twiddles, bool inverse, uint32_t lanes);
+
+template<> void radix4StageLanes<float>(SimdLevel level, float* re, float* im, uint32_t n, uint32_t h,
+                                        const float* twiddles, bool inverse, uint32_t lanes);
+template<> void radix4StageLanes<double>(SimdLevel level, double* re, double* im, uint32_t n, uint32_t h,
+                                         const double* twiddles, bool inverse, uint32_t lanes);
+
+/**
+ * @brief Sums produced by spectralMoments
+ */
+template<typename T>
+struct SpectralSums {
+    T magnitude;            ///< sum |X_k|
+    T weightedMagnitude;    ///< sum k * |X_k|
+    T power;                ///< sum |X_k|^2
+};
+
+/**
+ * @brief Power spectrum and magnitude moments in one pass over the bins
+ *
+ * @param level SIMD level (must be supported)
+ * @param bins Complex bins
+ * @param count Number of bins
+ * @param power Output |X_k|^2 (count entries)
+ * @return SpectralSums<T> Magnitude, bin-weighted magnitude and power sums
+ */
+template<typename T>
+SpectralSums<T> spectralMoments(SimdLevel level, const std::complex<T>* bins, uint32_t count, T* power);
+
+template<> SpectralSums<float> spectralMoments<float>(SimdLevel level, const std::complex<float>* bins,
+                                                      uint32_t count, float* power);
+template<> SpectralSums<double> spectralMoments<double>(SimdLevel level, const std::complex<double>* bins,
+                                                        uint32_t count, double* power);
+
+/**
+ * @brief One block-scaled radix-2 stage over fixed-point data
+ *
+ * Butterflies of half length h on bit-reversed split data: t = w * b is
+ * rounded back to Q format, then a' = (a + t) >> shift and
+ * b' = (a - t) >> shift are rounded and saturated.
+ *
+ * @param level SIMD level (falls back to scalar when h is not a multiple
+ *              of the vector width)
+ * @param re Real parts
+ * @param im Imaginary parts
+ * @param n Transform size
+ * @param h Half block length of this stage
+ * @param twiddleRe Real parts of W^j for j < h (never the minimum value)
+ * @param twiddleIm Imaginary parts of W^j for j < h (never the minimum value)
+ * @param shift Right shift applied to the outputs (0 to 2)
+ * @return Q Largest |component| written (saturated)
+ */
+template<typename Q>
+Q fixedRadix2Stage(SimdLevel level, Q* re, Q* im, uint32_t n, uint32_t h,
+                   const Q* twiddleRe, const Q* twiddleIm, uint32_t shift);
+
+template<> int16_t fixedRadix2Stage<int16_t>(SimdLevel level, int16_t* re, int16_t* im, uint32_t n, uint32_t h,
+                                             const int16_t* twiddleRe, const int16_t* twiddleIm, uint32_t shift);
+template<> int32_t fixedRadix2Stage<int32_t>(SimdLevel level, int32_t* re, int32_t* im, uint32_t n, uint32_t h,
+                                             const int32_t* twiddleRe, const int32_t* twiddleIm, uint32_t shift);
+
+/**
+ * @brief Build the bit-reversal permutation for a power-of-2 size
+ *
+ * @param n Transform size
+ * @param table Output permutation (n entries)
+ */
+void buildBitReverse(uint32_t n, std::vector<uint32_t>& table);
+
+/**
+ * @brief Build the radix-4 twiddle blocks for all stages of a power-of-2 size
+ *
+ * Blocks are stored stage after stage, starting at h = 2 for odd powers
+ * of 2 (after the radix-2 first stage) and h = 1 otherwise.
+ *
+ * @param n Transform size
+ * @param inverse True for inverse direction
+ * @param twiddles Output table
+ */
+template<typename T>
+void buildRadix4Twiddles(uint32_t n, bool inverse, std::vector<T>& twiddles);
+
+/**
+ * @brief Largest prime factor handled by the mixed-radix kernel
+ */
+static const uint32_t MAX_MIXED_RADIX = 31;
+
+/**
+ * @brief Out-of-place mixed-radix decimation-in-time transform
+ *
+ * @param input Input samples (n entries, not modified)
+ * @param output Output samples (n entries, must not alias input)
+ * @param factors Pairs (radix p, remaining length m) from the outermost
+ *                stage inwards; the last pair has m == 1. Radices are 2, 4
+ *                or odd primes up to MAX_MIXED_RADIX.
+ * @param roots Roots of unity exp(-+2*pi*i*t/n) for t < n
+ * @param inverse True for inverse direction (no scaling applied)
+ */
+template<typename T>
+void mixedRadixTransform(const std::complex<T>* input, std::complex<T>* output,
+                         const uint32_t* factors, const std::complex<T>* roots, bool inverse);
+
+} // namespace internal
+} // namespace dsp
+} // namespace fmus
@@ -1,5 +1,7 @@
 #include "fmus/dsp/filter.h"
+#include "fmus/dsp/sos_filter.h"
 #include "fmus/core/logging.h"
+#include "simd_kernels.h"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
@@ -14,7 +16,7 @@ namespace dsp {
 template<typename T>
 LowPassFilter<T>::LowPassFilter(T alpha)
     : m_alpha(alpha), m_previousOutput(0), m_order(1), 
-      m_implementation(FilterImplementation::IIR), m_impl(nullptr) {
+      m_implementation(FilterImplementation::IIR) {
     if (alpha <= 0 || alpha >= 1) {
         FMUS_LOG_WARNING("LowPassFilter alpha should be between 0 and 1, clamping to valid range");
         m_alpha = std::clamp(alpha, static_cast<T>(0.001), static_cast<T>(0.999));
@@ -23,12 +25,20 @@ LowPassFilter<T>::LowPassFilter(T alpha)
 
 template<typename T>
 LowPassFilter<T>::LowPassFilter(T cutoffFreq, uint32_t order)
-    : m_order(order), m_implementation(FilterImplementation::Butterworth), m_impl(nullptr) {
-    // Simple approximation for Butterworth filter using RC equivalent
-    // For more accurate implementation, would use proper Butterworth design
-    m_alpha = static_cast<T>(1.0) - std::exp(-2.0 * M_PI * cutoffFreq);
+    : m_order(order), m_implementation(FilterImplementation::Butterworth) {
+    // RC equivalent, used if the design is rejected
+    m_alpha = static_cast<T>(1.0) - std::exp(-M_PI * cutoffFreq);
     m_alpha = std::clamp(m_alpha, static_cast<T>(0.001), static_cast<T>(0.999));
     m_previousOutput = 0;
+
+    auto design = designSOS<T>(FilterImplementation::Butterworth, FilterType::LowPass, order, cutoffFreq);
+    if (design.isOk()) {
+        m_design = std::make_unique<SOSFilter<T>>(design.value(), FilterType::LowPass, FilterImplementation::Butterworth);
+    } else {
+        FMUS_LOG_WARNING("LowPassFilter: " + design.error().message() + ", using a first-order RC filter");
+        m_order = 1;
+        m_implementation = FilterImplementation::IIR;
+    }
 }
 
 template<typename T>
@@ -36,6 +46,10 @@ LowPassFilter<T>::~LowPassFilter() = default;
 
 template<typename T>
 T LowPassFilter<T>::process(T input) {
+    if (m_design) {
+        return m_design->process(input);
+    }
+
     // Simple first-order IIR low-pass filter: y[n] = α*x[n] + (1-α)*y[n-1]
     m_previousOutput = m_alpha * input + (1 - m_alpha) * m_previousOutput;
     return m_previousOutput;
@@ -43,19 +57,27 @@ T LowPassFilter<T>::process(T input) {
 
 template<typename T>
 std::vector<T> LowPassFilter<T>::process(const std::vector<T>& input) {
-    std::vector<T> output;
-    output.reserve(input.size());
-    
-    for (const T& sample : input) {
-        output.push_back(process(sample));
-    }
-    
+    std::vector<T> output(input.size());
+    processBlock(input.data(), output.data(), input.size());
     return output;
 }
 
+template<typename T>
+void LowPassFilter<T>::processBlock(const T* input, T* output, size_t count) {
+    applyTuning();
+    if (m_design) {
+        m_design->process(input, output, count);
+        return;
+    }
+    internal::onePole(detectSimdLevel(), m_alpha, 1 - m_alpha, m_previousOutput, input, output, count);
+}
+
 template<typename T>
 void LowPassFilter<T>::reset() {
     m_previousOutput = 0;
+    if (m_design) {
+        m_design->reset();
+    }
 }
 
 template<typename T>
@@ -71,6 +93,20 @@ uint32_t LowPassFilter<T>::getOrder() const {
 template<typename T>
 void LowPassFilter<T>::setAlpha(T alpha) {
     m_alpha = std::clamp(alpha, static_cast<T>(0.001), static_cast<T>(0.999));
+    if (m_design) {
+        m_design.reset();
+        m_order = 1;
+        m_implementation = FilterImplementation::IIR;
+        m_previousOutput = 0;
+    }
+}
+
+template<typename T>
+void LowPassFilter<T>::publishAlpha(T alpha) {
+    Tuning& next = m_tuning.back();
+    next.alpha = std::clamp(alpha, static_cast<T>(0.001), static_cast<T>(0.999));
+    next.retired.reset();
+    m_tuning.publish();
 }
 
 template<typename T>
@@ -78,6 +114,22 @@ T LowPassFilter<T>::getAlpha() const {
     return m_alpha;
 }
 
+template<typename T>
+void LowPassFilter<T>::applyTuning() {
+    if (!m_tuning.update()) {
+        return;
+    }
+    Tuning& tuning = m_tuning.front();
+    m_alpha = tuning.alpha;
+    if (m_design) {
+        // Handed back to the control thread instead of freed here
+        tuning.retired = std::move(m_design);
+        m_order = 1;
+        m_implementation = FilterImplementation::IIR;
+        m_previousOutput = 0;
+    }
+}
+
 //=============================================================================
 // HighPassFilter Implementation
 //=============================================================================
@@ -85,7 +137,7 @@ T LowPassFilter<T>::getAlpha() const {
 template<typename T>
 HighPassFilter<T>::HighPassFilter(T alpha)
     : m_alpha(alpha), m_previousInput(0), m_previousOutput(0), m_order(1),
-      m_implementation(FilterImplementation::IIR), m_impl(nullptr) {
+      m_implementation(FilterImplementation::IIR) {
     if (alpha <= 0 || alpha >= 1) {
         FMUS_LOG_WARNING("HighPassFilter alpha should be between 0 and 1, clamping to valid range");
         m_alpha = std::clamp(alpha, static_cast<T>(0.001), static_cast<T>(0.999));
@@ -94,12 +146,21 @@ HighPassFilter<T>::HighPassFilter(T alpha)
 
 template<typename T>
 HighPassFilter<T>::HighPassFilter(T cutoffFreq, uint32_t order)
-    : m_order(order), m_implementation(FilterImplementation::Butterworth), m_impl(nullptr) {
-    // Simple approximation for high-pass filter
-    m_alpha = static_cast<T>(1.0) - std::exp(-2.0 * M_PI * cutoffFreq);
+    : m_order(order), m_implementation(FilterImplementation::Butterworth) {
+    // RC equivalent, used if the design is rejected
+    m_alpha = std::exp(-M_PI * cutoffFreq);
     m_alpha = std::clamp(m_alpha, static_cast<T>(0.001), static_cast<T>(0.999));
     m_previousInput = 0;
     m_previousOutput = 0;
+
+    auto design = designSOS<T>(FilterImplementation::Butterworth, FilterType::HighPass, order, cutoffFreq);
+    if (design.isOk()) {
+        m_design = std::make_unique<SOSFilter<T>>(design.value(), FilterType::HighPass, FilterImplementation::Butterworth);
+    } else {
+        FMUS_LOG_WARNING("HighPassFilter: " + design.error().message() + ", using a first-order RC filter");
+        m_order = 1;
+        m_implementation = FilterImplementation::IIR;
+    }
 }
 
 template<typename T>
@@ -107,6 +168,10 @@ HighPassFilter<T>::~HighPassFilter() = default;
 
 template<typename T>
 T HighPassFilter<T>::process(T input) {
+    if (m_design) {
+        return m_design->process(input);
+    }
+
     // First-order IIR high-pass filter: y[n] = α*(y[n-1] + x[n] - x[n-1])
     m_previousOutput = m_alpha * (m_previousOutput + input - m_previousInput);
     m_previousInput = input;
@@ -115,20 +180,35 @@ T HighPassFilter<T>::process(T input) {
 
 template<typename T>
 std::vector<T> HighPassFilter<T>::process(const std::vector<T>& input) {
-    std::vector<T> output;
-    output.reserve(input.size());
-    
-    for (const T& sample : input) {
-        output.push_back(process(sample));
-    }
-    
+    std::vector<T> output(input.size());
+    processBlock(input.data(), output.data(), input.size());
     return output;
 }
 
+template<typename T>
+void HighPassFilter<T>::processBlock(const T* input, T* output, size_t count) {
+    applyTuning();
+    if (m_design) {
+        m_design->process(input, output, count);
+        return;
+    }
+
+    // y[n] = α*y[n-1] + α*(x[n] - x[n-1]): a one-pole recursion over the differences
+    for (size_t i = 0; i < count; ++i) {
+        T sample = input[i];
+        output[i] = sample - m_previousInput;
+        m_previousInput = sample;
+    }
+    internal::onePole(detectSimdLevel(), m_alpha, m_alpha, m_previousOutput, output, output, count);
+}
+
 template<typename T>
 void HighPassFilter<T>::reset() {
     m_previousInput = 0;
     m_previousOutput = 0;
+    if (m_design) {
+        m_design->reset();
+    }
 }
 
 template<typename T>
@@ -141,6 +221,31 @@ uint32_t HighPassFilter<T>::getOrder() const {
     return m_order;
 }
 
+template<typename T>
+void HighPassFilter<T>::publishAlpha(T alpha) {
+    Tuning& next = m_tuning.back();
+    next.alpha = std::clamp(alpha, static_cast<T>(0.001), static_cast<T>(0.999));
+    next.retired.reset();
+    m_tuning.publish();
+}
+
+template<typename T>
+void HighPassFilter<T>::applyTuning() {
+    if (!m_tuning.update()) {
+        return;
+    }
+    Tuning& tuning = m_tuning.front();
+    m_alpha = tuning.alpha;
+    if (m_design) {
+        // Handed back to the control thread instead of freed here
+        tuning.retired = std::move(m_design);
+        m_order = 1;
+        m_implementation = FilterImplementation::IIR;
+        m_previousInput = 0;
+        m_previousOutput = 0;
+    }
+}
+
 //=============================================================================
 // BandPassFilter Implementation
 //=============================================================================
@@ -155,8 +260,9 @@ BandPassFilter<T>::BandPassFilter(T lowCutoff, T highCutoff, uint32_t order)
     }
     
     // Create cascade of high-pass and low-pass filters
-    m_highPass = std::make_unique<HighPassFilter<T>>(m_lowCutoff, order / 2);
-    m_lowPass = std::make_unique<LowPassFilter<T>>(m_highCutoff, order / 2);
+    uint32_t stageOrder = std::max<uint32_t>(1, order / 2);
+    m_highPass = std::make_unique<HighPassFilter<T>>(m_lowCutoff, stageOrder);
+    m_lowPass = std::make_unique<LowPassFilter<T>>(m_highCutoff, stageOrder);
 }
 
 template<typename T>
@@ -171,16 +277,18 @@ T BandPassFilter<T>::process(T input) {
 
 template<typename T>
 std::vector<T> BandPassFilter<T>::process(const std::vector<T>& input) {
-    std::vector<T> output;
-    output.reserve(input.size());
-    
-    for (const T& sample : input) {
-        output.push_back(process(sample));
-    }
-    
+    std::vector<T> output(input.size());
+    processBlock(input.data(), output.data(), input.size());
     return output;
 }
 
+template<typename T>
+void BandPassFilter<T>::processBlock(const T* input, T* output, size_t count) {
+    applyTuning();
+    m_highPass->processBlock(input, output, count);
+    m_lowPass->processBlock(output, output, count);
+}
+
 template<typename T>
 void BandPassFilter<T>::reset() {
     m_highPass->reset();
@@ -197,6 +305,32 @@ uint32_t BandPassFilter<T>::getOrder() const {
     return m_order;
 }
 
+template<typename T>
+void BandPassFilter<T>::publishCutoffs(T lowCutoff, T highCutoff) {
+    if (lowCutoff >= highCutoff) {
+        FMUS_LOG_ERROR("BandPassFilter: low cutoff must be less than high cutoff");
+        std::swap(lowCutoff, highCutoff);
+    }
+
+    // Same stages as the constructor; this also frees the retired ones
+    uint32_t stageOrder = std::max<uint32_t>(1, m_order / 2);
+    Tuning& next = m_tuning.back();
+    next.highPass = std::make_unique<HighPassFilter<T>>(lowCutoff, stageOrder);
+    next.lowPass = std::make_unique<LowPassFilter<T>>(highCutoff, stageOrder);
+    m_tuning.publish();
+}
+
+template<typename T>
+void BandPassFilter<T>::applyTuning() {
+    if (!m_tuning.update()) {
+        return;
+    }
+    // The old stages go back to the control thread instead of freed here
+    Tuning& tuning = m_tuning.front();
+    m_highPass.swap(tuning.highPass);
+    m_lowPass.swap(tuning.lowPass);
+}
+
 //=============================================================================
 // MovingAverageFilter Implementation
 //=============================================================================
@@ -216,6 +350,11 @@ MovingAverageFilter<T>::~MovingAverageFilter() = default;
 
 template<typename T>
 T MovingAverageFilter<T>::process(T input) {
+    return advance(input);
+}
+
+template<typename T>
+T MovingAverageFilter<T>::advance(T input) {
     // Remove old value from sum
     m_sum -= m_buffer[m_index];
     
@@ -236,16 +375,43 @@ T MovingAverageFilter<T>::process(T input) {
 
 template<typename T>
 std::vector<T> MovingAverageFilter<T>::process(const std::vector<T>& input) {
-    std::vector<T> output;
-    output.reserve(input.size());
-    
-    for (const T& sample : input) {
-        output.push_back(process(sample));
-    }
-    
+    std::vector<T> output(input.size());
+    processBlock(input.data(), output.data(), input.size());
     return output;
 }
 
+template<typename T>
+void MovingAverageFilter<T>::processBlock(const T* input, T* output, size_t count) {
+    applyTuning();
+
+    // The divisor changes while the window fills
+    size_t i = 0;
+    for (; i < count && !m_bufferFull; ++i) {
+        output[i] = advance(input[i]);
+    }
+
+    // Runs up to the end of the ring buffer: first the differences against
+    // the samples leaving the window, then their prefix sum on top of m_sum
+    const T scale = static_cast<T>(1) / static_cast<T>(m_windowSize);
+    while (i < count) {
+        size_t run = std::min<size_t>(count - i, m_windowSize - m_index);
+        T* oldest = m_buffer.data() + m_index;
+        for (size_t k = 0; k < run; ++k) {
+            T sample = input[i + k];
+            output[i + k] = sample - oldest[k];
+            oldest[k] = sample;
+        }
+        T sum = m_sum;
+        for (size_t k = 0; k < run; ++k) {
+            sum += output[i + k];
+            output[i + k] = sum * scale;
+        }
+        m_sum = sum;
+        m_index = static_cast<uint32_t>((m_index + run) % m_windowSize);
+        i += run;
+    }
+}
+
 template<typename T>
 void MovingAverageFilter<T>::reset() {
     std::fill(m_buffer.begin(), m_buffer.end(), 0);
@@ -271,18 +437,45 @@ void MovingAverageFilter<T>::setWindowSize(uint32_t windowSize) {
     reset();
 }
 
+template<typename T>
+void MovingAverageFilter<T>::publishWindowSize(uint32_t windowSize) {
+    if (windowSize == 0) {
+        FMUS_LOG_ERROR("MovingAverageFilter: window size cannot be zero");
+        return;
+    }
+
+    Tuning& next = m_tuning.back();
+    next.windowSize = windowSize;
+    next.buffer.assign(windowSize, 0);
+    m_tuning.publish();
+}
+
 template<typename T>
 uint32_t MovingAverageFilter<T>::getWindowSize() const {
     return m_windowSize;
 }
 
+template<typename T>
+void MovingAverageFilter<T>::applyTuning() {
+    if (!m_tuning.update()) {
+        return;
+    }
+    // Same as setWindowSize(), with the cleared window prepared already
+    Tuning& tuning = m_tuning.front();
+    m_windowSize = tuning.windowSize;
+    m_buffer.swap(tuning.buffer);
+    m_index = 0;
+    m_sum = 0;
+    m_bufferFull = false;
+}
+
 //=============================================================================
 // MedianFilter Implementation
 //=============================================================================
 
 template<typename T>
 MedianFilter<T>::MedianFilter(uint32_t windowSize)
-    : m_windowSize(windowSize), m_index(0), m_bufferFull(false) {
+    : m_windowSize(windowSize), m_index(0), m_count(0), m_heapCenter(0) {
     if (windowSize == 0) {
         FMUS_LOG_ERROR("MedianFilter: window size cannot be zero, setting to 1");
         m_windowSize = 1;
@@ -291,6 +484,10 @@ MedianFilter<T>::MedianFilter(uint32_t windowSize)
         FMUS_LOG_WARNING("MedianFilter: window size should be odd for best results");
     }
     m_buffer.resize(m_windowSize, 0);
+    m_heap.resize(m_windowSize);
+    m_heapIndex.resize(m_windowSize);
+    m_heapCenter = static_cast<int32_t>(m_windowSize / 2);
+    reset();
 }
 
 template<typename T>
@@ -298,33 +495,39 @@ MedianFilter<T>::~MedianFilter() = default;
 
 template<typename T>
 T MedianFilter<T>::process(T input) {
-    // Add new sample to buffer
-    m_buffer[m_index] = input;
-    m_index = (m_index + 1) % m_windowSize;
-    if (m_index == 0) {
-        m_bufferFull = true;
-    }
-    
-    return calculateMedian();
+    insert(input);
+    return median();
 }
 
 template<typename T>
 std::vector<T> MedianFilter<T>::process(const std::vector<T>& input) {
-    std::vector<T> output;
-    output.reserve(input.size());
-    
-    for (const T& sample : input) {
-        output.push_back(process(sample));
-    }
-    
+    std::vector<T> output(input.size());
+    processBlock(input.data(), output.data(), input.size());
     return output;
 }
 
+template<typename T>
+void MedianFilter<T>::processBlock(const T* input, T* output, size_t count) {
+    applyTuning();
+    for (size_t i = 0; i < count; ++i) {
+        insert(input[i]);
+        output[i] = median();
+    }
+}
+
 template<typename T>
 void MedianFilter<T>::reset() {
     std::fill(m_buffer.begin(), m_buffer.end(), 0);
     m_index = 0;
-    m_bufferFull = false;
+    m_count = 0;
+
+    // Slots fill the heap positions in the order 0, -1, 1, -2, 2, ... so
+    // both heaps stay balanced while the window grows
+    for (int32_t slot = 0; slot < static_cast<int32_t>(m_windowSize); ++slot) {
+        int32_t position = ((slot + 1) / 2) * ((slot % 2) ? -1 : 1);
+        m_heapIndex[slot] = position;
+        heapAt(position) = slot;
+    }
 }
 
 template<typename T>
@@ -333,29 +536,140 @@ uint32_t MedianFilter<T>::getOrder() const {
 }
 
 template<typename T>
-T MedianFilter<T>::calculateMedian() {
-    // Create a copy of the relevant portion of the buffer
-    std::vector<T> sortBuffer;
-    if (m_bufferFull) {
-        sortBuffer = m_buffer;
-    } else {
-        sortBuffer.assign(m_buffer.begin(), m_buffer.begin() + m_index);
+void MedianFilter<T>::publishWindowSize(uint32_t windowSize) {
+    if (windowSize == 0) {
+        FMUS_LOG_ERROR("MedianFilter: window size cannot be zero");
+        return;
     }
-    
-    if (sortBuffer.empty()) {
-        return 0;
+    if (windowSize % 2 == 0) {
+        FMUS_LOG_WARNING("MedianFilter: window size should be odd for best results");
     }
-    
-    // Sort the buffer
-    std::sort(sortBuffer.begin(), sortBuffer.end());
-    
-    // Return median
-    size_t size = sortBuffer.size();
-    if (size % 2 == 0) {
-        return (sortBuffer[size / 2 - 1] + sortBuffer[size / 2]) / 2;
+
+    Tuning& next = m_tuning.back();
+    next.windowSize = windowSize;
+    next.buffer.resize(windowSize);
+    next.heap.resize(windowSize);
+    next.heapIndex.resize(windowSize);
+    m_tuning.publish();
+}
+
+template<typename T>
+void MedianFilter<T>::applyTuning() {
+    if (!m_tuning.update()) {
+        return;
+    }
+    // reset() clears the swapped-in storage without allocating
+    Tuning& tuning = m_tuning.front();
+    m_windowSize = tuning.windowSize;
+    m_buffer.swap(tuning.buffer);
+    m_heap.swap(tuning.heap);
+    m_heapIndex.swap(tuning.heapIndex);
+    m_heapCenter = static_cast<int32_t>(m_windowSize / 2);
+    reset();
+}
+
+template<typename T>
+bool MedianFilter<T>::heapLess(int32_t i, int32_t j) {
+    return m_buffer[heapAt(i)] < m_buffer[heapAt(j)];
+}
+
+template<typename T>
+bool MedianFilter<T>::exchangeIfLess(int32_t i, int32_t j) {
+    if (!heapLess(i, j)) {
+        return false;
+    }
+    std::swap(heapAt(i), heapAt(j));
+    m_heapIndex[heapAt(i)] = i;
+    m_heapIndex[heapAt(j)] = j;
+    return true;
+}
+
+// Sifts an entry of the min-heap (positions 1, 2, ... with children 2i and
+// 2i + 1) down, starting at its child; child 1 of the median at 0 swaps the
+// entry across the median
+template<typename T>
+void MedianFilter<T>::minSortDown(int32_t child) {
+    for (; child <= minHeapCount(); child *= 2) {
+        if (child > 1 && child < minHeapCount() && heapLess(child + 1, child)) {
+            ++child;
+        }
+        if (!exchangeIfLess(child, child / 2)) {
+            break;
+        }
+    }
+}
+
+// Mirror image of minSortDown on positions -1, -2, ...
+template<typename T>
+void MedianFilter<T>::maxSortDown(int32_t child) {
+    for (; child >= -maxHeapCount(); child *= 2) {
+        if (child < -1 && child > -maxHeapCount() && heapLess(child, child - 1)) {
+            --child;
+        }
+        if (!exchangeIfLess(child / 2, child)) {
+            break;
+        }
+    }
+}
+
+// Both sort-ups return true when the entry reached the median position
+template<typename T>
+bool MedianFilter<T>::minSortUp(int32_t position) {
+    while (position > 0 && exchangeIfLess(position, position / 2)) {
+        position /= 2;
+    }
+    return position == 0;
+}
+
+template<typename T>
+bool MedianFilter<T>::maxSortUp(int32_t position) {
+    while (position < 0 && exchangeIfLess(position / 2, position)) {
+        position /= 2;
+    }
+    return position == 0;
+}
+
+template<typename T>
+void MedianFilter<T>::insert(T input) {
+    const bool growing = m_count < m_windowSize;
+    const int32_t position = m_heapIndex[m_index];
+    const T old = m_buffer[m_index];
+    m_buffer[m_index] = input;
+    m_index = (m_index + 1) % m_windowSize;
+    if (growing) {
+        ++m_count;
+    }
+
+    // The oldest slot is overwritten in place and only its entry moves
+    if (position > 0) {
+        if (!growing && old < input) {
+            minSortDown(position * 2);
+        } else if (minSortUp(position)) {
+            maxSortDown(-1);
+        }
+    } else if (position < 0) {
+        if (!growing && input < old) {
+            maxSortDown(position * 2);
+        } else if (maxSortUp(position)) {
+            minSortDown(1);
+        }
     } else {
-        return sortBuffer[size / 2];
+        if (maxHeapCount() > 0) {
+            maxSortDown(-1);
+        }
+        if (minHeapCount() > 0) {
+            minSortDown(1);
+        }
+    }
+}
+
+template<typename T>
+T MedianFilter<T>::median() {
+    T value = m_buffer[heapAt(0)];
+    if (m_count % 2 == 0) {
+        value = (value + m_buffer[heapAt(-1)]) / 2;
     }
+    return value;
 }
 
 //=============================================================================
@@ -371,6 +685,11 @@ KalmanFilter<T>::KalmanFilter(T processNoise, T measurementNoise, T initialEstim
 
 template<typename T>
 T KalmanFilter<T>::update(T measurement) {
+    if (m_tuning.update()) {
+        m_processNoise = m_tuning.front().processNoise;
+        m_measurementNoise = m_tuning.front().measurementNoise;
+    }
+
     // Prediction step
     // x_k|k-1 = x_k-1|k-1 (no state transition for simple 1D case)
     // P_k|k-1 = P_k-1|k-1 + Q
@@ -412,6 +731,14 @@ T KalmanFilter<T>::getCovariance() const {
     return m_covariance;
 }
 
+template<typename T>
+void KalmanFilter<T>::publishNoise(T processNoise, T measurementNoise) {
+    Tuning& next = m_tuning.back();
+    next.processNoise = processNoise;
+    next.measurementNoise = measurementNoise;
+    m_tuning.publish();
+}
+
 //=============================================================================
 // Factory Functions
 //=============================================================================
@@ -420,9 +747,14 @@ template<typename T>
 std::unique_ptr<Filter<T>> createFilter(FilterType type, T cutoffFreq, uint32_t order) {
     switch (type) {
         case FilterType::LowPass:
-            return std::make_unique<LowPassFilter<T>>(cutoffFreq, order);
-        case FilterType::HighPass:
-            return std::make_unique<HighPassFilter<T>>(cutoffFreq, order);
+        case FilterType::HighPass: {
+            auto design = designSOS<T>(FilterImplementation::Butterworth, type, order, cutoffFreq);
+            if (design.isError()) {
+                FMUS_LOG_ERROR("createFilter: " + design.error().message());
+                return nullptr;
+            }
+            return std::make_unique<SOSFilter<T>>(design.value(), type, FilterImplementation::Butterworth);
+        }
         default:
             FMUS_LOG_ERROR("Unsupported filter type in createFilter");
             return nullptr;
@@ -431,7 +763,18 @@ std::unique_ptr<Filter<T>> createFilter(FilterType type, T cutoffFreq, uint32_t
 
 template<typename T>
 std::unique_ptr<Filter<T>> createBandPassFilter(T lowCutoff, T highCutoff, uint32_t order) {
-    return std::make_unique<BandPassFilter<T>>(lowCutoff, highCutoff, order);
+    if (lowCutoff > highCutoff) {
+        FMUS_LOG_ERROR("createBandPassFilter: low cutoff must be less than high cutoff");
+        std::swap(lowCutoff, highCutoff);
+    }
+    uint32_t prototypeOrder = std::max<uint32_t>(1, (order + 1) / 2);
+    auto design = designSOS<T>(FilterImplementation::Butterworth, FilterType::BandPass,
+                               prototypeOrder, lowCutoff, highCutoff);
+    if (design.isError()) {
+        FMUS_LOG_ERROR("createBandPassFilter: " + design.error().message());
+        return nullptr;
+    }
+    return std::make_unique<SOSFilter<T>>(design.value(), FilterType::BandPass, FilterImplementation::Butterworth);
 }
 
 //=============================================================================
@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file fir_kernels.h
+ * @brief Internal FIR helpers shared by the resamplers and CIC filters
+ *        (not part of the public API)
+ *
+ * Kaiser window design and the streaming FIR inner loop: a history that
+ * stores every input twice, so the newest taps are always contiguous, and
+ * a dot product over them.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fmus {
+namespace dsp {
+namespace internal {
+
+/**
+ * @brief Modified Bessel function of the first kind, order 0 (power series)
+ *
+ * @param x Argument
+ * @return double I0(x)
+ */
+inline double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double quarter = x * x / 4.0;
+    for (int k = 1; k < 64; ++k) {
+        term *= quarter / (static_cast<double>(k) * k);
+        sum += term;
+        if (term < sum * 1e-17) {
+            break;
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Dot product with four partial sums
+ *
+ * The partial sums keep the multiply-adds independent.
+ *
+ * @param a First vector
+ * @param b Second vector
+ * @param count Number of elements
+ * @return T Sum of a[k] * b[k]
+ */
+template<typename T>
+T dotProduct(const T* a, const T* b, size_t count) {
+    T s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t k = 0;
+    for (; k + 4 <= count; k += 4) {
+        s0 += a[k] * b[k];
+        s1 += a[k + 1] * b[k + 1];
+        s2 += a[k + 2] * b[k + 2];
+        s3 += a[k + 3] * b[k + 3];
+    }
+    for (; k < count; ++k) {
+        s0 += a[k] * b[k];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * @brief Push a sample into a double-written FIR history
+ *
+ * Each sample is stored at index and index + length, so the newest length
+ * samples are always contiguous, oldest first, right after the write
+ * position.
+ *
+ * @param history History of 2 * length samples
+ * @param length FIR length
+ * @param index Write position (advanced, wraps at length)
+ * @param sample New sample
+ * @return const T* Newest length samples, oldest first
+ */
+template<typename T>
+const T* pushHistory(T* history, uint32_t length, uint32_t& index, T sample) {
+    history[index] = sample;
+    history[index + length] = sample;
+    const T* window = history + index + 1;
+    index = (index + 1 == length) ? 0 : index + 1;
+    return window;
+}
+
+} // namespace internal
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,287 @@
+#include "fmus/dsp/fixed_point.h"
+#include "fmus/core/logging.h"
+#include "fft_kernels.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace fmus {
+namespace dsp {
+
+namespace {
+
+// Each output component of a radix-2 butterfly is at most (1 + sqrt(2))
+// times the largest input component; two halvings always suffice
+template<typename Q>
+uint32_t stageShift(Q peak) {
+    double bound = (1.0 + std::sqrt(2.0)) * static_cast<double>(peak);
+    uint32_t shift = 0;
+    while (shift < 2 && bound > static_cast<double>(FixedPointTraits<Q>::MAX_VALUE)) {
+        bound *= 0.5;
+        ++shift;
+    }
+    return shift;
+}
+
+// Twiddles use a symmetric range so |w| stays below one and no product
+// can be MIN * MIN
+template<typename Q>
+Q twiddleValue(double value) {
+    return std::max<Q>(toFixed<Q>(value), -FixedPointTraits<Q>::MAX_VALUE);
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Conversions
+//=============================================================================
+
+template<typename Q, typename T>
+void toFixed(const T* input, Q* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = toFixed<Q>(input[i]);
+    }
+}
+
+template<typename T, typename Q>
+void fromFixed(const Q* input, T* output, size_t count, int32_t exponent) {
+    const double scale = std::ldexp(1.0, exponent - static_cast<int32_t>(FixedPointTraits<Q>::FRACTION_BITS));
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = static_cast<T>(static_cast<double>(input[i]) * scale);
+    }
+}
+
+//=============================================================================
+// FixedFFTPlan Implementation
+//=============================================================================
+
+template<typename Q>
+FixedFFTPlan<Q>::FixedFFTPlan(uint32_t size, FFTDirection direction, SimdLevel simd)
+    : m_size(size), m_direction(direction), m_simdLevel(simd), m_log2Size(0) {
+    if (size < 2 || !FFT::isValidSize(size)) {
+        FMUS_LOG_ERROR("FixedFFTPlan size must be a power of 2 and at least 2");
+        return;
+    }
+
+    if (!isSimdLevelSupported(simd)) {
+        FMUS_LOG_WARNING("FixedFFTPlan: requested SIMD level not supported, using detected level");
+        m_simdLevel = detectSimdLevel();
+    }
+
+    while ((1u << m_log2Size) < size) {
+        ++m_log2Size;
+    }
+    internal::buildBitReverse(size, m_bitReverse);
+
+    const double sign = (direction == FFTDirection::Inverse) ? 1.0 : -1.0;
+    m_twiddleRe.reserve(size - 1);
+    m_twiddleIm.reserve(size - 1);
+    for (uint32_t h = 1; h < size; h *= 2) {
+        for (uint32_t j = 0; j < h; ++j) {
+            double angle = sign * M_PI * static_cast<double>(j) / static_cast<double>(h);
+            m_twiddleRe.push_back(twiddleValue<Q>(std::cos(angle)));
+            m_twiddleIm.push_back(twiddleValue<Q>(std::sin(angle)));
+        }
+    }
+}
+
+template<typename Q>
+core::Result<int32_t> FixedFFTPlan<Q>::execute(Q* real, Q* imag) const {
+    if (!isValid()) {
+        return core::makeError<int32_t>(core::ErrorCode::InvalidArgument, "FixedFFTPlan was built for an invalid size");
+    }
+    if (real == nullptr || imag == nullptr) {
+        return core::makeError<int32_t>(core::ErrorCode::InvalidArgument, "FixedFFTPlan input is null");
+    }
+
+    using Acc = typename FixedPointTraits<Q>::Accumulator;
+    const uint32_t n = m_size;
+    for (uint32_t i = 0; i < n; ++i) {
+        uint32_t j = m_bitReverse[i];
+        if (i < j) {
+            std::swap(real[i], real[j]);
+            std::swap(imag[i], imag[j]);
+        }
+    }
+
+    // Separate pass so the compiler can vectorize the reduction
+    Acc peak = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        peak = std::max(peak, std::max(std::abs(static_cast<Acc>(real[i])), std::abs(static_cast<Acc>(imag[i]))));
+    }
+
+    // Each stage reports its output peak, which sets the next stage's shift
+    Q stagePeak = saturate<Q>(peak);
+    int32_t exponent = 0;
+    const Q* twiddleRe = m_twiddleRe.data();
+    const Q* twiddleIm = m_twiddleIm.data();
+    for (uint32_t h = 1; h < n; h *= 2) {
+        uint32_t shift = stageShift(stagePeak);
+        stagePeak = internal::fixedRadix2Stage(m_simdLevel, real, imag, n, h, twiddleRe, twiddleIm, shift);
+        exponent += static_cast<int32_t>(shift);
+        twiddleRe += h;
+        twiddleIm += h;
+    }
+
+    if (m_direction == FFTDirection::Inverse) {
+        exponent -= static_cast<int32_t>(m_log2Size);
+    }
+    return core::makeOk<int32_t>(std::move(exponent));
+}
+
+//=============================================================================
+// FIRFilterQ15 Implementation
+//=============================================================================
+
+FIRFilterQ15::FIRFilterQ15(const std::vector<float>& coefficients, SimdLevel simd)
+    : m_position(0), m_simdLevel(simd) {
+    if (!isSimdLevelSupported(simd)) {
+        FMUS_LOG_WARNING("FIRFilterQ15: requested SIMD level not supported, using detected level");
+        m_simdLevel = detectSimdLevel();
+    }
+
+    bool clipped = false;
+    m_coefficients.reserve(coefficients.size());
+    for (float c : coefficients) {
+        clipped = clipped || c >= 1.0f || c < -1.0f;
+        // INT16_MIN is excluded so the SIMD pairwise sums cannot overflow
+        m_coefficients.push_back(std::max<int16_t>(toFixed<int16_t>(c), -INT16_MAX));
+    }
+    if (clipped) {
+        FMUS_LOG_WARNING("FIRFilterQ15 coefficients outside [-1, 1) were saturated");
+    }
+    if (m_coefficients.empty()) {
+        FMUS_LOG_ERROR("FIRFilterQ15 needs at least one coefficient, using a pass-through tap");
+        m_coefficients.push_back(INT16_MAX);
+    }
+
+    m_history.assign(2 * m_coefficients.size(), 0);
+}
+
+int16_t FIRFilterQ15::process(int16_t input) {
+    const uint32_t taps = getTapCount();
+    m_position = (m_position == 0) ? taps - 1 : m_position - 1;
+    m_history[m_position] = input;
+    m_history[m_position + taps] = input;
+
+    // history[position + k] holds x[n - k]
+    int64_t acc = internal::dotProductQ15(m_simdLevel, m_history.data() + m_position, m_coefficients.data(), taps);
+    return saturate<int16_t>((acc + (1 << 14)) >> 15);
+}
+
+void FIRFilterQ15::process(const int16_t* input, int16_t* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = process(input[i]);
+    }
+}
+
+std::vector<int16_t> FIRFilterQ15::process(const std::vector<int16_t>& input) {
+    std::vector<int16_t> output(input.size());
+    process(input.data(), output.data(), input.size());
+    return output;
+}
+
+void FIRFilterQ15::reset() {
+    std::fill(m_history.begin(), m_history.end(), static_cast<int16_t>(0));
+    m_position = 0;
+}
+
+//=============================================================================
+// BiquadFilterQ15 Implementation
+//=============================================================================
+
+BiquadFilterQ15::BiquadFilterQ15(const std::vector<float>& coefficients) {
+    if (coefficients.size() % 5 != 0) {
+        FMUS_LOG_ERROR("BiquadFilterQ15 needs five coefficients per section, ignoring the remainder");
+    }
+
+    for (size_t offset = 0; offset + 5 <= coefficients.size(); offset += 5) {
+        const float* c = coefficients.data() + offset;
+        float largest = 0;
+        for (uint32_t i = 0; i < 5; ++i) {
+            largest = std::max(largest, std::abs(c[i]));
+        }
+
+        // Smallest power-of-2 scale that brings every coefficient below one
+        uint32_t postShift = 0;
+        while (postShift < 14 && std::ldexp(static_cast<double>(largest), -static_cast<int>(postShift)) >= 1.0) {
+            ++postShift;
+        }
+        auto scaled = [postShift](float value) {
+            return toFixed<int16_t>(std::ldexp(static_cast<double>(value), -static_cast<int>(postShift)));
+        };
+
+        Section section = {scaled(c[0]), scaled(c[1]), scaled(c[2]), scaled(c[3]), scaled(c[4]), postShift, 0, 0, 0, 0};
+        m_sections.push_back(section);
+    }
+}
+
+int16_t BiquadFilterQ15::process(int16_t input) {
+    int16_t output = input;
+    process(&input, &output, 1);
+    return output;
+}
+
+void BiquadFilterQ15::process(const int16_t* input, int16_t* output, size_t count) {
+    if (m_sections.empty()) {
+        std::copy(input, input + count, output);
+        return;
+    }
+
+    // Section by section over the whole block keeps each state in registers
+    const int16_t* source = input;
+    for (Section& s : m_sections) {
+        const uint32_t bits = 15 - s.postShift;
+        const int64_t round = static_cast<int64_t>(1) << (bits - 1);
+        int16_t x1 = s.x1, x2 = s.x2, y1 = s.y1, y2 = s.y2;
+        for (size_t i = 0; i < count; ++i) {
+            int16_t x = source[i];
+            int64_t acc = static_cast<int64_t>(s.b0) * x + static_cast<int64_t>(s.b1) * x1 +
+                          static_cast<int64_t>(s.b2) * x2 - static_cast<int64_t>(s.a1) * y1 -
+                          static_cast<int64_t>(s.a2) * y2;
+            int16_t y = saturate<int16_t>((acc + round) >> bits);
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            output[i] = y;
+        }
+        s.x1 = x1;
+        s.x2 = x2;
+        s.y1 = y1;
+        s.y2 = y2;
+        source = output;
+    }
+}
+
+std::vector<int16_t> BiquadFilterQ15::process(const std::vector<int16_t>& input) {
+    std::vector<int16_t> output(input.size());
+    process(input.data(), output.data(), input.size());
+    return output;
+}
+
+void BiquadFilterQ15::reset() {
+    for (Section& s : m_sections) {
+        s.x1 = s.x2 = s.y1 = s.y2 = 0;
+    }
+}
+
+//=============================================================================
+// Explicit Template Instantiations
+//=============================================================================
+
+template class FixedFFTPlan<int16_t>;
+template class FixedFFTPlan<int32_t>;
+
+template void toFixed<int16_t, float>(const float*, int16_t*, size_t);
+template void toFixed<int16_t, double>(const double*, int16_t*, size_t);
+template void toFixed<int32_t, float>(const float*, int32_t*, size_t);
+template void toFixed<int32_t, double>(const double*, int32_t*, size_t);
+template void fromFixed<float, int16_t>(const int16_t*, float*, size_t, int32_t);
+template void fromFixed<double, int16_t>(const int16_t*, double*, size_t, int32_t);
+template void fromFixed<float, int32_t>(const int32_t*, float*, size_t, int32_t);
+template void fromFixed<double, int32_t>(const int32_t*, double*, size_t, int32_t);
+
+} // namespace dsp
+} // namespace fmus
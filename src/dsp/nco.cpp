@@ -0,0 +1,314 @@
+#include "fmus/dsp/nco.h"
+#include "fmus/core/logging.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace fmus {
+namespace dsp {
+
+namespace {
+
+const uint32_t SINE_TABLE_BITS = 12;
+const uint32_t SINE_TABLE_SIZE = 1u << SINE_TABLE_BITS;
+const double PHASE_SCALE = 18446744073709551616.0;     // 2^64, one cycle
+const uint64_t QUARTER_CYCLE = 1ull << 62;
+
+// One cycle of sin with the step to the next entry, so interpolation is a
+// single multiply-add
+template<typename T>
+struct SineTable {
+    std::vector<T> value;
+    std::vector<T> slope;
+
+    SineTable() : value(SINE_TABLE_SIZE), slope(SINE_TABLE_SIZE) {
+        for (uint32_t i = 0; i < SINE_TABLE_SIZE; ++i) {
+            double a = std::sin(2.0 * M_PI * i / SINE_TABLE_SIZE);
+            double b = std::sin(2.0 * M_PI * (i + 1) / SINE_TABLE_SIZE);
+            value[i] = static_cast<T>(a);
+            slope[i] = static_cast<T>(b - a);
+        }
+    }
+};
+
+template<typename T>
+const SineTable<T>& sineTable() {
+    static const SineTable<T> table;
+    return table;
+}
+
+// The top bits of the phase select the entry, the next 32 the fraction
+template<typename T>
+inline T lookupSine(const T* value, const T* slope, uint64_t phase) {
+    const uint32_t index = static_cast<uint32_t>(phase >> (64 - SINE_TABLE_BITS));
+    const uint32_t fraction = static_cast<uint32_t>(phase >> (32 - SINE_TABLE_BITS));
+    return value[index] + static_cast<T>(fraction) * static_cast<T>(1.0 / 4294967296.0) * slope[index];
+}
+
+// Fraction of a cycle in [0, 1) as a 64-bit phase
+uint64_t toPhase(double cycles) {
+    const double scaled = (cycles - std::floor(cycles)) * PHASE_SCALE;
+    return (scaled >= PHASE_SCALE) ? 0 : static_cast<uint64_t>(scaled);
+}
+
+template<typename T>
+inline T phaseFraction(uint64_t phase) {
+    return static_cast<T>(phase >> 11) * static_cast<T>(1.0 / 9007199254740992.0);
+}
+
+template<typename T, typename Shape>
+void runOscillator(T* output, size_t count, uint64_t& phase, uint64_t& increment, uint64_t sweep, Shape shape) {
+    uint64_t p = phase;
+    uint64_t step = increment;
+    for (size_t n = 0; n < count; ++n) {
+        output[n] = shape(p);
+        p += step;
+        step += sweep;
+    }
+    phase = p;
+    increment = step;
+}
+
+template<typename T>
+void generateWaveform(Waveform waveform, T amplitude, T dutyCycle, T* output, size_t count,
+                      uint64_t& phase, uint64_t& increment, uint64_t sweep) {
+    const SineTable<T>& table = sineTable<T>();
+    const T* value = table.value.data();
+    const T* slope = table.slope.data();
+
+    switch (waveform) {
+        case Waveform::Sine:
+            runOscillator(output, count, phase, increment, sweep, [=](uint64_t p) {
+                return amplitude * lookupSine(value, slope, p);
+            });
+            break;
+        case Waveform::Cosine:
+            runOscillator(output, count, phase, increment, sweep, [=](uint64_t p) {
+                return amplitude * lookupSine(value, slope, p + QUARTER_CYCLE);
+            });
+            break;
+        case Waveform::Square: {
+            const uint64_t high = (dutyCycle >= 1) ? UINT64_MAX : toPhase(static_cast<double>(dutyCycle));
+            runOscillator(output, count, phase, increment, sweep, [=](uint64_t p) {
+                return (p < high) ? amplitude : -amplitude;
+            });
+            break;
+        }
+        case Waveform::Sawtooth:
+            runOscillator(output, count, phase, increment, sweep, [=](uint64_t p) {
+                return amplitude * (2 * phaseFraction<T>(p) - 1);
+            });
+            break;
+        case Waveform::Triangle:
+            runOscillator(output, count, phase, increment, sweep, [=](uint64_t p) {
+                T f = phaseFraction<T>(p);
+                return (f < static_cast<T>(0.5)) ? amplitude * (4 * f - 1) : amplitude * (3 - 4 * f);
+            });
+            break;
+    }
+}
+
+// Expands a seed into well-mixed generator state
+uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// NCO Implementation
+//=============================================================================
+
+template<typename T>
+NCO<T>::NCO(T sampleRate, T frequency, T amplitude, Waveform waveform, T phase)
+    : m_sampleRate(sampleRate), m_amplitude(amplitude), m_dutyCycle(static_cast<T>(0.5)),
+      m_waveform(waveform), m_phase(0), m_increment(0), m_sweep(0), m_sweepRemaining(0), m_sweepEnd(0) {
+    if (!(m_sampleRate > 0)) {
+        FMUS_LOG_ERROR("NCO: sample rate must be positive, setting to 1");
+        m_sampleRate = 1;
+    }
+    setFrequency(frequency);
+    setPhase(phase);
+}
+
+template<typename T>
+void NCO<T>::fill(T* output, size_t count) {
+    while (m_sweepRemaining > 0 && count > 0) {
+        const size_t length = static_cast<size_t>(std::min<uint64_t>(count, m_sweepRemaining));
+        generateWaveform(m_waveform, m_amplitude, m_dutyCycle, output, length, m_phase, m_increment, m_sweep);
+        output += length;
+        count -= length;
+        m_sweepRemaining -= length;
+        if (m_sweepRemaining == 0) {
+            m_increment = m_sweepEnd;
+            m_sweep = 0;
+        }
+    }
+    if (count > 0) {
+        generateWaveform(m_waveform, m_amplitude, m_dutyCycle, output, count, m_phase, m_increment, m_sweep);
+    }
+}
+
+template<typename T>
+std::vector<T> NCO<T>::generate(size_t count) {
+    std::vector<T> output(count);
+    fill(output.data(), count);
+    return output;
+}
+
+template<typename T>
+void NCO<T>::setFrequency(T frequency) {
+    m_increment = toPhase(static_cast<double>(frequency) / m_sampleRate);
+    m_sweep = 0;
+    m_sweepRemaining = 0;
+}
+
+template<typename T>
+void NCO<T>::sweepTo(T endFrequency, T duration) {
+    const double rate = static_cast<double>(m_sampleRate);
+    const uint64_t samples = static_cast<uint64_t>(std::llround(static_cast<double>(duration) * rate));
+    const uint64_t end = toPhase(static_cast<double>(endFrequency) / rate);
+    if (samples == 0) {
+        m_increment = end;
+        m_sweep = 0;
+        m_sweepRemaining = 0;
+        return;
+    }
+
+    // The step is taken at each sample's midpoint, so the phase at sample
+    // n matches f0 * t + k * t^2 / 2 of the continuous chirp
+    const double start = getFrequency();
+    const double step = (static_cast<double>(endFrequency) - start) / samples / rate;
+    m_sweep = static_cast<uint64_t>(std::llround(step * PHASE_SCALE));
+    m_increment = toPhase(start / rate + step / 2);
+    m_sweepRemaining = samples;
+    m_sweepEnd = end;
+}
+
+template<typename T>
+void NCO<T>::setPhase(T phase) {
+    m_phase = toPhase(static_cast<double>(phase) / (2.0 * M_PI));
+}
+
+template<typename T>
+void NCO<T>::setDutyCycle(T dutyCycle) {
+    if (dutyCycle < 0 || dutyCycle > 1) {
+        FMUS_LOG_WARNING("NCO: duty cycle should be between 0 and 1, clamping to valid range");
+        dutyCycle = std::clamp(dutyCycle, static_cast<T>(0), static_cast<T>(1));
+    }
+    m_dutyCycle = dutyCycle;
+}
+
+template<typename T>
+T NCO<T>::getFrequency() const {
+    return static_cast<T>(static_cast<double>(static_cast<int64_t>(m_increment)) / PHASE_SCALE * m_sampleRate);
+}
+
+template<typename T>
+T NCO<T>::getPhase() const {
+    return static_cast<T>(static_cast<double>(m_phase) / PHASE_SCALE * 2.0 * M_PI);
+}
+
+//=============================================================================
+// NoiseGenerator Implementation
+//=============================================================================
+
+template<typename T>
+NoiseGenerator<T>::NoiseGenerator(T standardDeviation, uint64_t seed)
+    : m_standardDeviation(standardDeviation) {
+    this->seed(seed);
+}
+
+template<typename T>
+void NoiseGenerator<T>::seed(uint64_t seed) {
+    if (seed == 0) {
+        std::random_device device;
+        seed = (static_cast<uint64_t>(device()) << 32) | device();
+    }
+    for (uint32_t l = 0; l < LANES; ++l) {
+        m_state0[l] = splitMix64(seed);
+        m_state1[l] = splitMix64(seed);
+    }
+    m_batchIndex = BATCH;
+}
+
+template<typename T>
+void NoiseGenerator<T>::refill() {
+    // xorshift128+ on every lane; the loop body is branch-free and
+    // independent across lanes
+    uint64_t bits[STEPS][LANES];
+    for (uint32_t step = 0; step < STEPS; ++step) {
+        for (uint32_t l = 0; l < LANES; ++l) {
+            uint64_t s1 = m_state0[l];
+            const uint64_t s0 = m_state1[l];
+            m_state0[l] = s0;
+            s1 ^= s1 << 23;
+            m_state1[l] = s1 ^ s0 ^ (s1 >> 17) ^ (s0 >> 26);
+            bits[step][l] = m_state1[l] + s0;
+        }
+    }
+
+    // Box-Muller: the high half gives the radius, the low half the angle
+    const SineTable<T>& table = sineTable<T>();
+    const uint64_t* random = &bits[0][0];
+    for (uint32_t i = 0; i < LANES * STEPS; ++i) {
+        const double uniform = (static_cast<double>(random[i] >> 32) + 1.0) * (1.0 / 4294967296.0);
+        const T radius = static_cast<T>(std::sqrt(-2.0 * std::log(uniform)));
+        const uint64_t angle = random[i] << 32;
+        m_batch[2 * i] = radius * lookupSine(table.value.data(), table.slope.data(), angle);
+        m_batch[2 * i + 1] = radius * lookupSine(table.value.data(), table.slope.data(), angle + QUARTER_CYCLE);
+    }
+    m_batchIndex = 0;
+}
+
+template<typename T>
+void NoiseGenerator<T>::fill(T* output, size_t count) {
+    for (size_t n = 0; n < count;) {
+        if (m_batchIndex == BATCH) {
+            refill();
+        }
+        const size_t length = std::min<size_t>(count - n, BATCH - m_batchIndex);
+        for (size_t i = 0; i < length; ++i) {
+            output[n + i] = m_standardDeviation * m_batch[m_batchIndex + i];
+        }
+        m_batchIndex += static_cast<uint32_t>(length);
+        n += length;
+    }
+}
+
+template<typename T>
+std::vector<T> NoiseGenerator<T>::generate(size_t count) {
+    std::vector<T> output(count);
+    fill(output.data(), count);
+    return output;
+}
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+std::string waveformToString(Waveform waveform) {
+    switch (waveform) {
+        case Waveform::Sine: return "Sine";
+        case Waveform::Cosine: return "Cosine";
+        case Waveform::Square: return "Square";
+        case Waveform::Sawtooth: return "Sawtooth";
+        case Waveform::Triangle: return "Triangle";
+        default: return "Unknown";
+    }
+}
+
+//=============================================================================
+// Explicit Template Instantiations
+//=============================================================================
+
+template class NCO<float>;
+template class NCO<double>;
+template class NoiseGenerator<float>;
+template class NoiseGenerator<double>;
+
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,195 @@
+#include "fmus/dsp/resampler.h"
+#include "fir_kernels.h"
+#include "fmus/core/logging.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+
+namespace fmus {
+namespace dsp {
+
+//=============================================================================
+// PolyphaseResampler Implementation
+//=============================================================================
+
+template<typename T>
+PolyphaseResampler<T>::PolyphaseResampler(uint32_t upFactor, uint32_t downFactor, uint32_t tapsPerPhase,
+                                          T bandwidth, T kaiserBeta)
+    : m_up(upFactor), m_down(downFactor), m_tapsPerPhase(tapsPerPhase), m_historyIndex(0), m_time(0) {
+    if (m_up == 0 || m_down == 0) {
+        FMUS_LOG_ERROR("PolyphaseResampler: factors must be positive, setting to 1");
+        m_up = std::max<uint32_t>(m_up, 1);
+        m_down = std::max<uint32_t>(m_down, 1);
+    }
+    if (m_tapsPerPhase == 0) {
+        FMUS_LOG_ERROR("PolyphaseResampler: taps per phase cannot be zero, setting to 1");
+        m_tapsPerPhase = 1;
+    }
+    if (bandwidth <= 0 || bandwidth > 1) {
+        FMUS_LOG_WARNING("PolyphaseResampler: bandwidth should be between 0 and 1, clamping to valid range");
+        bandwidth = std::clamp(bandwidth, static_cast<T>(0.01), static_cast<T>(1));
+    }
+    const uint32_t divisor = std::gcd(m_up, m_down);
+    m_up /= divisor;
+    m_down /= divisor;
+    // When decimating, the filter must span as many output periods as it
+    // would when interpolating, so each phase grows by M / L
+    if (m_down > m_up) {
+        m_tapsPerPhase = static_cast<uint32_t>(
+            (static_cast<uint64_t>(m_tapsPerPhase) * m_down + m_up - 1) / m_up);
+    }
+
+    // Windowed-sinc prototype at the upsampled rate, cut off below the
+    // lower of the two Nyquist rates, with a gain of L to undo the stuffing
+    const uint32_t length = m_up * m_tapsPerPhase;
+    m_center = length / 2;
+    const double cutoff = static_cast<double>(bandwidth) / std::max(m_up, m_down);
+    const double windowNorm = internal::besselI0(kaiserBeta);
+    std::vector<double> prototype(length);
+    double sum = 0;
+    for (uint32_t j = 0; j < length; ++j) {
+        double offset = static_cast<double>(j) - m_center;
+        double x = cutoff * offset;
+        double sinc = (offset == 0) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+        double edge = (m_center > 0) ? offset / m_center : 0.0;
+        double window = internal::besselI0(kaiserBeta * std::sqrt(std::max(0.0, 1.0 - edge * edge))) / windowNorm;
+        prototype[j] = cutoff * sinc * window;
+        sum += prototype[j];
+    }
+
+    // Phase p holds taps p, p + L, p + 2L, ..., reversed to match the
+    // history, which is ordered oldest input first
+    m_phases.resize(length);
+    for (uint32_t p = 0; p < m_up; ++p) {
+        for (uint32_t i = 0; i < m_tapsPerPhase; ++i) {
+            m_phases[p * m_tapsPerPhase + (m_tapsPerPhase - 1 - i)] =
+                static_cast<T>(prototype[p + i * m_up] * m_up / sum);
+        }
+    }
+
+    m_history.resize(2 * m_tapsPerPhase);
+    reset();
+}
+
+template<typename T>
+size_t PolyphaseResampler<T>::process(const T* input, size_t count, T* output) {
+    const uint32_t taps = m_tapsPerPhase;
+    size_t produced = 0;
+    for (size_t n = 0; n < count; ++n) {
+        const T* window = internal::pushHistory(m_history.data(), taps, m_historyIndex, input[n]);
+
+        // Outputs whose newest contributing input is this one
+        for (; m_time < m_up; m_time += m_down) {
+            output[produced++] = internal::dotProduct(m_phases.data() + m_time * taps, window, taps);
+        }
+        m_time -= m_up;
+    }
+    return produced;
+}
+
+template<typename T>
+std::vector<T> PolyphaseResampler<T>::process(const std::vector<T>& input) {
+    std::vector<T> output(getMaxOutputCount(input.size()));
+    output.resize(process(input.data(), input.size(), output.data()));
+    return output;
+}
+
+template<typename T>
+size_t PolyphaseResampler<T>::getMaxOutputCount(size_t inputCount) const {
+    return (inputCount * m_up + m_down - 1) / m_down + 1;
+}
+
+template<typename T>
+void PolyphaseResampler<T>::reset() {
+    std::fill(m_history.begin(), m_history.end(), static_cast<T>(0));
+    m_historyIndex = 0;
+    // The first output sits at input time 0, i.e. upsampled time m_center
+    m_time = m_center;
+}
+
+//=============================================================================
+// FarrowResampler Implementation
+//=============================================================================
+
+template<typename T>
+FarrowResampler<T>::FarrowResampler(double ratio)
+    : m_ratio(1.0), m_step(1.0) {
+    setRatio(ratio);
+    reset();
+}
+
+template<typename T>
+void FarrowResampler<T>::setRatio(double ratio) {
+    if (!(ratio > 0)) {
+        FMUS_LOG_ERROR("FarrowResampler: ratio must be positive, keeping " + std::to_string(m_ratio));
+        return;
+    }
+    m_ratio = ratio;
+    m_step = 1.0 / ratio;
+}
+
+template<typename T>
+size_t FarrowResampler<T>::process(const T* input, size_t count, T* output) {
+    double position = m_position;
+    T x0 = m_taps[0], x1 = m_taps[1], x2 = m_taps[2], x3 = m_taps[3];
+    size_t produced = 0;
+    for (size_t n = 0; n < count; ++n) {
+        x0 = x1;
+        x1 = x2;
+        x2 = x3;
+        x3 = input[n];
+        position -= 1.0;
+        if (position >= 1.0) {
+            continue;
+        }
+
+        // Cubic through x0..x3 at t = -1, 0, 1, 2, evaluated at mu in [0, 1)
+        const T c1 = x2 - x0 / 3 - x1 / 2 - x3 / 6;
+        const T c2 = (x0 + x2) / 2 - x1;
+        const T c3 = (x1 - x2) / 2 + (x3 - x0) / 6;
+        do {
+            const T mu = static_cast<T>(position);
+            output[produced++] = ((c3 * mu + c2) * mu + c1) * mu + x1;
+            position += m_step;
+        } while (position < 1.0);
+    }
+    m_taps[0] = x0;
+    m_taps[1] = x1;
+    m_taps[2] = x2;
+    m_taps[3] = x3;
+    m_position = position;
+    return produced;
+}
+
+template<typename T>
+std::vector<T> FarrowResampler<T>::process(const std::vector<T>& input) {
+    std::vector<T> output(getMaxOutputCount(input.size()));
+    output.resize(process(input.data(), input.size(), output.data()));
+    return output;
+}
+
+template<typename T>
+size_t FarrowResampler<T>::getMaxOutputCount(size_t inputCount) const {
+    return static_cast<size_t>(std::ceil(static_cast<double>(inputCount) * m_ratio)) + 1;
+}
+
+template<typename T>
+void FarrowResampler<T>::reset() {
+    std::fill(m_taps, m_taps + 4, static_cast<T>(0));
+    // The first output sits at input time 0, which becomes m_taps[1] once
+    // three inputs have arrived
+    m_position = 3.0;
+}
+
+//=============================================================================
+// Explicit Template Instantiations
+//=============================================================================
+
+template class PolyphaseResampler<float>;
+template class PolyphaseResampler<double>;
+template class FarrowResampler<float>;
+template class FarrowResampler<double>;
+
+} // namespace dsp
+} // namespace fmus
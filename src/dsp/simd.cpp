@@ -0,0 +1,81 @@
+#include "fmus/dsp/simd.h"
+
+#if defined(FMUS_EMBED_COMPILER_MSVC) && (defined(FMUS_EMBED_ARCH_X64) || defined(FMUS_EMBED_ARCH_X86))
+#include <intrin.h>
+#endif
+
+namespace fmus {
+namespace dsp {
+
+namespace {
+
+SimdLevel probeSimdLevel() {
+#if defined(FMUS_EMBED_ARCH_X64) || defined(FMUS_EMBED_ARCH_X86)
+#if defined(FMUS_EMBED_COMPILER_MSVC)
+    int info[4] = {0, 0, 0, 0};
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+
+    // The OS must save YMM state for AVX code to be usable
+    bool ymmEnabled = osxsave && avx && ((_xgetbv(0) & 0x6) == 0x6);
+
+    if (avx2 && fma && ymmEnabled) {
+        return SimdLevel::AVX2;
+    }
+    return sse2 ? SimdLevel::SSE2 : SimdLevel::Scalar;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::AVX2;
+    }
+    return __builtin_cpu_supports("sse2") ? SimdLevel::SSE2 : SimdLevel::Scalar;
+#endif
+#elif defined(FMUS_EMBED_ARCH_ARM64) || defined(__ARM_NEON)
+    return SimdLevel::NEON;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+} // anonymous namespace
+
+SimdLevel detectSimdLevel() {
+    static const SimdLevel level = probeSimdLevel();
+    return level;
+}
+
+bool isSimdLevelSupported(SimdLevel level) {
+    SimdLevel best = detectSimdLevel();
+    switch (level) {
+        case SimdLevel::Scalar: return true;
+        case SimdLevel::SSE2: return best == SimdLevel::SSE2 || best == SimdLevel::AVX2;
+        case SimdLevel::AVX2: return best == SimdLevel::AVX2;
+        case SimdLevel::NEON: return best == SimdLevel::NEON;
+        default: return false;
+    }
+}
+
+std::string simdLevelToString(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "Scalar";
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::NEON: return "NEON";
+        default: return "Unknown";
+    }
+}
+
+} // namespace dsp
+} // namespace fmus
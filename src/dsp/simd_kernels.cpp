@@ -0,0 +1,348 @@
+#include "simd_kernels.h"
+#include "simd_ops.h"
+#include "fmus/dsp/sos_filter.h"
+
+namespace fmus {
+namespace dsp {
+namespace internal {
+
+namespace {
+
+//=============================================================================
+// Biquad cascade wavefront
+//=============================================================================
+
+// Coefficients and transposed direct form II state of up to W sections,
+// one per lane, plus the output each lane produced on its last active step
+template<typename T, uint32_t W>
+struct WavefrontLanes {
+    T b0[W], b1[W], b2[W], a1[W], a2[W];
+    T s1[W], s2[W];
+    T y[W];
+};
+
+// Unused lanes get zero coefficients, so they only ever output zero
+template<typename T, uint32_t W>
+void loadWavefront(WavefrontLanes<T, W>& lanes, const BiquadSection<T>* sections, const T* state, uint32_t count) {
+    for (uint32_t k = 0; k < W; ++k) {
+        const bool used = k < count;
+        lanes.b0[k] = used ? sections[k].b0 : 0;
+        lanes.b1[k] = used ? sections[k].b1 : 0;
+        lanes.b2[k] = used ? sections[k].b2 : 0;
+        lanes.a1[k] = used ? sections[k].a1 : 0;
+        lanes.a2[k] = used ? sections[k].a2 : 0;
+        lanes.s1[k] = used ? state[2 * k] : 0;
+        lanes.s2[k] = used ? state[2 * k + 1] : 0;
+        lanes.y[k] = 0;
+    }
+}
+
+template<typename T, uint32_t W>
+void saveWavefront(const WavefrontLanes<T, W>& lanes, T* state, uint32_t count) {
+    for (uint32_t k = 0; k < count; ++k) {
+        state[2 * k] = lanes.s1[k];
+        state[2 * k + 1] = lanes.s2[k];
+    }
+}
+
+// Ramp-up or ramp-down step: lane k filters sample t - k only while that
+// sample exists. Lanes run from last to first so lane k still sees the
+// output lane k - 1 produced on the previous step.
+template<typename T, uint32_t W>
+void wavefrontEdgeStep(WavefrontLanes<T, W>& lanes, uint32_t count, const T* input, T* output,
+                       size_t samples, size_t t) {
+    const uint32_t last = count - 1;
+    for (uint32_t k = count; k-- > 0;) {
+        if (t < k || t - k >= samples) {
+            continue;
+        }
+        T v = (k == 0) ? input[t] : lanes.y[k - 1];
+        T y = lanes.b0[k] * v + lanes.s1[k];
+        lanes.s1[k] = lanes.b1[k] * v + lanes.s2[k] - lanes.a1[k] * y;
+        lanes.s2[k] = lanes.b2[k] * v - lanes.a2[k] * y;
+        lanes.y[k] = y;
+    }
+    if (t >= last) {
+        output[t - last] = lanes.y[last];
+    }
+}
+
+// Two sections per pass with their state in registers: out-of-order
+// execution overlaps the second section of one sample with the first
+// section of the next, without the store-to-load latency of keeping the
+// state in memory
+template<typename T>
+void biquadCascadeScalar(const BiquadSection<T>* sections, T* state, uint32_t count,
+                         const T* input, T* output, size_t samples) {
+    const T* source = input;
+    for (uint32_t k = 0; k < count; k += 2) {
+        const BiquadSection<T> f = sections[k];
+        const BiquadSection<T> g = (k + 1 < count) ? sections[k + 1] : BiquadSection<T>{1, 0, 0, 0, 0};
+        T f1 = state[2 * k], f2 = state[2 * k + 1];
+        T g1 = (k + 1 < count) ? state[2 * k + 2] : 0;
+        T g2 = (k + 1 < count) ? state[2 * k + 3] : 0;
+        for (size_t n = 0; n < samples; ++n) {
+            T x = source[n];
+            T u = f.b0 * x + f1;
+            f1 = f.b1 * x + f2 - f.a1 * u;
+            f2 = f.b2 * x - f.a2 * u;
+            T y = g.b0 * u + g1;
+            g1 = g.b1 * u + g2 - g.a1 * y;
+            g2 = g.b2 * u - g.a2 * y;
+            output[n] = y;
+        }
+        state[2 * k] = f1;
+        state[2 * k + 1] = f2;
+        if (k + 1 < count) {
+            state[2 * k + 2] = g1;
+            state[2 * k + 3] = g2;
+        }
+        source = output;
+    }
+}
+
+//=============================================================================
+// First-order recursion look-ahead
+//=============================================================================
+
+// Unrolling y[n] = g * x[n] + p * y[n-1] over the W samples of a vector
+// gives y[t+i] = sum_{j<=i} g * p^(i-j) * x[t+j] + p^(i+1) * y[t-1]. The
+// input terms do not depend on earlier outputs, so the recursion itself
+// only carries one multiply-add per vector instead of one per sample.
+template<typename T, uint32_t W>
+struct OnePoleLookahead {
+    T columns[W][W];    ///< Lane i of column j: g * p^(i-j) for i >= j, else 0
+    T powers[W];        ///< Lane i: p^(i+1)
+};
+
+template<typename T, uint32_t W>
+void buildLookahead(OnePoleLookahead<T, W>& lookahead, T gain, T pole) {
+    for (uint32_t j = 0; j < W; ++j) {
+        for (uint32_t i = 0; i < W; ++i) {
+            lookahead.columns[j][i] = (i >= j) ? static_cast<T>(gain * std::pow(static_cast<double>(pole), i - j)) : 0;
+        }
+        lookahead.powers[j] = static_cast<T>(std::pow(static_cast<double>(pole), j + 1));
+    }
+}
+
+template<typename T>
+T onePoleScalar(T gain, T pole, T state, const T* input, T* output, size_t samples) {
+    for (size_t t = 0; t < samples; ++t) {
+        state = gain * input[t] + pole * state;
+        output[t] = state;
+    }
+    return state;
+}
+
+//=============================================================================
+// Vector kernels
+//=============================================================================
+
+// Compiled for the baseline target and again with AVX2 enabled, so the
+// 256-bit operations inline into the AVX2 loops (see simd_ops.h)
+namespace baseline {
+#define FMUS_DSP_KERNEL_TARGET
+#include "simd_kernels.inc"
+#undef FMUS_DSP_KERNEL_TARGET
+} // namespace baseline
+
+#if defined(FMUS_DSP_HAVE_AVX2)
+namespace avx2 {
+#define FMUS_DSP_KERNEL_TARGET FMUS_DSP_TARGET_AVX2
+#include "simd_kernels.inc"
+#undef FMUS_DSP_KERNEL_TARGET
+} // namespace avx2
+#endif
+
+// Runs the leading sections that fit in one vector and returns how many.
+// A single section gains nothing from a wavefront.
+uint32_t biquadWavefront(SimdLevel level, const BiquadSection<float>* sections, float* state, uint32_t count,
+                         const float* input, float* output, size_t samples) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2 && count > Sse2FloatOps::width) {
+        uint32_t used = std::min(count, Avx2FloatOps::width);
+        avx2::biquadWavefrontVec<Avx2FloatOps>(sections, state, used, input, output, samples);
+        return used;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if ((level == SimdLevel::AVX2 || level == SimdLevel::SSE2) && count > 1) {
+        uint32_t used = std::min(count, Sse2FloatOps::width);
+        baseline::biquadWavefrontVec<Sse2FloatOps>(sections, state, used, input, output, samples);
+        return used;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON)
+    if (level == SimdLevel::NEON && count > 1) {
+        uint32_t used = std::min(count, NeonFloatOps::width);
+        baseline::biquadWavefrontVec<NeonFloatOps>(sections, state, used, input, output, samples);
+        return used;
+    }
+#endif
+    (void)level;
+    biquadCascadeScalar(sections, state, count, input, output, samples);
+    return count;
+}
+
+uint32_t biquadWavefront(SimdLevel level, const BiquadSection<double>* sections, double* state, uint32_t count,
+                         const double* input, double* output, size_t samples) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2 && count > Sse2DoubleOps::width) {
+        uint32_t used = std::min(count, Avx2DoubleOps::width);
+        avx2::biquadWavefrontVec<Avx2DoubleOps>(sections, state, used, input, output, samples);
+        return used;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if ((level == SimdLevel::AVX2 || level == SimdLevel::SSE2) && count > 1) {
+        uint32_t used = std::min(count, Sse2DoubleOps::width);
+        baseline::biquadWavefrontVec<Sse2DoubleOps>(sections, state, used, input, output, samples);
+        return used;
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON_F64)
+    if (level == SimdLevel::NEON && count > 1) {
+        uint32_t used = std::min(count, NeonDoubleOps::width);
+        baseline::biquadWavefrontVec<NeonDoubleOps>(sections, state, used, input, output, samples);
+        return used;
+    }
+#endif
+    (void)level;
+    biquadCascadeScalar(sections, state, count, input, output, samples);
+    return count;
+}
+
+float onePoleDispatch(SimdLevel level, float gain, float pole, float state,
+                      const float* input, float* output, size_t samples) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2) {
+        return avx2::onePoleVec<Avx2FloatOps>(gain, pole, state, input, output, samples);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if (level == SimdLevel::SSE2) {
+        return baseline::onePoleVec<Sse2FloatOps>(gain, pole, state, input, output, samples);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON)
+    if (level == SimdLevel::NEON) {
+        return baseline::onePoleVec<NeonFloatOps>(gain, pole, state, input, output, samples);
+    }
+#endif
+    (void)level;
+    return onePoleScalar(gain, pole, state, input, output, samples);
+}
+
+double onePoleDispatch(SimdLevel level, double gain, double pole, double state,
+                       const double* input, double* output, size_t samples) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2) {
+        return avx2::onePoleVec<Avx2DoubleOps>(gain, pole, state, input, output, samples);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if (level == SimdLevel::SSE2) {
+        return baseline::onePoleVec<Sse2DoubleOps>(gain, pole, state, input, output, samples);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON_F64)
+    if (level == SimdLevel::NEON) {
+        return baseline::onePoleVec<NeonDoubleOps>(gain, pole, state, input, output, samples);
+    }
+#endif
+    (void)level;
+    return onePoleScalar(gain, pole, state, input, output, samples);
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Dispatch
+//=============================================================================
+
+int64_t dotProductQ15(SimdLevel level, const int16_t* a, const int16_t* b, uint32_t count) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2) {
+        return avx2::dotProductQ15Vec<Avx2Q15Ops>(a, b, count);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if (level == SimdLevel::SSE2) {
+        return baseline::dotProductQ15Vec<Sse2Q15Ops>(a, b, count);
+    }
+#endif
+    (void)level;
+    int64_t sum = 0;
+    for (uint32_t k = 0; k < count; ++k) {
+        sum += static_cast<int32_t>(a[k]) * b[k];
+    }
+    return sum;
+}
+
+template<>
+BlockMoments<float> blockMoments<float>(SimdLevel level, const float* data, size_t count) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2) {
+        return avx2::blockMomentsVec<Avx2FloatOps>(data, count);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if (level == SimdLevel::SSE2) {
+        return baseline::blockMomentsVec<Sse2FloatOps>(data, count);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON)
+    if (level == SimdLevel::NEON) {
+        return baseline::blockMomentsVec<NeonFloatOps>(data, count);
+    }
+#endif
+    (void)level;
+    return baseline::blockMomentsVec<ScalarOps<float>>(data, count);
+}
+
+template<>
+BlockMoments<double> blockMoments<double>(SimdLevel level, const double* data, size_t count) {
+#if defined(FMUS_DSP_HAVE_AVX2)
+    if (level == SimdLevel::AVX2) {
+        return avx2::blockMomentsVec<Avx2DoubleOps>(data, count);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_SSE2)
+    if (level == SimdLevel::SSE2) {
+        return baseline::blockMomentsVec<Sse2DoubleOps>(data, count);
+    }
+#endif
+#if defined(FMUS_DSP_HAVE_NEON_F64)
+    if (level == SimdLevel::NEON) {
+        return baseline::blockMomentsVec<NeonDoubleOps>(data, count);
+    }
+#endif
+    (void)level;
+    return baseline::blockMomentsVec<ScalarOps<double>>(data, count);
+}
+
+template<typename T>
+void biquadCascade(SimdLevel level, const BiquadSection<T>* sections, T* state, uint32_t count,
+                   const T* input, T* output, size_t samples) {
+    const T* source = input;
+    for (uint32_t first = 0; first < count;) {
+        first += biquadWavefront(level, sections + first, state + 2 * first, count - first, source, output, samples);
+        source = output;
+    }
+}
+
+template<typename T>
+void onePole(SimdLevel level, T gain, T pole, T& state, const T* input, T* output, size_t samples) {
+    state = onePoleDispatch(level, gain, pole, state, input, output, samples);
+}
+
+template void biquadCascade<float>(SimdLevel, const BiquadSection<float>*, float*, uint32_t,
+                                  const float*, float*, size_t);
+template void biquadCascade<double>(SimdLevel, const BiquadSection<double>*, double*, uint32_t,
+                                   const double*, double*, size_t);
+template void onePole<float>(SimdLevel, float, float, float&, const float*, float*, size_t);
+template void onePole<double>(SimdLevel, double, double, double&, const double*, double*, size_t);
+
+} // namespace internal
+} // namespace dsp
+} // namespace fmus
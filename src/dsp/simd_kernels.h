@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ * @file simd_kernels.h
+ * @brief Internal SIMD kernels outside the FFT (not part of the public API)
+ *
+ * Filter and statistics inner loops with one implementation per SIMD
+ * level, sharing the operation sets of simd_ops.h with the FFT kernels.
+ * The Q15 dot product serves the fixed-point FIR filter, the biquad
+ * cascade SOSFilter blocks, the one-pole kernel the RC filters' blocks and
+ * the block moments RunningStats.
+ */
+
+#include "fmus/dsp/simd.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace fmus {
+namespace dsp {
+
+template<typename T>
+struct BiquadSection;
+
+namespace internal {
+
+/**
+ * @brief Exact Q15 dot product
+ *
+ * @param level SIMD level (must be supported)
+ * @param a First vector
+ * @param b Second vector (must not contain INT16_MIN)
+ * @param count Number of elements
+ * @return int64_t Sum of a[k] * b[k] (Q30)
+ */
+int64_t dotProductQ15(SimdLevel level, const int16_t* a, const int16_t* b, uint32_t count);
+
+/**
+ * @brief Run a block through a biquad cascade (transposed direct form II)
+ *
+ * Consecutive sections are processed as a wavefront across SIMD lanes,
+ * one section per lane; the result matches running the sections one
+ * sample at a time up to rounding.
+ *
+ * @param level SIMD level (must be supported)
+ * @param sections Section coefficients
+ * @param state s1, s2 per section (updated)
+ * @param count Number of sections
+ * @param input Input samples
+ * @param output Output samples (may alias input)
+ * @param samples Number of samples
+ */
+template<typename T>
+void biquadCascade(SimdLevel level, const BiquadSection<T>* sections, T* state, uint32_t count,
+                   const T* input, T* output, size_t samples);
+
+/**
+ * @brief Run a block through y[n] = gain * x[n] + pole * y[n-1]
+ *
+ * Vector levels unroll the recursion over the vector width, so it only
+ * advances once per vector; the result matches the sample-by-sample
+ * recursion up to rounding.
+ *
+ * @param level SIMD level (must be supported)
+ * @param gain Input gain
+ * @param pole Feedback coefficient
+ * @param state y[n-1] before the block (updated to the last output)
+ * @param input Input samples
+ * @param output Output samples (may alias input)
+ * @param samples Number of samples
+ */
+template<typename T>
+void onePole(SimdLevel level, T gain, T pole, T& state, const T* input, T* output, size_t samples);
+
+/**
+ * @brief Moments produced by blockMoments
+ */
+template<typename T>
+struct BlockMoments {
+    T sum;                  ///< sum x
+    T min;                  ///< Smallest sample
+    T max;                  ///< Largest sample
+    T squaredDeviations;    ///< sum (x - mean)^2 about the block's own mean
+};
+
+/**
+ * @brief Sum, range and squared deviations of a block in two passes
+ *
+ * The second pass re-reads the block, so callers keep blocks small
+ * enough to stay in L1 cache.
+ *
+ * @param level SIMD level (must be supported)
+ * @param data Samples
+ * @param count Number of samples (at least 1)
+ * @return BlockMoments<T> Block moments
+ */
+template<typename T>
+BlockMoments<T> blockMoments(SimdLevel level, const T* data, size_t count);
+
+template<> BlockMoments<float> blockMoments<float>(SimdLevel level, const float* data, size_t count);
+template<> BlockMoments<double> blockMoments<double>(SimdLevel level, const double* data, size_t count);
+
+} // namespace internal
+} // namespace dsp
+} // namespace fmus
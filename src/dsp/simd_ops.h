@@ -0,0 +1,333 @@
+#pragma once
+
+/**
+ * @file simd_ops.h
+ * @brief Internal SIMD operation sets shared by the kernel sources
+ *
+ * Each Ops struct wraps one instruction set behind the same static
+ * interface, so a kernel is written once as a template over Ops and
+ * instantiated per SIMD level. AVX2 operations carry a target attribute
+ * and are only called from kernels compiled for AVX2.
+ *
+ * Such a kernel lives in a .inc file and is declared with
+ * FMUS_DSP_KERNEL_TARGET. Its source file includes the .inc twice: in a
+ * `baseline` namespace with the macro empty, and in an `avx2` namespace
+ * with the macro set to FMUS_DSP_TARGET_AVX2. The AVX2 instances are then
+ * compiled for AVX2 from the same body, which is never written twice.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define FMUS_DSP_HAVE_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#if defined(FMUS_DSP_HAVE_SSE2) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+    #define FMUS_DSP_HAVE_AVX2 1
+    #include <immintrin.h>
+    #if defined(__GNUC__) || defined(__clang__)
+        #define FMUS_DSP_TARGET_AVX2 __attribute__((target("avx2,fma")))
+    #else
+        #define FMUS_DSP_TARGET_AVX2
+    #endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+    #define FMUS_DSP_HAVE_NEON 1
+    #include <arm_neon.h>
+    #if defined(__aarch64__) || defined(_M_ARM64)
+        #define FMUS_DSP_HAVE_NEON_F64 1
+    #endif
+#endif
+
+namespace fmus {
+namespace dsp {
+namespace internal {
+
+//=============================================================================
+// Vector operation sets
+//=============================================================================
+
+template<typename T>
+struct ScalarOps {
+    using Scalar = T;
+    using Vec = T;
+    static constexpr uint32_t width = 1;
+
+    static Vec load(const T* p) { return *p; }
+    static Vec broadcast(T v) { return v; }
+    static void store(T* p, Vec v) { *p = v; }
+    static Vec add(Vec a, Vec b) { return a + b; }
+    static Vec sub(Vec a, Vec b) { return a - b; }
+    static Vec mul(Vec a, Vec b) { return a * b; }
+    static Vec min(Vec a, Vec b) { return std::min(a, b); }
+    static Vec max(Vec a, Vec b) { return std::max(a, b); }
+    static Vec sqrt(Vec a) { return std::sqrt(a); }
+    static Vec norm(const T* p) { return p[0] * p[0] + p[1] * p[1]; }
+    static void cmul(Vec ar, Vec ai, Vec wr, Vec wi, Vec& outRe, Vec& outIm) {
+        outRe = ar * wr - ai * wi;
+        outIm = ar * wi + ai * wr;
+    }
+};
+
+#if defined(FMUS_DSP_HAVE_SSE2)
+struct Sse2FloatOps {
+    using Scalar = float;
+    using Vec = __m128;
+    static constexpr uint32_t width = 4;
+
+    static Vec load(const float* p) { return _mm_loadu_ps(p); }
+    static Vec broadcast(float v) { return _mm_set1_ps(v); }
+    static void store(float* p, Vec v) { _mm_storeu_ps(p, v); }
+    static Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+    static Vec min(Vec a, Vec b) { return _mm_min_ps(a, b); }
+    static Vec max(Vec a, Vec b) { return _mm_max_ps(a, b); }
+    static Vec sqrt(Vec a) { return _mm_sqrt_ps(a); }
+    static Vec shiftIn(Vec v, float x) {
+        return _mm_move_ss(_mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)), _mm_set_ss(x));
+    }
+    static Vec broadcastLast(Vec v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)); }
+    static Vec norm(const float* p) {
+        Vec a = _mm_loadu_ps(p);
+        Vec b = _mm_loadu_ps(p + 4);
+        a = _mm_mul_ps(a, a);
+        b = _mm_mul_ps(b, b);
+        return _mm_add_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    static void cmul(Vec ar, Vec ai, Vec wr, Vec wi, Vec& outRe, Vec& outIm) {
+        outRe = _mm_sub_ps(_mm_mul_ps(ar, wr), _mm_mul_ps(ai, wi));
+        outIm = _mm_add_ps(_mm_mul_ps(ar, wi), _mm_mul_ps(ai, wr));
+    }
+};
+
+struct Sse2DoubleOps {
+    using Scalar = double;
+    using Vec = __m128d;
+    static constexpr uint32_t width = 2;
+
+    static Vec load(const double* p) { return _mm_loadu_pd(p); }
+    static Vec broadcast(double v) { return _mm_set1_pd(v); }
+    static void store(double* p, Vec v) { _mm_storeu_pd(p, v); }
+    static Vec add(Vec a, Vec b) { return _mm_add_pd(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm_sub_pd(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm_mul_pd(a, b); }
+    static Vec min(Vec a, Vec b) { return _mm_min_pd(a, b); }
+    static Vec max(Vec a, Vec b) { return _mm_max_pd(a, b); }
+    static Vec sqrt(Vec a) { return _mm_sqrt_pd(a); }
+    static Vec shiftIn(Vec v, double x) { return _mm_unpacklo_pd(_mm_set_sd(x), v); }
+    static Vec broadcastLast(Vec v) { return _mm_unpackhi_pd(v, v); }
+    static Vec norm(const double* p) {
+        Vec a = _mm_loadu_pd(p);
+        Vec b = _mm_loadu_pd(p + 2);
+        a = _mm_mul_pd(a, a);
+        b = _mm_mul_pd(b, b);
+        return _mm_add_pd(_mm_unpacklo_pd(a, b), _mm_unpackhi_pd(a, b));
+    }
+    static void cmul(Vec ar, Vec ai, Vec wr, Vec wi, Vec& outRe, Vec& outIm) {
+        outRe = _mm_sub_pd(_mm_mul_pd(ar, wr), _mm_mul_pd(ai, wi));
+        outIm = _mm_add_pd(_mm_mul_pd(ar, wi), _mm_mul_pd(ai, wr));
+    }
+};
+#endif
+
+#if defined(FMUS_DSP_HAVE_AVX2)
+struct Avx2FloatOps {
+    using Scalar = float;
+    using Vec = __m256;
+    static constexpr uint32_t width = 8;
+
+    FMUS_DSP_TARGET_AVX2 static Vec load(const float* p) { return _mm256_loadu_ps(p); }
+    FMUS_DSP_TARGET_AVX2 static Vec broadcast(float v) { return _mm256_set1_ps(v); }
+    FMUS_DSP_TARGET_AVX2 static void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+    FMUS_DSP_TARGET_AVX2 static Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec min(Vec a, Vec b) { return _mm256_min_ps(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec max(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec sqrt(Vec a) { return _mm256_sqrt_ps(a); }
+    FMUS_DSP_TARGET_AVX2 static Vec shiftIn(Vec v, float x) {
+        Vec rotated = _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+        return _mm256_blend_ps(rotated, _mm256_set1_ps(x), 1);
+    }
+    FMUS_DSP_TARGET_AVX2 static Vec broadcastLast(Vec v) { return _mm256_permutevar8x32_ps(v, _mm256_set1_epi32(7)); }
+    FMUS_DSP_TARGET_AVX2 static Vec norm(const float* p) {
+        Vec a = _mm256_loadu_ps(p);
+        Vec b = _mm256_loadu_ps(p + 8);
+        a = _mm256_mul_ps(a, a);
+        b = _mm256_mul_ps(b, b);
+        // In-lane shuffles leave 64-bit blocks ordered 0, 2, 1, 3
+        Vec sum = _mm256_add_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)),
+                                _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sum), _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    FMUS_DSP_TARGET_AVX2 static void cmul(Vec ar, Vec ai, Vec wr, Vec wi, Vec& outRe, Vec& outIm) {
+        outRe = _mm256_fmsub_ps(ar, wr, _mm256_mul_ps(ai, wi));
+        outIm = _mm256_fmadd_ps(ar, wi, _mm256_mul_ps(ai, wr));
+    }
+};
+
+struct Avx2DoubleOps {
+    using Scalar = double;
+    using Vec = __m256d;
+    static constexpr uint32_t width = 4;
+
+    FMUS_DSP_TARGET_AVX2 static Vec load(const double* p) { return _mm256_loadu_pd(p); }
+    FMUS_DSP_TARGET_AVX2 static Vec broadcast(double v) { return _mm256_set1_pd(v); }
+    FMUS_DSP_TARGET_AVX2 static void store(double* p, Vec v) { _mm256_storeu_pd(p, v); }
+    FMUS_DSP_TARGET_AVX2 static Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec min(Vec a, Vec b) { return _mm256_min_pd(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec max(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec sqrt(Vec a) { return _mm256_sqrt_pd(a); }
+    FMUS_DSP_TARGET_AVX2 static Vec shiftIn(Vec v, double x) {
+        return _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 3)), _mm256_set1_pd(x), 1);
+    }
+    FMUS_DSP_TARGET_AVX2 static Vec broadcastLast(Vec v) { return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3)); }
+    FMUS_DSP_TARGET_AVX2 static Vec norm(const double* p) {
+        Vec a = _mm256_loadu_pd(p);
+        Vec b = _mm256_loadu_pd(p + 4);
+        a = _mm256_mul_pd(a, a);
+        b = _mm256_mul_pd(b, b);
+        Vec sum = _mm256_add_pd(_mm256_unpacklo_pd(a, b), _mm256_unpackhi_pd(a, b));
+        return _mm256_permute4x64_pd(sum, _MM_SHUFFLE(3, 1, 2, 0));
+    }
+    FMUS_DSP_TARGET_AVX2 static void cmul(Vec ar, Vec ai, Vec wr, Vec wi, Vec& outRe, Vec& outIm) {
+        outRe = _mm256_fmsub_pd(ar, wr, _mm256_mul_pd(ai, wi));
+        outIm = _mm256_fmadd_pd(ar, wi, _mm256_mul_pd(ai, wr));
+    }
+};
+#endif
+
+#if defined(FMUS_DSP_HAVE_NEON)
+struct NeonFloatOps {
+    using Scalar = float;
+    using Vec = float32x4_t;
+    static constexpr uint32_t width = 4;
+
+    static Vec load(const float* p) { return vld1q_f32(p); }
+    static Vec broadcast(float v) { return vdupq_n_f32(v); }
+    static void store(float* p, Vec v) { vst1q_f32(p, v); }
+    static Vec add(Vec a, Vec b) { return vaddq_f32(a, b); }
+    static Vec sub(Vec a, Vec b) { return vsubq_f32(a, b); }
+    static Vec mul(Vec a, Vec b) { return vmulq_f32(a, b); }
+    static Vec min(Vec a, Vec b) { return vminq_f32(a, b); }
+    static Vec max(Vec a, Vec b) { return vmaxq_f32(a, b); }
+    static Vec shiftIn(Vec v, float x) { return vextq_f32(vdupq_n_f32(x), v, 3); }
+    static Vec broadcastLast(Vec v) { return vdupq_n_f32(vgetq_lane_f32(v, 3)); }
+    static Vec norm(const float* p) {
+        float32x4x2_t z = vld2q_f32(p);
+        return vmlaq_f32(vmulq_f32(z.val[0], z.val[0]), z.val[1], z.val[1]);
+    }
+#if defined(FMUS_DSP_HAVE_NEON_F64)
+    static Vec sqrt(Vec a) { return vsqrtq_f32(a); }
+#else
+    // ARMv7 NEON has no vector square root: two Newton steps refine the
+    // reciprocal estimate, and zero (whose reciprocal is infinite) maps to zero
+    static Vec sqrt(Vec a) {
+        Vec r = vrsqrteq_f32(a);
+        r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a, r), r));
+        r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a, r), r));
+        return vbslq_f32(vceqq_f32(a, vdupq_n_f32(0.0f)), a, vmulq_f32(a, r));
+    }
+#endif
+    static void cmul(Vec ar, Vec ai, Vec wr, Vec wi, Vec& outRe, Vec& outIm) {
+        outRe = vmlsq_f32(vmulq_f32(ar, wr), ai, wi);
+        outIm = vmlaq_f32(vmulq_f32(ar, wi), ai, wr);
+    }
+};
+#endif
+
+#if defined(FMUS_DSP_HAVE_NEON_F64)
+struct NeonDoubleOps {
+    using Scalar = double;
+    using Vec = float64x2_t;
+    static constexpr uint32_t width = 2;
+
+    static Vec load(const double* p) { return vld1q_f64(p); }
+    static Vec broadcast(double v) { return vdupq_n_f64(v); }
+    static void store(double* p, Vec v) { vst1q_f64(p, v); }
+    static Vec add(Vec a, Vec b) { return vaddq_f64(a, b); }
+    static Vec sub(Vec a, Vec b) { return vsubq_f64(a, b); }
+    static Vec mul(Vec a, Vec b) { return vmulq_f64(a, b); }
+    static Vec min(Vec a, Vec b) { return vminq_f64(a, b); }
+    static Vec max(Vec a, Vec b) { return vmaxq_f64(a, b); }
+    static Vec sqrt(Vec a) { return vsqrtq_f64(a); }
+    static Vec shiftIn(Vec v, double x) { return vextq_f64(vdupq_n_f64(x), v, 1); }
+    static Vec broadcastLast(Vec v) { return vdupq_laneq_f64(v, 1); }
+    static Vec norm(const double* p) {
+        float64x2x2_t z = vld2q_f64(p);
+        return vfmaq_f64(vmulq_f64(z.val[0], z.val[0]), z.val[1], z.val[1]);
+    }
+    static void cmul(Vec ar, Vec ai, Vec wr, Vec wi, Vec& outRe, Vec& outIm) {
+        outRe = vfmsq_f64(vmulq_f64(ar, wr), ai, wi);
+        outIm = vfmaq_f64(vmulq_f64(ar, wi), ai, wr);
+    }
+};
+#endif
+
+#if defined(FMUS_DSP_HAVE_SSE2)
+// Integer operations for Q15 kernels. Widening and narrowing pair an
+// unpack with a pack that work within each 128-bit lane, so element
+// order is preserved for both register widths.
+struct Sse2Q15Ops {
+    using Vec = __m128i;
+    static constexpr uint32_t width = 8;
+
+    static Vec load(const int16_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(int16_t* p, Vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static Vec zero() { return _mm_setzero_si128(); }
+    static Vec broadcast32(int32_t v) { return _mm_set1_epi32(v); }
+    static Vec negate16(Vec a) { return _mm_subs_epi16(_mm_setzero_si128(), a); }
+    static Vec max16(Vec a, Vec b) { return _mm_max_epi16(a, b); }
+    static Vec abs16(Vec a) { return _mm_max_epi16(a, _mm_subs_epi16(_mm_setzero_si128(), a)); }
+    static Vec unpackLo16(Vec a, Vec b) { return _mm_unpacklo_epi16(a, b); }
+    static Vec unpackHi16(Vec a, Vec b) { return _mm_unpackhi_epi16(a, b); }
+    static Vec madd16(Vec a, Vec b) { return _mm_madd_epi16(a, b); }
+    static Vec widenLo16(Vec a) { return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16); }
+    static Vec widenHi16(Vec a) { return _mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16); }
+    static Vec add32(Vec a, Vec b) { return _mm_add_epi32(a, b); }
+    static Vec sub32(Vec a, Vec b) { return _mm_sub_epi32(a, b); }
+    static Vec shiftRight32(Vec a, __m128i count) { return _mm_sra_epi32(a, count); }
+    static Vec pack32(Vec lo, Vec hi) { return _mm_packs_epi32(lo, hi); }
+    static Vec widenLo32(Vec a) { return _mm_unpacklo_epi32(a, _mm_srai_epi32(a, 31)); }
+    static Vec widenHi32(Vec a) { return _mm_unpackhi_epi32(a, _mm_srai_epi32(a, 31)); }
+    static Vec add64(Vec a, Vec b) { return _mm_add_epi64(a, b); }
+};
+#endif
+
+#if defined(FMUS_DSP_HAVE_AVX2)
+struct Avx2Q15Ops {
+    using Vec = __m256i;
+    static constexpr uint32_t width = 16;
+
+    FMUS_DSP_TARGET_AVX2 static Vec load(const int16_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    FMUS_DSP_TARGET_AVX2 static void store(int16_t* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    FMUS_DSP_TARGET_AVX2 static Vec zero() { return _mm256_setzero_si256(); }
+    FMUS_DSP_TARGET_AVX2 static Vec broadcast32(int32_t v) { return _mm256_set1_epi32(v); }
+    FMUS_DSP_TARGET_AVX2 static Vec negate16(Vec a) { return _mm256_subs_epi16(_mm256_setzero_si256(), a); }
+    FMUS_DSP_TARGET_AVX2 static Vec max16(Vec a, Vec b) { return _mm256_max_epi16(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec abs16(Vec a) { return _mm256_max_epi16(a, _mm256_subs_epi16(_mm256_setzero_si256(), a)); }
+    FMUS_DSP_TARGET_AVX2 static Vec unpackLo16(Vec a, Vec b) { return _mm256_unpacklo_epi16(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec unpackHi16(Vec a, Vec b) { return _mm256_unpackhi_epi16(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec madd16(Vec a, Vec b) { return _mm256_madd_epi16(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec widenLo16(Vec a) { return _mm256_srai_epi32(_mm256_unpacklo_epi16(a, a), 16); }
+    FMUS_DSP_TARGET_AVX2 static Vec widenHi16(Vec a) { return _mm256_srai_epi32(_mm256_unpackhi_epi16(a, a), 16); }
+    FMUS_DSP_TARGET_AVX2 static Vec add32(Vec a, Vec b) { return _mm256_add_epi32(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec sub32(Vec a, Vec b) { return _mm256_sub_epi32(a, b); }
+    FMUS_DSP_TARGET_AVX2 static Vec shiftRight32(Vec a, __m128i count) { return _mm256_sra_epi32(a, count); }
+    FMUS_DSP_TARGET_AVX2 static Vec pack32(Vec lo, Vec hi) { return _mm256_packs_epi32(lo, hi); }
+    FMUS_DSP_TARGET_AVX2 static Vec widenLo32(Vec a) { return _mm256_unpacklo_epi32(a, _mm256_srai_epi32(a, 31)); }
+    FMUS_DSP_TARGET_AVX2 static Vec widenHi32(Vec a) { return _mm256_unpackhi_epi32(a, _mm256_srai_epi32(a, 31)); }
+    FMUS_DSP_TARGET_AVX2 static Vec add64(Vec a, Vec b) { return _mm256_add_epi64(a, b); }
+};
+#endif
+
+} // namespace internal
+} // namespace dsp
+} // namespace fmus
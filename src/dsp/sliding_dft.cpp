@@ -0,0 +1,281 @@
+#include "fmus/dsp/sliding_dft.h"
+#include "fmus/core/logging.h"
+#include <algorithm>
+#include <cmath>
+
+namespace fmus {
+namespace dsp {
+
+//=============================================================================
+// SlidingDFTBank Implementation
+//=============================================================================
+
+template<typename T>
+SlidingDFTBank<T>::SlidingDFTBank(T sampleRate, uint32_t windowSize, const std::vector<T>& frequencies,
+                                  uint32_t channelCount)
+    : m_sampleRate(sampleRate), m_windowSize(windowSize), m_binCount(static_cast<uint32_t>(frequencies.size())),
+      m_channelCount(channelCount), m_frequencies(frequencies), m_position(0), m_ready(false) {
+    if (windowSize == 0) {
+        FMUS_LOG_ERROR("SlidingDFTBank window size must be at least 1, using 1");
+        m_windowSize = 1;
+    }
+    if (channelCount == 0) {
+        FMUS_LOG_ERROR("SlidingDFTBank needs at least one channel, using 1");
+        m_channelCount = 1;
+    }
+    if (sampleRate <= 0) {
+        FMUS_LOG_ERROR("SlidingDFTBank sample rate must be positive, using 1");
+        m_sampleRate = 1;
+    }
+
+    m_omega.resize(m_binCount);
+    for (uint32_t k = 0; k < m_binCount; ++k) {
+        if (frequencies[k] < 0 || frequencies[k] > m_sampleRate / 2) {
+            FMUS_LOG_WARNING("SlidingDFTBank frequency outside [0, Nyquist], values will alias");
+        }
+        m_omega[k] = 2.0 * M_PI * static_cast<double>(frequencies[k]) / static_cast<double>(m_sampleRate);
+    }
+
+    m_phasorRe.resize(m_binCount);
+    m_phasorIm.resize(m_binCount);
+    m_oldPhasorRe.resize(m_binCount);
+    m_oldPhasorIm.resize(m_binCount);
+    m_stepRe.resize(m_binCount);
+    m_stepIm.resize(m_binCount);
+    for (uint32_t k = 0; k < m_binCount; ++k) {
+        m_stepRe[k] = static_cast<T>(std::cos(m_omega[k]));
+        m_stepIm[k] = static_cast<T>(-std::sin(m_omega[k]));
+    }
+
+    const size_t lanes = static_cast<size_t>(m_channelCount) * m_binCount;
+    m_sumRe.resize(lanes);
+    m_sumIm.resize(lanes);
+    m_shadowRe.resize(lanes);
+    m_shadowIm.resize(lanes);
+    m_energy.resize(m_channelCount);
+    m_shadowEnergy.resize(m_channelCount);
+    m_history.resize(static_cast<size_t>(m_channelCount) * m_windowSize);
+    m_anchorPhase.resize(m_binCount);
+
+    reset();
+}
+
+template<typename T>
+std::vector<T> SlidingDFTBank<T>::harmonicFrequencies(T fundamental, uint32_t numHarmonics) {
+    std::vector<T> frequencies;
+    frequencies.reserve(numHarmonics + 1);
+    for (uint32_t h = 1; h <= numHarmonics + 1; ++h) {
+        frequencies.push_back(fundamental * static_cast<T>(h));
+    }
+    return frequencies;
+}
+
+template<typename T>
+void SlidingDFTBank<T>::reset() {
+    std::fill(m_sumRe.begin(), m_sumRe.end(), static_cast<T>(0));
+    std::fill(m_sumIm.begin(), m_sumIm.end(), static_cast<T>(0));
+    std::fill(m_shadowRe.begin(), m_shadowRe.end(), static_cast<T>(0));
+    std::fill(m_shadowIm.begin(), m_shadowIm.end(), static_cast<T>(0));
+    std::fill(m_energy.begin(), m_energy.end(), static_cast<T>(0));
+    std::fill(m_shadowEnergy.begin(), m_shadowEnergy.end(), static_cast<T>(0));
+    std::fill(m_history.begin(), m_history.end(), static_cast<T>(0));
+    std::fill(m_anchorPhase.begin(), m_anchorPhase.end(), 0.0);
+    m_position = 0;
+    m_ready = false;
+    anchorPhasors();
+}
+
+template<typename T>
+void SlidingDFTBank<T>::anchorPhasors() {
+    // Recompute the rotating phasors exactly at each window boundary so
+    // their rounding error never spans more than one window
+    for (uint32_t k = 0; k < m_binCount; ++k) {
+        double phase = m_anchorPhase[k];
+        double oldPhase = phase - m_omega[k] * m_windowSize;
+        m_phasorRe[k] = static_cast<T>(std::cos(phase));
+        m_phasorIm[k] = static_cast<T>(-std::sin(phase));
+        m_oldPhasorRe[k] = static_cast<T>(std::cos(oldPhase));
+        m_oldPhasorIm[k] = static_cast<T>(-std::sin(oldPhase));
+    }
+}
+
+template<typename T>
+void SlidingDFTBank<T>::processFrame(const T* frame) {
+    const uint32_t bins = m_binCount;
+    const T* pr = m_phasorRe.data();
+    const T* pi = m_phasorIm.data();
+    const T* qr = m_oldPhasorRe.data();
+    const T* qi = m_oldPhasorIm.data();
+
+    for (uint32_t c = 0; c < m_channelCount; ++c) {
+        T x = frame[c];
+        T& slot = m_history[static_cast<size_t>(c) * m_windowSize + m_position];
+        T old = slot;
+        slot = x;
+
+        m_energy[c] += x * x - old * old;
+        m_shadowEnergy[c] += x * x;
+
+        // S += x[n] * exp(-i*w*n) - x[n-N] * exp(-i*w*(n-N)); shadow omits the removal
+        T* sr = m_sumRe.data() + static_cast<size_t>(c) * bins;
+        T* si = m_sumIm.data() + static_cast<size_t>(c) * bins;
+        T* hr = m_shadowRe.data() + static_cast<size_t>(c) * bins;
+        T* hi = m_shadowIm.data() + static_cast<size_t>(c) * bins;
+        for (uint32_t k = 0; k < bins; ++k) {
+            T inRe = x * pr[k];
+            T inIm = x * pi[k];
+            sr[k] += inRe - old * qr[k];
+            si[k] += inIm - old * qi[k];
+            hr[k] += inRe;
+            hi[k] += inIm;
+        }
+    }
+
+    // Advance both phasors by one sample
+    for (uint32_t k = 0; k < bins; ++k) {
+        T re = m_phasorRe[k] * m_stepRe[k] - m_phasorIm[k] * m_stepIm[k];
+        T im = m_phasorRe[k] * m_stepIm[k] + m_phasorIm[k] * m_stepRe[k];
+        m_phasorRe[k] = re;
+        m_phasorIm[k] = im;
+        re = m_oldPhasorRe[k] * m_stepRe[k] - m_oldPhasorIm[k] * m_stepIm[k];
+        im = m_oldPhasorRe[k] * m_stepIm[k] + m_oldPhasorIm[k] * m_stepRe[k];
+        m_oldPhasorRe[k] = re;
+        m_oldPhasorIm[k] = im;
+    }
+
+    if (++m_position == m_windowSize) {
+        // The shadow sums now cover exactly the current window
+        m_position = 0;
+        m_ready = true;
+        m_sumRe.swap(m_shadowRe);
+        m_sumIm.swap(m_shadowIm);
+        m_energy.swap(m_shadowEnergy);
+        std::fill(m_shadowRe.begin(), m_shadowRe.end(), static_cast<T>(0));
+        std::fill(m_shadowIm.begin(), m_shadowIm.end(), static_cast<T>(0));
+        std::fill(m_shadowEnergy.begin(), m_shadowEnergy.end(), static_cast<T>(0));
+
+        for (uint32_t k = 0; k < m_binCount; ++k) {
+            m_anchorPhase[k] = std::fmod(m_anchorPhase[k] + m_omega[k] * m_windowSize, 2.0 * M_PI);
+        }
+        anchorPhasors();
+    }
+}
+
+template<typename T>
+void SlidingDFTBank<T>::process(T sample) {
+    if (m_channelCount != 1) {
+        FMUS_LOG_ERROR("SlidingDFTBank::process(T) requires a single-channel bank");
+        return;
+    }
+    processFrame(&sample);
+}
+
+template<typename T>
+void SlidingDFTBank<T>::process(const T* frames, size_t frameCount) {
+    if (frames == nullptr) {
+        return;
+    }
+    for (size_t f = 0; f < frameCount; ++f) {
+        processFrame(frames + f * m_channelCount);
+    }
+}
+
+template<typename T>
+bool SlidingDFTBank<T>::validIndex(uint32_t channel, uint32_t bin) const {
+    return channel < m_channelCount && bin < m_binCount;
+}
+
+template<typename T>
+std::complex<T> SlidingDFTBank<T>::getValue(uint32_t channel, uint32_t bin) const {
+    if (!validIndex(channel, bin)) {
+        return std::complex<T>(0, 0);
+    }
+
+    // Running sums are referenced to absolute time; the old-sample phasor is
+    // exp(-i*w*m0) for the oldest sample m0 in the window
+    size_t lane = static_cast<size_t>(channel) * m_binCount + bin;
+    std::complex<T> sum(m_sumRe[lane], m_sumIm[lane]);
+    std::complex<T> reference(m_oldPhasorRe[bin], -m_oldPhasorIm[bin]);
+    return sum * reference;
+}
+
+template<typename T>
+T SlidingDFTBank<T>::getMagnitude(uint32_t channel, uint32_t bin) const {
+    return std::abs(getValue(channel, bin));
+}
+
+template<typename T>
+T SlidingDFTBank<T>::getPhase(uint32_t channel, uint32_t bin) const {
+    return std::arg(getValue(channel, bin));
+}
+
+template<typename T>
+T SlidingDFTBank<T>::getAmplitude(uint32_t channel, uint32_t bin) const {
+    return 2 * getMagnitude(channel, bin) / static_cast<T>(m_windowSize);
+}
+
+template<typename T>
+core::Result<T> SlidingDFTBank<T>::calculateTHD(uint32_t channel) const {
+    if (channel >= m_channelCount || m_binCount < 2) {
+        return core::makeError<T>(core::ErrorCode::InvalidArgument, "THD needs a valid channel and at least one harmonic bin");
+    }
+    if (!m_ready) {
+        return core::makeError<T>(core::ErrorCode::NotInitialized, "Window not yet filled");
+    }
+
+    T fundamental = getMagnitude(channel, 0);
+    if (fundamental <= 0) {
+        return core::makeError<T>(core::ErrorCode::DataError, "Fundamental magnitude is zero");
+    }
+
+    T harmonicPower = 0;
+    for (uint32_t k = 1; k < m_binCount; ++k) {
+        T magnitude = getMagnitude(channel, k);
+        harmonicPower += magnitude * magnitude;
+    }
+
+    T thd = std::sqrt(harmonicPower) / fundamental * 100;
+    return core::makeOk<T>(std::move(thd));
+}
+
+template<typename T>
+core::Result<T> SlidingDFTBank<T>::calculateSNR(uint32_t channel, uint32_t bin) const {
+    if (!validIndex(channel, bin)) {
+        return core::makeError<T>(core::ErrorCode::InvalidArgument, "Invalid channel or bin");
+    }
+    if (!m_ready) {
+        return core::makeError<T>(core::ErrorCode::NotInitialized, "Window not yet filled");
+    }
+
+    // Mean power of a real sinusoid at bin k is 2|X_k|^2 / N^2 (|X_0|^2 / N^2 at DC)
+    const T n2 = static_cast<T>(m_windowSize) * static_cast<T>(m_windowSize);
+    auto binPower = [&](uint32_t k) {
+        T magnitude = getMagnitude(channel, k);
+        T scale = (m_frequencies[k] == 0) ? 1 : 2;
+        return scale * magnitude * magnitude / n2;
+    };
+
+    T signalPower = binPower(bin);
+    T trackedPower = 0;
+    for (uint32_t k = 0; k < m_binCount; ++k) {
+        trackedPower += binPower(k);
+    }
+    T noisePower = m_energy[channel] / static_cast<T>(m_windowSize) - trackedPower;
+
+    if (signalPower <= 0 || noisePower <= 0) {
+        return core::makeError<T>(core::ErrorCode::DataError, "Signal or noise power is zero");
+    }
+
+    T snr = 10 * std::log10(signalPower / noisePower);
+    return core::makeOk<T>(std::move(snr));
+}
+
+//=============================================================================
+// Explicit Template Instantiations
+//=============================================================================
+
+template class SlidingDFTBank<float>;
+template class SlidingDFTBank<double>;
+
+} // namespace dsp
+} // namespace fmus
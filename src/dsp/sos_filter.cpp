@@ -0,0 +1,471 @@
+#include "fmus/dsp/sos_filter.h"
+#include "fmus/core/logging.h"
+#include "simd_kernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace fmus {
+namespace dsp {
+
+namespace {
+
+using Complex = std::complex<double>;
+
+/**
+ * @brief Zeros, poles and gain of a filter (analog or digital)
+ */
+struct ZeroPoleGain {
+    std::vector<Complex> zeros;
+    std::vector<Complex> poles;
+    double gain;
+};
+
+// Highest prototype order accepted by designSOS
+const uint32_t MAX_DESIGN_ORDER = 64;
+
+// Sample rate of the design domain: normalized frequency 1 is Nyquist
+const double DESIGN_RATE = 2.0;
+
+Complex product(const std::vector<Complex>& values, Complex offset) {
+    Complex result = 1.0;
+    for (const Complex& v : values) {
+        result *= offset - v;
+    }
+    return result;
+}
+
+//=============================================================================
+// Analog prototypes (cutoff 1 rad/s)
+//=============================================================================
+
+ZeroPoleGain butterworthPrototype(uint32_t order) {
+    ZeroPoleGain zpk = {{}, {}, 1.0};
+    for (uint32_t k = 0; k < order; ++k) {
+        double m = 2.0 * k + 1.0 - order;
+        zpk.poles.push_back(-std::exp(Complex(0.0, M_PI * m / (2.0 * order))));
+    }
+    return zpk;
+}
+
+ZeroPoleGain chebyshev1Prototype(uint32_t order, double rippleDb) {
+    const double epsilon = std::sqrt(std::pow(10.0, 0.1 * rippleDb) - 1.0);
+    const double mu = std::asinh(1.0 / epsilon) / order;
+    ZeroPoleGain zpk = {{}, {}, 1.0};
+    for (uint32_t k = 0; k < order; ++k) {
+        double theta = M_PI * (2.0 * k + 1.0 - order) / (2.0 * order);
+        zpk.poles.push_back(-std::sinh(Complex(mu, theta)));
+    }
+    zpk.gain = product(zpk.poles, 0.0).real();
+    if (order % 2 == 0) {
+        // Even orders start at the bottom of the ripple
+        zpk.gain /= std::sqrt(1.0 + epsilon * epsilon);
+    }
+    return zpk;
+}
+
+ZeroPoleGain chebyshev2Prototype(uint32_t order, double attenuationDb) {
+    const double epsilon = 1.0 / std::sqrt(std::pow(10.0, 0.1 * attenuationDb) - 1.0);
+    const double mu = std::asinh(1.0 / epsilon) / order;
+    ZeroPoleGain zpk = {{}, {}, 1.0};
+    for (uint32_t k = 0; k < order; ++k) {
+        double m = 2.0 * k + 1.0 - order;
+        if (m != 0.0) {
+            // Zeros on the imaginary axis; the middle one of an odd order is at infinity
+            zpk.zeros.push_back(Complex(0.0, 1.0 / std::sin(M_PI * m / (2.0 * order))));
+        }
+        Complex p = -std::exp(Complex(0.0, M_PI * m / (2.0 * order)));
+        zpk.poles.push_back(1.0 / Complex(std::sinh(mu) * p.real(), std::cosh(mu) * p.imag()));
+    }
+    zpk.gain = (product(zpk.poles, 0.0) / product(zpk.zeros, 0.0)).real();
+    return zpk;
+}
+
+//=============================================================================
+// Frequency transformations and bilinear transform
+//=============================================================================
+
+void toLowPass(ZeroPoleGain& zpk, double cutoff) {
+    const size_t degree = zpk.poles.size() - zpk.zeros.size();
+    for (Complex& z : zpk.zeros) {
+        z *= cutoff;
+    }
+    for (Complex& p : zpk.poles) {
+        p *= cutoff;
+    }
+    zpk.gain *= std::pow(cutoff, static_cast<double>(degree));
+}
+
+void toHighPass(ZeroPoleGain& zpk, double cutoff) {
+    const size_t degree = zpk.poles.size() - zpk.zeros.size();
+    zpk.gain *= (product(zpk.zeros, 0.0) / product(zpk.poles, 0.0)).real();
+    for (Complex& z : zpk.zeros) {
+        z = cutoff / z;
+    }
+    for (Complex& p : zpk.poles) {
+        p = cutoff / p;
+    }
+    zpk.zeros.insert(zpk.zeros.end(), degree, Complex(0.0));
+}
+
+// s -> (s^2 + w0^2) / (s * bw): each root r maps to the pair solving
+// s^2 - r * bw * s + w0^2 = 0
+void splitRoots(std::vector<Complex>& roots, double center, double bandwidth) {
+    std::vector<Complex> result;
+    result.reserve(2 * roots.size());
+    for (const Complex& r : roots) {
+        Complex half = r * bandwidth / 2.0;
+        Complex root = std::sqrt(half * half - center * center);
+        result.push_back(half + root);
+        result.push_back(half - root);
+    }
+    roots.swap(result);
+}
+
+void toBandPass(ZeroPoleGain& zpk, double low, double high) {
+    const size_t degree = zpk.poles.size() - zpk.zeros.size();
+    const double bandwidth = high - low;
+    splitRoots(zpk.zeros, std::sqrt(low * high), bandwidth);
+    splitRoots(zpk.poles, std::sqrt(low * high), bandwidth);
+    zpk.zeros.insert(zpk.zeros.end(), degree, Complex(0.0));
+    zpk.gain *= std::pow(bandwidth, static_cast<double>(degree));
+}
+
+void toBandStop(ZeroPoleGain& zpk, double low, double high) {
+    const size_t degree = zpk.poles.size() - zpk.zeros.size();
+    const double bandwidth = high - low;
+    const double center = std::sqrt(low * high);
+    zpk.gain *= (product(zpk.zeros, 0.0) / product(zpk.poles, 0.0)).real();
+
+    // Low-pass to high-pass with unit cutoff, then to band-pass
+    for (Complex& z : zpk.zeros) {
+        z = 1.0 / z;
+    }
+    for (Complex& p : zpk.poles) {
+        p = 1.0 / p;
+    }
+    splitRoots(zpk.zeros, center, bandwidth);
+    splitRoots(zpk.poles, center, bandwidth);
+    for (size_t i = 0; i < degree; ++i) {
+        zpk.zeros.push_back(Complex(0.0, center));
+        zpk.zeros.push_back(Complex(0.0, -center));
+    }
+}
+
+// Zeros at infinity land on z = -1
+void bilinear(ZeroPoleGain& zpk) {
+    const double twiceRate = 2.0 * DESIGN_RATE;
+    const size_t degree = zpk.poles.size() - zpk.zeros.size();
+    zpk.gain *= (product(zpk.zeros, twiceRate) / product(zpk.poles, twiceRate)).real();
+    for (Complex& z : zpk.zeros) {
+        z = (twiceRate + z) / (twiceRate - z);
+    }
+    for (Complex& p : zpk.poles) {
+        p = (twiceRate + p) / (twiceRate - p);
+    }
+    zpk.zeros.insert(zpk.zeros.end(), degree, Complex(-1.0));
+}
+
+double prewarp(double frequency) {
+    return 2.0 * DESIGN_RATE * std::tan(M_PI * frequency / DESIGN_RATE);
+}
+
+//=============================================================================
+// Pairing into sections
+//=============================================================================
+
+bool isReal(const Complex& value) {
+    return std::abs(value.imag()) <= 1e-10 * std::max(1.0, std::abs(value));
+}
+
+/**
+ * @brief One or two roots of a section (conjugate pair or real roots)
+ */
+struct RootGroup {
+    Complex first;
+    Complex second;
+    uint32_t count;     ///< 0, 1 or 2 roots
+};
+
+// Complex roots are taken from the upper half plane with their conjugates
+// implied; real roots are grouped two by two in sorted order
+std::vector<RootGroup> groupRoots(const std::vector<Complex>& roots) {
+    std::vector<RootGroup> groups;
+    std::vector<double> reals;
+    for (const Complex& r : roots) {
+        if (isReal(r)) {
+            reals.push_back(r.real());
+        } else if (r.imag() > 0) {
+            groups.push_back({r, std::conj(r), 2});
+        }
+    }
+    std::sort(reals.begin(), reals.end());
+    for (size_t i = 0; i < reals.size(); i += 2) {
+        if (i + 1 < reals.size()) {
+            groups.push_back({reals[i], reals[i + 1], 2});
+        } else {
+            groups.push_back({reals[i], 0.0, 1});
+        }
+    }
+    return groups;
+}
+
+// Coefficients c1, c2 of (1 - r1 z^-1)(1 - r2 z^-1) = 1 + c1 z^-1 + c2 z^-2
+void expandGroup(const RootGroup& group, double& c1, double& c2) {
+    if (group.count == 2) {
+        c1 = -(group.first + group.second).real();
+        c2 = (group.first * group.second).real();
+    } else if (group.count == 1) {
+        c1 = -group.first.real();
+        c2 = 0.0;
+    } else {
+        c1 = 0.0;
+        c2 = 0.0;
+    }
+}
+
+// Poles closest to the unit circle pick their zeros first, taking the
+// nearest remaining group; sections are then emitted in the opposite
+// order so the most resonant one comes last.
+template<typename T>
+std::vector<BiquadSection<T>> pairSections(const ZeroPoleGain& zpk) {
+    std::vector<RootGroup> poleGroups = groupRoots(zpk.poles);
+    std::vector<RootGroup> zeroGroups = groupRoots(zpk.zeros);
+    auto radius = [](const RootGroup& g) { return std::abs(g.first); };
+    std::sort(poleGroups.begin(), poleGroups.end(),
+              [&](const RootGroup& a, const RootGroup& b) { return radius(a) > radius(b); });
+
+    std::vector<RootGroup> matched(poleGroups.size(), RootGroup{0.0, 0.0, 0});
+    std::vector<bool> taken(zeroGroups.size(), false);
+    for (size_t i = 0; i < poleGroups.size(); ++i) {
+        size_t best = zeroGroups.size();
+        double bestDistance = 0;
+        for (size_t j = 0; j < zeroGroups.size(); ++j) {
+            if (taken[j] || zeroGroups[j].count > poleGroups[i].count) {
+                continue;
+            }
+            double distance = std::abs(zeroGroups[j].first - poleGroups[i].first);
+            if (best == zeroGroups.size() || distance < bestDistance) {
+                best = j;
+                bestDistance = distance;
+            }
+        }
+        if (best < zeroGroups.size()) {
+            taken[best] = true;
+            matched[i] = zeroGroups[best];
+        }
+    }
+
+    std::vector<BiquadSection<T>> sections;
+    for (size_t i = poleGroups.size(); i-- > 0;) {
+        double b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+        expandGroup(matched[i], b1, b2);
+        expandGroup(poleGroups[i], a1, a2);
+        double gain = sections.empty() ? zpk.gain : 1.0;
+        sections.push_back({static_cast<T>(gain), static_cast<T>(gain * b1), static_cast<T>(gain * b2),
+                            static_cast<T>(a1), static_cast<T>(a2)});
+    }
+    return sections;
+}
+
+// Each section contributes the degree of its longer polynomial
+template<typename T>
+uint32_t cascadeOrder(const std::vector<BiquadSection<T>>& sections) {
+    uint32_t order = 0;
+    for (const BiquadSection<T>& s : sections) {
+        if (s.a2 != 0 || s.b2 != 0) {
+            order += 2;
+        } else if (s.a1 != 0 || s.b1 != 0) {
+            order += 1;
+        }
+    }
+    return order;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Design
+//=============================================================================
+
+template<typename T>
+core::Result<std::vector<BiquadSection<T>>> designSOS(FilterImplementation prototype, FilterType type, uint32_t order,
+                                                      T cutoff, T upperCutoff, T ripple) {
+    using Sections = std::vector<BiquadSection<T>>;
+
+    if (order == 0 || order > MAX_DESIGN_ORDER) {
+        return core::makeError<Sections>(core::ErrorCode::InvalidArgument, "Filter order must be between 1 and 64");
+    }
+    const bool band = (type == FilterType::BandPass || type == FilterType::BandStop);
+    if (!(cutoff > 0 && cutoff < 1) || (band && !(upperCutoff > cutoff && upperCutoff < 1))) {
+        return core::makeError<Sections>(core::ErrorCode::InvalidArgument,
+                                         "Cutoff frequencies must be increasing and within (0, 1)");
+    }
+    if (prototype != FilterImplementation::Butterworth && !(ripple > 0)) {
+        return core::makeError<Sections>(core::ErrorCode::InvalidArgument, "Chebyshev ripple must be positive");
+    }
+
+    ZeroPoleGain zpk;
+    switch (prototype) {
+        case FilterImplementation::Butterworth:
+            zpk = butterworthPrototype(order);
+            break;
+        case FilterImplementation::Chebyshev1:
+            zpk = chebyshev1Prototype(order, static_cast<double>(ripple));
+            break;
+        case FilterImplementation::Chebyshev2:
+            zpk = chebyshev2Prototype(order, static_cast<double>(ripple));
+            break;
+        default:
+            return core::makeError<Sections>(core::ErrorCode::NotSupported,
+                                             "Only Butterworth and Chebyshev designs are supported");
+    }
+
+    const double low = prewarp(static_cast<double>(cutoff));
+    switch (type) {
+        case FilterType::LowPass:
+            toLowPass(zpk, low);
+            break;
+        case FilterType::HighPass:
+            toHighPass(zpk, low);
+            break;
+        case FilterType::BandPass:
+            toBandPass(zpk, low, prewarp(static_cast<double>(upperCutoff)));
+            break;
+        case FilterType::BandStop:
+            toBandStop(zpk, low, prewarp(static_cast<double>(upperCutoff)));
+            break;
+        default:
+            return core::makeError<Sections>(core::ErrorCode::NotSupported,
+                                             "Filter type has no IIR design");
+    }
+
+    bilinear(zpk);
+    return core::makeOk<Sections>(pairSections<T>(zpk));
+}
+
+//=============================================================================
+// SOSFilter Implementation
+//=============================================================================
+
+template<typename T>
+SOSFilter<T>::SOSFilter(const std::vector<BiquadSection<T>>& sections, FilterType type,
+                        FilterImplementation implementation, SimdLevel simd)
+    : m_sections(sections), m_type(type), m_implementation(implementation), m_order(0), m_simdLevel(simd) {
+    initialize(simd);
+}
+
+template<typename T>
+SOSFilter<T>::SOSFilter(FilterImplementation prototype, FilterType type, uint32_t order,
+                        T cutoff, T upperCutoff, T ripple, SimdLevel simd)
+    : m_type(type), m_implementation(prototype), m_order(0), m_simdLevel(simd) {
+    auto design = designSOS<T>(prototype, type, order, cutoff, upperCutoff, ripple);
+    if (design.isOk()) {
+        m_sections = design.value();
+    } else {
+        FMUS_LOG_ERROR("SOSFilter design failed, passing samples through: " + design.error().message());
+    }
+    initialize(simd);
+}
+
+template<typename T>
+SOSFilter<T>::~SOSFilter() = default;
+
+template<typename T>
+void SOSFilter<T>::initialize(SimdLevel simd) {
+    if (!isSimdLevelSupported(simd)) {
+        FMUS_LOG_WARNING("SOSFilter: requested SIMD level not supported, using detected level");
+        m_simdLevel = detectSimdLevel();
+    }
+
+    m_order = cascadeOrder(m_sections);
+    m_state.assign(2 * m_sections.size(), 0);
+}
+
+template<typename T>
+T SOSFilter<T>::process(T input) {
+    T x = input;
+    T* state = m_state.data();
+    for (const BiquadSection<T>& s : m_sections) {
+        T y = s.b0 * x + state[0];
+        state[0] = s.b1 * x + state[1] - s.a1 * y;
+        state[1] = s.b2 * x - s.a2 * y;
+        x = y;
+        state += 2;
+    }
+    return x;
+}
+
+template<typename T>
+void SOSFilter<T>::process(const T* input, T* output, size_t count) {
+    applyTuning();
+    if (m_sections.empty()) {
+        std::copy(input, input + count, output);
+        return;
+    }
+    internal::biquadCascade(m_simdLevel, m_sections.data(), m_state.data(), getSectionCount(),
+                            input, output, count);
+}
+
+template<typename T>
+std::vector<T> SOSFilter<T>::process(const std::vector<T>& input) {
+    std::vector<T> output(input.size());
+    process(input.data(), output.data(), input.size());
+    return output;
+}
+
+template<typename T>
+void SOSFilter<T>::reset() {
+    std::fill(m_state.begin(), m_state.end(), static_cast<T>(0));
+}
+
+template<typename T>
+void SOSFilter<T>::publishSections(const std::vector<BiquadSection<T>>& sections) {
+    Tuning& next = m_tuning.back();
+    next.sections.assign(sections.begin(), sections.end());
+    next.state.assign(2 * sections.size(), 0);
+    next.order = cascadeOrder(sections);
+    m_tuning.publish();
+}
+
+template<typename T>
+void SOSFilter<T>::applyTuning() {
+    if (!m_tuning.update()) {
+        return;
+    }
+    // The state carries over when the section count matches, so small
+    // coefficient changes do not restart the filter
+    Tuning& tuning = m_tuning.front();
+    m_sections.swap(tuning.sections);
+    if (m_state.size() != tuning.state.size()) {
+        m_state.swap(tuning.state);
+    }
+    m_order = tuning.order;
+}
+
+template<typename T>
+std::complex<T> SOSFilter<T>::getFrequencyResponse(T frequency) const {
+    const Complex z1 = std::exp(Complex(0.0, -M_PI * static_cast<double>(frequency)));
+    const Complex z2 = z1 * z1;
+    Complex response = 1.0;
+    for (const BiquadSection<T>& s : m_sections) {
+        Complex numerator = static_cast<double>(s.b0) + static_cast<double>(s.b1) * z1 + static_cast<double>(s.b2) * z2;
+        Complex denominator = 1.0 + static_cast<double>(s.a1) * z1 + static_cast<double>(s.a2) * z2;
+        response *= numerator / denominator;
+    }
+    return std::complex<T>(static_cast<T>(response.real()), static_cast<T>(response.imag()));
+}
+
+//=============================================================================
+// Explicit Template Instantiations
+//=============================================================================
+
+template class SOSFilter<float>;
+template class SOSFilter<double>;
+
+template core::Result<std::vector<BiquadSection<float>>> designSOS<float>(
+    FilterImplementation, FilterType, uint32_t, float, float, float);
+template core::Result<std::vector<BiquadSection<double>>> designSOS<double>(
+    FilterImplementation, FilterType, uint32_t, double, double, double);
+
+} // namespace dsp
+} // namespace fmus
@@ -0,0 +1,237 @@
+#include "fmus/dsp/spectral_density.h"
+#include "fmus/core/logging.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace fmus {
+namespace dsp {
+
+namespace {
+
+// Factors turning |X_k|^2 of a windowed frame into a one-sided density:
+// 2 / (fs * sum w^2), not doubled at DC and Nyquist
+template<typename T>
+std::vector<T> densityScale(uint32_t size, T sampleRate, WindowType window) {
+    auto coeffs = FFT::getWindow<T>(size, window);
+    double energy = 0;
+    for (T w : *coeffs) {
+        energy += static_cast<double>(w) * w;
+    }
+
+    std::vector<T> scale(size / 2 + 1, static_cast<T>(2.0 / (static_cast<double>(sampleRate) * energy)));
+    scale.front() /= 2;
+    if (size % 2 == 0) {
+        scale.back() /= 2;
+    }
+    return scale;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// WelchEstimator Implementation
+//=============================================================================
+
+template<typename T>
+WelchEstimator<T>::WelchEstimator(uint32_t segmentSize, T sampleRate, T overlapFactor, WindowType window,
+                                  WelchAveraging averaging, T smoothing)
+    : m_segmentSize(std::max<uint32_t>(segmentSize, 2)), m_sampleRate(sampleRate), m_averaging(averaging),
+      m_smoothing(smoothing), m_stft(std::max<uint32_t>(segmentSize, 2), sampleRate, overlapFactor, window),
+      m_segmentCount(0) {
+    if (segmentSize < 2) {
+        FMUS_LOG_ERROR("WelchEstimator segment size must be at least 2, using 2");
+    }
+    if (sampleRate <= 0) {
+        FMUS_LOG_ERROR("WelchEstimator sample rate must be positive, using 1");
+        m_sampleRate = 1;
+    }
+    if (smoothing <= 0 || smoothing > 1) {
+        FMUS_LOG_WARNING("WelchEstimator smoothing out of range, clamping to (0, 1]");
+        m_smoothing = std::min(std::max(smoothing, std::numeric_limits<T>::epsilon()), static_cast<T>(1));
+    }
+
+    m_scale = densityScale(m_segmentSize, m_sampleRate, window);
+    m_psd.assign(m_scale.size(), 0);
+    m_onSegment = [this](const std::complex<T>* bins, uint32_t binCount) { accumulate(bins, binCount); };
+}
+
+template<typename T>
+void WelchEstimator<T>::accumulate(const std::complex<T>* bins, uint32_t binCount) {
+    ++m_segmentCount;
+
+    // Running mean; exponential mode never weights below its smoothing
+    // factor but starts as a plain mean so early segments are not biased
+    T weight = static_cast<T>(1.0 / static_cast<double>(m_segmentCount));
+    if (m_averaging == WelchAveraging::Exponential) {
+        weight = std::max(weight, m_smoothing);
+    }
+
+    const T* scale = m_scale.data();
+    T* psd = m_psd.data();
+    for (uint32_t k = 0; k < binCount; ++k) {
+        T density = scale[k] * (bins[k].real() * bins[k].real() + bins[k].imag() * bins[k].imag());
+        psd[k] += weight * (density - psd[k]);
+    }
+}
+
+template<typename T>
+uint32_t WelchEstimator<T>::process(const T* samples, size_t count) {
+    return m_stft.processSamples(samples, count, m_onSegment);
+}
+
+template<typename T>
+uint32_t WelchEstimator<T>::process(const std::vector<T>& samples) {
+    return process(samples.data(), samples.size());
+}
+
+template<typename T>
+void WelchEstimator<T>::reset() {
+    m_stft.reset();
+    std::fill(m_psd.begin(), m_psd.end(), static_cast<T>(0));
+    m_segmentCount = 0;
+}
+
+//=============================================================================
+// Spectrogram Implementation
+//=============================================================================
+
+template<typename T>
+Spectrogram<T>::Spectrogram(uint32_t fftSize, T sampleRate, uint32_t maxFrames, T overlapFactor,
+                            WindowType window, SpectrogramScale scale, SpectrogramMode mode)
+    : m_fftSize(std::max<uint32_t>(fftSize, 2)), m_sampleRate(sampleRate), m_maxFrames(maxFrames),
+      m_binCount(std::max<uint32_t>(fftSize, 2) / 2 + 1), m_scale(scale), m_mode(mode),
+      m_stft(std::max<uint32_t>(fftSize, 2), sampleRate, overlapFactor, window),
+      m_frameCount(0), m_oldestRow(0), m_firstFrame(0) {
+    if (fftSize < 2) {
+        FMUS_LOG_ERROR("Spectrogram FFT size must be at least 2, using 2");
+    }
+    if (sampleRate <= 0) {
+        FMUS_LOG_ERROR("Spectrogram sample rate must be positive, using 1");
+        m_sampleRate = 1;
+    }
+    if (maxFrames == 0) {
+        FMUS_LOG_ERROR("Spectrogram needs room for at least one frame, using 1");
+        m_maxFrames = 1;
+    }
+
+    m_density = densityScale(m_fftSize, m_sampleRate, window);
+    m_matrix.assign(static_cast<size_t>(m_maxFrames) * m_binCount, 0);
+    m_onFrame = [this](const std::complex<T>* bins, uint32_t binCount) { storeFrame(bins, binCount); };
+}
+
+template<typename T>
+void Spectrogram<T>::storeFrame(const std::complex<T>* bins, uint32_t binCount) {
+    uint32_t row;
+    if (m_frameCount < m_maxFrames) {
+        row = m_frameCount++;
+    } else if (m_mode == SpectrogramMode::Scroll) {
+        row = m_oldestRow;
+        m_oldestRow = (m_oldestRow + 1 == m_maxFrames) ? 0 : m_oldestRow + 1;
+        ++m_firstFrame;
+    } else {
+        return;
+    }
+
+    T* out = m_matrix.data() + static_cast<size_t>(row) * m_binCount;
+    const T* density = m_density.data();
+    switch (m_scale) {
+        case SpectrogramScale::Magnitude:
+            for (uint32_t k = 0; k < binCount; ++k) {
+                out[k] = std::abs(bins[k]);
+            }
+            break;
+        case SpectrogramScale::Power:
+            for (uint32_t k = 0; k < binCount; ++k) {
+                out[k] = density[k] * (bins[k].real() * bins[k].real() + bins[k].imag() * bins[k].imag());
+            }
+            break;
+        case SpectrogramScale::Decibel:
+            for (uint32_t k = 0; k < binCount; ++k) {
+                T power = density[k] * (bins[k].real() * bins[k].real() + bins[k].imag() * bins[k].imag());
+                out[k] = 10 * std::log10(std::max(power, std::numeric_limits<T>::min()));
+            }
+            break;
+    }
+}
+
+template<typename T>
+uint32_t Spectrogram<T>::process(const T* samples, size_t count) {
+    uint32_t before = m_frameCount;
+    uint32_t frames = m_stft.processSamples(samples, count, m_onFrame);
+    return (m_mode == SpectrogramMode::Scroll) ? frames : m_frameCount - before;
+}
+
+template<typename T>
+uint32_t Spectrogram<T>::process(const std::vector<T>& samples) {
+    return process(samples.data(), samples.size());
+}
+
+template<typename T>
+void Spectrogram<T>::reset() {
+    m_stft.reset();
+    std::fill(m_matrix.begin(), m_matrix.end(), static_cast<T>(0));
+    m_frameCount = 0;
+    m_oldestRow = 0;
+    m_firstFrame = 0;
+}
+
+template<typename T>
+const T* Spectrogram<T>::getFrame(uint32_t index) const {
+    if (index >= m_frameCount) {
+        return nullptr;
+    }
+    uint32_t row = m_oldestRow + index;
+    if (row >= m_maxFrames) {
+        row -= m_maxFrames;
+    }
+    return m_matrix.data() + static_cast<size_t>(row) * m_binCount;
+}
+
+template<typename T>
+T Spectrogram<T>::getFrameTime(uint32_t index) const {
+    // Frame f covers samples [f * hop, f * hop + fftSize)
+    double start = static_cast<double>(m_firstFrame + index) * m_stft.getHopSize();
+    return static_cast<T>((start + 0.5 * m_fftSize) / static_cast<double>(m_sampleRate));
+}
+
+//=============================================================================
+// Helper Functions
+//=============================================================================
+
+std::string welchAveragingToString(WelchAveraging averaging) {
+    switch (averaging) {
+        case WelchAveraging::Linear: return "Linear";
+        case WelchAveraging::Exponential: return "Exponential";
+        default: return "Unknown";
+    }
+}
+
+std::string spectrogramScaleToString(SpectrogramScale scale) {
+    switch (scale) {
+        case SpectrogramScale::Magnitude: return "Magnitude";
+        case SpectrogramScale::Power: return "Power";
+        case SpectrogramScale::Decibel: return "Decibel";
+        default: return "Unknown";
+    }
+}
+
+std::string spectrogramModeToString(SpectrogramMode mode) {
+    switch (mode) {
+        case SpectrogramMode::Fill: return "Fill";
+        case SpectrogramMode::Scroll: return "Scroll";
+        default: return "Unknown";
+    }
+}
+
+//=============================================================================
+// Explicit Template Instantiations
+//=============================================================================
+
+template class WelchEstimator<float>;
+template class WelchEstimator<double>;
+template class Spectrogram<float>;
+template class Spectrogram<double>;
+
+} // namespace dsp
+} // namespace fmus
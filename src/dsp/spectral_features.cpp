@@ -0,0 +1,189 @@
+#include "fmus/dsp/spectral_features.h"
+#include "fft_kernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace fmus {
+namespace dsp {
+
+//=============================================================================
+// SpectralFeatures Implementation
+//=============================================================================
+
+template<typename T>
+SpectralFeatures<T>::SpectralFeatures(const SpectralFeatureConfig<T>& config, uint32_t maxBins)
+    : m_config(config), m_simdLevel(detectSimdLevel()), m_resolution(0), m_centroid(0), m_rolloff(0),
+      m_totalPower(0), m_fundamental(0), m_fundamentalPower(0), m_harmonicPower(0),
+      m_signalPower(0), m_noisePower(0) {
+    m_power.reserve(maxBins);
+    m_candidates.reserve(maxBins / 2 + 1);
+    m_peaks.reserve(config.numPeaks);
+}
+
+template<typename T>
+void SpectralFeatures<T>::setConfig(const SpectralFeatureConfig<T>& config) {
+    m_config = config;
+    m_peaks.reserve(config.numPeaks);
+}
+
+template<typename T>
+core::Result<void> SpectralFeatures<T>::compute(const FFTResult<T>& fftResult) {
+    uint32_t usable = static_cast<uint32_t>(std::min<size_t>(fftResult.data.size(), fftResult.size / 2 + 1));
+    return compute(fftResult.data.data(), usable, fftResult.frequencyResolution);
+}
+
+template<typename T>
+core::Result<void> SpectralFeatures<T>::compute(const std::complex<T>* bins, uint32_t binCount,
+                                                T frequencyResolution) {
+    if (bins == nullptr || binCount == 0 || frequencyResolution <= 0) {
+        return core::makeError(core::ErrorCode::InvalidArgument, "Spectrum is empty or has no frequency resolution");
+    }
+
+    m_resolution = frequencyResolution;
+    m_power.resize(binCount);
+    m_candidates.reserve(binCount / 2 + 1);
+    internal::SpectralSums<T> sums = internal::spectralMoments(m_simdLevel, bins, binCount, m_power.data());
+
+    m_totalPower = sums.power;
+    m_centroid = (sums.magnitude > 0) ? m_resolution * sums.weightedMagnitude / sums.magnitude : 0;
+
+    // Rolloff: first bin at which the cumulative power reaches the threshold
+    m_rolloff = 0;
+    if (m_totalPower > 0) {
+        const T threshold = m_config.rolloffPercent * m_totalPower;
+        T cumulative = 0;
+        uint32_t k = 0;
+        for (; k + 1 < binCount; ++k) {
+            cumulative += m_power[k];
+            if (cumulative >= threshold) {
+                break;
+            }
+        }
+        m_rolloff = static_cast<T>(k) * m_resolution;
+    }
+
+    selectPeaks();
+    measureHarmonics();
+    return core::makeOk();
+}
+
+template<typename T>
+void SpectralFeatures<T>::selectPeaks() {
+    const T* power = m_power.data();
+    const uint32_t count = static_cast<uint32_t>(m_power.size());
+
+    m_candidates.clear();
+    m_peaks.clear();
+    for (uint32_t k = 1; k + 1 < count; ++k) {
+        if (power[k] > power[k - 1] && power[k] > power[k + 1]) {
+            m_candidates.push_back(k);
+        }
+    }
+
+    // Heapify in O(M) and pop only until numPeaks are accepted
+    auto weaker = [power](uint32_t a, uint32_t b) { return power[a] < power[b]; };
+    std::make_heap(m_candidates.begin(), m_candidates.end(), weaker);
+    m_fundamental = m_candidates.empty() ? 0 : static_cast<T>(m_candidates.front()) * m_resolution;
+
+    auto heapEnd = m_candidates.end();
+    while (m_peaks.size() < m_config.numPeaks && heapEnd != m_candidates.begin()) {
+        std::pop_heap(m_candidates.begin(), heapEnd, weaker);
+        --heapEnd;
+        uint32_t bin = *heapEnd;
+        T frequency = static_cast<T>(bin) * m_resolution;
+
+        bool tooClose = false;
+        for (const SpectralPeak<T>& peak : m_peaks) {
+            if (std::abs(frequency - peak.frequency) < m_config.minPeakDistance) {
+                tooClose = true;
+                break;
+            }
+        }
+        if (!tooClose) {
+            m_peaks.push_back({bin, frequency, std::sqrt(power[bin])});
+        }
+    }
+
+    std::sort(m_peaks.begin(), m_peaks.end(),
+              [](const SpectralPeak<T>& a, const SpectralPeak<T>& b) { return a.bin < b.bin; });
+}
+
+template<typename T>
+T SpectralFeatures<T>::peakPowerNear(T frequency) const {
+    // Largest |X|^2 within one bin, tolerating leakage between bins
+    const size_t count = m_power.size();
+    T position = frequency / m_resolution;
+    if (position < 0 || position > static_cast<T>(count - 1)) {
+        return 0;
+    }
+
+    size_t center = static_cast<size_t>(std::lround(position));
+    size_t first = (center > 0) ? center - 1 : 0;
+    size_t last = std::min(center + 1, count - 1);
+    T peak = 0;
+    for (size_t i = first; i <= last; ++i) {
+        peak = std::max(peak, m_power[i]);
+    }
+    return peak;
+}
+
+template<typename T>
+void SpectralFeatures<T>::measureHarmonics() {
+    if (m_config.fundamentalFreq > 0) {
+        m_fundamental = m_config.fundamentalFreq;
+    }
+
+    m_fundamentalPower = 0;
+    m_harmonicPower = 0;
+    m_signalPower = 0;
+    m_noisePower = 0;
+    if (m_fundamental <= 0) {
+        return;
+    }
+
+    m_fundamentalPower = peakPowerNear(m_fundamental);
+    for (uint32_t h = 2; h <= m_config.numHarmonics + 1; ++h) {
+        m_harmonicPower += peakPowerNear(m_fundamental * static_cast<T>(h));
+    }
+
+    // Noise is summed directly rather than as total minus signal, which
+    // would cancel catastrophically at high SNR
+    const T halfBand = std::max(m_config.signalBandwidth / 2, m_resolution);
+    const uint32_t count = static_cast<uint32_t>(m_power.size());
+    for (uint32_t k = 1; k < count; ++k) {
+        T frequency = static_cast<T>(k) * m_resolution;
+        if (std::abs(frequency - m_fundamental) <= halfBand) {
+            m_signalPower += m_power[k];
+        } else {
+            m_noisePower += m_power[k];
+        }
+    }
+}
+
+template<typename T>
+core::Result<T> SpectralFeatures<T>::getTHD() const {
+    if (m_fundamentalPower <= 0) {
+        return core::makeError<T>(core::ErrorCode::DataError, "No energy at the fundamental frequency");
+    }
+    T thd = std::sqrt(m_harmonicPower / m_fundamentalPower) * 100;
+    return core::makeOk<T>(std::move(thd));
+}
+
+template<typename T>
+core::Result<T> SpectralFeatures<T>::getSNR() const {
+    if (m_signalPower <= 0 || m_noisePower <= 0) {
+        return core::makeError<T>(core::ErrorCode::DataError, "Signal or noise power is zero");
+    }
+    T snr = 10 * std::log10(m_signalPower / m_noisePower);
+    return core::makeOk<T>(std::move(snr));
+}
+
+//=============================================================================
+// Explicit Template Instantiations
+//=============================================================================
+
+template class SpectralFeatures<float>;
+template class SpectralFeatures<double>;
+
+} // namespace dsp
+} // namespace fmus
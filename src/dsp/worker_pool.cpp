@@ -0,0 +1,137 @@
+#include "fmus/dsp/worker_pool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fmus {
+namespace dsp {
+
+// Each worker sleeps on its own condition variable, so a job only wakes
+// the participants that have a chunk
+struct WorkerSlot {
+    std::condition_variable wake;
+    uint64_t generation = 0;            ///< Jobs assigned to this worker
+};
+
+struct WorkerPoolImpl {
+    std::vector<std::thread> threads;
+    std::vector<WorkerSlot> slots;      ///< Indexed by participant
+    std::mutex jobMutex;                ///< Serializes parallelFor callers
+    std::mutex mutex;
+    std::condition_variable done;
+    const WorkerPool::RangeTask* task = nullptr;
+    uint32_t count = 0;
+    uint32_t chunks = 0;                ///< Participants in the current job
+    uint32_t pending = 0;               ///< Worker chunks not yet finished
+    bool stopping = false;
+};
+
+namespace {
+
+void chunkBounds(uint32_t count, uint32_t chunks, uint32_t index, uint32_t& begin, uint32_t& end) {
+    const uint32_t base = count / chunks;
+    const uint32_t extra = count % chunks;
+    begin = index * base + std::min(index, extra);
+    end = begin + base + (index < extra ? 1 : 0);
+}
+
+void workerLoop(WorkerPoolImpl* impl, uint32_t index) {
+    WorkerSlot& slot = impl->slots[index];
+    uint64_t seen = 0;
+    for (;;) {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        const WorkerPool::RangeTask* task = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(impl->mutex);
+            slot.wake.wait(lock, [&] { return impl->stopping || slot.generation != seen; });
+            if (impl->stopping) {
+                return;
+            }
+            seen = slot.generation;
+            task = impl->task;
+            chunkBounds(impl->count, impl->chunks, index, begin, end);
+        }
+
+        (*task)(begin, end, index);
+
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        if (--impl->pending == 0) {
+            impl->done.notify_one();
+        }
+    }
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// WorkerPool Implementation
+//=============================================================================
+
+WorkerPool::WorkerPool(uint32_t threadCount)
+    : m_threadCount(threadCount), m_impl(new WorkerPoolImpl()) {
+    if (m_threadCount == 0) {
+        m_threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Participant 0 is the thread calling parallelFor
+    m_impl->slots = std::vector<WorkerSlot>(m_threadCount);
+    m_impl->threads.reserve(m_threadCount - 1);
+    for (uint32_t i = 1; i < m_threadCount; ++i) {
+        m_impl->threads.emplace_back(workerLoop, m_impl.get(), i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        m_impl->stopping = true;
+    }
+    for (WorkerSlot& slot : m_impl->slots) {
+        slot.wake.notify_one();
+    }
+    for (std::thread& thread : m_impl->threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::parallelFor(uint32_t count, const RangeTask& task) {
+    if (count == 0) {
+        return;
+    }
+
+    const uint32_t chunks = std::min(count, m_threadCount);
+    if (chunks == 1) {
+        task(0, count, 0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> jobLock(m_impl->jobMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        m_impl->task = &task;
+        m_impl->count = count;
+        m_impl->chunks = chunks;
+        m_impl->pending = chunks - 1;
+        for (uint32_t i = 1; i < chunks; ++i) {
+            ++m_impl->slots[i].generation;
+        }
+    }
+    for (uint32_t i = 1; i < chunks; ++i) {
+        m_impl->slots[i].wake.notify_one();
+    }
+
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    chunkBounds(count, chunks, 0, begin, end);
+    task(begin, end, 0);
+
+    std::unique_lock<std::mutex> lock(m_impl->mutex);
+    m_impl->done.wait(lock, [&] { return m_impl->pending == 0; });
+    m_impl->task = nullptr;
+}
+
+} // namespace dsp
+} // namespace fmus
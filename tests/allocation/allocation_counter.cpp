@@ -0,0 +1,38 @@
+#include "allocation_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions for the allocation test
+// executable only. They live in their own translation unit so the
+// compiler never pairs a counted new with a free it can see.
+
+namespace {
+std::atomic<size_t> g_allocationCount(0);
+}
+
+namespace fmus {
+namespace test {
+
+size_t allocationCount() {
+    return g_allocationCount.load(std::memory_order_relaxed);
+}
+
+} // namespace test
+} // namespace fmus
+
+void* operator new(std::size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
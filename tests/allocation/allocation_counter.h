@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+namespace fmus {
+namespace test {
+
+/**
+ * @brief Number of global operator new calls made by this process so far
+ *
+ * Only available in the allocation test executable, which replaces the
+ * global allocation functions; the main test binary keeps the defaults.
+ */
+size_t allocationCount();
+
+} // namespace test
+} // namespace fmus
@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+#include "allocation_counter.h"
+#include "fmus/dsp/fft.h"
+#include <cmath>
+
+using namespace fmus::dsp;
+using fmus::test::allocationCount;
+
+TEST(FFTWorkspaceTest, SteadyStateMakesNoAllocations) {
+    for (uint32_t n : {1024u, 1000u, 1009u, 999u}) {
+        std::vector<float> input(n), restored(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            input[i] = std::sin(0.05f * i) + 0.5f * std::sin(0.71f * i);
+        }
+        std::vector<std::complex<float>> spectrum(n);
+        std::vector<std::complex<float>> bins(n / 2 + 1);
+        FFTWorkspace<float> workspace(n, WindowType::Blackman);
+
+        size_t before = allocationCount();
+        for (int iteration = 0; iteration < 100; ++iteration) {
+            ASSERT_TRUE(FFT::forward(input.data(), n, spectrum.data(), workspace).isOk());
+            ASSERT_TRUE(FFT::forwardReal(input.data(), n, bins.data(), workspace).isOk());
+            ASSERT_TRUE(FFT::inverseReal(bins.data(), restored.data(), workspace).isOk());
+        }
+        EXPECT_EQ(allocationCount() - before, 0u) << "n=" << n;
+    }
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/batch_fft.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+using namespace fmus::dsp;
+
+namespace {
+
+// Channel-major test matrix with a different tone mix per channel
+std::vector<double> makeChannels(uint32_t size, uint32_t channels) {
+    std::vector<double> data(static_cast<size_t>(size) * channels);
+    for (uint32_t c = 0; c < channels; ++c) {
+        for (uint32_t t = 0; t < size; ++t) {
+            data[static_cast<size_t>(c) * size + t] =
+                std::sin(0.1 * (c + 1) * t) + 0.25 * std::cos(0.37 * t + c) + 0.01 * c;
+        }
+    }
+    return data;
+}
+
+std::vector<double> interleave(const std::vector<double>& channelMajor, uint32_t size, uint32_t channels) {
+    std::vector<double> frames(channelMajor.size());
+    for (uint32_t c = 0; c < channels; ++c) {
+        for (uint32_t t = 0; t < size; ++t) {
+            frames[static_cast<size_t>(t) * channels + c] = channelMajor[static_cast<size_t>(c) * size + t];
+        }
+    }
+    return frames;
+}
+
+void expectMatchesPerChannel(const std::vector<double>& channelMajor, uint32_t size, uint32_t channels,
+                             const std::vector<std::complex<double>>& output, WindowType window) {
+    const uint32_t bins = size / 2 + 1;
+    for (uint32_t c = 0; c < channels; ++c) {
+        std::vector<double> channel(channelMajor.begin() + static_cast<size_t>(c) * size,
+                                    channelMajor.begin() + static_cast<size_t>(c + 1) * size);
+        auto expected = FFT::forwardReal(channel, 1.0, window);
+        ASSERT_TRUE(expected.isOk());
+        for (uint32_t k = 0; k < bins; ++k) {
+            const std::complex<double>& actual = output[static_cast<size_t>(c) * bins + k];
+            ASSERT_NEAR(actual.real(), expected.value().data[k].real(), 1e-9) << "channel " << c << " bin " << k;
+            ASSERT_NEAR(actual.imag(), expected.value().data[k].imag(), 1e-9) << "channel " << c << " bin " << k;
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(BatchFFTTest, MatchesPerChannelTransform) {
+    WorkerPool pool(3);
+    for (uint32_t size : {1u, 2u, 8u, 64u, 128u, 2048u, 100u, 63u}) {
+        for (uint32_t channels : {1u, 7u, 17u, 64u}) {
+            std::vector<double> data = makeChannels(size, channels);
+            std::vector<double> frames = interleave(data, size, channels);
+            BatchFFT<double> batch(size, channels);
+            std::vector<std::complex<double>> output(static_cast<size_t>(channels) * batch.getBinCount());
+
+            SCOPED_TRACE("size " + std::to_string(size) + ", channels " + std::to_string(channels));
+            ASSERT_TRUE(batch.forwardReal(data.data(), BatchLayout::ChannelMajor, output.data()).isOk());
+            expectMatchesPerChannel(data, size, channels, output, WindowType::None);
+
+            std::fill(output.begin(), output.end(), std::complex<double>(0, 0));
+            ASSERT_TRUE(batch.forwardReal(frames.data(), BatchLayout::Interleaved, output.data(), &pool).isOk());
+            expectMatchesPerChannel(data, size, channels, output, WindowType::None);
+        }
+    }
+}
+
+TEST(BatchFFTTest, AppliesWindow) {
+    for (uint32_t size : {256u, 96u}) {
+        const uint32_t channels = 5;
+        std::vector<double> data = makeChannels(size, channels);
+        BatchFFT<double> batch(size, channels, WindowType::Hanning);
+        std::vector<std::complex<double>> output(static_cast<size_t>(channels) * batch.getBinCount());
+
+        ASSERT_TRUE(batch.forwardReal(data.data(), BatchLayout::ChannelMajor, output.data()).isOk());
+        expectMatchesPerChannel(data, size, channels, output, WindowType::Hanning);
+    }
+}
+
+TEST(BatchFFTTest, SelectsLaneWisePath) {
+    EXPECT_TRUE(BatchFFT<float>(64, 64).isLaneWise());
+    EXPECT_TRUE(BatchFFT<float>(BatchFFT<float>::MAX_LANE_SIZE, 2).isLaneWise());
+    EXPECT_FALSE(BatchFFT<float>(2 * BatchFFT<float>::MAX_LANE_SIZE, 64).isLaneWise());
+    EXPECT_FALSE(BatchFFT<float>(100, 64).isLaneWise());
+    EXPECT_FALSE(BatchFFT<float>(64, 1).isLaneWise());
+}
+
+TEST(BatchFFTTest, FloatMatchesDouble) {
+    const uint32_t size = 512;
+    const uint32_t channels = 64;
+    std::vector<double> data = makeChannels(size, channels);
+    std::vector<float> dataFloat(data.begin(), data.end());
+
+    BatchFFT<float> batch(size, channels);
+    std::vector<std::complex<float>> output(static_cast<size_t>(channels) * batch.getBinCount());
+    ASSERT_TRUE(batch.forwardReal(dataFloat.data(), BatchLayout::ChannelMajor, output.data()).isOk());
+
+    BatchFFT<double> reference(size, channels);
+    std::vector<std::complex<double>> expected(output.size());
+    ASSERT_TRUE(reference.forwardReal(data.data(), BatchLayout::ChannelMajor, expected.data()).isOk());
+    for (size_t i = 0; i < output.size(); ++i) {
+        EXPECT_NEAR(output[i].real(), expected[i].real(), 2e-3);
+        EXPECT_NEAR(output[i].imag(), expected[i].imag(), 2e-3);
+    }
+}
+
+TEST(BatchFFTTest, RejectsNullBuffers) {
+    BatchFFT<float> batch(16, 4);
+    std::vector<float> input(64);
+    std::vector<std::complex<float>> output(4 * batch.getBinCount());
+    EXPECT_TRUE(batch.forwardReal(nullptr, BatchLayout::ChannelMajor, output.data()).isError());
+    EXPECT_TRUE(batch.forwardReal(input.data(), BatchLayout::Interleaved, nullptr).isError());
+}
+
+TEST(WorkerPoolTest, CoversRangeOnce) {
+    for (uint32_t threads : {1u, 2u, 5u}) {
+        WorkerPool pool(threads);
+        EXPECT_EQ(pool.getThreadCount(), threads);
+        for (uint32_t count : {0u, 1u, 3u, 100u}) {
+            std::vector<std::atomic<int>> hits(count);
+            std::atomic<uint32_t> maxWorker(0);
+            for (auto& hit : hits) {
+                hit = 0;
+            }
+            pool.parallelFor(count, [&](uint32_t begin, uint32_t end, uint32_t worker) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    hits[i]++;
+                }
+                uint32_t seen = maxWorker.load();
+                while (worker > seen && !maxWorker.compare_exchange_weak(seen, worker)) {
+                }
+            });
+            for (uint32_t i = 0; i < count; ++i) {
+                EXPECT_EQ(hits[i].load(), 1) << "threads " << threads << ", count " << count;
+            }
+            // Only participants with a non-empty chunk run
+            EXPECT_LT(maxWorker.load(), std::max(1u, std::min(count, threads)));
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/cic_filter.h"
+#include <cmath>
+#include <random>
+
+using namespace fmus::dsp;
+
+namespace {
+
+std::vector<double> makeNoise(size_t count) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> signal(count);
+    for (auto& x : signal) {
+        x = dist(rng);
+    }
+    return signal;
+}
+
+// N cascaded moving sums of length R * D, normalized to unity gain
+std::vector<double> boxcarCascade(std::vector<double> signal, uint32_t length, uint32_t order) {
+    for (uint32_t stage = 0; stage < order; ++stage) {
+        std::vector<double> out(signal.size(), 0.0);
+        for (size_t n = 0; n < signal.size(); ++n) {
+            for (uint32_t k = 0; k < length && k <= n; ++k) {
+                out[n] += signal[n - k];
+            }
+            out[n] /= length;
+        }
+        signal = out;
+    }
+    return signal;
+}
+
+// Amplitude of a sine after the filter has settled
+double steadyAmplitude(const std::vector<double>& output, size_t skip) {
+    double peak = 0;
+    for (size_t m = skip; m < output.size(); ++m) {
+        peak = std::max(peak, std::abs(output[m]));
+    }
+    return peak;
+}
+
+} // anonymous namespace
+
+TEST(CICFilterTest, DecimatorMatchesBoxcarCascade) {
+    std::vector<double> input = makeNoise(2000);
+    for (uint32_t delay : {1u, 2u}) {
+        CICDecimator<double> cic(8, 3, delay);
+        std::vector<double> reference = boxcarCascade(input, 8 * delay, 3);
+        std::vector<double> output = cic.process(input);
+
+        ASSERT_EQ(output.size(), input.size() / 8);
+        for (size_t m = 0; m < output.size(); ++m) {
+            ASSERT_NEAR(output[m], reference[m * 8 + 7], 1e-9) << "D=" << delay << " output " << m;
+        }
+    }
+}
+
+TEST(CICFilterTest, ChunksMatchOneShotAndDCStaysExact) {
+    std::vector<double> input = makeNoise(5000);
+    CICDecimator<double> whole(100, 5, 1, 15);
+    CICDecimator<double> chunked(100, 5, 1, 15);
+    std::vector<double> expected = whole.process(input);
+
+    std::vector<double> actual;
+    for (size_t offset = 0; offset < input.size(); offset += 37) {
+        size_t count = std::min<size_t>(37, input.size() - offset);
+        std::vector<double> block(chunked.getMaxOutputCount(count));
+        block.resize(chunked.process(input.data() + offset, count, block.data()));
+        actual.insert(actual.end(), block.begin(), block.end());
+    }
+    ASSERT_EQ(actual, expected);
+
+    // The integrators wrap many times over; the output must not drift
+    CICDecimator<float> cic(100, 5);
+    std::vector<float> dc(2000000, 0.9f);
+    std::vector<float> output = cic.process(dc);
+    ASSERT_EQ(output.size(), 20000u);
+    EXPECT_NEAR(output[10], 0.9f, 1e-6f);
+    EXPECT_NEAR(output.back(), 0.9f, 1e-6f);
+}
+
+TEST(CICFilterTest, CompensatorFlattensPassband) {
+    // 0.15 cycles per output sample, where a 4-stage CIC droops by about 1.3 dB
+    const uint32_t factor = 16;
+    const double frequency = 0.15 / factor;
+    std::vector<double> input(factor * 2000);
+    for (size_t n = 0; n < input.size(); ++n) {
+        input[n] = std::sin(2 * M_PI * frequency * n);
+    }
+
+    CICDecimator<double> plain(factor, 4);
+    CICDecimator<double> compensated(factor, 4, 1, 31);
+    EXPECT_EQ(compensated.getCompensationTaps().size(), 31u);
+    EXPECT_TRUE(plain.getCompensationTaps().empty());
+
+    double droop = steadyAmplitude(plain.process(input), 100);
+    double flat = steadyAmplitude(compensated.process(input), 100);
+    EXPECT_LT(droop, 0.9);
+    EXPECT_NEAR(flat, 1.0, 0.02);
+
+    double taps = 0;
+    for (double tap : compensated.getCompensationTaps()) {
+        taps += tap;
+    }
+    EXPECT_NEAR(taps, 1.0, 1e-12);
+}
+
+TEST(CICFilterTest, InterpolatorMatchesBoxcarCascade) {
+    std::vector<double> input = makeNoise(300);
+    CICInterpolator<double> cic(5, 3);
+    std::vector<double> output = cic.process(input);
+    ASSERT_EQ(output.size(), input.size() * 5);
+
+    std::vector<double> stuffed(output.size(), 0.0);
+    for (size_t n = 0; n < input.size(); ++n) {
+        stuffed[n * 5] = input[n] * 5;
+    }
+    std::vector<double> reference = boxcarCascade(stuffed, 5, 3);
+    for (size_t m = 0; m < output.size(); ++m) {
+        ASSERT_NEAR(output[m], reference[m], 1e-9) << "output " << m;
+    }
+
+    CICInterpolator<float> dc(64, 4, 1, 21);
+    std::vector<float> ones = dc.process(std::vector<float>(100, 1.0f));
+    EXPECT_NEAR(ones.back(), 1.0f, 1e-5f);
+}
+
+TEST(CICFilterTest, InvalidParametersAreClamped) {
+    CICDecimator<float> cic(0, 12, 5);
+    EXPECT_EQ(cic.getFactor(), 1u);
+    EXPECT_EQ(cic.getOrder(), 8u);
+    EXPECT_EQ(cic.getDifferentialDelay(), 2u);
+
+    // 20 bits of growth per stage cannot fit eight stages in 64 bits
+    CICInterpolator<double> wide(1u << 20, 8);
+    EXPECT_LT(wide.getOrder(), 8u);
+    EXPECT_LE(wide.getBitGrowth(), 62u - 24u);
+}
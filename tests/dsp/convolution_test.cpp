@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/dsp.h"
+#include <cmath>
+
+using namespace fmus::dsp;
+
+namespace {
+
+std::vector<double> directFIR(const std::vector<double>& taps, const std::vector<double>& input) {
+    std::vector<double> output(input.size(), 0.0);
+    for (size_t n = 0; n < input.size(); ++n) {
+        for (size_t k = 0; k < taps.size() && k <= n; ++k) {
+            output[n] += taps[k] * input[n - k];
+        }
+    }
+    return output;
+}
+
+std::vector<double> makeTaps(size_t count) {
+    std::vector<double> taps(count);
+    for (size_t k = 0; k < count; ++k) {
+        taps[k] = std::exp(-0.004 * k) * std::cos(0.2 * k);
+    }
+    return taps;
+}
+
+} // anonymous namespace
+
+TEST(FFTConvolverTest, MatchesDirectFIRWithBlockLatency) {
+    std::vector<double> input(6000);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = std::sin(0.013 * i) + 0.5 * std::cos(0.71 * i);
+    }
+
+    for (size_t tapCount : {1u, 100u, 512u, 2048u}) {
+        auto taps = makeTaps(tapCount);
+        auto expected = directFIR(taps, input);
+
+        for (ConvolutionMode mode : {ConvolutionMode::OverlapSave, ConvolutionMode::Partitioned}) {
+            FFTConvolver<double> convolver(taps, mode, 64);
+            EXPECT_EQ(convolver.getOrder(), tapCount - 1);
+            uint32_t latency = convolver.getLatency();
+            if (mode == ConvolutionMode::Partitioned) {
+                EXPECT_EQ(latency, 64u);
+                EXPECT_EQ(convolver.getPartitionCount(), (tapCount + 63) / 64);
+            } else {
+                EXPECT_GE(latency, tapCount);
+                EXPECT_EQ(convolver.getPartitionCount(), 1u);
+            }
+
+            auto output = convolver.process(input);
+            ASSERT_EQ(output.size(), input.size());
+            for (size_t n = 0; n < latency; ++n) {
+                ASSERT_NEAR(output[n], 0.0, 1e-12);
+            }
+            for (size_t n = latency; n < input.size(); ++n) {
+                ASSERT_NEAR(output[n], expected[n - latency], 1e-9)
+                    << convolutionModeToString(mode) << " taps=" << tapCount << " n=" << n;
+            }
+        }
+    }
+}
+
+TEST(FFTConvolverTest, SampleAndChunkedProcessingAgree) {
+    auto taps = makeTaps(700);
+    std::vector<double> input(3000);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = std::sin(0.05 * i);
+    }
+
+    FFTConvolver<double> reference(taps, ConvolutionMode::Partitioned, 128);
+    auto expected = reference.process(input);
+
+    FFTConvolver<double> chunked(taps, ConvolutionMode::Partitioned, 128);
+    std::vector<double> output = input;
+    size_t offset = 0;
+    for (size_t chunk : {1u, 127u, 300u, 5u, 1000u}) {
+        chunked.process(output.data() + offset, output.data() + offset, chunk);
+        offset += chunk;
+    }
+    for (; offset < input.size(); ++offset) {
+        output[offset] = chunked.process(input[offset]);
+    }
+    for (size_t n = 0; n < input.size(); ++n) {
+        ASSERT_EQ(output[n], expected[n]);
+    }
+
+    chunked.reset();
+    EXPECT_EQ(chunked.process(input), expected);
+}
+
+TEST(FFTConvolverTest, PlugsIntoRealTimeProcessor) {
+    RealTimeProcessor<float> processor(256, 48000.0f);
+    auto convolver = std::make_shared<FFTConvolver<float>>(std::vector<float>{0.5f, 0.5f},
+                                                           ConvolutionMode::Partitioned, 4);
+    ASSERT_TRUE(processor.addFilter(convolver).isOk());
+
+    std::vector<float> impulse(16, 0.0f);
+    impulse[0] = 1.0f;
+    auto output = processor.processBuffer(impulse);
+    EXPECT_NEAR(output[4], 0.5f, 1e-6f);
+    EXPECT_NEAR(output[5], 0.5f, 1e-6f);
+    EXPECT_NEAR(output[6], 0.0f, 1e-6f);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/dsp.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace fmus::dsp;
+
+TEST(DSPTest, CrossCorrelationLagLayout) {
+    std::vector<double> a = {1, 2, 3};
+    std::vector<double> b = {0, 1, 0.5};
+
+    // r[lag] = sum_n a[n + lag] * b[n], lags -2..2
+    std::vector<double> expected = {0.5, 2.0, 3.5, 3.0, 0.0};
+    for (CorrelationMethod method : {CorrelationMethod::Direct, CorrelationMethod::FFT}) {
+        auto result = crossCorrelation(a, b, method);
+        ASSERT_EQ(result.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_NEAR(result[i], expected[i], 1e-12) << correlationMethodToString(method);
+        }
+    }
+
+    EXPECT_TRUE(crossCorrelation(std::vector<double>(), b).empty());
+}
+
+TEST(DSPTest, FFTCorrelationMatchesDirect) {
+    for (auto sizes : {std::make_pair(300u, 300u), std::make_pair(1000u, 37u), std::make_pair(5u, 700u)}) {
+        std::vector<double> a(sizes.first), b(sizes.second);
+        for (size_t i = 0; i < a.size(); ++i) {
+            a[i] = std::sin(0.1 * i) + 0.01 * i;
+        }
+        for (size_t i = 0; i < b.size(); ++i) {
+            b[i] = std::cos(0.37 * i);
+        }
+
+        auto direct = crossCorrelation(a, b, CorrelationMethod::Direct);
+        auto fft = crossCorrelation(a, b, CorrelationMethod::FFT);
+        ASSERT_EQ(direct.size(), fft.size());
+        for (size_t i = 0; i < direct.size(); ++i) {
+            EXPECT_NEAR(fft[i], direct[i], 1e-9);
+        }
+    }
+}
+
+TEST(DSPTest, AutoCorrelationIsSymmetricWithPeakAtZeroLag) {
+    std::vector<float> signal(4096);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = std::sin(0.05f * i) + 0.5f * std::sin(1.3f * i);
+    }
+    EXPECT_TRUE(shouldUseFFTCorrelation(signal.size(), signal.size()));
+    EXPECT_FALSE(shouldUseFFTCorrelation(16, 16));
+
+    auto result = autoCorrelation(signal);
+    ASSERT_EQ(result.size(), 2 * signal.size() - 1);
+    size_t zeroLag = signal.size() - 1;
+    auto peak = std::max_element(result.begin(), result.end());
+    EXPECT_EQ(static_cast<size_t>(peak - result.begin()), zeroLag);
+    for (size_t lag = 1; lag < signal.size(); lag += 97) {
+        EXPECT_NEAR(result[zeroLag - lag], result[zeroLag + lag], 1e-2f);
+    }
+}
+
+TEST(DSPTest, RunningStatsMatchesTwoPass) {
+    // A large offset makes the sum-of-squares formula cancel catastrophically
+    std::vector<float> signal(10007);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 1e4f + std::sin(0.37f * i) + ((i % 7) == 0 ? 0.5f : 0.0f);
+    }
+    double mean = 0;
+    for (float x : signal) {
+        mean += x;
+    }
+    mean /= signal.size();
+    double variance = 0;
+    for (float x : signal) {
+        variance += (x - mean) * (x - mean);
+    }
+    variance /= signal.size();
+
+    RunningStats<float> blocks;
+    blocks.add(signal.data(), 3001);
+    blocks.add(signal.data() + 3001, signal.size() - 3001);
+    RunningStats<float> samples;
+    for (float x : signal) {
+        samples.add(x);
+    }
+
+    for (const RunningStats<float>* stats : {&blocks, &samples}) {
+        EXPECT_EQ(stats->getCount(), signal.size());
+        EXPECT_NEAR(stats->getMean(), mean, 1e-3);
+        EXPECT_NEAR(stats->getVariance(), variance, variance * 1e-4);
+        EXPECT_EQ(stats->getMin(), *std::min_element(signal.begin(), signal.end()));
+        EXPECT_EQ(stats->getMax(), *std::max_element(signal.begin(), signal.end()));
+    }
+    EXPECT_NEAR(samples.getSampleVariance(), variance * signal.size() / (signal.size() - 1), variance * 1e-4);
+
+    SignalStats<float> stats = calculateSignalStats(signal);
+    EXPECT_EQ(stats.length, signal.size());
+    EXPECT_NEAR(stats.stdDev, std::sqrt(variance), 1e-4);
+    EXPECT_NEAR(stats.rms, std::sqrt(variance + mean * mean), 1e-2);
+    EXPECT_FLOAT_EQ(stats.peakToPeak, stats.max - stats.min);
+
+    RunningStats<float> empty;
+    empty.merge(RunningStats<float>());
+    EXPECT_EQ(empty.getStats().length, 0u);
+    EXPECT_EQ(empty.getVariance(), 0.0f);
+}
+
+TEST(DSPTest, ParallelSignalStatsMatchesSerial) {
+    std::vector<double> signal(1000003);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = std::sin(0.001 * i) * (1.0 + 1e-6 * i) - 0.25;
+    }
+    SignalStats<double> serial = calculateSignalStats(signal);
+
+    WorkerPool pool(4);
+    SignalStats<double> parallel = calculateSignalStats(signal.data(), signal.size(), pool);
+    EXPECT_EQ(parallel.length, serial.length);
+    EXPECT_NEAR(parallel.mean, serial.mean, 1e-12);
+    EXPECT_NEAR(parallel.variance, serial.variance, 1e-12);
+    EXPECT_NEAR(parallel.rms, serial.rms, 1e-12);
+    EXPECT_EQ(parallel.min, serial.min);
+    EXPECT_EQ(parallel.max, serial.max);
+
+    // Merging per-thread accumulators is the same as adding everything to one
+    RunningStats<double> left, right, whole;
+    left.add(signal.data(), 400000);
+    right.add(signal.data() + 400000, signal.size() - 400000);
+    whole.add(signal.data(), signal.size());
+    left.merge(right);
+    EXPECT_NEAR(left.getMean(), whole.getMean(), 1e-12);
+    EXPECT_NEAR(left.getVariance(), whole.getVariance(), 1e-12);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "fmus/dsp/fft.h"
+#include <cmath>
 
 using namespace fmus::dsp;
 
@@ -14,3 +15,368 @@ TEST(FFTTest, InverseFFT) {
     auto result = FFT::inverse(input);
     EXPECT_TRUE(result.isOk() || result.isError());
 }
+
+TEST(FFTTest, PlanCacheReturnsSharedPlan) {
+    auto a = FFTPlan<float>::get(64, FFTDirection::Forward);
+    auto b = FFTPlan<float>::get(64, FFTDirection::Forward);
+    auto c = FFTPlan<float>::get(64, FFTDirection::Inverse);
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(FFTPlan<float>::get(0, FFTDirection::Forward), nullptr);
+}
+
+TEST(FFTTest, PlanMatchesDirectDFT) {
+    const uint32_t n = 256;
+    std::vector<std::complex<double>> input(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        input[i] = {std::sin(0.3 * i) + 0.25 * std::cos(1.7 * i), 0.1 * i / n};
+    }
+
+    std::vector<std::complex<double>> output = input;
+    FFTPlan<double> plan(n, FFTDirection::Forward);
+    plan.execute(output);
+
+    for (uint32_t k = 0; k < n; ++k) {
+        std::complex<double> expected(0, 0);
+        for (uint32_t i = 0; i < n; ++i) {
+            expected += input[i] * std::polar(1.0, -2.0 * M_PI * k * i / n);
+        }
+        EXPECT_NEAR(output[k].real(), expected.real(), 1e-9);
+        EXPECT_NEAR(output[k].imag(), expected.imag(), 1e-9);
+    }
+}
+
+TEST(FFTTest, ForwardInverseRoundTrip) {
+    std::vector<float> input(1024);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = std::sin(0.05f * i) + 0.5f * std::sin(0.71f * i);
+    }
+
+    auto spectrum = FFT::forward(input);
+    ASSERT_TRUE(spectrum.isOk());
+    auto restored = FFT::inverse(spectrum.value().data);
+    ASSERT_TRUE(restored.isOk());
+    ASSERT_EQ(restored.value().size(), input.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+        EXPECT_NEAR(restored.value()[i], input[i], 1e-4f);
+    }
+}
+
+TEST(FFTTest, RealForwardMatchesComplexHalfSpectrum) {
+    std::vector<double> input(200);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = std::sin(0.2 * i) + 0.3 * std::cos(2.1 * i) + 0.05 * i;
+    }
+
+    auto full = FFT::forward(input, 1000.0, WindowType::Hanning, FFTPadding::NextPowerOf2);
+    auto half = FFT::forwardReal(input, 1000.0, WindowType::Hanning, FFTPadding::NextPowerOf2);
+    ASSERT_TRUE(full.isOk());
+    ASSERT_TRUE(half.isOk());
+    EXPECT_EQ(half.value().size, 256u);
+    ASSERT_EQ(half.value().data.size(), 129u);
+    EXPECT_TRUE(half.value().isOneSided());
+    EXPECT_FALSE(full.value().isOneSided());
+
+    for (size_t k = 0; k < half.value().data.size(); ++k) {
+        EXPECT_NEAR(half.value().data[k].real(), full.value().data[k].real(), 1e-9);
+        EXPECT_NEAR(half.value().data[k].imag(), full.value().data[k].imag(), 1e-9);
+    }
+
+    auto peak = SpectralAnalysis::findPeakFrequency(half.value());
+    ASSERT_TRUE(peak.isOk());
+}
+
+TEST(FFTTest, RealInverseRoundTrip) {
+    for (uint32_t n : {2u, 4u, 8u, 512u}) {
+        std::vector<float> input(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            input[i] = std::cos(0.37f * i) - 0.2f * i / n;
+        }
+
+        auto spectrum = FFT::forwardReal(input);
+        ASSERT_TRUE(spectrum.isOk());
+        auto restored = FFT::inverseReal(spectrum.value().data);
+        ASSERT_TRUE(restored.isOk());
+        ASSERT_EQ(restored.value().size(), n);
+        for (uint32_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(restored.value()[i], input[i], 1e-5f);
+        }
+    }
+}
+
+TEST(FFTTest, PlanKernelsAgreeAcrossSizesAndSimdLevels) {
+    const SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON};
+
+    for (uint32_t n = 1; n <= 4096; n *= 2) {
+        std::vector<std::complex<float>> input(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            input[i] = {std::sin(0.11f * i), std::cos(0.07f * i * i / n)};
+        }
+
+        for (auto direction : {FFTDirection::Forward, FFTDirection::Inverse}) {
+            std::vector<std::complex<float>> expected = input;
+            FFTPlan<float>(n, direction, SimdLevel::Scalar).execute(expected);
+
+            if (n <= 512) {
+                // Check the scalar kernel against a direct DFT
+                double sign = (direction == FFTDirection::Inverse) ? 1.0 : -1.0;
+                double scale = (direction == FFTDirection::Inverse) ? 1.0 / n : 1.0;
+                for (uint32_t k = 0; k < n; ++k) {
+                    std::complex<double> sum(0, 0);
+                    for (uint32_t i = 0; i < n; ++i) {
+                        sum += std::complex<double>(input[i]) * std::polar(1.0, sign * 2.0 * M_PI * k * i / n);
+                    }
+                    EXPECT_NEAR(expected[k].real(), sum.real() * scale, 1e-3);
+                    EXPECT_NEAR(expected[k].imag(), sum.imag() * scale, 1e-3);
+                }
+            }
+
+            for (SimdLevel level : levels) {
+                if (!isSimdLevelSupported(level)) {
+                    continue;
+                }
+                std::vector<std::complex<float>> output = input;
+                FFTPlan<float> plan(n, direction, level);
+                EXPECT_EQ(plan.getSimdLevel(), level);
+                plan.execute(output);
+                for (uint32_t k = 0; k < n; ++k) {
+                    EXPECT_NEAR(output[k].real(), expected[k].real(), 1e-3f * std::sqrt(static_cast<float>(n)));
+                    EXPECT_NEAR(output[k].imag(), expected[k].imag(), 1e-3f * std::sqrt(static_cast<float>(n)));
+                }
+            }
+        }
+    }
+}
+
+TEST(FFTTest, PlanSplitFormatMatchesInterleaved) {
+    const uint32_t n = 2048;
+    std::vector<std::complex<double>> data(n);
+    std::vector<double> re(n), im(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        data[i] = {std::cos(0.013 * i), std::sin(0.29 * i)};
+        re[i] = data[i].real();
+        im[i] = data[i].imag();
+    }
+
+    auto plan = FFTPlan<double>::get(n, FFTDirection::Forward);
+    plan->execute(data);
+    plan->execute(re.data(), im.data());
+    for (uint32_t k = 0; k < n; ++k) {
+        EXPECT_NEAR(re[k], data[k].real(), 1e-9);
+        EXPECT_NEAR(im[k], data[k].imag(), 1e-9);
+    }
+}
+
+TEST(FFTTest, ArbitrarySizesMatchDirectDFT) {
+    // Smooth, prime, odd and 2*prime lengths, each through every algorithm
+    // that can handle it
+    for (uint32_t n : {1u, 3u, 12u, 30u, 97u, 210u, 1000u, 1009u, 2 * 1031u}) {
+        std::vector<std::complex<double>> input(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            input[i] = {std::sin(0.3 * i) + 0.25 * std::cos(1.7 * i), 0.1 * i / n};
+        }
+
+        std::vector<std::complex<double>> expected(n);
+        for (uint32_t k = 0; k < n; ++k) {
+            for (uint32_t i = 0; i < n; ++i) {
+                expected[k] += input[i] * std::polar(1.0, -2.0 * M_PI * ((static_cast<uint64_t>(k) * i) % n) / n);
+            }
+        }
+
+        for (FFTAlgorithm algorithm : {FFTAlgorithm::Auto, FFTAlgorithm::MixedRadix, FFTAlgorithm::Bluestein}) {
+            FFTPlan<double> plan(n, FFTDirection::Forward, detectSimdLevel(), algorithm);
+            std::vector<std::complex<double>> output = input;
+            plan.execute(output);
+            for (uint32_t k = 0; k < n; ++k) {
+                ASSERT_NEAR(output[k].real(), expected[k].real(), 1e-8) << "n=" << n << " k=" << k;
+                ASSERT_NEAR(output[k].imag(), expected[k].imag(), 1e-8) << "n=" << n << " k=" << k;
+            }
+        }
+    }
+}
+
+TEST(FFTTest, AlgorithmSelection) {
+    EXPECT_EQ(FFTPlan<float>::selectAlgorithm(4096), FFTAlgorithm::Radix4);
+    EXPECT_EQ(FFTPlan<float>::selectAlgorithm(1000), FFTAlgorithm::MixedRadix);
+    EXPECT_EQ(FFTPlan<float>::selectAlgorithm(1009), FFTAlgorithm::Bluestein);
+    EXPECT_EQ(FFTPlan<float>::selectAlgorithm(2 * 37), FFTAlgorithm::Bluestein);
+
+    // Unsuitable explicit requests fall back to automatic selection
+    FFTPlan<float> plan(1009, FFTDirection::Forward, SimdLevel::Scalar, FFTAlgorithm::MixedRadix);
+    EXPECT_EQ(plan.getAlgorithm(), FFTAlgorithm::Bluestein);
+}
+
+TEST(FFTTest, ArbitrarySizeRoundTrip) {
+    for (uint32_t n : {5u, 1000u, 5000u, 1009u}) {
+        std::vector<float> input(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            input[i] = std::sin(0.05f * i) + 0.5f * std::sin(0.71f * i);
+        }
+
+        auto spectrum = FFT::forward(input);
+        ASSERT_TRUE(spectrum.isOk());
+        EXPECT_EQ(spectrum.value().size, n);
+        auto restored = FFT::inverse(spectrum.value().data);
+        ASSERT_TRUE(restored.isOk());
+        ASSERT_EQ(restored.value().size(), n);
+        for (uint32_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(restored.value()[i], input[i], 1e-4f);
+        }
+
+        // Split-format execution packs through the interleaved path
+        std::vector<std::complex<float>> data(input.begin(), input.end());
+        std::vector<float> re(input), im(n, 0.0f);
+        auto plan = FFTPlan<float>::get(n, FFTDirection::Forward);
+        plan->execute(data);
+        plan->execute(re.data(), im.data());
+        for (uint32_t k = 0; k < n; ++k) {
+            EXPECT_NEAR(re[k], data[k].real(), 1e-3f);
+            EXPECT_NEAR(im[k], data[k].imag(), 1e-3f);
+        }
+    }
+}
+
+TEST(FFTTest, RealExactSizes) {
+    for (uint32_t n : {6u, 9u, 1000u, 1001u}) {
+        std::vector<double> input(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            input[i] = std::cos(0.37 * i) - 0.2 * i / n;
+        }
+
+        auto full = FFT::forward(input);
+        auto half = FFT::forwardReal(input);
+        ASSERT_TRUE(full.isOk());
+        ASSERT_TRUE(half.isOk());
+        ASSERT_EQ(half.value().data.size(), n / 2 + 1);
+        for (size_t k = 0; k < half.value().data.size(); ++k) {
+            EXPECT_NEAR(half.value().data[k].real(), full.value().data[k].real(), 1e-9);
+            EXPECT_NEAR(half.value().data[k].imag(), full.value().data[k].imag(), 1e-9);
+        }
+
+        auto restored = FFT::inverseReal(half.value().data, n);
+        ASSERT_TRUE(restored.isOk());
+        ASSERT_EQ(restored.value().size(), n);
+        for (uint32_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(restored.value()[i], input[i], 1e-9);
+        }
+    }
+
+    std::vector<std::complex<double>> bins(4);
+    EXPECT_TRUE(FFT::inverseReal(bins, 9).isError());
+}
+
+TEST(FFTTest, RealTimeFFTFramesMatchDirectTransform) {
+    const uint32_t n = 256;
+    RealTimeFFT<double> stft(n, 8000.0, 0.75, WindowType::Hanning);
+    EXPECT_EQ(stft.getHopSize(), 64u);
+
+    std::vector<double> signal(2000);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = std::sin(0.11 * i) + 0.2 * std::cos(1.3 * i);
+    }
+
+    auto frames = stft.processSamples(signal);
+    ASSERT_EQ(frames.size(), 1 + (signal.size() - n) / 64);
+
+    for (size_t f = 0; f < frames.size(); ++f) {
+        std::vector<double> slice(signal.begin() + f * 64, signal.begin() + f * 64 + n);
+        auto expected = FFT::forwardReal(slice, 8000.0, WindowType::Hanning);
+        ASSERT_TRUE(expected.isOk());
+        ASSERT_EQ(frames[f].data.size(), n / 2 + 1);
+        for (uint32_t k = 0; k < n / 2 + 1; ++k) {
+            ASSERT_NEAR(frames[f].data[k].real(), expected.value().data[k].real(), 1e-9);
+            ASSERT_NEAR(frames[f].data[k].imag(), expected.value().data[k].imag(), 1e-9);
+        }
+    }
+}
+
+TEST(FFTTest, RealTimeFFTChunkingIsTransparent) {
+    std::vector<float> signal(5000);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = std::sin(0.03f * i);
+    }
+
+    RealTimeFFT<float> whole(500, 1000.0f, 0.5f);
+    std::vector<std::vector<std::complex<float>>> expected;
+    whole.processSamples(signal.data(), signal.size(), [&](const std::complex<float>* bins, uint32_t count) {
+        expected.emplace_back(bins, bins + count);
+    });
+    ASSERT_EQ(expected.size(), 1 + (5000u - 500u) / 250u);
+
+    RealTimeFFT<float> chunked(500, 1000.0f, 0.5f);
+    size_t frame = 0;
+    size_t offset = 0;
+    for (size_t chunk : {1u, 7u, 499u, 1u, 1200u, 3u, 1000u}) {
+        chunked.processSamples(signal.data() + offset, chunk, [&](const std::complex<float>* bins, uint32_t count) {
+            ASSERT_LT(frame, expected.size());
+            for (uint32_t k = 0; k < count; ++k) {
+                EXPECT_EQ(bins[k], expected[frame][k]);
+            }
+            ++frame;
+        });
+        offset += chunk;
+    }
+    for (; offset < signal.size(); ++offset) {
+        if (chunked.processSample(signal[offset]).isOk()) {
+            ++frame;
+        }
+    }
+    EXPECT_EQ(frame, expected.size());
+}
+
+TEST(FFTTest, WindowCacheSharesCoefficients) {
+    FFT::clearWindowCache();
+
+    auto a = FFT::getWindow<float>(512, WindowType::Hanning);
+    auto b = FFT::getWindow<float>(512, WindowType::Hanning, 3.0f);
+    auto c = FFT::getWindow<double>(512, WindowType::Hanning);
+    auto k1 = FFT::getWindow<float>(512, WindowType::Kaiser, 4.0f);
+    auto k2 = FFT::getWindow<float>(512, WindowType::Kaiser, 6.0f);
+    EXPECT_EQ(a, b);
+    EXPECT_NE(k1, k2);
+    EXPECT_EQ(*a, FFT::generateWindow<float>(512, WindowType::Hanning));
+    EXPECT_EQ(*c, FFT::generateWindow<double>(512, WindowType::Hanning));
+
+    WindowCacheStats stats = FFT::getWindowCacheStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 4u);
+    EXPECT_EQ(stats.entries, 4u);
+
+    // Repeated transforms hit the cache instead of regenerating
+    std::vector<float> signal(512, 1.0f);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(FFT::forward(signal, 1000.0f, WindowType::Hanning).isOk());
+    }
+    stats = FFT::getWindowCacheStats();
+    EXPECT_EQ(stats.hits, 11u);
+    EXPECT_EQ(stats.misses, 4u);
+
+    FFT::clearWindowCache();
+    stats = FFT::getWindowCacheStats();
+    EXPECT_EQ(stats.entries, 0u);
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ((*a)[256], FFT::generateWindow<float>(512, WindowType::Hanning)[256]);
+}
+
+TEST(FFTTest, WindowCacheKeysOnEffectiveParameter) {
+    FFT::clearWindowCache();
+
+    // 0 selects the default parameter, so both requests are the same window
+    auto kaiserDefault = FFT::getWindow<double>(256, WindowType::Kaiser);
+    auto kaiserExplicit = FFT::getWindow<double>(256, WindowType::Kaiser, 5.0);
+    auto gaussianDefault = FFT::getWindow<float>(256, WindowType::Gaussian, 0.0f);
+    auto gaussianExplicit = FFT::getWindow<float>(256, WindowType::Gaussian, 0.4f);
+    auto tukeyDefault = FFT::getWindow<float>(256, WindowType::Tukey);
+    auto tukeyExplicit = FFT::getWindow<float>(256, WindowType::Tukey, 0.5f);
+    EXPECT_EQ(kaiserDefault, kaiserExplicit);
+    EXPECT_EQ(gaussianDefault, gaussianExplicit);
+    EXPECT_EQ(tukeyDefault, tukeyExplicit);
+    EXPECT_EQ(*kaiserDefault, FFT::generateWindow<double>(256, WindowType::Kaiser, 5.0));
+
+    WindowCacheStats stats = FFT::getWindowCacheStats();
+    EXPECT_EQ(stats.hits, 3u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.entries, 3u);
+    FFT::clearWindowCache();
+}
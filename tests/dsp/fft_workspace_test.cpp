@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/fft.h"
+#include <cmath>
+
+using namespace fmus::dsp;
+
+TEST(FFTWorkspaceTest, MatchesVectorAPI) {
+    for (uint32_t n : {64u, 1000u, 1001u}) {
+        std::vector<double> input(n - 7);
+        for (size_t i = 0; i < input.size(); ++i) {
+            input[i] = std::sin(0.2 * i) + 0.3 * std::cos(2.1 * i);
+        }
+
+        FFTWorkspace<double> workspace(n, WindowType::Hanning);
+        std::vector<std::complex<double>> full(n), half(n / 2 + 1);
+        ASSERT_TRUE(FFT::forward(input.data(), static_cast<uint32_t>(input.size()), full.data(), workspace).isOk());
+        ASSERT_TRUE(FFT::forwardReal(input.data(), static_cast<uint32_t>(input.size()), half.data(), workspace).isOk());
+
+        std::vector<double> padded = FFT::zeroPad(input, n);
+        auto expected = FFT::forward(padded, 1.0, WindowType::Hanning);
+        ASSERT_TRUE(expected.isOk());
+        for (uint32_t k = 0; k < n; ++k) {
+            EXPECT_NEAR(full[k].real(), expected.value().data[k].real(), 1e-9);
+            EXPECT_NEAR(full[k].imag(), expected.value().data[k].imag(), 1e-9);
+        }
+        for (uint32_t k = 0; k < half.size(); ++k) {
+            EXPECT_NEAR(half[k].real(), expected.value().data[k].real(), 1e-9);
+            EXPECT_NEAR(half[k].imag(), expected.value().data[k].imag(), 1e-9);
+        }
+    }
+}
+
+TEST(FFTWorkspaceTest, RejectsInvalidInput) {
+    FFTWorkspace<float> workspace(16);
+    std::vector<float> input(17, 1.0f);
+    std::vector<std::complex<float>> output(16);
+    EXPECT_TRUE(FFT::forward(input.data(), 17, output.data(), workspace).isError());
+    EXPECT_TRUE(FFT::forward(input.data(), 0, output.data(), workspace).isError());
+    EXPECT_TRUE(FFT::forwardReal<float>(nullptr, 4, output.data(), workspace).isError());
+}
+
+TEST(FFTWorkspaceTest, RealRoundTrip) {
+    for (uint32_t n : {2u, 9u, 512u, 1000u}) {
+        std::vector<double> input(n), restored(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            input[i] = std::cos(0.37 * i) - 0.2 * i / n;
+        }
+        std::vector<std::complex<double>> bins(n / 2 + 1);
+        FFTWorkspace<double> workspace(n);
+
+        ASSERT_TRUE(FFT::forwardReal(input.data(), n, bins.data(), workspace).isOk());
+        ASSERT_TRUE(FFT::inverseReal(bins.data(), restored.data(), workspace).isOk());
+        for (uint32_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(restored[i], input[i], 1e-9);
+        }
+    }
+}
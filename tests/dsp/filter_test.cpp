@@ -1,8 +1,60 @@
 #include <gtest/gtest.h>
-#include "fmus/dsp/filter.h"
+#include "fmus/dsp/dsp.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <thread>
 
 using namespace fmus::dsp;
 
+namespace {
+
+// Runs one filter sample by sample and a twin through uneven in-place blocks
+template<typename T>
+void expectBlocksMatchSamples(Filter<T>& samples, Filter<T>& blocks, double tolerance) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<T> dist(-1, 1);
+    std::vector<T> input(600);
+    for (T& x : input) {
+        x = dist(rng);
+    }
+
+    std::vector<T> output = input;
+    const size_t chunks[] = {1, 2, 5, 31, 64, 3, 494};
+    size_t offset = 0;
+    for (size_t chunk : chunks) {
+        blocks.processBlock(output.data() + offset, chunk);
+        offset += chunk;
+    }
+    ASSERT_EQ(offset, input.size());
+
+    for (size_t n = 0; n < input.size(); ++n) {
+        ASSERT_NEAR(output[n], samples.process(input[n]), tolerance) << "sample " << n;
+    }
+}
+
+template<typename T>
+void expectAllBlocksMatchSamples(double tolerance) {
+    auto check = [tolerance](auto makeFilter) {
+        auto samples = makeFilter();
+        auto blocks = makeFilter();
+        expectBlocksMatchSamples<T>(*samples, *blocks, tolerance);
+    };
+    check([] { return std::make_unique<LowPassFilter<T>>(static_cast<T>(0.05)); });
+    check([] { return std::make_unique<LowPassFilter<T>>(static_cast<T>(0.9)); });
+    check([] { return std::make_unique<HighPassFilter<T>>(static_cast<T>(0.95)); });
+    check([] { return std::make_unique<LowPassFilter<T>>(static_cast<T>(0.2), 4u); });
+    check([] { return std::make_unique<BandPassFilter<T>>(static_cast<T>(0.1), static_cast<T>(0.4), 4u); });
+    check([] { return std::make_unique<MovingAverageFilter<T>>(1u); });
+    check([] { return std::make_unique<MovingAverageFilter<T>>(16u); });
+    check([] { return std::make_unique<MovingAverageFilter<T>>(100u); });
+    check([] { return std::make_unique<MedianFilter<T>>(9u); });
+}
+
+} // anonymous namespace
+
 TEST(FilterTest, LowPassFilter) {
     LowPassFilter filter(0.1f);
     std::vector<float> input = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
@@ -11,8 +63,214 @@ TEST(FilterTest, LowPassFilter) {
 }
 
 TEST(FilterTest, MovingAverage) {
-    MovingAverageFilter filter(3);
+    MovingAverageFilter<float> filter(3);
     std::vector<float> input = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
     auto output = filter.process(input);
     EXPECT_EQ(output.size(), input.size());
 }
+
+TEST(FilterTest, MedianMatchesSortedWindow) {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> dist(-20, 20);
+    std::vector<double> input(1000);
+    for (double& x : input) {
+        x = dist(rng);  // small range, so the window holds many duplicates
+    }
+
+    for (uint32_t window : {1u, 2u, 3u, 4u, 7u, 10u, 101u}) {
+        SCOPED_TRACE("window " + std::to_string(window));
+        MedianFilter<double> filter(window);
+        std::vector<double> output = filter.process(input);
+
+        for (size_t n = 0; n < input.size(); ++n) {
+            size_t first = (n + 1 >= window) ? n + 1 - window : 0;
+            std::vector<double> sorted(input.begin() + first, input.begin() + n + 1);
+            std::sort(sorted.begin(), sorted.end());
+            size_t size = sorted.size();
+            double expected = (size % 2) ? sorted[size / 2] : (sorted[size / 2 - 1] + sorted[size / 2]) / 2;
+            ASSERT_EQ(output[n], expected) << "sample " << n;
+        }
+
+        filter.reset();
+        std::vector<double> block = input;
+        filter.processBlock(block.data(), 300);
+        for (size_t n = 300; n < input.size(); ++n) {
+            block[n] = filter.process(input[n]);
+        }
+        EXPECT_EQ(block, output);
+    }
+}
+
+TEST(FilterTest, MedianRemovesSpikes) {
+    MedianFilter<float> filter(5);
+    std::vector<float> input(50, 1.0f);
+    input[20] = 100.0f;
+    input[21] = -100.0f;
+    for (float y : filter.process(input)) {
+        EXPECT_FLOAT_EQ(y, 1.0f);
+    }
+}
+
+TEST(FilterTest, BlocksMatchSamples) {
+    expectAllBlocksMatchSamples<float>(1e-5);
+    expectAllBlocksMatchSamples<double>(1e-12);
+}
+
+TEST(FilterTest, ProcessBufferRunsBlocks) {
+    std::vector<float> input(300);
+    for (size_t n = 0; n < input.size(); ++n) {
+        input[n] = std::sin(0.05f * n) + ((n % 7) ? 0.0f : 0.5f);
+    }
+    RealTimeProcessor<float> processor(64, 1000.0f);
+    processor.addFilter(std::make_shared<LowPassFilter<float>>(0.3f));
+    processor.addFilter(std::make_shared<HighPassFilter<float>>(0.98f));
+    processor.addFilter(std::make_shared<MovingAverageFilter<float>>(5));
+
+    std::vector<float> output = processor.processBuffer(input);
+    processor.reset();
+    for (size_t n = 0; n < input.size(); ++n) {
+        EXPECT_NEAR(output[n], processor.processSample(input[n]), 1e-5f) << "sample " << n;
+    }
+}
+
+TEST(FilterTest, PipelineMatchesSerial) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    std::vector<double> input(5000);
+    for (double& x : input) {
+        x = dist(rng);
+    }
+
+    auto makeProcessor = [] {
+        auto processor = std::make_unique<RealTimeProcessor<double>>(128, 1000.0);
+        processor->addFilter(std::make_shared<LowPassFilter<double>>(0.3));
+        processor->addFilter(std::make_shared<HighPassFilter<double>>(0.98));
+        processor->addFilter(std::make_shared<MovingAverageFilter<double>>(5));
+        processor->addFilter(std::make_shared<MedianFilter<double>>(3));
+        processor->addFilter(createBandPassFilter<double>(0.1, 0.3, 4));
+        return processor;
+    };
+    std::vector<double> expected = makeProcessor()->processBuffer(input);
+
+    for (uint32_t stages : {1u, 2u, 3u, 8u}) {
+        auto processor = makeProcessor();
+        ASSERT_TRUE(processor->startPipeline(stages, 2).isOk());
+        EXPECT_TRUE(processor->isPipelined());
+
+        // Two calls so state carries across processBuffer() boundaries
+        std::vector<double> head(input.begin(), input.begin() + 1700);
+        std::vector<double> tail(input.begin() + 1700, input.end());
+        std::vector<double> output = processor->processBuffer(head);
+        std::vector<double> rest = processor->processBuffer(tail);
+        output.insert(output.end(), rest.begin(), rest.end());
+
+        ASSERT_EQ(output.size(), expected.size());
+        for (size_t n = 0; n < output.size(); ++n) {
+            ASSERT_NEAR(output[n], expected[n], 1e-12) << stages << " stages, sample " << n;
+        }
+
+        std::vector<PipelineStageStats> stats = processor->getPipelineStats();
+        ASSERT_EQ(stats.size(), std::min(stages, 5u));
+        uint32_t filters = 0;
+        for (const PipelineStageStats& stage : stats) {
+            EXPECT_EQ(stage.firstFilter, filters);
+            EXPECT_EQ(stage.blocks, 40u);       // ceil(1700 / 128) + ceil(3300 / 128)
+            EXPECT_GE(stage.maxLatency, stage.meanLatency);
+            EXPECT_EQ(stage.queueCapacity, 2u);
+            filters += stage.filterCount;
+        }
+        EXPECT_EQ(filters, 5u);
+    }
+}
+
+TEST(FilterTest, PipelinedSamplesAndResetMatchSerial) {
+    std::vector<double> input(300);
+    for (size_t n = 0; n < input.size(); ++n) {
+        input[n] = std::sin(0.05 * n) + ((n % 7) ? 0.0 : 0.5);
+    }
+    auto makeProcessor = [] {
+        auto processor = std::make_unique<RealTimeProcessor<double>>(32, 1000.0);
+        processor->addFilter(std::make_shared<LowPassFilter<double>>(0.3));
+        processor->addFilter(std::make_shared<MovingAverageFilter<double>>(5));
+        return processor;
+    };
+    auto serial = makeProcessor();
+    auto pipelined = makeProcessor();
+    ASSERT_TRUE(pipelined->startPipeline(2).isOk());
+
+    for (size_t n = 0; n < 100; ++n) {
+        ASSERT_NEAR(pipelined->processSample(input[n]), serial->processSample(input[n]), 1e-12) << "sample " << n;
+    }
+
+    serial->reset();
+    pipelined->reset();
+    EXPECT_TRUE(pipelined->isPipelined());
+    EXPECT_EQ(pipelined->getPipelineStats().size(), 2u);
+    std::vector<double> expected = serial->processBuffer(input);
+    std::vector<double> output = pipelined->processBuffer(input);
+    for (size_t n = 0; n < input.size(); ++n) {
+        ASSERT_NEAR(output[n], expected[n], 1e-12) << "sample " << n;
+    }
+}
+
+TEST(FilterTest, PipelineAppliesBackpressure) {
+    RealTimeProcessor<float> processor(16, 1000.0f);
+    std::vector<float> block(16, 1.0f);
+    std::vector<float> output;
+    EXPECT_FALSE(processor.pushBlock(block.data(), block.size()));
+    EXPECT_FALSE(processor.startPipeline(2).isOk());
+
+    processor.addFilter(std::make_shared<LowPassFilter<float>>(0.5f));
+    processor.addFilter(std::make_shared<MovingAverageFilter<float>>(4));
+    EXPECT_FALSE(processor.startPipeline(0).isOk());
+    ASSERT_TRUE(processor.startPipeline(2, 1).isOk());
+    EXPECT_FALSE(processor.addFilter(std::make_shared<LowPassFilter<float>>(0.5f)).isOk());
+    EXPECT_FALSE(processor.pushBlock(block.data(), 17));
+
+    // Without draining, at most one block fits in each of the three queues
+    // plus one held by each stage
+    size_t pushed = 0;
+    for (int attempt = 0; attempt < 100000 && pushed < 10; ++attempt) {
+        if (processor.pushBlock(block.data(), block.size())) {
+            ++pushed;
+        }
+    }
+    EXPECT_GE(pushed, 1u);
+    EXPECT_LE(pushed, 5u);
+
+    size_t popped = 0;
+    for (int attempt = 0; attempt < 100000 && popped < pushed; ++attempt) {
+        if (processor.popBlock(output)) {
+            EXPECT_EQ(output.size(), 16u);
+            ++popped;
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+        }
+    }
+    EXPECT_EQ(popped, pushed);
+
+    processor.clearFilters();
+    EXPECT_FALSE(processor.isPipelined());
+    EXPECT_TRUE(processor.getPipelineStats().empty());
+}
+
+TEST(FilterTest, PipelinedProcessBufferRejectsBlocksInFlight) {
+    RealTimeProcessor<float> processor(16, 1000.0f);
+    processor.addFilter(std::make_shared<LowPassFilter<float>>(0.5f));
+    processor.addFilter(std::make_shared<MovingAverageFilter<float>>(4));
+    ASSERT_TRUE(processor.startPipeline(2).isOk());
+
+    // A pushed block that has not been popped must not end up in the output
+    std::vector<float> block(16, 1.0f);
+    ASSERT_TRUE(processor.pushBlock(block.data(), block.size()));
+    std::vector<float> input(4, 1.0f);
+    EXPECT_TRUE(processor.processBuffer(input).empty());
+    EXPECT_EQ(processor.processSample(1.0f), 0.0f);
+
+    std::vector<float> output;
+    for (int attempt = 0; attempt < 100000 && !processor.popBlock(output); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+    EXPECT_EQ(output.size(), 16u);
+    EXPECT_EQ(processor.processBuffer(input).size(), input.size());
+}
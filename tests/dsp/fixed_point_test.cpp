@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/fixed_point.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+
+using namespace fmus::dsp;
+
+namespace {
+
+// Signal-to-error ratio in dB of a fixed-point transform against the
+// double-precision FFT of the same (quantized) input
+template<typename Q>
+double transformSnr(uint32_t size, double amplitude, FFTDirection direction, SimdLevel level) {
+    std::mt19937 rng(size);
+    std::uniform_real_distribution<double> dist(-amplitude, amplitude);
+    std::vector<Q> re(size), im(size);
+    std::vector<std::complex<double>> reference(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        re[i] = toFixed<Q>(dist(rng));
+        im[i] = toFixed<Q>(dist(rng));
+        reference[i] = {fromFixed<double>(re[i]), fromFixed<double>(im[i])};
+    }
+
+    std::vector<std::complex<double>> expected;
+    if (direction == FFTDirection::Forward) {
+        expected = FFT::forward(reference).value().data;
+    } else {
+        expected = FFT::inverseComplex(reference).value();
+    }
+
+    FixedFFTPlan<Q> plan(size, direction, level);
+    auto exponent = plan.execute(re.data(), im.data());
+    EXPECT_TRUE(exponent.isOk());
+
+    double signal = 0;
+    double error = 0;
+    for (uint32_t k = 0; k < size; ++k) {
+        std::complex<double> actual(fromFixed<double>(re[k], exponent.value()), fromFixed<double>(im[k], exponent.value()));
+        signal += std::norm(expected[k]);
+        error += std::norm(actual - expected[k]);
+    }
+    return 10 * std::log10(signal / error);
+}
+
+} // anonymous namespace
+
+TEST(FixedPointTest, ConversionsSaturateAndRound) {
+    EXPECT_EQ(toFixed<int16_t>(0.5f), 16384);
+    EXPECT_EQ(toFixed<int16_t>(-1.0), INT16_MIN);
+    EXPECT_EQ(toFixed<int16_t>(1.0), INT16_MAX);
+    EXPECT_EQ(toFixed<int16_t>(-3.0), INT16_MIN);
+    EXPECT_EQ(toFixed<int16_t>(std::nan("")), 0);
+    EXPECT_EQ(toFixed<int32_t>(0.25), 1 << 29);
+    EXPECT_DOUBLE_EQ(fromFixed<double>(static_cast<int16_t>(16384)), 0.5);
+    EXPECT_DOUBLE_EQ(fromFixed<double>(static_cast<int16_t>(16384), 3), 4.0);
+
+    EXPECT_EQ(fixedMultiply<int16_t>(16384, 16384), 8192);
+    EXPECT_EQ(fixedMultiply<int16_t>(INT16_MIN, INT16_MIN), INT16_MAX);
+    EXPECT_EQ(fixedMultiply<int32_t>(1 << 30, -(1 << 30)), -(1 << 29));
+    EXPECT_EQ(saturatingAdd<int16_t>(30000, 30000), INT16_MAX);
+    EXPECT_EQ(saturatingAdd<int32_t>(INT32_MIN, -1), INT32_MIN);
+
+    std::vector<float> values = {0.25f, -0.5f, 0.999f};
+    std::vector<int16_t> fixed(values.size());
+    std::vector<float> back(values.size());
+    toFixed(values.data(), fixed.data(), values.size());
+    fromFixed(fixed.data(), back.data(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_NEAR(back[i], values[i], 1.0f / 32768);
+    }
+}
+
+TEST(FixedFFTPlanTest, MatchesFloatingPointTransform) {
+    for (uint32_t size : {2u, 8u, 64u, 1024u, 4096u}) {
+        SCOPED_TRACE("size " + std::to_string(size));
+        EXPECT_GT(transformSnr<int16_t>(size, 0.9, FFTDirection::Forward, detectSimdLevel()), 60.0);
+        EXPECT_GT(transformSnr<int16_t>(size, 0.9, FFTDirection::Inverse, detectSimdLevel()), 60.0);
+        EXPECT_GT(transformSnr<int32_t>(size, 0.9, FFTDirection::Forward, detectSimdLevel()), 150.0);
+        EXPECT_GT(transformSnr<int32_t>(size, 0.9, FFTDirection::Inverse, detectSimdLevel()), 150.0);
+    }
+}
+
+TEST(FixedFFTPlanTest, BlockScalingKeepsSmallInputsPrecise) {
+    // A quiet input needs fewer shifts, so its relative accuracy holds up
+    EXPECT_GT(transformSnr<int16_t>(1024, 0.01, FFTDirection::Forward, SimdLevel::Scalar), 40.0);
+
+    // Full-scale impulse: every bin is 1, no stage may overflow
+    std::vector<int16_t> re(256, 0), im(256, 0);
+    re[0] = INT16_MAX;
+    im[0] = INT16_MIN;
+    FixedFFTPlan<int16_t> plan(256, FFTDirection::Forward);
+    auto exponent = plan.execute(re.data(), im.data());
+    ASSERT_TRUE(exponent.isOk());
+    EXPECT_LE(exponent.value(), 2);
+    for (uint32_t k = 0; k < 256; ++k) {
+        EXPECT_NEAR(fromFixed<double>(re[k], exponent.value()), 1.0, 1e-3);
+        EXPECT_NEAR(fromFixed<double>(im[k], exponent.value()), -1.0, 1e-3);
+    }
+
+    // Full-scale DC grows by N and must come out as exactly one large bin
+    std::fill(re.begin(), re.end(), static_cast<int16_t>(INT16_MAX));
+    std::fill(im.begin(), im.end(), static_cast<int16_t>(0));
+    exponent = plan.execute(re.data(), im.data());
+    ASSERT_TRUE(exponent.isOk());
+    EXPECT_NEAR(fromFixed<double>(re[0], exponent.value()), 256.0, 0.5);
+    for (uint32_t k = 1; k < 256; ++k) {
+        EXPECT_NEAR(fromFixed<double>(re[k], exponent.value()), 0.0, 0.05);
+    }
+}
+
+TEST(FixedFFTPlanTest, SimdLevelsAreBitExact) {
+    for (uint32_t size : {16u, 128u, 2048u}) {
+        std::mt19937 rng(size);
+        std::uniform_int_distribution<int> dist(INT16_MIN, INT16_MAX);
+        std::vector<int16_t> re(size), im(size);
+        for (uint32_t i = 0; i < size; ++i) {
+            re[i] = static_cast<int16_t>(dist(rng));
+            im[i] = static_cast<int16_t>(dist(rng));
+        }
+
+        FixedFFTPlan<int16_t> scalar(size, FFTDirection::Forward, SimdLevel::Scalar);
+        std::vector<int16_t> expectedRe = re, expectedIm = im;
+        int32_t expectedExponent = scalar.execute(expectedRe.data(), expectedIm.data()).value();
+
+        for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+            if (!isSimdLevelSupported(level)) {
+                continue;
+            }
+            SCOPED_TRACE(simdLevelToString(level) + " size " + std::to_string(size));
+            FixedFFTPlan<int16_t> plan(size, FFTDirection::Forward, level);
+            std::vector<int16_t> actualRe = re, actualIm = im;
+            EXPECT_EQ(plan.execute(actualRe.data(), actualIm.data()).value(), expectedExponent);
+            EXPECT_EQ(actualRe, expectedRe);
+            EXPECT_EQ(actualIm, expectedIm);
+        }
+    }
+}
+
+TEST(FixedFFTPlanTest, RejectsInvalidSizes) {
+    FixedFFTPlan<int16_t> plan(48, FFTDirection::Forward);
+    EXPECT_FALSE(plan.isValid());
+    std::vector<int16_t> re(48), im(48);
+    EXPECT_TRUE(plan.execute(re.data(), im.data()).isError());
+
+    FixedFFTPlan<int32_t> valid(32, FFTDirection::Forward);
+    EXPECT_TRUE(valid.isValid());
+    EXPECT_TRUE(valid.execute(nullptr, nullptr).isError());
+}
+
+TEST(FIRFilterQ15Test, MatchesFloatingPointFilter) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-0.2f, 0.2f);
+    std::vector<float> taps(37);
+    for (float& t : taps) {
+        t = dist(rng);
+    }
+    std::vector<int16_t> input(500);
+    for (int16_t& x : input) {
+        x = toFixed<int16_t>(4 * dist(rng));
+    }
+
+    FIRFilterQ15 filter(taps);
+    ASSERT_EQ(filter.getTapCount(), taps.size());
+    std::vector<int16_t> output = filter.process(input);
+
+    // Exact reference with the quantized taps: at most half an LSB of
+    // rounding, or saturation at full scale
+    for (size_t n = 0; n < input.size(); ++n) {
+        double acc = 0;
+        for (size_t k = 0; k < taps.size() && k <= n; ++k) {
+            acc += fromFixed<double>(filter.getCoefficients()[k]) * input[n - k];
+        }
+        acc = std::min(std::max(acc, -32768.0), 32767.0);
+        EXPECT_NEAR(output[n], acc, 0.5 + 1e-9) << "sample " << n;
+    }
+
+    // Other SIMD levels, single samples and in-place blocks agree exactly
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (!isSimdLevelSupported(level)) {
+            continue;
+        }
+        FIRFilterQ15 other(taps, level);
+        std::vector<int16_t> samples(input.begin(), input.begin() + 100);
+        for (size_t n = 0; n < samples.size(); ++n) {
+            EXPECT_EQ(other.process(samples[n]), output[n]);
+        }
+        samples.assign(input.begin() + 100, input.end());
+        other.process(samples.data(), samples.data(), samples.size());
+        EXPECT_TRUE(std::equal(samples.begin(), samples.end(), output.begin() + 100));
+    }
+
+    filter.reset();
+    EXPECT_EQ(filter.process(input), output);
+}
+
+TEST(BiquadFilterQ15Test, MatchesFloatingPointCascade) {
+    // Two-section low-pass (Butterworth, fc = 0.1 fs); a1 needs a post-shift
+    const std::vector<float> coefficients = {
+        0.0048243f, 0.0096486f, 0.0048243f, -1.0485995f, 0.2961403f,
+        1.0f, 2.0f, 1.0f, -1.3209134f, 0.6327387f};
+    BiquadFilterQ15 filter(coefficients);
+    ASSERT_EQ(filter.getSectionCount(), 2u);
+
+    std::vector<int16_t> input(2000);
+    std::vector<double> expected(input.size());
+    double state[2][4] = {};
+    for (size_t n = 0; n < input.size(); ++n) {
+        input[n] = toFixed<int16_t>(0.2 * std::sin(0.05 * n) + 0.1 * std::sin(1.3 * n));
+        double x = fromFixed<double>(input[n]);
+        for (int s = 0; s < 2; ++s) {
+            const float* c = coefficients.data() + 5 * s;
+            double* z = state[s];
+            double y = c[0] * x + c[1] * z[0] + c[2] * z[1] - c[3] * z[2] - c[4] * z[3];
+            z[1] = z[0];
+            z[0] = x;
+            z[3] = z[2];
+            z[2] = y;
+            x = y;
+        }
+        expected[n] = x;
+    }
+
+    std::vector<int16_t> output = filter.process(input);
+    double maxError = 0;
+    for (size_t n = 0; n < output.size(); ++n) {
+        maxError = std::max(maxError, std::abs(fromFixed<double>(output[n]) - expected[n]));
+    }
+    EXPECT_LT(maxError, 2e-3);
+
+    filter.reset();
+    std::vector<int16_t> single;
+    for (int16_t x : input) {
+        single.push_back(filter.process(x));
+    }
+    EXPECT_EQ(single, output);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/kalman_filter.h"
+#include "fmus/dsp/filter.h"
+#include <atomic>
+#include <random>
+#include <thread>
+
+using namespace fmus::dsp;
+
+namespace {
+
+// Position, velocity and a constant sensor bias; position is measured
+// through the bias, velocity directly
+using ImuFilter = KalmanFilterN<double, 3, 2>;
+
+ImuFilter makeImuFilter(KalmanForm form, const ImuFilter::MeasurementMatrix& noise) {
+    const double dt = 0.01;
+    ImuFilter::StateMatrix f{{1, dt, 0,
+                              0, 1, 0,
+                              0, 0, 1}};
+    ImuFilter::ObservationMatrix h{{1, 0, 1,
+                                    0, 1, 0}};
+    ImuFilter::StateMatrix q{{1e-6, 1e-5, 0,
+                              1e-5, 1e-3, 0,
+                              0, 0, 1e-8}};
+    // The start position is known, which makes the bias observable
+    ImuFilter::StateMatrix p0 = ImuFilter::StateMatrix::identity();
+    p0(0, 0) = 1e-6;
+    p0(2, 2) = 0.25;
+    return ImuFilter(f, h, q, noise, ImuFilter::StateVector::zero(), p0, form);
+}
+
+} // anonymous namespace
+
+TEST(KalmanFilterNTest, MatchesScalarFilter) {
+    for (KalmanForm form : {KalmanForm::Joseph, KalmanForm::UD}) {
+        KalmanFilter<double> scalar(0.01, 0.5, 0.0, 1.0);
+        KalmanFilterN<double, 1, 1> filter({{1}}, {{1}}, {{0.01}}, {{0.5}}, {{0}}, {{1}}, form);
+
+        std::mt19937 rng(3);
+        std::normal_distribution<double> noise(0.0, 0.7);
+        for (int n = 0; n < 200; ++n) {
+            double z = 2.0 + noise(rng);
+            filter.predict();
+            ASSERT_TRUE(filter.update({{z}}).isOk());
+            EXPECT_NEAR(filter.getState()(0, 0), scalar.update(z), 1e-12);
+            EXPECT_NEAR(filter.getCovariance()(0, 0), scalar.getCovariance(), 1e-12);
+        }
+    }
+}
+
+TEST(KalmanFilterNTest, FormsAgreeAndTrack) {
+    // Correlated measurement noise exercises the decorrelation of the U-D form
+    ImuFilter::MeasurementMatrix r{{0.04, 0.01,
+                                    0.01, 0.09}};
+    ImuFilter joseph = makeImuFilter(KalmanForm::Joseph, r);
+    ImuFilter ud = makeImuFilter(KalmanForm::UD, r);
+
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0.0, 0.2);
+    const double bias = 0.3;
+    double position = 0;
+    double velocity = 1.0;
+    for (int n = 0; n < 2000; ++n) {
+        velocity = std::cos(0.002 * n);
+        position += 0.01 * velocity;
+        ImuFilter::MeasurementVector z{{position + bias + noise(rng), velocity + 1.5 * noise(rng)}};
+
+        joseph.predict();
+        ud.predict();
+        ASSERT_TRUE(joseph.update(z).isOk());
+        ASSERT_TRUE(ud.update(z).isOk());
+
+        for (size_t i = 0; i < 3; ++i) {
+            ASSERT_NEAR(ud.getState().data[i], joseph.getState().data[i], 1e-9) << "step " << n;
+        }
+    }
+
+    ImuFilter::StateMatrix pj = joseph.getCovariance();
+    ImuFilter::StateMatrix pu = ud.getCovariance();
+    for (size_t i = 0; i < 9; ++i) {
+        EXPECT_NEAR(pu.data[i], pj.data[i], 1e-12);
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_GT(pj(i, i), 0.0);
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_EQ(pj(i, j), pj(j, i));
+        }
+    }
+
+    EXPECT_NEAR(joseph.getState()(2, 0), bias, 0.05);
+    EXPECT_NEAR(joseph.getState()(1, 0), velocity, 0.1);
+
+    joseph.reset();
+    EXPECT_EQ(joseph.getState()(2, 0), 0.0);
+    EXPECT_EQ(joseph.getCovariance()(2, 2), 0.25);
+}
+
+TEST(KalmanFilterNTest, RejectsSingularInnovation) {
+    for (KalmanForm form : {KalmanForm::Joseph, KalmanForm::UD}) {
+        KalmanFilterN<float, 2, 1> filter({{1, 1, 0, 1}}, {{1, 0}}, {{0, 0, 0, 0}}, {{0}},
+                                          {{1, 2}}, {{0, 0, 0, 0}}, form);
+        filter.predict();
+        auto result = filter.update({{5}});
+        ASSERT_TRUE(result.isError());
+        EXPECT_EQ(result.error().code(), fmus::core::ErrorCode::DataError);
+        EXPECT_FLOAT_EQ(filter.getState()(0, 0), 3.0f);
+        EXPECT_FLOAT_EQ(filter.getState()(1, 0), 2.0f);
+    }
+}
+
+TEST(KalmanFilterNTest, PublishedNoiseTakesEffectAtNextStep) {
+    for (KalmanForm form : {KalmanForm::Joseph, KalmanForm::UD}) {
+        KalmanFilter<double> scalar(0.01, 0.5, 0.0, 1.0);
+        KalmanFilterN<double, 1, 1> filter({{1}}, {{1}}, {{0.01}}, {{0.5}}, {{0}}, {{1}}, form);
+        KalmanFilterN<double, 1, 1> direct = filter;
+
+        std::mt19937 rng(5);
+        std::normal_distribution<double> noise(0.0, 0.7);
+        for (int n = 0; n < 400; ++n) {
+            if (n == 200) {
+                // Published from another thread, picked up by the next step
+                std::thread control([&] {
+                    scalar.publishNoise(0.2, 0.05);
+                    filter.publishNoise({{0.2}}, {{0.05}});
+                });
+                control.join();
+                EXPECT_DOUBLE_EQ(scalar.getProcessNoise(), 0.01);
+                direct.setProcessNoise({{0.2}});
+                direct.setMeasurementNoise({{0.05}});
+            }
+            double z = 2.0 + noise(rng);
+            filter.predict();
+            direct.predict();
+            ASSERT_TRUE(filter.update({{z}}).isOk());
+            ASSERT_TRUE(direct.update({{z}}).isOk());
+            EXPECT_NEAR(filter.getState()(0, 0), scalar.update(z), 1e-12);
+            EXPECT_NEAR(filter.getCovariance()(0, 0), scalar.getCovariance(), 1e-12);
+            EXPECT_EQ(filter.getState()(0, 0), direct.getState()(0, 0));
+        }
+        EXPECT_DOUBLE_EQ(scalar.getProcessNoise(), 0.2);
+        EXPECT_DOUBLE_EQ(scalar.getMeasurementNoise(), 0.05);
+        EXPECT_DOUBLE_EQ(filter.getMeasurementNoise()(0, 0), 0.05);
+    }
+}
+
+TEST(KalmanFilterNTest, NoiseRetunedWhileRunning) {
+    ImuFilter::MeasurementMatrix r{{0.04, 0.01,
+                                    0.01, 0.09}};
+    ImuFilter filter = makeImuFilter(KalmanForm::UD, r);
+
+    std::atomic<bool> done(false);
+    std::thread control([&] {
+        for (int i = 0; !done.load(); ++i) {
+            ImuFilter::MeasurementMatrix retuned = r;
+            retuned(0, 0) = (i % 2) ? 0.02 : 0.08;
+            filter.publishNoise(ImuFilter::StateMatrix::identity(), retuned);
+            std::this_thread::yield();
+        }
+    });
+    bool ok = true;
+    for (int n = 0; n < 20000; ++n) {
+        filter.predict();
+        ok = ok && filter.update({{0.3, 0.0}}).isOk();
+    }
+    done.store(true);
+    control.join();
+    EXPECT_TRUE(ok);
+
+    // The filter ends on one of the published sets, never a torn mix
+    filter.predict();
+    const ImuFilter::MeasurementMatrix& used = filter.getMeasurementNoise();
+    EXPECT_TRUE(used(0, 0) == 0.02 || used(0, 0) == 0.08);
+    EXPECT_EQ(used(1, 1), 0.09);
+    EXPECT_EQ(filter.getProcessNoise()(2, 2), 1.0);
+}
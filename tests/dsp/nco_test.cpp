@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/nco.h"
+#include "fmus/dsp/dsp.h"
+#include <cmath>
+
+using namespace fmus::dsp;
+
+TEST(NCOTest, SineMatchesStdSin) {
+    const double rate = 48000.0;
+    const double frequency = 1234.5;
+    NCO<double> nco(rate, frequency, 2.0, Waveform::Sine, 0.3);
+    std::vector<double> output = nco.generate(100000);
+    for (size_t n = 0; n < output.size(); ++n) {
+        ASSERT_NEAR(output[n], 2.0 * std::sin(2 * M_PI * frequency * n / rate + 0.3), 2e-6) << "sample " << n;
+    }
+    EXPECT_NEAR(nco.getFrequency(), frequency, 1e-9);
+
+    NCO<float> cosine(1000.0f, 10.0f, 1.0f, Waveform::Cosine);
+    std::vector<float> c = cosine.generate(200);
+    for (size_t n = 0; n < c.size(); ++n) {
+        ASSERT_NEAR(c[n], std::cos(2 * M_PI * 10.0 * n / 1000.0), 1e-6) << "sample " << n;
+    }
+}
+
+TEST(NCOTest, FillCarriesPhaseAndSweepAcrossCalls) {
+    const float rate = 8000.0f;
+    NCO<float> whole(rate, 100.0f);
+    NCO<float> chunked(rate, 100.0f);
+    whole.sweepTo(2000.0f, 0.5f);
+    chunked.sweepTo(2000.0f, 0.5f);
+    EXPECT_TRUE(chunked.isSweeping());
+
+    std::vector<float> expected = whole.generate(6000);
+    std::vector<float> actual(6000);
+    for (size_t offset = 0; offset < actual.size(); offset += 333) {
+        chunked.fill(actual.data() + offset, std::min<size_t>(333, actual.size() - offset));
+    }
+    ASSERT_EQ(actual, expected);
+    EXPECT_FALSE(chunked.isSweeping());
+    EXPECT_NEAR(chunked.getFrequency(), 2000.0f, 1e-3f);
+
+    // The sweep follows the continuous chirp phase f0 * t + k * t^2 / 2
+    std::vector<double> chirp = SignalGenerator::chirp(100.0, 2000.0, 1.0, 8000.0, 0.5);
+    ASSERT_EQ(chirp.size(), 4000u);
+    for (size_t n = 0; n < chirp.size(); ++n) {
+        double t = n / 8000.0;
+        ASSERT_NEAR(chirp[n], std::sin(2 * M_PI * (100.0 * t + 0.5 * 3800.0 * t * t)), 1e-5) << "sample " << n;
+    }
+
+    // A frequency change keeps the phase continuous
+    NCO<double> nco(1000.0, 50.0);
+    nco.generate(7);
+    double phase = nco.getPhase();
+    nco.setFrequency(-125.0);
+    EXPECT_DOUBLE_EQ(nco.getPhase(), phase);
+    EXPECT_NEAR(nco.getFrequency(), -125.0, 1e-9);
+}
+
+TEST(NCOTest, WaveformsMatchSignalGeneratorShapes) {
+    // 8 samples per period
+    std::vector<double> square = SignalGenerator::square(125.0, 1.0, 1000.0, 0.016, 0.25);
+    std::vector<double> saw = SignalGenerator::sawtooth(125.0, 1.0, 1000.0, 0.016);
+    std::vector<double> tri = SignalGenerator::triangle(125.0, 1.0, 1000.0, 0.016);
+    ASSERT_EQ(square.size(), 16u);
+    for (size_t n = 0; n < 16; ++n) {
+        double p = (n % 8) / 8.0;
+        EXPECT_EQ(square[n], p < 0.25 ? 1.0 : -1.0) << n;
+        EXPECT_NEAR(saw[n], 2 * p - 1, 1e-12) << n;
+        EXPECT_NEAR(tri[n], p < 0.5 ? 4 * p - 1 : 3 - 4 * p, 1e-12) << n;
+    }
+    EXPECT_EQ(waveformToString(Waveform::Triangle), "Triangle");
+}
+
+TEST(NCOTest, NoiseIsGaussianAndSeeded) {
+    NoiseGenerator<double> noise(0.5, 42);
+    std::vector<double> samples(200003);
+    noise.fill(samples.data(), 3);
+    noise.fill(samples.data() + 3, samples.size() - 3);
+
+    RunningStats<double> stats;
+    stats.add(samples.data(), samples.size());
+    EXPECT_NEAR(stats.getMean(), 0.0, 0.01);
+    EXPECT_NEAR(std::sqrt(stats.getVariance()), 0.5, 0.01);
+
+    // About 4.55% of a Gaussian lies beyond two standard deviations
+    size_t tails = 0;
+    for (double x : samples) {
+        tails += (std::abs(x) > 1.0) ? 1 : 0;
+    }
+    EXPECT_NEAR(static_cast<double>(tails) / samples.size(), 0.0455, 0.003);
+
+    NoiseGenerator<double> same(0.5, 42);
+    EXPECT_EQ(same.generate(50), std::vector<double>(samples.begin(), samples.begin() + 50));
+    same.seed(43);
+    EXPECT_NE(same.generate(50), std::vector<double>(samples.begin() + 50, samples.begin() + 100));
+}
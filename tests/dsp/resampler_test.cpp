@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/resampler.h"
+#include "fmus/dsp/dsp.h"
+#include <cmath>
+#include <random>
+
+using namespace fmus::dsp;
+
+namespace {
+
+std::vector<double> makeSine(size_t count, double cyclesPerSample) {
+    std::vector<double> signal(count);
+    for (size_t n = 0; n < count; ++n) {
+        signal[n] = std::sin(2 * M_PI * cyclesPerSample * n);
+    }
+    return signal;
+}
+
+std::vector<double> makeNoise(size_t count) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> signal(count);
+    for (auto& x : signal) {
+        x = dist(rng);
+    }
+    return signal;
+}
+
+// Feeds the input in blocks of varying length
+template<typename Resampler>
+std::vector<double> processChunked(Resampler& resampler, const std::vector<double>& input) {
+    std::vector<double> output;
+    size_t offset = 0;
+    for (size_t block = 1; offset < input.size(); block = block * 3 % 97 + 1) {
+        size_t count = std::min(block, input.size() - offset);
+        std::vector<double> chunk(resampler.getMaxOutputCount(count));
+        chunk.resize(resampler.process(input.data() + offset, count, chunk.data()));
+        output.insert(output.end(), chunk.begin(), chunk.end());
+        offset += count;
+    }
+    return output;
+}
+
+// Largest difference from a sine of the given frequency and phase, skipping
+// the filter's start-up and the tail
+double maxSineError(const std::vector<double>& output, double cyclesPerSample, double phase, size_t skip) {
+    double error = 0;
+    for (size_t m = skip; m + skip < output.size(); ++m) {
+        error = std::max(error, std::abs(output[m] - std::sin(2 * M_PI * cyclesPerSample * m + phase)));
+    }
+    return error;
+}
+
+} // anonymous namespace
+
+TEST(ResamplerTest, PolyphaseChunksMatchOneShot) {
+    std::vector<double> input = makeNoise(3000);
+    for (auto factors : {std::make_pair(3u, 2u), std::make_pair(160u, 147u), std::make_pair(1u, 5u)}) {
+        PolyphaseResampler<double> whole(factors.first, factors.second);
+        PolyphaseResampler<double> chunked(factors.first, factors.second);
+        std::vector<double> expected = whole.process(input);
+        std::vector<double> actual = processChunked(chunked, input);
+
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t m = 0; m < expected.size(); ++m) {
+            ASSERT_EQ(actual[m], expected[m]) << factors.first << "/" << factors.second << " output " << m;
+        }
+    }
+}
+
+TEST(ResamplerTest, PolyphasePassesSine) {
+    const double frequency = 0.05;
+    std::vector<double> input = makeSine(4000, frequency);
+    for (auto factors : {std::make_pair(3u, 2u), std::make_pair(160u, 147u), std::make_pair(2u, 1u)}) {
+        PolyphaseResampler<double> resampler(factors.first, factors.second);
+        EXPECT_EQ(resampler.getUpFactor(), factors.first);
+        EXPECT_EQ(resampler.getDownFactor(), factors.second);
+
+        std::vector<double> output = resampler.process(input);
+        double ratio = static_cast<double>(factors.first) / factors.second;
+        // Outputs wait for getLatency() inputs of look-ahead
+        double pending = (input.size() - resampler.getLatency()) * ratio;
+        EXPECT_NEAR(static_cast<double>(output.size()), pending, 2.0);
+
+        // Output m lies at input time m / ratio
+        EXPECT_LT(maxSineError(output, frequency / ratio, 0.0, 200), 1e-3)
+            << factors.first << "/" << factors.second;
+    }
+}
+
+TEST(ResamplerTest, DecimationRejectsAliases) {
+    // 0.3 cycles/sample folds to 0.1 after decimating by 2 unless filtered
+    std::vector<double> tone = makeSine(4000, 0.3);
+    std::vector<double> filtered = decimate(tone, 2u, true);
+    std::vector<double> plain = decimate(tone, 2u, false);
+    ASSERT_EQ(filtered.size(), 2000u);
+    ASSERT_EQ(plain.size(), 2000u);
+
+    double filteredPeak = 0;
+    double plainPeak = 0;
+    for (size_t m = 100; m + 100 < filtered.size(); ++m) {
+        filteredPeak = std::max(filteredPeak, std::abs(filtered[m]));
+        plainPeak = std::max(plainPeak, std::abs(plain[m]));
+    }
+    EXPECT_GT(plainPeak, 0.9);
+    EXPECT_LT(filteredPeak, 1e-3);
+}
+
+TEST(ResamplerTest, LargeFactorDecimationRejectsAliases) {
+    // After decimating by 32, 0.025 cycles/sample folds to 0.2 cycles per
+    // output sample; the prototype must be long enough for the narrow cutoff
+    const uint32_t factor = 32;
+    std::vector<double> alias = decimate(makeSine(32000, 0.025), factor);
+    std::vector<double> passed = decimate(makeSine(32000, 0.004), factor);
+    ASSERT_EQ(alias.size(), 1000u);
+
+    double aliasPeak = 0;
+    for (size_t m = 50; m + 50 < alias.size(); ++m) {
+        aliasPeak = std::max(aliasPeak, std::abs(alias[m]));
+    }
+    EXPECT_LT(aliasPeak, 1e-3);
+    EXPECT_LT(maxSineError(passed, 0.004 * factor, 0.0, 50), 1e-3);
+}
+
+TEST(ResamplerTest, SignalFunctionsKeepLengthAndAlignment) {
+    const double frequency = 0.02;
+    std::vector<double> input = makeSine(1001, frequency);
+
+    std::vector<double> decimated = decimate(input, 3u);
+    ASSERT_EQ(decimated.size(), 334u);
+    EXPECT_LT(maxSineError(decimated, frequency * 3, 0.0, 30), 1e-3);
+
+    std::vector<double> interpolated = interpolate(input, 4u);
+    ASSERT_EQ(interpolated.size(), 4004u);
+    EXPECT_LT(maxSineError(interpolated, frequency / 4, 0.0, 200), 1e-3);
+    std::vector<double> stuffed = interpolate(input, 4u, false);
+    ASSERT_EQ(stuffed.size(), 4004u);
+    EXPECT_EQ(stuffed[4], input[1]);
+    EXPECT_EQ(stuffed[5], 0.0);
+
+    // 48000 -> 44100 reduces to 147/160 and uses the polyphase filter
+    auto polyphase = resample(input, 48000.0, 44100.0);
+    ASSERT_TRUE(polyphase.isOk());
+    ASSERT_EQ(polyphase.value().size(), static_cast<size_t>(1001 * 44100.0 / 48000.0));
+    EXPECT_LT(maxSineError(polyphase.value(), frequency * 48000.0 / 44100.0, 0.0, 100), 1e-3);
+
+    // A fractional rate goes through the Farrow interpolator
+    auto farrow = resample(input, 1000.0, 1234.5);
+    ASSERT_TRUE(farrow.isOk());
+    ASSERT_EQ(farrow.value().size(), static_cast<size_t>(1001 * 1.2345));
+    EXPECT_LT(maxSineError(farrow.value(), frequency / 1.2345, 0.0, 10), 1e-3);
+
+    EXPECT_TRUE(resample(input, 0.0, 1.0).isError());
+    EXPECT_TRUE(resample(std::vector<double>{}, 1.0, 2.0).isError());
+}
+
+TEST(ResamplerTest, FarrowUnitRatioIsDelay) {
+    std::vector<double> input = makeNoise(500);
+    FarrowResampler<double> resampler(1.0);
+    std::vector<double> output = resampler.process(input);
+    ASSERT_EQ(output.size(), input.size() - resampler.getLatency());
+    for (size_t m = 0; m < output.size(); ++m) {
+        ASSERT_EQ(output[m], input[m]) << "output " << m;
+    }
+}
+
+TEST(ResamplerTest, FarrowChunksMatchAndTrackRatio) {
+    std::vector<double> input = makeNoise(3000);
+    FarrowResampler<double> whole(0.913);
+    FarrowResampler<double> chunked(0.913);
+    std::vector<double> expected = whole.process(input);
+    std::vector<double> actual = processChunked(chunked, input);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t m = 0; m < expected.size(); ++m) {
+        ASSERT_EQ(actual[m], expected[m]) << "output " << m;
+    }
+
+    // A ratio change takes effect for the following outputs
+    const double frequency = 0.01;
+    FarrowResampler<double> resampler(1.5);
+    std::vector<double> first = resampler.process(makeSine(1000, frequency));
+    EXPECT_NEAR(static_cast<double>(first.size()), 1500.0, 3.0);
+    resampler.setRatio(0.5);
+    EXPECT_EQ(resampler.getRatio(), 0.5);
+    resampler.setRatio(-1.0);
+    EXPECT_EQ(resampler.getRatio(), 0.5);
+    std::vector<double> second = resampler.process(makeSine(1000, frequency));
+    EXPECT_NEAR(static_cast<double>(second.size()), 500.0, 3.0);
+
+    resampler.reset();
+    std::vector<double> sine = resampler.process(makeSine(2000, frequency));
+    EXPECT_LT(maxSineError(sine, frequency * 2, 0.0, 0), 1e-4);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/dsp.h"
+#include <cmath>
+#include <random>
+
+using namespace fmus::dsp;
+
+namespace {
+
+std::complex<double> directDFT(const std::vector<double>& signal, size_t end, uint32_t window, double omega) {
+    std::complex<double> sum(0, 0);
+    for (uint32_t m = 0; m < window; ++m) {
+        sum += signal[end - window + m] * std::polar(1.0, -omega * m);
+    }
+    return sum;
+}
+
+} // anonymous namespace
+
+TEST(SlidingDFTBankTest, MatchesDirectDFTAcrossChannels) {
+    const double sampleRate = 1000.0;
+    const uint32_t window = 200;
+    std::vector<double> frequencies = {50.0, 123.4, 0.0, 499.0};
+    SlidingDFTBank<double> bank(sampleRate, window, frequencies, 2);
+
+    std::vector<double> left(1337), right(1337), interleaved;
+    for (size_t i = 0; i < left.size(); ++i) {
+        left[i] = std::sin(0.31 * i) + 0.2;
+        right[i] = std::cos(0.77 * i) * (1 + 0.001 * i);
+        interleaved.push_back(left[i]);
+        interleaved.push_back(right[i]);
+    }
+
+    EXPECT_FALSE(bank.isReady());
+    size_t processed = 0;
+    for (size_t chunk : {150u, 50u, 1u, 900u, 236u}) {
+        bank.process(interleaved.data() + 2 * processed, chunk);
+        processed += chunk;
+        if (processed < window) {
+            continue;
+        }
+        EXPECT_TRUE(bank.isReady());
+        for (uint32_t k = 0; k < frequencies.size(); ++k) {
+            double omega = 2 * M_PI * frequencies[k] / sampleRate;
+            auto expectedLeft = directDFT(left, processed, window, omega);
+            auto expectedRight = directDFT(right, processed, window, omega);
+            EXPECT_NEAR(std::abs(bank.getValue(0, k) - expectedLeft), 0.0, 1e-9);
+            EXPECT_NEAR(std::abs(bank.getValue(1, k) - expectedRight), 0.0, 1e-9);
+        }
+    }
+}
+
+TEST(SlidingDFTBankTest, NoDriftOverLongStreams) {
+    const uint32_t window = 480;
+    SlidingDFTBank<float> bank(48000.0f, window, {1000.0f, 1234.5f});
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+
+    std::vector<double> tail(window);
+    const size_t total = 2000000 + 123;
+    for (size_t i = 0; i < total; ++i) {
+        float x = std::sin(2.0f * static_cast<float>(M_PI) * 1000.0f * (i % 48) / 48000.0f) + noise(rng);
+        bank.process(x);
+        if (i >= total - window) {
+            tail[i - (total - window)] = x;
+        }
+    }
+
+    for (uint32_t k = 0; k < 2; ++k) {
+        double omega = 2 * M_PI * bank.getFrequencies()[k] / 48000.0;
+        auto expected = directDFT(tail, window, window, omega);
+        EXPECT_NEAR(std::abs(std::complex<double>(bank.getValue(0, k)) - expected), 0.0, 1e-2);
+    }
+}
+
+TEST(SlidingDFTBankTest, THDAndSNRMatchFFTAnalysis) {
+    const double sampleRate = 8000.0;
+    const double fundamental = 250.0;
+    const uint32_t window = 1024;
+    std::mt19937 rng(3);
+    std::normal_distribution<double> noise(0.0, 0.01);
+
+    std::vector<double> signal(4096);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        double t = i / sampleRate;
+        signal[i] = std::sin(2 * M_PI * fundamental * t) + 0.1 * std::sin(2 * M_PI * 3 * fundamental * t) +
+                    0.05 * std::sin(2 * M_PI * 5 * fundamental * t) + noise(rng);
+    }
+
+    SlidingDFTBank<double> bank(sampleRate, window, SlidingDFTBank<double>::harmonicFrequencies(fundamental, 5));
+    EXPECT_EQ(bank.getBinCount(), 6u);
+    EXPECT_TRUE(bank.calculateTHD(0).isError());
+    bank.process(signal.data(), signal.size());
+
+    auto thd = bank.calculateTHD(0);
+    ASSERT_TRUE(thd.isOk());
+    EXPECT_NEAR(thd.value(), 100 * std::sqrt(0.01 + 0.0025), 0.1);
+
+    // Noise variance 1e-4 against a unit sinusoid (power 0.5)
+    auto snr = bank.calculateSNR(0);
+    ASSERT_TRUE(snr.isOk());
+    EXPECT_NEAR(snr.value(), 10 * std::log10(0.5 / 1e-4), 1.0);
+
+    std::vector<double> last(signal.end() - window, signal.end());
+    auto spectrum = FFT::forwardReal(last, sampleRate);
+    ASSERT_TRUE(spectrum.isOk());
+    auto fftTHD = SpectralAnalysis::calculateTHD(spectrum.value(), fundamental, 5u);
+    ASSERT_TRUE(fftTHD.isOk());
+    EXPECT_NEAR(fftTHD.value(), thd.value(), 0.1);
+
+    auto fftSNR = SpectralAnalysis::calculateSNR(spectrum.value(), fundamental, 20.0);
+    ASSERT_TRUE(fftSNR.isOk());
+    EXPECT_LT(fftSNR.value(), snr.value());  // FFT noise includes the harmonics
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/sos_filter.h"
+#include <cmath>
+#include <random>
+
+using namespace fmus::dsp;
+
+namespace {
+
+double gainDecibels(const SOSFilter<double>& filter, double frequency) {
+    return 20 * std::log10(std::abs(filter.getFrequencyResponse(frequency)));
+}
+
+// Steady-state amplitude of a unit sine from its RMS over the last 1000
+// samples (a whole number of periods for the frequencies used here)
+template<typename T>
+double sineAmplitude(Filter<T>& filter, double frequency) {
+    double energy = 0;
+    for (int n = 0; n < 4000; ++n) {
+        T y = filter.process(static_cast<T>(std::sin(M_PI * frequency * n)));
+        if (n >= 3000) {
+            energy += static_cast<double>(y) * y;
+        }
+    }
+    return std::sqrt(2 * energy / 1000);
+}
+
+template<typename T>
+void expectBlockMatchesSamples(uint32_t order, SimdLevel level, double tolerance) {
+    SOSFilter<T> reference(FilterImplementation::Butterworth, FilterType::LowPass, order, static_cast<T>(0.15));
+    SOSFilter<T> block(reference.getSections(), FilterType::LowPass, FilterImplementation::Butterworth, level);
+
+    std::mt19937 rng(order);
+    std::uniform_real_distribution<T> dist(-1, 1);
+    std::vector<T> input(700);
+    for (T& x : input) {
+        x = dist(rng);
+    }
+
+    // Uneven chunks, some shorter than the wavefront, processed in place
+    std::vector<T> output = input;
+    const size_t chunks[] = {1, 3, 17, 100, 2, 64, 513};
+    size_t offset = 0;
+    for (size_t chunk : chunks) {
+        block.process(output.data() + offset, output.data() + offset, chunk);
+        offset += chunk;
+    }
+    ASSERT_EQ(offset, input.size());
+
+    for (size_t n = 0; n < input.size(); ++n) {
+        T expected = reference.process(input[n]);
+        ASSERT_NEAR(output[n], expected, tolerance) << "sample " << n;
+    }
+}
+
+} // anonymous namespace
+
+TEST(SOSFilterTest, ButterworthDesignMatchesReference) {
+    // Fourth-order low-pass at 0.2 Nyquist
+    auto design = designSOS<double>(FilterImplementation::Butterworth, FilterType::LowPass, 4, 0.2);
+    ASSERT_TRUE(design.isOk());
+    const std::vector<BiquadSection<double>>& s = design.value();
+    ASSERT_EQ(s.size(), 2u);
+    EXPECT_NEAR(s[0].b0, 0.0048243, 1e-7);
+    EXPECT_NEAR(s[0].b1, 0.0096486, 1e-7);
+    EXPECT_NEAR(s[0].b2, 0.0048243, 1e-7);
+    EXPECT_NEAR(s[0].a1, -1.0485995, 1e-7);
+    EXPECT_NEAR(s[0].a2, 0.2961403, 1e-7);
+    EXPECT_NEAR(s[1].b0, 1.0, 1e-12);
+    EXPECT_NEAR(s[1].b1, 2.0, 1e-12);
+    EXPECT_NEAR(s[1].b2, 1.0, 1e-12);
+    EXPECT_NEAR(s[1].a1, -1.3209134, 1e-7);
+    EXPECT_NEAR(s[1].a2, 0.6327387, 1e-7);
+}
+
+TEST(SOSFilterTest, ButterworthResponse) {
+    for (uint32_t order = 1; order <= 9; ++order) {
+        SCOPED_TRACE("order " + std::to_string(order));
+        SOSFilter<double> lowPass(FilterImplementation::Butterworth, FilterType::LowPass, order, 0.3);
+        SOSFilter<double> highPass(FilterImplementation::Butterworth, FilterType::HighPass, order, 0.3);
+        EXPECT_EQ(lowPass.getOrder(), order);
+        EXPECT_EQ(lowPass.getSectionCount(), (order + 1) / 2);
+
+        EXPECT_NEAR(gainDecibels(lowPass, 0.0), 0.0, 1e-9);
+        EXPECT_NEAR(gainDecibels(lowPass, 0.3), -3.0103, 1e-3);
+        EXPECT_NEAR(gainDecibels(highPass, 1.0), 0.0, 1e-9);
+        EXPECT_NEAR(gainDecibels(highPass, 0.3), -3.0103, 1e-3);
+
+        // Roll-off steepens by about 6 dB per octave and order
+        EXPECT_LT(gainDecibels(lowPass, 0.6), -5.0 * order);
+        EXPECT_LT(gainDecibels(highPass, 0.15), -5.0 * order);
+    }
+
+    SOSFilter<double> bandPass(FilterImplementation::Butterworth, FilterType::BandPass, 3, 0.2, 0.4);
+    EXPECT_EQ(bandPass.getOrder(), 6u);
+    EXPECT_NEAR(gainDecibels(bandPass, 0.2), -3.0103, 1e-3);
+    EXPECT_NEAR(gainDecibels(bandPass, 0.4), -3.0103, 1e-3);
+    EXPECT_LT(gainDecibels(bandPass, 0.05), -40.0);
+    EXPECT_LT(gainDecibels(bandPass, 0.8), -40.0);
+
+    SOSFilter<double> bandStop(FilterImplementation::Butterworth, FilterType::BandStop, 2, 0.45, 0.55);
+    EXPECT_NEAR(gainDecibels(bandStop, 0.0), 0.0, 1e-9);
+    EXPECT_NEAR(gainDecibels(bandStop, 1.0), 0.0, 1e-9);
+    EXPECT_NEAR(gainDecibels(bandStop, 0.45), -3.0103, 1e-3);
+    EXPECT_LT(gainDecibels(bandStop, 0.5), -60.0);
+}
+
+TEST(SOSFilterTest, ChebyshevResponse) {
+    for (uint32_t order : {3u, 4u, 7u}) {
+        SCOPED_TRACE("order " + std::to_string(order));
+        SOSFilter<double> type1(FilterImplementation::Chebyshev1, FilterType::LowPass, order, 0.25, 0, 0.5);
+        SOSFilter<double> type2(FilterImplementation::Chebyshev2, FilterType::LowPass, order, 0.25, 0, 50.0);
+
+        // Type I: equiripple passband ending at -ripple; type II: stopband below -attenuation
+        EXPECT_NEAR(gainDecibels(type1, 0.25), -0.5, 1e-6);
+        EXPECT_NEAR(gainDecibels(type2, 0.0), 0.0, 1e-9);
+        for (double f = 0; f < 0.25; f += 0.005) {
+            EXPECT_LE(gainDecibels(type1, f), 1e-9);
+            EXPECT_GE(gainDecibels(type1, f), -0.5 - 1e-9);
+        }
+        for (double f = 0.25; f <= 1.0; f += 0.005) {
+            EXPECT_LE(gainDecibels(type2, f), -50.0 + 1e-6);
+        }
+    }
+
+    SOSFilter<double> highPass(FilterImplementation::Chebyshev1, FilterType::HighPass, 5, 0.5, 0, 1.0);
+    EXPECT_NEAR(gainDecibels(highPass, 0.5), -1.0, 1e-6);
+    EXPECT_NEAR(gainDecibels(highPass, 1.0), 0.0, 1e-9);
+    EXPECT_LT(gainDecibels(highPass, 0.2), -40.0);
+}
+
+TEST(SOSFilterTest, BlockMatchesSampleProcessing) {
+    // One to ten sections: scalar, partial and full vectors, several chunks
+    for (uint32_t order : {1u, 2u, 3u, 5u, 8u, 9u, 16u, 20u}) {
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON}) {
+            if (!isSimdLevelSupported(level)) {
+                continue;
+            }
+            SCOPED_TRACE(simdLevelToString(level) + " order " + std::to_string(order));
+            expectBlockMatchesSamples<float>(order, level, 1e-5);
+            expectBlockMatchesSamples<double>(order, level, 1e-12);
+        }
+    }
+}
+
+TEST(SOSFilterTest, FactoriesBuildButterworthCascades) {
+    auto lowPass = createFilter<float>(FilterType::LowPass, 0.2f, 6);
+    ASSERT_NE(lowPass, nullptr);
+    EXPECT_NE(dynamic_cast<SOSFilter<float>*>(lowPass.get()), nullptr);
+    EXPECT_EQ(lowPass->getImplementation(), FilterImplementation::Butterworth);
+    EXPECT_EQ(lowPass->getOrder(), 6u);
+    EXPECT_NEAR(sineAmplitude(*lowPass, 0.2), std::sqrt(0.5), 1e-3);
+    lowPass->reset();
+    EXPECT_LT(sineAmplitude(*lowPass, 0.4), 0.01);
+
+    auto bandPass = createBandPassFilter<double>(0.1, 0.3, 4);
+    ASSERT_NE(bandPass, nullptr);
+    EXPECT_EQ(bandPass->getType(), FilterType::BandPass);
+    EXPECT_EQ(bandPass->getOrder(), 4u);
+    EXPECT_NEAR(sineAmplitude(*bandPass, 0.1), std::sqrt(0.5), 1e-3);
+    bandPass->reset();
+    EXPECT_LT(sineAmplitude(*bandPass, 0.8), 0.02);
+
+    // The cutoff/order constructors honour the order
+    LowPassFilter<double> fourth(0.2, 4);
+    LowPassFilter<double> second(0.2, 2);
+    EXPECT_EQ(fourth.getOrder(), 4u);
+    EXPECT_NEAR(sineAmplitude(fourth, 0.2), std::sqrt(0.5), 1e-3);
+    EXPECT_LT(sineAmplitude(fourth, 0.6), sineAmplitude(second, 0.6) / 4);
+    HighPassFilter<double> highPass(0.2, 3);
+    EXPECT_NEAR(sineAmplitude(highPass, 0.2), std::sqrt(0.5), 1e-3);
+}
+
+TEST(SOSFilterTest, RejectsInvalidDesigns) {
+    EXPECT_TRUE((designSOS<float>(FilterImplementation::Butterworth, FilterType::LowPass, 0, 0.2f).isError()));
+    EXPECT_TRUE((designSOS<float>(FilterImplementation::Butterworth, FilterType::LowPass, 2, 1.2f).isError()));
+    EXPECT_TRUE((designSOS<float>(FilterImplementation::Butterworth, FilterType::BandPass, 2, 0.3f, 0.2f).isError()));
+    EXPECT_TRUE((designSOS<float>(FilterImplementation::Chebyshev1, FilterType::LowPass, 2, 0.3f, 0.0f, 0.0f).isError()));
+    auto elliptic = designSOS<float>(FilterImplementation::Elliptic, FilterType::LowPass, 2, 0.2f);
+    ASSERT_TRUE(elliptic.isError());
+    EXPECT_EQ(elliptic.error().code(), fmus::core::ErrorCode::NotSupported);
+
+    SOSFilter<float> passThrough(FilterImplementation::Butterworth, FilterType::LowPass, 0, 0.2f);
+    EXPECT_EQ(passThrough.getSectionCount(), 0u);
+    EXPECT_FLOAT_EQ(passThrough.process(0.75f), 0.75f);
+    EXPECT_EQ(createFilter<float>(FilterType::LowPass, 2.0f, 2), nullptr);
+}
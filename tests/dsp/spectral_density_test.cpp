@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/spectral_density.h"
+#include <cmath>
+#include <random>
+
+using namespace fmus::dsp;
+
+TEST(WelchEstimatorTest, WhiteNoiseDensityAndParseval) {
+    const double sampleRate = 1000.0;
+    const double sigma = 0.5;
+    std::mt19937 rng(42);
+    std::normal_distribution<double> noise(0.0, sigma);
+    std::vector<double> signal(200000);
+    for (double& x : signal) {
+        x = noise(rng);
+    }
+
+    WelchEstimator<double> welch(256, sampleRate);
+    welch.process(signal);
+    ASSERT_GT(welch.getSegmentCount(), 1000u);
+
+    // White noise: flat one-sided density sigma^2 / (fs / 2)
+    const auto& psd = welch.getPSD();
+    const double expected = sigma * sigma / (sampleRate / 2);
+    double integral = 0;
+    for (size_t k = 0; k < psd.size(); ++k) {
+        if (k > 0 && k + 1 < psd.size()) {
+            EXPECT_NEAR(psd[k], expected, 0.15 * expected) << "bin " << k;
+        }
+        integral += psd[k] * welch.getFrequencyResolution();
+    }
+    EXPECT_NEAR(integral, sigma * sigma, 0.02 * sigma * sigma);
+}
+
+TEST(WelchEstimatorTest, SinePowerAndChunking) {
+    const double sampleRate = 2000.0;
+    const double amplitude = 2.0;
+    std::vector<double> signal(20000);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = amplitude * std::sin(2 * M_PI * 125.0 * i / sampleRate);
+    }
+
+    WelchEstimator<double> whole(512, sampleRate, 0.5, WindowType::Hanning);
+    WelchEstimator<double> chunked(512, sampleRate, 0.5, WindowType::Hanning);
+    whole.process(signal);
+    for (size_t offset = 0; offset < signal.size(); offset += 37) {
+        chunked.process(signal.data() + offset, std::min<size_t>(37, signal.size() - offset));
+    }
+    ASSERT_EQ(whole.getSegmentCount(), chunked.getSegmentCount());
+    EXPECT_EQ(whole.getHopSize(), 256u);
+
+    // All power sits within the window main lobe around 125 Hz
+    double power = 0;
+    for (size_t k = 0; k < whole.getBinCount(); ++k) {
+        EXPECT_NEAR(whole.getPSD()[k], chunked.getPSD()[k], 1e-12);
+        power += whole.getPSD()[k] * whole.getFrequencyResolution();
+    }
+    EXPECT_NEAR(power, amplitude * amplitude / 2, 1e-3);
+}
+
+TEST(WelchEstimatorTest, ExponentialAveragingTracksChanges) {
+    const double sampleRate = 1000.0;
+    std::vector<double> quiet(20000), loud(20000);
+    for (size_t i = 0; i < quiet.size(); ++i) {
+        quiet[i] = 0.1 * std::sin(2 * M_PI * 100.0 * i / sampleRate);
+        loud[i] = 10 * quiet[i];
+    }
+
+    WelchEstimator<double> linear(128, sampleRate, 0.5, WindowType::Hanning, WelchAveraging::Linear);
+    WelchEstimator<double> exponential(128, sampleRate, 0.5, WindowType::Hanning, WelchAveraging::Exponential, 0.2);
+    for (auto* estimator : {&linear, &exponential}) {
+        estimator->process(quiet);
+        estimator->process(loud);
+    }
+
+    // Linear averages both halves; exponential has forgotten the quiet part
+    uint32_t bin = static_cast<uint32_t>(100.0 / linear.getFrequencyResolution() + 0.5);
+    double loudOnly = 0;
+    {
+        WelchEstimator<double> reference(128, sampleRate);
+        reference.process(loud);
+        loudOnly = reference.getPSD()[bin];
+    }
+    EXPECT_NEAR(exponential.getPSD()[bin], loudOnly, 0.01 * loudOnly);
+    EXPECT_NEAR(linear.getPSD()[bin], 0.5 * (loudOnly + loudOnly / 100), 0.02 * loudOnly);
+
+    linear.reset();
+    EXPECT_EQ(linear.getSegmentCount(), 0u);
+    EXPECT_EQ(linear.getPSD()[bin], 0.0);
+}
+
+TEST(SpectrogramTest, FramesMatchRealTimeFFT) {
+    const float sampleRate = 8000.0f;
+    std::vector<float> signal(4000);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        float f = 200.0f + 0.5f * i;    // chirp
+        signal[i] = std::sin(2 * static_cast<float>(M_PI) * f * i / sampleRate);
+    }
+
+    Spectrogram<float> spectrogram(256, sampleRate, 64, 0.5f, WindowType::Hanning, SpectrogramScale::Magnitude);
+    RealTimeFFT<float> stft(256, sampleRate, 0.5f, WindowType::Hanning);
+    uint32_t stored = spectrogram.process(signal);
+    auto frames = stft.processSamples(signal);
+
+    ASSERT_EQ(stored, frames.size());
+    ASSERT_EQ(spectrogram.getFrameCount(), frames.size());
+    for (uint32_t f = 0; f < stored; ++f) {
+        const float* row = spectrogram.getFrame(f);
+        ASSERT_NE(row, nullptr);
+        for (uint32_t k = 0; k < spectrogram.getBinCount(); ++k) {
+            EXPECT_NEAR(row[k], std::abs(frames[f].data[k]), 1e-4f);
+        }
+        EXPECT_FLOAT_EQ(spectrogram.getFrameTime(f), (f * 128.0f + 128.0f) / sampleRate);
+    }
+    EXPECT_EQ(spectrogram.getFrame(stored), nullptr);
+    EXPECT_EQ(spectrogram.getMatrix().size(), 64u * 129u);
+}
+
+TEST(SpectrogramTest, FillAndScrollModes) {
+    const double sampleRate = 100.0;
+    std::vector<double> signal(64 * 20);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = static_cast<double>(i / 64 + 1);    // constant level per 64-sample block
+    }
+
+    Spectrogram<double> fill(64, sampleRate, 5, 0.0, WindowType::None, SpectrogramScale::Power, SpectrogramMode::Fill);
+    Spectrogram<double> scroll(64, sampleRate, 5, 0.0, WindowType::None, SpectrogramScale::Power, SpectrogramMode::Scroll);
+    EXPECT_EQ(fill.process(signal), 5u);
+    EXPECT_EQ(scroll.process(signal), 20u);
+    EXPECT_TRUE(fill.isFull());
+    EXPECT_TRUE(scroll.isFull());
+
+    // DC density of a constant c over N samples with a rectangular window: c^2 / fs
+    for (uint32_t f = 0; f < 5; ++f) {
+        double firstLevel = f + 1;
+        double lastLevel = 16 + f;
+        EXPECT_NEAR(fill.getFrame(f)[0], firstLevel * firstLevel * 64 / sampleRate, 1e-9);
+        EXPECT_NEAR(scroll.getFrame(f)[0], lastLevel * lastLevel * 64 / sampleRate, 1e-9);
+        EXPECT_NEAR(scroll.getFrameTime(f), ((15 + f) * 64 + 32) / sampleRate, 1e-12);
+    }
+}
+
+TEST(SpectrogramTest, DecibelScale) {
+    std::vector<float> signal(1024, 0.0f);
+    Spectrogram<float> spectrogram(128, 1000.0f, 4, 0.0f, WindowType::Hanning, SpectrogramScale::Decibel);
+    EXPECT_EQ(spectrogram.process(signal), 4u);
+    const float* frame = spectrogram.getFrame(0);
+    for (uint32_t k = 0; k < spectrogram.getBinCount(); ++k) {
+        EXPECT_TRUE(std::isfinite(frame[k]));
+        EXPECT_LT(frame[k], -300.0f);
+    }
+    EXPECT_EQ(spectrogramScaleToString(SpectrogramScale::Decibel), "Decibel");
+    EXPECT_EQ(spectrogramModeToString(SpectrogramMode::Scroll), "Scroll");
+    EXPECT_EQ(welchAveragingToString(WelchAveraging::Exponential), "Exponential");
+}
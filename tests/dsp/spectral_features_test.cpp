@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/spectral_features.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace fmus::dsp;
+
+namespace {
+
+std::vector<double> makeSignal(uint32_t size, double sampleRate) {
+    std::vector<double> signal(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        double t = i / sampleRate;
+        signal[i] = std::sin(2 * M_PI * 50 * t) + 0.3 * std::sin(2 * M_PI * 100 * t) +
+                    0.1 * std::sin(2 * M_PI * 150 * t) + 0.6 * std::sin(2 * M_PI * 333 * t) +
+                    0.01 * std::sin(12.9898 * i * i);
+    }
+    return signal;
+}
+
+} // anonymous namespace
+
+TEST(SpectralFeaturesTest, MatchesDirectComputation) {
+    const double sampleRate = 1000.0;
+    for (uint32_t size : {30u, 1000u, 1024u, 4095u}) {
+        auto result = FFT::forwardReal(makeSignal(size, sampleRate), sampleRate, WindowType::Hanning);
+        ASSERT_TRUE(result.isOk());
+        const auto& bins = result.value().data;
+
+        double magnitudeSum = 0;
+        double weightedSum = 0;
+        double powerSum = 0;
+        for (size_t k = 0; k < bins.size(); ++k) {
+            double magnitude = std::abs(bins[k]);
+            magnitudeSum += magnitude;
+            weightedSum += magnitude * k * result.value().frequencyResolution;
+            powerSum += magnitude * magnitude;
+        }
+
+        SpectralFeatures<double> features;
+        ASSERT_TRUE(features.compute(result.value()).isOk());
+        SCOPED_TRACE("size " + std::to_string(size));
+        ASSERT_EQ(features.getPowerSpectrum().size(), bins.size());
+        for (size_t k = 0; k < bins.size(); ++k) {
+            EXPECT_NEAR(features.getPowerSpectrum()[k], std::norm(bins[k]), 1e-9 * powerSum);
+        }
+        EXPECT_NEAR(features.getTotalPower(), powerSum, 1e-9 * powerSum);
+        EXPECT_NEAR(features.getCentroid(), weightedSum / magnitudeSum, 1e-9 * sampleRate);
+
+        double cumulative = 0;
+        size_t rolloffBin = 0;
+        while (rolloffBin + 1 < bins.size() && (cumulative += std::norm(bins[rolloffBin])) < 0.85 * powerSum) {
+            ++rolloffBin;
+        }
+        EXPECT_NEAR(features.getRolloff(), rolloffBin * result.value().frequencyResolution, 1e-9);
+    }
+}
+
+TEST(SpectralFeaturesTest, PeaksMatchFullSort) {
+    const double sampleRate = 1000.0;
+    const uint32_t size = 2000;
+    auto result = FFT::forwardReal(makeSignal(size, sampleRate), sampleRate, WindowType::Blackman);
+    ASSERT_TRUE(result.isOk());
+    const auto& bins = result.value().data;
+
+    // Reference: sort every local maximum
+    std::vector<std::pair<double, uint32_t>> maxima;
+    for (uint32_t k = 1; k + 1 < bins.size(); ++k) {
+        if (std::norm(bins[k]) > std::norm(bins[k - 1]) && std::norm(bins[k]) > std::norm(bins[k + 1])) {
+            maxima.emplace_back(std::norm(bins[k]), k);
+        }
+    }
+    std::sort(maxima.begin(), maxima.end(), std::greater<std::pair<double, uint32_t>>());
+
+    SpectralFeatureConfig<double> config;
+    config.numPeaks = 4;
+    SpectralFeatures<double> features(config, static_cast<uint32_t>(bins.size()));
+    ASSERT_TRUE(features.compute(result.value()).isOk());
+
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < config.numPeaks; ++i) {
+        expected.push_back(maxima[i].second);
+    }
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(features.getPeaks().size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(features.getPeaks()[i].bin, expected[i]);
+        EXPECT_NEAR(features.getPeaks()[i].magnitude, std::abs(bins[expected[i]]), 1e-9);
+    }
+    EXPECT_NEAR(features.getPeaks()[0].frequency, 50.0, 1e-9);
+    EXPECT_NEAR(features.getPeaks()[3].frequency, 333.0, 1e-9);
+    EXPECT_NEAR(features.getFundamental(), 50.0, 1e-9);
+
+    auto frequencies = SpectralAnalysis::findPeaks(result.value(), 4);
+    ASSERT_EQ(frequencies.size(), 4u);
+    EXPECT_NEAR(frequencies[1], 100.0, 1e-9);
+}
+
+TEST(SpectralFeaturesTest, MinimumPeakDistance) {
+    const double sampleRate = 1000.0;
+    auto result = FFT::forwardReal(makeSignal(1000, sampleRate), sampleRate, WindowType::Hanning);
+    ASSERT_TRUE(result.isOk());
+
+    SpectralFeatureConfig<double> config;
+    config.numPeaks = 10;
+    config.minPeakDistance = 120;
+    SpectralFeatures<double> features(config);
+    ASSERT_TRUE(features.compute(result.value()).isOk());
+
+    const auto& peaks = features.getPeaks();
+    ASSERT_GE(peaks.size(), 2u);
+    EXPECT_NEAR(peaks[0].frequency, 50.0, 1e-9);
+    for (size_t i = 1; i < peaks.size(); ++i) {
+        EXPECT_GE(peaks[i].frequency - peaks[i - 1].frequency, 120.0);
+    }
+}
+
+TEST(SpectralFeaturesTest, HarmonicMetricsMatchSpectralAnalysis) {
+    const double sampleRate = 1000.0;
+    auto result = FFT::forwardReal(makeSignal(1000, sampleRate), sampleRate, WindowType::Hanning);
+    ASSERT_TRUE(result.isOk());
+
+    auto thd = SpectralAnalysis::calculateTHD(result.value(), 50.0, 2);
+    auto snr = SpectralAnalysis::calculateSNR(result.value(), 50.0, 4.0);
+    ASSERT_TRUE(thd.isOk());
+    ASSERT_TRUE(snr.isOk());
+
+    // Fundamental detected as the strongest peak
+    SpectralFeatureConfig<double> config;
+    config.numHarmonics = 2;
+    config.signalBandwidth = 4.0;
+    SpectralFeatures<double> features(config);
+    ASSERT_TRUE(features.compute(result.value()).isOk());
+    ASSERT_TRUE(features.getTHD().isOk());
+    ASSERT_TRUE(features.getSNR().isOk());
+    EXPECT_NEAR(features.getTHD().value(), thd.value(), 1e-9);
+    EXPECT_NEAR(features.getSNR().value(), snr.value(), 1e-9);
+    EXPECT_NEAR(features.getTHD().value(), 100 * std::sqrt(0.3 * 0.3 + 0.1 * 0.1), 1.0);
+
+    // Explicit fundamental
+    config.fundamentalFreq = 333.0;
+    features.setConfig(config);
+    ASSERT_TRUE(features.compute(result.value()).isOk());
+    EXPECT_NEAR(features.getSNR().value(), SpectralAnalysis::calculateSNR(result.value(), 333.0, 4.0).value(), 1e-9);
+}
+
+TEST(SpectralFeaturesTest, FloatMatchesDouble) {
+    const float sampleRate = 8000.0f;
+    std::vector<float> signal(1023);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = std::sin(0.3f * i) + 0.5f * std::cos(1.1f * i);
+    }
+    auto result = FFT::forwardReal(signal, sampleRate);
+    ASSERT_TRUE(result.isOk());
+
+    std::vector<std::complex<double>> bins(result.value().data.begin(), result.value().data.end());
+    SpectralFeatures<float> features;
+    SpectralFeatures<double> reference;
+    ASSERT_TRUE(features.compute(result.value()).isOk());
+    ASSERT_TRUE(reference.compute(bins.data(), static_cast<uint32_t>(bins.size()),
+                                  result.value().frequencyResolution).isOk());
+    EXPECT_NEAR(features.getCentroid(), reference.getCentroid(), 1e-3 * sampleRate);
+    EXPECT_NEAR(features.getTotalPower(), reference.getTotalPower(), 1e-4 * reference.getTotalPower());
+    EXPECT_FLOAT_EQ(features.getRolloff(), static_cast<float>(reference.getRolloff()));
+}
+
+TEST(SpectralFeaturesTest, RejectsInvalidInput) {
+    SpectralFeatures<float> features;
+    std::complex<float> bin(1.0f, 0.0f);
+    EXPECT_TRUE(features.compute(nullptr, 4, 1.0f).isError());
+    EXPECT_TRUE(features.compute(&bin, 0, 1.0f).isError());
+    EXPECT_TRUE(features.compute(&bin, 1, 0.0f).isError());
+    EXPECT_TRUE(features.compute(FFTResult<float>()).isError());
+    EXPECT_TRUE(features.getTHD().isError());
+}
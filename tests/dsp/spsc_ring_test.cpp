@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/spsc_ring.h"
+#include <thread>
+#include <vector>
+
+using namespace fmus::dsp;
+
+TEST(SPSCRingTest, FullAndEmpty) {
+    SPSCRing<int> ring(3);
+    EXPECT_EQ(ring.capacity(), 4u);
+
+    int item = 0;
+    EXPECT_FALSE(ring.tryPop(item));
+    for (int i = 0; i < 4; ++i) {
+        item = i;
+        ASSERT_TRUE(ring.tryPush(item));
+    }
+    item = 4;
+    EXPECT_FALSE(ring.tryPush(item));
+    EXPECT_EQ(item, 4);
+    EXPECT_EQ(ring.size(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.tryPop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(ring.tryPop(item));
+    EXPECT_EQ(ring.size(), 0u);
+}
+
+TEST(SPSCRingTest, MovesBuffersWithoutCopying) {
+    SPSCRing<std::vector<float>> ring(2);
+    std::vector<float> block(100, 1.0f);
+    const float* data = block.data();
+    ASSERT_TRUE(ring.tryPush(block));
+
+    std::vector<float> received;
+    ASSERT_TRUE(ring.tryPop(received));
+    EXPECT_EQ(received.data(), data);
+    EXPECT_EQ(received.size(), 100u);
+}
+
+TEST(SPSCRingTest, TwoThreadsKeepOrder) {
+    const int count = 200000;
+    SPSCRing<int> ring(16);
+    std::thread producer([&] {
+        for (int i = 0; i < count; ++i) {
+            int item = i;
+            while (!ring.tryPush(item)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    int outOfOrder = 0;
+    int item = 0;
+    while (expected < count) {
+        if (ring.tryPop(item)) {
+            outOfOrder += (item != expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_EQ(outOfOrder, 0);
+    EXPECT_EQ(ring.size(), 0u);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/dsp.h"
+#include <cmath>
+#include <memory>
+
+using namespace fmus::dsp;
+
+namespace {
+
+std::vector<double> testSignal(size_t length) {
+    std::vector<double> signal(length);
+    for (size_t n = 0; n < length; ++n) {
+        signal[n] = std::sin(0.02 * n) + 0.5 * std::sin(2.1 * n);
+    }
+    return signal;
+}
+
+} // anonymous namespace
+
+TEST(StaticFilterChainTest, MatchesRealTimeProcessor) {
+    const BiquadSection<double> section =
+        designSOS<double>(FilterImplementation::Butterworth, FilterType::LowPass, 2, 0.25).value()[0];
+
+    RealTimeProcessor<double> processor(64, 1000.0);
+    processor.addFilter(std::make_shared<HighPassFilter<double>>(0.9));
+    processor.addFilter(std::make_shared<SOSFilter<double>>(std::vector<BiquadSection<double>>{section}));
+    processor.addFilter(std::make_shared<LowPassFilter<double>>(0.4));
+
+    auto chain = makeStaticFilterChain<double>(OnePoleHighPassStage<double>(0.9), BiquadStage<double>(section),
+                                               OnePoleLowPassStage<double>(0.4), GainStage<double>(2.0));
+    EXPECT_EQ(chain.size(), 4u);
+
+    // Same arithmetic in the same order: results are identical
+    std::vector<double> input = testSignal(300);
+    std::vector<double> output = chain.process(input);
+    for (size_t n = 0; n < input.size(); ++n) {
+        EXPECT_EQ(output[n], 2.0 * processor.processSample(input[n])) << "sample " << n;
+    }
+}
+
+TEST(StaticFilterChainTest, BlocksSamplesAndResetAgree) {
+    auto makeChain = [] {
+        return makeStaticFilterChain<float>(OnePoleLowPassStage<float>(0.2f), OnePoleLowPassStage<float>(0.5f),
+                                            OnePoleHighPassStage<float>(0.95f));
+    };
+    auto blockChain = makeChain();
+    auto sampleChain = makeChain();
+
+    std::vector<double> signal = testSignal(257);
+    std::vector<float> input(signal.begin(), signal.end());
+    std::vector<float> output = input;
+    blockChain.processBlock(output.data(), output.data(), 100);
+    blockChain.processBlock(output.data() + 100, output.data() + 100, input.size() - 100);
+    for (size_t n = 0; n < input.size(); ++n) {
+        EXPECT_EQ(output[n], sampleChain.process(input[n]));
+    }
+
+    blockChain.reset();
+    EXPECT_EQ(blockChain.process(input), makeChain().process(input));
+
+    // Stages are reachable for tuning
+    blockChain.stage<2>().alpha = 0.5f;
+    EXPECT_FLOAT_EQ(blockChain.stage<2>().alpha, 0.5f);
+}
+
+TEST(StaticFilterChainTest, ChainsNest) {
+    using Smoother = StaticFilterChain<double, OnePoleLowPassStage<double>, OnePoleLowPassStage<double>>;
+    Smoother inner(OnePoleLowPassStage<double>(0.3), OnePoleLowPassStage<double>(0.3));
+    auto outer = makeStaticFilterChain<double>(GainStage<double>(0.5), inner, GainStage<double>(4.0));
+    auto flat = makeStaticFilterChain<double>(GainStage<double>(0.5), OnePoleLowPassStage<double>(0.3),
+                                              OnePoleLowPassStage<double>(0.3), GainStage<double>(4.0));
+
+    std::vector<double> input = testSignal(100);
+    EXPECT_EQ(outer.process(input), flat.process(input));
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "fmus/dsp/triple_buffer.h"
+#include "fmus/dsp/dsp.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+using namespace fmus::dsp;
+
+namespace {
+
+std::vector<double> makeSignal(size_t count) {
+    std::vector<double> signal(count);
+    for (size_t n = 0; n < count; ++n) {
+        signal[n] = std::sin(0.07 * n) + ((n % 11) ? 0.0 : 0.8);
+    }
+    return signal;
+}
+
+} // anonymous namespace
+
+TEST(TripleBufferTest, ReaderSeesNewestSet) {
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.update());
+
+    buffer.back() = 1;
+    buffer.publish();
+    buffer.back() = 2;
+    buffer.publish();
+    ASSERT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.front(), 2);
+    EXPECT_FALSE(buffer.update());
+
+    // The writer gets a slot the reader no longer uses
+    buffer.back() = 3;
+    EXPECT_EQ(buffer.front(), 2);
+    buffer.publish();
+    ASSERT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.front(), 3);
+}
+
+TEST(TripleBufferTest, SetsNeverTearAcrossThreads) {
+    // Every element of a published set carries the same sequence number
+    TripleBuffer<std::array<uint64_t, 16>> buffer;
+    const uint64_t count = 100000;
+    std::thread writer([&] {
+        for (uint64_t i = 1; i <= count; ++i) {
+            buffer.back().fill(i);
+            buffer.publish();
+        }
+    });
+
+    uint64_t last = 0;
+    size_t torn = 0;
+    size_t backwards = 0;
+    while (last < count) {
+        if (buffer.update()) {
+            const std::array<uint64_t, 16>& set = buffer.front();
+            for (uint64_t value : set) {
+                torn += (value != set[0]);
+            }
+            backwards += (set[0] <= last);
+            last = set[0];
+        }
+    }
+    writer.join();
+    EXPECT_EQ(torn, 0u);
+    EXPECT_EQ(backwards, 0u);
+}
+
+TEST(TripleBufferTest, PublishedFilterParametersApplyAtNextBlock) {
+    std::vector<double> input = makeSignal(500);
+
+    // A Butterworth design dropped by publishAlpha() becomes an RC filter
+    LowPassFilter<double> lowPass(0.2, 4);
+    lowPass.processBlock(input.data(), 100);
+    lowPass.publishAlpha(0.1);
+    lowPass.process(input[0]);
+    EXPECT_EQ(lowPass.getImplementation(), FilterImplementation::Butterworth);
+    std::vector<double> output = lowPass.process(input);
+    EXPECT_EQ(lowPass.getImplementation(), FilterImplementation::IIR);
+    EXPECT_EQ(output, LowPassFilter<double>(0.1).process(input));
+
+    MovingAverageFilter<double> average(4);
+    average.process(input);
+    average.publishWindowSize(9);
+    average.publishWindowSize(0);
+    EXPECT_EQ(average.getWindowSize(), 4u);
+    output = average.process(input);
+    EXPECT_EQ(average.getWindowSize(), 9u);
+    EXPECT_EQ(output, MovingAverageFilter<double>(9).process(input));
+
+    HighPassFilter<double> highPass(0.2, 2);
+    highPass.process(input);
+    highPass.publishAlpha(0.8);
+    EXPECT_EQ(highPass.getImplementation(), FilterImplementation::Butterworth);
+    output = highPass.process(input);
+    EXPECT_EQ(highPass.getImplementation(), FilterImplementation::IIR);
+    EXPECT_EQ(output, HighPassFilter<double>(0.8).process(input));
+
+    // Stages start from cleared state, like a new filter
+    BandPassFilter<double> bandPass(0.1, 0.2, 4);
+    bandPass.process(input);
+    bandPass.publishCutoffs(0.4, 0.3);
+    output = bandPass.process(input);
+    EXPECT_EQ(output, BandPassFilter<double>(0.3, 0.4, 4).process(input));
+
+    MedianFilter<double> median(3);
+    median.process(input);
+    median.publishWindowSize(0);
+    median.publishWindowSize(7);
+    EXPECT_EQ(median.getOrder(), 3u);
+    output = median.process(input);
+    EXPECT_EQ(median.getOrder(), 7u);
+    EXPECT_EQ(output, MedianFilter<double>(7).process(input));
+}
+
+TEST(TripleBufferTest, PublishedSectionsApplyAtNextBlock) {
+    std::vector<double> input = makeSignal(500);
+    auto fourth = designSOS<double>(FilterImplementation::Butterworth, FilterType::LowPass, 4, 0.2);
+    auto sixth = designSOS<double>(FilterImplementation::Butterworth, FilterType::LowPass, 6, 0.3);
+    ASSERT_TRUE(fourth.isOk());
+    ASSERT_TRUE(sixth.isOk());
+
+    // A different section count starts from cleared state
+    SOSFilter<double> filter(fourth.value());
+    filter.process(input);
+    filter.publishSections(sixth.value());
+    filter.process(input[0]);
+    EXPECT_EQ(filter.getOrder(), 4u);
+    std::vector<double> output = filter.process(input);
+    EXPECT_EQ(filter.getOrder(), 6u);
+    EXPECT_EQ(output, SOSFilter<double>(sixth.value()).process(input));
+
+    // The same count keeps the state, which alone gives the output for a
+    // zero input
+    std::vector<BiquadSection<double>> doubled = sixth.value();
+    doubled[0].b0 *= 2;
+    doubled[0].b1 *= 2;
+    doubled[0].b2 *= 2;
+    SOSFilter<double> reference(sixth.value());
+    reference.process(input);
+    filter.publishSections(doubled);
+    std::vector<double> impulse(1, 0.0);
+    double kept = reference.process(impulse)[0];
+    double retuned = filter.process(impulse)[0];
+    EXPECT_NE(kept, 0.0);
+    EXPECT_NEAR(retuned, kept, 1e-12 * std::abs(kept));
+}
+
+TEST(TripleBufferTest, RetunesRunningPipeline) {
+    std::vector<double> input = makeSignal(4096);
+    auto lowPass = std::make_shared<LowPassFilter<double>>(0.5);
+    auto average = std::make_shared<MovingAverageFilter<double>>(4);
+    auto median = std::make_shared<MedianFilter<double>>(3);
+    RealTimeProcessor<double> processor(64, 1000.0);
+    processor.addFilter(lowPass);
+    processor.addFilter(average);
+    processor.addFilter(median);
+    ASSERT_TRUE(processor.startPipeline(3).isOk());
+
+    // A control thread retunes every stage while blocks stream through
+    std::atomic<bool> done(false);
+    std::thread control([&] {
+        for (uint32_t i = 0; !done.load(); ++i) {
+            lowPass->publishAlpha((i % 2) ? 0.2 : 0.7);
+            average->publishWindowSize(2 + i % 7);
+            median->publishWindowSize(1 + 2 * (i % 4));
+            std::this_thread::yield();
+        }
+    });
+    size_t outOfRange = 0;
+    for (int pass = 0; pass < 20; ++pass) {
+        for (double y : processor.processBuffer(input)) {
+            outOfRange += !(std::abs(y) <= 2.0);
+        }
+    }
+    done.store(true);
+    control.join();
+    EXPECT_EQ(outOfRange, 0u);
+
+    // Settle on known parameters; reset() restarts the pipeline cleanly
+    lowPass->publishAlpha(0.3);
+    average->publishWindowSize(5);
+    median->publishWindowSize(5);
+    processor.reset();
+    std::vector<double> output = processor.processBuffer(input);
+
+    RealTimeProcessor<double> reference(64, 1000.0);
+    reference.addFilter(std::make_shared<LowPassFilter<double>>(0.3));
+    reference.addFilter(std::make_shared<MovingAverageFilter<double>>(5));
+    reference.addFilter(std::make_shared<MedianFilter<double>>(5));
+    std::vector<double> expected = reference.processBuffer(input);
+    for (size_t n = 0; n < input.size(); ++n) {
+        ASSERT_NEAR(output[n], expected[n], 1e-12) << "sample " << n;
+    }
+}